@@ -116,9 +116,20 @@ run_cmake --build "$build_dir" --target install --config "$LIBMONGOCRYPT_BUILD_T
 run_cmake --build "$build_dir" --target test-mongocrypt --config "$LIBMONGOCRYPT_BUILD_TYPE"
 run_chdir "$build_dir" run_ctest -C "$LIBMONGOCRYPT_BUILD_TYPE"
 
+# Build and test libmongocrypt with the built-in crypto, without OpenSSL.
+run_cmake \
+    -UDISABLE_NATIVE_CRYPTO \
+    -DMONGOCRYPT_CRYPTO=builtin \
+    -DCMAKE_INSTALL_PREFIX="$MONGOCRYPT_INSTALL_PREFIX/builtincrypto" \
+    "${common_cmake_args[@]}"
+
+run_cmake --build "$build_dir" --target test-mongocrypt --config "$LIBMONGOCRYPT_BUILD_TYPE"
+run_chdir "$build_dir" run_ctest -C "$LIBMONGOCRYPT_BUILD_TYPE"
+
 # Build and install libmongocrypt without statically linking libbson
 run_cmake \
     -UDISABLE_NATIVE_CRYPTO \
+    -UMONGOCRYPT_CRYPTO \
     -DUSE_SHARED_LIBBSON=ON \
     -DCMAKE_INSTALL_PREFIX="$MONGOCRYPT_INSTALL_PREFIX/sharedbson" \
     "${common_cmake_args[@]}"
@@ -0,0 +1,179 @@
+﻿/*
+ * Copyright 2023–present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+using BenchmarkDotNet.Attributes;
+using MongoDB.Bson;
+using MongoDB.Bson.IO;
+using MongoDB.Bson.Serialization;
+using MongoDB.Bson.Serialization.Serializers;
+using System;
+using System.IO;
+using System.Text;
+
+namespace MongoDB.Libmongocrypt.Benchmarks
+{
+    /// <summary>
+    /// Compares the byte[] and span entry points for auto encryption and decryption.
+    /// Keys and collection info are cached during setup, so each operation only exercises
+    /// the data path and the crypto. The allocation column shows the managed copies avoided.
+    /// </summary>
+    [MemoryDiagnoser]
+    public class CryptContextBenchmarks
+    {
+        private CryptClient _cryptClient;
+        private byte[] _command;
+        private byte[] _markedCommand;
+        private byte[] _encryptedReply;
+        private byte[] _resultBuffer;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            var awsCredentials = new BsonDocument("aws", new BsonDocument { { "secretAccessKey", "dummy" }, { "accessKeyId", "dummy" } });
+            _cryptClient = CryptClientFactory.Create(new CryptOptions(new[] { new KmsCredentials(awsCredentials.ToBson()) }));
+
+            _command = ReadJsonTestFile("cmd.json");
+            _markedCommand = ReadJsonTestFile("mongocryptd-reply.json");
+            _encryptedReply = ReadJsonTestFile("encrypted-command-reply.json");
+            _resultBuffer = new byte[64 * 1024];
+
+            // Run one full encryption to populate the collection info and key caches
+            using (var context = _cryptClient.StartEncryptionContext("test", _command))
+            {
+                while (context.State != CryptContext.StateCode.MONGOCRYPT_CTX_READY)
+                {
+                    switch (context.State)
+                    {
+                        case CryptContext.StateCode.MONGOCRYPT_CTX_NEED_MONGO_COLLINFO:
+                            context.Feed(ReadJsonTestFile("collection-info.json"));
+                            context.MarkDone();
+                            break;
+                        case CryptContext.StateCode.MONGOCRYPT_CTX_NEED_MONGO_MARKINGS:
+                            context.Feed(_markedCommand);
+                            context.MarkDone();
+                            break;
+                        case CryptContext.StateCode.MONGOCRYPT_CTX_NEED_MONGO_KEYS:
+                            context.Feed(ReadJsonTestFile("key-document.json"));
+                            context.MarkDone();
+                            break;
+                        case CryptContext.StateCode.MONGOCRYPT_CTX_NEED_KMS:
+                            var requests = context.GetKmsMessageRequests();
+                            foreach (var request in requests)
+                            {
+                                request.Feed(Encoding.UTF8.GetBytes(ReadHttpTestFile("kms-decrypt-reply.txt")));
+                            }
+                            requests.MarkDone();
+                            break;
+                        default:
+                            throw new InvalidOperationException($"Unexpected state {context.State}.");
+                    }
+                }
+
+                using (context.FinalizeForEncryption())
+                {
+                }
+            }
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            _cryptClient.Dispose();
+        }
+
+        [Benchmark(Baseline = true)]
+        public int EncryptArray()
+        {
+            using (var context = _cryptClient.StartEncryptionContext("test", _command))
+            {
+                context.Feed(_markedCommand);
+                context.MarkDone();
+                using (var binary = context.FinalizeForEncryption())
+                {
+                    return binary.ToArray().Length;
+                }
+            }
+        }
+
+        [Benchmark]
+        public int EncryptSpan()
+        {
+            using (var context = _cryptClient.StartEncryptionContext("test", new ReadOnlySpan<byte>(_command)))
+            {
+                context.Feed(new ReadOnlySpan<byte>(_markedCommand));
+                context.MarkDone();
+                return CopyToResultBuffer(context.FinalizeAsSpan());
+            }
+        }
+
+        [Benchmark]
+        public int DecryptArray()
+        {
+            using (var context = _cryptClient.StartDecryptionContext(_encryptedReply))
+            using (var binary = context.FinalizeForEncryption())
+            {
+                return binary.ToArray().Length;
+            }
+        }
+
+        [Benchmark]
+        public int DecryptSpan()
+        {
+            using (var context = _cryptClient.StartDecryptionContext(new ReadOnlySpan<byte>(_encryptedReply)))
+            {
+                return CopyToResultBuffer(context.FinalizeAsSpan());
+            }
+        }
+
+        // Stands in for a caller that writes the result straight into its own (e.g. pooled) buffer
+        private int CopyToResultBuffer(ReadOnlySpan<byte> result)
+        {
+            result.CopyTo(_resultBuffer);
+            return result.Length;
+        }
+
+        private static byte[] ReadJsonTestFile(string fileName)
+        {
+            var text = File.ReadAllText(GetTestFilePath(fileName));
+
+            // Work around C# drivers and C driver have different extended json support
+            text = text.Replace("\"$numberLong\"", "$numberLong");
+
+            var settings = new BsonBinaryWriterSettings()
+            {
+                // C# driver "magically" changes UUIDs underneath by default so tell it not to
+                GuidRepresentation = GuidRepresentation.Standard
+            };
+            var jsonReaderSettings = new JsonReaderSettings { GuidRepresentation = GuidRepresentation.Unspecified };
+            using (var jsonReader = new JsonReader(text, jsonReaderSettings))
+            {
+                var context = BsonDeserializationContext.CreateRoot(jsonReader);
+                return BsonDocumentSerializer.Instance.Deserialize(context).ToBson(null, settings);
+            }
+        }
+
+        private static string ReadHttpTestFile(string fileName)
+        {
+            // The HTTP tests assume \r\n, and git strips \r on Unix machines by default
+            return File.ReadAllText(GetTestFilePath(fileName)).Replace("\r\n", "\n").Replace("\n", "\r\n");
+        }
+
+        private static string GetTestFilePath(string fileName)
+        {
+            return Path.Combine(AppContext.BaseDirectory, "test", "example", fileName);
+        }
+    }
+}
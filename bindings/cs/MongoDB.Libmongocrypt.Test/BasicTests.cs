@@ -15,6 +15,7 @@
  */
 
 using MongoDB.Bson;
+using MongoDB.Bson.Serialization;
 using System;
 using System.Collections.Generic;
 using System.IO;
@@ -128,6 +129,34 @@ namespace MongoDB.Libmongocrypt.Test
             }
         }
 
+        [Fact]
+        public void DecryptQueryWithSpans()
+        {
+            // Pass slices of larger buffers to check that offsets are honored
+            var command = BsonUtil.ToBytes(ReadJsonTestFile("encrypted-command-reply.json"));
+            var commandBuffer = new byte[command.Length + 8];
+            command.CopyTo(commandBuffer, 4);
+
+            using (var cryptClient = CryptClientFactory.Create(CreateOptions()))
+            using (var context = cryptClient.StartDecryptionContext(new ReadOnlySpan<byte>(commandBuffer, 4, command.Length)))
+            {
+                context.State.Should().Be(CryptContext.StateCode.MONGOCRYPT_CTX_NEED_MONGO_KEYS);
+                var keyDocument = BsonUtil.ToBytes(ReadJsonTestFile("key-document.json"));
+                var keyDocumentBuffer = new byte[keyDocument.Length + 8];
+                keyDocument.CopyTo(keyDocumentBuffer, 4);
+                context.Feed(new ReadOnlySpan<byte>(keyDocumentBuffer, 4, keyDocument.Length));
+                context.MarkDone();
+
+                var (state, _, _) = ProcessState(context);
+                state.Should().Be(CryptContext.StateCode.MONGOCRYPT_CTX_NEED_KMS);
+                context.State.Should().Be(CryptContext.StateCode.MONGOCRYPT_CTX_READY);
+
+                var result = context.FinalizeAsSpan().ToArray();
+                context.State.Should().Be(CryptContext.StateCode.MONGOCRYPT_CTX_DONE);
+                BsonSerializer.Deserialize<BsonDocument>(result).Should().Equal(ReadJsonTestFile("command-reply.json"));
+            }
+        }
+
         [Fact]
         public void DecryptQueryStepwise()
         {
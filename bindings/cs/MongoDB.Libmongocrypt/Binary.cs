@@ -81,16 +81,38 @@ namespace MongoDB.Libmongocrypt
             }
         }
 
+        /// <summary>
+        /// Gets a view of Data without copying it. The view is only valid while the owner of the data is alive.
+        /// </summary>
+        public ReadOnlySpan<byte> AsSpan()
+        {
+            unsafe
+            {
+                return new ReadOnlySpan<byte>((void*)Data, (int)Length);
+            }
+        }
+
         /// <summary>
         /// Write bytes into Data.
         /// </summary>
         public void WriteBytes(byte[] bytes)
+        {
+            WriteBytes(new ReadOnlySpan<byte>(bytes));
+        }
+
+        /// <summary>
+        /// Write bytes into Data.
+        /// </summary>
+        public void WriteBytes(ReadOnlySpan<byte> bytes)
         {
             // The length of the new bytes can be smaller than allocated memory 
             // because sometimes the allocated memory contains reserved blocks for future usage
             if (bytes.Length <= Length)
             {
-                Marshal.Copy(bytes, 0, Data, bytes.Length);
+                unsafe
+                {
+                    bytes.CopyTo(new Span<byte>((void*)Data, (int)Length));
+                }
             }
             else
             {
@@ -15,6 +15,7 @@
  */
 
 using System;
+using System.Buffers;
 using System.Security.Cryptography;
 
 namespace MongoDB.Libmongocrypt
@@ -36,30 +37,7 @@ namespace MongoDB.Libmongocrypt
             ref uint bytes_written,
             IntPtr statusPtr)
         {
-            using (var status = new Status(StatusSafeHandle.FromIntPtr(statusPtr)))
-            {
-                try
-                {
-                    var keyBinary = new Binary(BinarySafeHandle.FromIntPtr(key));
-                    var inputBinary = new Binary(BinarySafeHandle.FromIntPtr(@in));
-                    var outputBinary = new Binary(BinarySafeHandle.FromIntPtr(@out));
-                    var ivBinary = new Binary(BinarySafeHandle.FromIntPtr(iv));
-
-                    byte[] keyBytes = keyBinary.ToArray();
-                    byte[] ivBytes = ivBinary.ToArray();
-                    byte[] inputBytes = inputBinary.ToArray();
-
-                    var outputBytes = AesCrypt(keyBytes, ivBytes, inputBytes, CryptMode.Encrypt, CipherMode.CBC);
-                    bytes_written = (uint)outputBytes.Length;
-                    outputBinary.WriteBytes(outputBytes);
-                    return true;
-                }
-                catch (Exception e)
-                {
-                    status.SetStatus(1, e.Message);
-                    return false;
-                }
-            }
+            return Crypt(key, iv, @in, @out, ref bytes_written, statusPtr, CryptMode.Encrypt, CipherMode.CBC);
         }
 
         public static bool DecryptCbc(
@@ -71,31 +49,7 @@ namespace MongoDB.Libmongocrypt
             ref uint bytes_written,
             IntPtr statusPtr)
         {
-            using (var status = new Status(StatusSafeHandle.FromIntPtr(statusPtr)))
-            {
-                try
-                {
-                    var keyBinary = new Binary(BinarySafeHandle.FromIntPtr(key));
-                    var inputBinary = new Binary(BinarySafeHandle.FromIntPtr(@in));
-                    var outputBinary = new Binary(BinarySafeHandle.FromIntPtr(@out));
-                    var ivBinary = new Binary(BinarySafeHandle.FromIntPtr(iv));
-
-                    byte[] keyBytes = keyBinary.ToArray();
-                    byte[] ivBytes = ivBinary.ToArray();
-                    byte[] inputBytes = inputBinary.ToArray();
-
-                    var outputBytes = AesCrypt(keyBytes, ivBytes, inputBytes, CryptMode.Decrypt, CipherMode.CBC);
-                    bytes_written = (uint)outputBytes.Length;
-                    outputBinary.WriteBytes(outputBytes);
-
-                    return true;
-                }
-                catch (Exception e)
-                {
-                    status.SetStatus(1, e.Message);
-                    return false;
-                }
-            }
+            return Crypt(key, iv, @in, @out, ref bytes_written, statusPtr, CryptMode.Decrypt, CipherMode.CBC);
         }
 
         public static bool EncryptEcb(
@@ -106,6 +60,29 @@ namespace MongoDB.Libmongocrypt
             IntPtr @out,
             ref uint bytes_written,
             IntPtr statusPtr)
+        {
+            return Crypt(key, iv, @in, @out, ref bytes_written, statusPtr, CryptMode.Encrypt, CipherMode.ECB);
+        }
+
+        public static byte[] AesCrypt(byte[] keyBytes, byte[] ivBytes, byte[] inputBytes, CryptMode cryptMode, CipherMode cipherMode)
+        {
+            using (var aes = CreateAes(keyBytes, ivBytes, cipherMode))
+            using (var encrypto = CreateCryptoTransform(aes, cryptMode))
+            {
+                byte[] encryptedBytes = encrypto.TransformFinalBlock(inputBytes, 0, inputBytes.Length);
+                return encryptedBytes;
+            }
+        }
+
+        private static bool Crypt(
+            IntPtr key,
+            IntPtr iv,
+            IntPtr @in,
+            IntPtr @out,
+            ref uint bytes_written,
+            IntPtr statusPtr,
+            CryptMode cryptMode,
+            CipherMode cipherMode)
         {
             using (var status = new Status(StatusSafeHandle.FromIntPtr(statusPtr)))
             {
@@ -116,13 +93,7 @@ namespace MongoDB.Libmongocrypt
                     var outputBinary = new Binary(BinarySafeHandle.FromIntPtr(@out));
                     var ivBinary = new Binary(BinarySafeHandle.FromIntPtr(iv));
 
-                    byte[] keyBytes = keyBinary.ToArray();
-                    byte[] ivBytes = ivBinary.ToArray();
-                    byte[] inputBytes = inputBinary.ToArray();
-
-                    var outputBytes = AesCrypt(keyBytes, ivBytes, inputBytes, CryptMode.Encrypt, CipherMode.ECB);
-                    bytes_written = (uint)outputBytes.Length;
-                    outputBinary.WriteBytes(outputBytes);
+                    bytes_written = (uint)AesCrypt(keyBinary.ToArray(), ivBinary.ToArray(), inputBinary, outputBinary, cryptMode, cipherMode);
                     return true;
                 }
                 catch (Exception e)
@@ -133,35 +104,59 @@ namespace MongoDB.Libmongocrypt
             }
         }
 
-        public static byte[] AesCrypt(byte[] keyBytes, byte[] ivBytes, byte[] inputBytes, CryptMode cryptMode, CipherMode cipherMode)
+        // Stages the input and output through pooled arrays, since the transforms only accept arrays,
+        // so a callback does not allocate in proportion to the payload.
+        private static int AesCrypt(byte[] keyBytes, byte[] ivBytes, Binary input, Binary output, CryptMode cryptMode, CipherMode cipherMode)
         {
-            using (var aes = new RijndaelManaged())
+            var length = (int)input.Length;
+            var inputBuffer = ArrayPool<byte>.Shared.Rent(length);
+            var outputBuffer = ArrayPool<byte>.Shared.Rent(length);
+            try
             {
-                aes.Mode = cipherMode;
+                input.AsSpan().CopyTo(inputBuffer);
 
-                aes.Key = keyBytes;
-                if (ivBytes.Length > 0)
+                // mongocrypt level is responsible for padding, so the whole input is a multiple of the block size
+                // and TransformBlock does not hold back a final block.
+                int written;
+                using (var aes = CreateAes(keyBytes, ivBytes, cipherMode))
+                using (var transform = CreateCryptoTransform(aes, cryptMode))
                 {
-                    aes.IV = ivBytes;
+                    written = transform.TransformBlock(inputBuffer, 0, length, outputBuffer, 0);
                 }
 
-                aes.Padding = PaddingMode.None; // mongocrypt level is responsible for padding
+                output.WriteBytes(new ReadOnlySpan<byte>(outputBuffer, 0, written));
+                return written;
+            }
+            finally
+            {
+                // The buffers hold plaintext, so clear them before they are reused
+                ArrayPool<byte>.Shared.Return(inputBuffer, clearArray: true);
+                ArrayPool<byte>.Shared.Return(outputBuffer, clearArray: true);
+            }
+        }
 
-                using (var encrypto = CreateCryptoTransform(aes))
-                {
-                    byte[] encryptedBytes = encrypto.TransformFinalBlock(inputBytes, 0, inputBytes.Length);
-                    return encryptedBytes;
-                }
+        private static RijndaelManaged CreateAes(byte[] keyBytes, byte[] ivBytes, CipherMode cipherMode)
+        {
+            var aes = new RijndaelManaged();
+            aes.Mode = cipherMode;
 
-                ICryptoTransform CreateCryptoTransform(RijndaelManaged rijndaelManaged)
-                {
-                    switch (cryptMode)
-                    {
-                        case CryptMode.Encrypt: return rijndaelManaged.CreateEncryptor();
-                        case CryptMode.Decrypt: return rijndaelManaged.CreateDecryptor();
-                        default: throw new InvalidOperationException($"Unsupported crypt mode {cryptMode}."); // should not be reached
-                    }
-                }
+            aes.Key = keyBytes;
+            if (ivBytes.Length > 0)
+            {
+                aes.IV = ivBytes;
+            }
+
+            aes.Padding = PaddingMode.None; // mongocrypt level is responsible for padding
+            return aes;
+        }
+
+        private static ICryptoTransform CreateCryptoTransform(RijndaelManaged rijndaelManaged, CryptMode cryptMode)
+        {
+            switch (cryptMode)
+            {
+                case CryptMode.Encrypt: return rijndaelManaged.CreateEncryptor();
+                case CryptMode.Decrypt: return rijndaelManaged.CreateDecryptor();
+                default: throw new InvalidOperationException($"Unsupported crypt mode {cryptMode}."); // should not be reached
             }
         }
     }
@@ -74,6 +74,17 @@ namespace MongoDB.Libmongocrypt
         /// <param name="command">The command.</param>
         /// <returns>A encryption context.</returns>
         public CryptContext StartEncryptionContext(string db, byte[] command)
+        {
+            return StartEncryptionContext(db, new ReadOnlySpan<byte>(command));
+        }
+
+        /// <summary>
+        /// Starts the encryption context. The command is pinned rather than copied.
+        /// </summary>
+        /// <param name="db">The database of the collection.</param>
+        /// <param name="command">The command.</param>
+        /// <returns>A encryption context.</returns>
+        public CryptContext StartEncryptionContext(string db, ReadOnlySpan<byte> command)
         {
             ContextSafeHandle handle = Library.mongocrypt_ctx_new(_handle);
 
@@ -165,6 +176,16 @@ namespace MongoDB.Libmongocrypt
         /// <param name="buffer">The bson document to decrypt.</param>
         /// <returns>A decryption context</returns>
         public CryptContext StartDecryptionContext(byte[] buffer)
+        {
+            return StartDecryptionContext(new ReadOnlySpan<byte>(buffer));
+        }
+
+        /// <summary>
+        /// Starts the decryption context. The document is pinned rather than copied.
+        /// </summary>
+        /// <param name="buffer">The bson document to decrypt.</param>
+        /// <returns>A decryption context</returns>
+        public CryptContext StartDecryptionContext(ReadOnlySpan<byte> buffer)
         {
             ContextSafeHandle handle = Library.mongocrypt_ctx_new(_handle);
 
@@ -189,6 +210,16 @@ namespace MongoDB.Libmongocrypt
         /// <param name="buffer">The buffer.</param>
         /// <returns>A encryption context</returns>
         public CryptContext StartExplicitDecryptionContext(byte[] buffer)
+        {
+            return StartExplicitDecryptionContext(new ReadOnlySpan<byte>(buffer));
+        }
+
+        /// <summary>
+        /// Starts an explicit decryption context. The buffer is pinned rather than copied.
+        /// </summary>
+        /// <param name="buffer">The buffer.</param>
+        /// <returns>A encryption context</returns>
+        public CryptContext StartExplicitDecryptionContext(ReadOnlySpan<byte> buffer)
         {
             ContextSafeHandle handle = Library.mongocrypt_ctx_new(_handle);
 
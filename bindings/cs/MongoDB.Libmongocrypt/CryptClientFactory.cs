@@ -48,8 +48,10 @@ namespace MongoDB.Libmongocrypt
                 status = new Status();
 
                 // The below code can be avoided on Windows. So, we don't call it on this system 
-                // to avoid restrictions on target frameworks that present in some of below
-                if (OperatingSystemHelper.CurrentOperatingSystem != OperatingSystemPlatform.Windows)
+                // to avoid restrictions on target frameworks that present in some of below.
+                // It is also skipped when libmongocrypt has native crypto, which avoids a managed
+                // callback per operation and, for AES-CTR, per 16-byte ECB block.
+                if (OperatingSystemHelper.CurrentOperatingSystem != OperatingSystemPlatform.Windows && !Library.IsCryptoAvailable)
                 {
                     handle.Check(
                         status,
@@ -122,6 +122,16 @@ namespace MongoDB.Libmongocrypt
         /// </summary>
         /// <param name="buffer">The buffer.</param>
         public void Feed(byte[] buffer)
+        {
+            Feed(new ReadOnlySpan<byte>(buffer));
+        }
+
+        /// <summary>
+        /// Feeds the result from running a remote operation back to the libmongocrypt.
+        /// The buffer is pinned rather than copied, so it may be a slice of a pooled or native buffer.
+        /// </summary>
+        /// <param name="buffer">The buffer.</param>
+        public void Feed(ReadOnlySpan<byte> buffer)
         {
             unsafe
             {
@@ -155,6 +165,19 @@ namespace MongoDB.Libmongocrypt
             return binary;
         }
 
+        /// <summary>
+        /// Finalizes for encryption without copying the result.
+        /// </summary>
+        /// <returns>A view of the encrypted or decrypted result, valid until this context is disposed.</returns>
+        public ReadOnlySpan<byte> FinalizeAsSpan()
+        {
+            using (var binary = FinalizeForEncryption())
+            {
+                // The data is owned by the context, so the view outlives the binary
+                return binary.AsSpan();
+            }
+        }
+
         /// <summary>
         /// Gets a collection of KMS message requests to make
         /// </summary>
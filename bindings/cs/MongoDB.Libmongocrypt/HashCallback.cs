@@ -15,6 +15,7 @@
  */
 
 using System;
+using System.Buffers;
 using System.Security.Cryptography;
 
 namespace MongoDB.Libmongocrypt
@@ -34,8 +35,22 @@ namespace MongoDB.Libmongocrypt
                     var inputBinary = new Binary(BinarySafeHandle.FromIntPtr(@in));
                     var outBinary = new Binary(BinarySafeHandle.FromIntPtr(@out));
 
-                    var outBytes = CalculateHash(inputBinary.ToArray());
-                    outBinary.WriteBytes(outBytes);
+                    // Stage the input through a pooled array so the callback does not allocate in proportion to the payload
+                    var inputLength = (int)inputBinary.Length;
+                    var inputBuffer = ArrayPool<byte>.Shared.Rent(inputLength);
+                    try
+                    {
+                        inputBinary.AsSpan().CopyTo(inputBuffer);
+                        using (var sha256 = SHA256.Create())
+                        {
+                            _ = sha256.TransformFinalBlock(inputBuffer, 0, inputLength);
+                            outBinary.WriteBytes(sha256.Hash);
+                        }
+                    }
+                    finally
+                    {
+                        ArrayPool<byte>.Shared.Return(inputBuffer, clearArray: true);
+                    }
                     return true;
                 }
                 catch (Exception ex)
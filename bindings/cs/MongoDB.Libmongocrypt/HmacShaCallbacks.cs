@@ -15,6 +15,7 @@
  */
 
 using System;
+using System.Buffers;
 using System.Security.Cryptography;
 
 namespace MongoDB.Libmongocrypt
@@ -77,10 +78,23 @@ namespace MongoDB.Libmongocrypt
                     var outBinary = new Binary(BinarySafeHandle.FromIntPtr(@out));
 
                     var keyBytes = keyBinary.ToArray();
-                    var inBytes = inBinary.ToArray();
 
-                    var outBytes = CalculateHash(keyBytes, inBytes, bitness: bitness);
-                    outBinary.WriteBytes(outBytes);
+                    // Stage the input through a pooled array so the callback does not allocate in proportion to the payload
+                    var inLength = (int)inBinary.Length;
+                    var inBuffer = ArrayPool<byte>.Shared.Rent(inLength);
+                    try
+                    {
+                        inBinary.AsSpan().CopyTo(inBuffer);
+                        using (var hmac = GetHmacByBitness(bitness, keyBytes))
+                        {
+                            _ = hmac.TransformFinalBlock(inBuffer, 0, inLength);
+                            outBinary.WriteBytes(hmac.Hash);
+                        }
+                    }
+                    finally
+                    {
+                        ArrayPool<byte>.Shared.Return(inBuffer, clearArray: true);
+                    }
 
                     return true;
                 }
@@ -49,6 +49,9 @@ namespace MongoDB.Libmongocrypt
                 () => __loader.Value.GetFunction<Delegates.mongocrypt_ctx_setopt_key_encryption_key>(
                     ("mongocrypt_ctx_setopt_key_encryption_key")), true);
 
+            _mongocrypt_is_crypto_available = new Lazy<Delegates.mongocrypt_is_crypto_available>(
+                () => __loader.Value.GetFunction<Delegates.mongocrypt_is_crypto_available>(
+                    ("mongocrypt_is_crypto_available")), true);
             _mongocrypt_setopt_aes_256_ecb = new Lazy<Delegates.mongocrypt_setopt_aes_256_ecb>(
                 () => __loader.Value.GetFunction<Delegates.mongocrypt_setopt_aes_256_ecb>(
                     ("mongocrypt_setopt_aes_256_ecb")), true);
@@ -225,6 +228,29 @@ namespace MongoDB.Libmongocrypt
             }
         }
 
+        /// <summary>
+        /// Gets a value indicating whether libmongocrypt was built with native crypto.
+        /// If so, the managed crypto callbacks are not needed.
+        /// </summary>
+        /// <value>
+        ///   <c>true</c> if native crypto is available; otherwise, <c>false</c>.
+        /// </value>
+        public static bool IsCryptoAvailable
+        {
+            get
+            {
+                try
+                {
+                    return mongocrypt_is_crypto_available();
+                }
+                catch (LibraryLoader.FunctionNotFoundException)
+                {
+                    // libmongocrypt predates mongocrypt_is_crypto_available
+                    return false;
+                }
+            }
+        }
+
         internal static Delegates.mongocrypt_version mongocrypt_version => _mongocrypt_version.Value;
 
         internal static Delegates.mongocrypt_new mongocrypt_new => _mongocrypt_new.Value;
@@ -232,6 +258,7 @@ namespace MongoDB.Libmongocrypt
         internal static Delegates.mongocrypt_setopt_kms_providers mongocrypt_setopt_kms_providers => _mongocrypt_setopt_kms_providers.Value;
         internal static Delegates.mongocrypt_ctx_setopt_key_encryption_key mongocrypt_ctx_setopt_key_encryption_key => _mongocrypt_ctx_setopt_key_encryption_key.Value;
 
+        internal static Delegates.mongocrypt_is_crypto_available mongocrypt_is_crypto_available => _mongocrypt_is_crypto_available.Value;
         internal static Delegates.mongocrypt_setopt_aes_256_ecb mongocrypt_setopt_aes_256_ecb => _mongocrypt_setopt_aes_256_ecb.Value;
         internal static Delegates.mongocrypt_setopt_bypass_query_analysis mongocrypt_setopt_bypass_query_analysis => _mongocrypt_setopt_bypass_query_analysis.Value;
         internal static Delegates.mongocrypt_setopt_crypto_hooks mongocrypt_setopt_crypto_hooks => _mongocrypt_setopt_crypto_hooks.Value;
@@ -309,6 +336,7 @@ namespace MongoDB.Libmongocrypt
         private static readonly Lazy<Delegates.mongocrypt_setopt_kms_providers> _mongocrypt_setopt_kms_providers;
         private static readonly Lazy<Delegates.mongocrypt_ctx_setopt_key_encryption_key> _mongocrypt_ctx_setopt_key_encryption_key;
 
+        private static readonly Lazy<Delegates.mongocrypt_is_crypto_available> _mongocrypt_is_crypto_available;
         private static readonly Lazy<Delegates.mongocrypt_setopt_aes_256_ecb> _mongocrypt_setopt_aes_256_ecb;
         private static readonly Lazy<Delegates.mongocrypt_setopt_bypass_query_analysis> _mongocrypt_setopt_bypass_query_analysis;
         private static readonly Lazy<Delegates.mongocrypt_setopt_crypto_hooks> _mongocrypt_setopt_crypto_hooks;
@@ -468,6 +496,12 @@ namespace MongoDB.Libmongocrypt
                 [MarshalAs(UnmanagedType.FunctionPtr)] CryptoCallback aes_256_ecb_encrypt,
                 IntPtr ctx);
 
+            /// <summary>
+            /// bool mongocrypt_is_crypto_available(void);
+            /// </summary>
+            [return: MarshalAs(UnmanagedType.I1)]
+            public delegate bool mongocrypt_is_crypto_available();
+
             /// <summary>
             /// void mongocrypt_setopt_bypass_query_analysis(mongocrypt_t* crypt);
             /// </summary>
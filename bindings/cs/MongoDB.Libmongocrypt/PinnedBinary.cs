@@ -26,6 +26,11 @@ namespace MongoDB.Libmongocrypt
     {
         #region static
         internal static void RunAsPinnedBinary<THandle>(THandle handle, byte[] bytes, Status status, Func<THandle, BinarySafeHandle, bool> handleFunc) where THandle : CheckableSafeHandle
+        {
+            RunAsPinnedBinary(handle, new ReadOnlySpan<byte>(bytes), status, handleFunc);
+        }
+
+        internal static void RunAsPinnedBinary<THandle>(THandle handle, ReadOnlySpan<byte> bytes, Status status, Func<THandle, BinarySafeHandle, bool> handleFunc) where THandle : CheckableSafeHandle
         {
             unsafe
             {
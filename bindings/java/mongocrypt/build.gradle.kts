@@ -35,6 +35,7 @@ plugins {
     signing
     id("de.undercouch.download") version "5.0.5"
     id("biz.aQute.bnd.builder") version "6.2.0"
+    id("me.champeau.jmh") version "0.6.8"
 }
 
 repositories {
@@ -160,6 +161,15 @@ tasks.test {
     mustRunAfter("downloadJnaLibs", "downloadJava", "unzipJava")
 }
 
+/*
+ * Benchmarks: ./gradlew jmh -DjnaLibsPath=<path>
+ */
+sourceSets["jmh"].resources.srcDirs("src/test/resources")
+
+jmh {
+    jvmArgs.add("-Djna.library.path=$jnaResources")
+}
+
 tasks.withType<AbstractPublishToMaven> {
     description = """$description
         | System properties:
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+package com.mongodb.crypt.capi;
+
+import com.mongodb.crypt.capi.MongoCryptContext.State;
+import org.bson.BsonDocument;
+import org.bson.RawBsonDocument;
+import org.bson.codecs.BsonDocumentCodec;
+import org.openjdk.jmh.annotations.AuxCounters;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+import org.openjdk.jmh.infra.Blackhole;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.UncheckedIOException;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.Scanner;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Compares auto encryption and decryption when documents cross the JNA boundary as heap-backed {@link BsonDocument}s versus direct
+ * {@link ByteBuffer}s. Keys are cached during setup, so each operation only exercises the document data path and the crypto.
+ *
+ * <p>Besides ops/s, the {@code bytesCopied} secondary result reports how many document bytes were copied between the Java heap and
+ * native memory per operation.</p>
+ */
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+@org.openjdk.jmh.annotations.State(Scope.Benchmark)
+public class MongoCryptBenchmark {
+
+    @Param({"heap", "direct"})
+    public String dataPath;
+
+    private MongoCrypt mongoCrypt;
+    private BsonDocument command;
+    private RawBsonDocument encryptedReply;
+    private ByteBuffer directEncryptedReply;
+    private BsonDocument markedCommand;
+    private ByteBuffer directMarkedCommand;
+
+    @AuxCounters(AuxCounters.Type.EVENTS)
+    @org.openjdk.jmh.annotations.State(Scope.Thread)
+    public static class Counters {
+        public long bytesCopied;
+
+        @Setup(Level.Iteration)
+        public void reset() {
+            bytesCopied = 0;
+        }
+    }
+
+    @Setup
+    public void setup() {
+        mongoCrypt = MongoCrypts.create(MongoCryptOptions
+                .builder()
+                .awsKmsProviderOptions(MongoAwsKmsProviderOptions.builder()
+                        .accessKeyId("example")
+                        .secretAccessKey("example")
+                        .build())
+                .build());
+
+        command = getResourceAsDocument("command.json");
+        markedCommand = getResourceAsDocument("mongocryptd-reply.json");
+        encryptedReply = toRaw(getResourceAsDocument("encrypted-command-reply.json"));
+        directMarkedCommand = toDirect(markedCommand);
+        directEncryptedReply = toDirect(encryptedReply);
+
+        // Run one full encryption to populate the collection info and key caches
+        try (MongoCryptContext context = mongoCrypt.createEncryptionContext("test", command)) {
+            while (context.getState() != State.READY) {
+                switch (context.getState()) {
+                    case NEED_MONGO_COLLINFO:
+                        context.addMongoOperationResult(getResourceAsDocument("collection-info.json"));
+                        context.completeMongoOperation();
+                        break;
+                    case NEED_MONGO_MARKINGS:
+                        context.addMongoOperationResult(markedCommand);
+                        context.completeMongoOperation();
+                        break;
+                    case NEED_MONGO_KEYS:
+                        context.addMongoOperationResult(getResourceAsDocument("key-document.json"));
+                        context.completeMongoOperation();
+                        break;
+                    case NEED_KMS:
+                        MongoKeyDecryptor keyDecryptor = context.nextKeyDecryptor();
+                        keyDecryptor.feed(ByteBuffer.wrap(getResourceAsString("kms-reply.txt", "\r\n")
+                                .getBytes(StandardCharsets.UTF_8)));
+                        context.completeKeyDecryptors();
+                        break;
+                    default:
+                        throw new IllegalStateException("Unexpected state " + context.getState());
+                }
+            }
+            context.finish();
+        }
+    }
+
+    @TearDown
+    public void tearDown() {
+        mongoCrypt.close();
+    }
+
+    @Benchmark
+    public void autoEncrypt(final Counters counters, final Blackhole blackhole) {
+        try (MongoCryptContext context = mongoCrypt.createEncryptionContext("test", command)) {
+            if (context.getState() != State.NEED_MONGO_MARKINGS) {
+                throw new IllegalStateException("Expected cached collection info, but state is " + context.getState());
+            }
+            if (isDirect()) {
+                directMarkedCommand.rewind();
+                context.addMongoOperationResult(directMarkedCommand);
+            } else {
+                // Encodes and copies the document into native memory
+                context.addMongoOperationResult(markedCommand);
+                counters.bytesCopied += directMarkedCommand.limit();
+            }
+            context.completeMongoOperation();
+            finish(context, counters, blackhole);
+        }
+    }
+
+    @Benchmark
+    public void autoDecrypt(final Counters counters, final Blackhole blackhole) {
+        MongoCryptContext context;
+        if (isDirect()) {
+            directEncryptedReply.rewind();
+            context = mongoCrypt.createDecryptionContext(directEncryptedReply);
+        } else {
+            context = mongoCrypt.createDecryptionContext(encryptedReply);
+            counters.bytesCopied += directEncryptedReply.limit();
+        }
+        try {
+            finish(context, counters, blackhole);
+        } finally {
+            context.close();
+        }
+    }
+
+    private void finish(final MongoCryptContext context, final Counters counters, final Blackhole blackhole) {
+        if (context.getState() != State.READY) {
+            throw new IllegalStateException("Expected cached keys, but state is " + context.getState());
+        }
+        if (isDirect()) {
+            ByteBuffer result = context.finishAsByteBuffer();
+            // Read the document in place, as a driver decoding straight from the buffer would
+            blackhole.consume(result.getInt(0));
+        } else {
+            RawBsonDocument result = context.finish();
+            counters.bytesCopied += result.getByteBuffer().remaining();
+            blackhole.consume(result);
+        }
+    }
+
+    private boolean isDirect() {
+        return dataPath.equals("direct");
+    }
+
+    private static RawBsonDocument toRaw(final BsonDocument document) {
+        return new RawBsonDocument(document, new BsonDocumentCodec());
+    }
+
+    private static ByteBuffer toDirect(final BsonDocument document) {
+        ByteBuffer source = toRaw(document).getByteBuffer().asNIO();
+        ByteBuffer direct = ByteBuffer.allocateDirect(source.remaining());
+        direct.put(source);
+        direct.flip();
+        return direct;
+    }
+
+    private static BsonDocument getResourceAsDocument(final String fileName) {
+        return BsonDocument.parse(getResourceAsString(fileName, System.lineSeparator()));
+    }
+
+    private static String getResourceAsString(final String fileName, final String lineSeparator) {
+        try (InputStream stream = MongoCryptBenchmark.class.getResourceAsStream("/" + fileName)) {
+            if (stream == null) {
+                throw new IllegalArgumentException("Could not find file " + fileName);
+            }
+            StringBuilder builder = new StringBuilder();
+            Scanner scanner = new Scanner(stream, StandardCharsets.UTF_8.name());
+            while (scanner.hasNextLine()) {
+                builder.append(scanner.nextLine()).append(lineSeparator);
+            }
+            return builder.toString();
+        } catch (IOException e) {
+            throw new UncheckedIOException(e);
+        }
+    }
+}
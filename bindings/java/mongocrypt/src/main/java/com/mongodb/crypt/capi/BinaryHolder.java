@@ -19,17 +19,28 @@ package com.mongodb.crypt.capi;
 
 import com.mongodb.crypt.capi.CAPI.mongocrypt_binary_t;
 
+import java.nio.ByteBuffer;
+
 import static com.mongodb.crypt.capi.CAPI.mongocrypt_binary_destroy;
 
 // Wrap JNA memory and a mongocrypt_binary_t that references that memory, in order to ensure that the JNA Memory is not GC'd before the
-// mongocrypt_binary_t is destroyed
+// mongocrypt_binary_t is destroyed. When the binary views a direct ByteBuffer instead, hold on to the buffer for the same reason.
 class BinaryHolder implements AutoCloseable {
 
     private final DisposableMemory memory;
+    @SuppressWarnings({"FieldCanBeLocal", "unused"})
+    private final ByteBuffer directBuffer;
     private final mongocrypt_binary_t binary;
 
     BinaryHolder(final DisposableMemory memory, final mongocrypt_binary_t binary) {
         this.memory = memory;
+        this.directBuffer = null;
+        this.binary = binary;
+    }
+
+    BinaryHolder(final ByteBuffer directBuffer, final mongocrypt_binary_t binary) {
+        this.memory = null;
+        this.directBuffer = directBuffer;
         this.binary = binary;
     }
 
@@ -40,6 +51,8 @@ class BinaryHolder implements AutoCloseable {
     @Override
     public void close() {
         mongocrypt_binary_destroy(binary);
-        memory.dispose();
+        if (memory != null) {
+            memory.dispose();
+        }
     }
 }
@@ -309,6 +309,16 @@ public class CAPI {
                                   mongocrypt_log_fn_t log_fn,
                                   Pointer log_ctx);
 
+    /**
+     * Returns true if libmongocrypt was built with native crypto support.
+     * <p>
+     * If false, crypto hooks must be set with @ref mongocrypt_setopt_crypto_hooks
+     * before calling @ref mongocrypt_init.
+     *
+     * @return A boolean indicating whether native crypto is available.
+     */
+    public static native boolean
+    mongocrypt_is_crypto_available();
 
     public static native boolean
     mongocrypt_setopt_crypto_hooks(mongocrypt_t crypt,
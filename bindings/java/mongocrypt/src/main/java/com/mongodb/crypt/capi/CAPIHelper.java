@@ -18,6 +18,7 @@
 package com.mongodb.crypt.capi;
 
 import com.mongodb.crypt.capi.CAPI.mongocrypt_binary_t;
+import com.sun.jna.Native;
 import com.sun.jna.Pointer;
 import org.bson.BsonBinaryWriter;
 import org.bson.BsonDocument;
@@ -42,6 +43,11 @@ final class CAPIHelper {
 
     @SuppressWarnings("unchecked")
     static BinaryHolder toBinary(final BsonDocument document) {
+        if (document instanceof RawBsonDocument) {
+            // Already encoded, so copy the bytes straight into native memory rather than re-encoding them first
+            return toBinary(((RawBsonDocument) document).getByteBuffer().asNIO());
+        }
+
         BasicOutputBuffer buffer = new BasicOutputBuffer();
         BsonBinaryWriter writer = new BsonBinaryWriter(buffer);
         ((Codec<BsonDocument>) CODEC_REGISTRY.get(document.getClass())).encode(writer, document, EncoderContext.builder().build());
@@ -59,14 +65,22 @@ final class CAPIHelper {
         return new RawBsonDocument(bytes);
     }
 
+    /**
+     * Wraps the remaining bytes of the buffer, consuming them. A direct buffer is passed to libmongocrypt by address without copying,
+     * so it must not be modified until the returned holder is closed. A heap buffer is copied into native memory.
+     */
     static BinaryHolder toBinary(final ByteBuffer buffer) {
-        byte[] message = new byte[buffer.remaining()];
-        buffer.get(message, 0, buffer.remaining());
+        int length = buffer.remaining();
+        if (buffer.isDirect()) {
+            Pointer pointer = Native.getDirectBufferPointer(buffer).share(buffer.position());
+            buffer.position(buffer.limit());
+            return new BinaryHolder(buffer, mongocrypt_binary_new_from_data(pointer, length));
+        }
 
-        DisposableMemory memory = new DisposableMemory(message.length);
-        memory.write(0, message, 0, message.length);
+        DisposableMemory memory = new DisposableMemory(length);
+        memory.getByteBuffer(0, length).put(buffer);
 
-        return new BinaryHolder(memory, mongocrypt_binary_new_from_data(memory, message.length));
+        return new BinaryHolder(memory, mongocrypt_binary_new_from_data(memory, length));
     }
 
     static ByteBuffer toByteBuffer(final mongocrypt_binary_t binary) {
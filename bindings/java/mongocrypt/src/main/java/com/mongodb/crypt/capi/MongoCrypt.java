@@ -21,6 +21,7 @@ package com.mongodb.crypt.capi;
 import org.bson.BsonDocument;
 
 import java.io.Closeable;
+import java.nio.ByteBuffer;
 
 /**
  * A context for encryption/decryption operations.
@@ -44,6 +45,16 @@ public interface MongoCrypt extends Closeable {
      */
     MongoCryptContext createDecryptionContext(BsonDocument document);
 
+    /**
+     * Create a context to use for decryption. The remaining bytes of the buffer are consumed. A direct buffer is passed to
+     * libmongocrypt without being copied onto the heap first.
+     *
+     * @param document the BSON-encoded document to decrypt
+     * @return the context
+     * @since 1.8
+     */
+    MongoCryptContext createDecryptionContext(ByteBuffer document);
+
     /**
      * Create a context to use for creating a data key
      * @param kmsProvider the KMS provider
@@ -21,6 +21,7 @@ import org.bson.BsonDocument;
 import org.bson.RawBsonDocument;
 
 import java.io.Closeable;
+import java.nio.ByteBuffer;
 
 /**
  * An interface representing the lifecycle of an encryption or decryption request.  It's modelled as a state machine.
@@ -102,6 +103,15 @@ public interface MongoCryptContext extends Closeable {
      */
     void addMongoOperationResult(BsonDocument document);
 
+    /**
+     * Add a BSON-encoded result of the operation. The remaining bytes of the buffer are consumed. A direct buffer is passed to
+     * libmongocrypt without being copied.
+     *
+     * @param document a result of the operation
+     * @since 1.8
+     */
+    void addMongoOperationResult(ByteBuffer document);
+
     /**
      * Signal completion of the operation
      */
@@ -132,6 +142,15 @@ public interface MongoCryptContext extends Closeable {
      */
     RawBsonDocument finish();
 
+    /**
+     * Like {@link #finish()}, but returns a read-only view of the encrypted or decrypted document in native memory instead of
+     * copying it onto the heap. The view is only valid until this context is closed.
+     *
+     * @return the encrypted or decrypted document
+     * @since 1.8
+     */
+    ByteBuffer finishAsByteBuffer();
+
     @Override
     void close();
 }
@@ -119,25 +119,38 @@ class MongoCryptImpl implements MongoCrypt {
 
         configure(() -> mongocrypt_setopt_log_handler(wrapped, logCallback, null));
 
-        // We specify NoPadding here because the underlying C library is responsible for padding prior
-        // to executing the callback
-        aesCBC256EncryptCallback = new CipherCallback("AES", "AES/CBC/NoPadding", Cipher.ENCRYPT_MODE);
-        aesCBC256DecryptCallback = new CipherCallback("AES", "AES/CBC/NoPadding", Cipher.DECRYPT_MODE);
-        aesCTR256EncryptCallback = new CipherCallback("AES", "AES/CTR/NoPadding", Cipher.ENCRYPT_MODE);
-        aesCTR256DecryptCallback = new CipherCallback("AES", "AES/CTR/NoPadding", Cipher.DECRYPT_MODE);
-
-        hmacSha512Callback = new MacCallback("HmacSHA512");
-        hmacSha256Callback = new MacCallback("HmacSHA256");
-        sha256Callback = new MessageDigestCallback("SHA-256");
-        secureRandomCallback = new SecureRandomCallback(new SecureRandom());
-
-        configure(() -> mongocrypt_setopt_crypto_hooks(wrapped, aesCBC256EncryptCallback, aesCBC256DecryptCallback,
-                                                        secureRandomCallback, hmacSha512Callback, hmacSha256Callback,
-                                                        sha256Callback, null));
-
-        signingRSAESPKCSCallback = new SigningRSAESPKCSCallback();
-        configure(() -> mongocrypt_setopt_crypto_hook_sign_rsaes_pkcs1_v1_5(wrapped, signingRSAESPKCSCallback, null));
-        configure(() -> mongocrypt_setopt_aes_256_ctr(wrapped, aesCTR256EncryptCallback, aesCTR256DecryptCallback, null));
+        if (isNativeCryptoAvailable()) {
+            // libmongocrypt does its own crypto, so skip the per-operation JNA callbacks into the JCE
+            aesCBC256EncryptCallback = null;
+            aesCBC256DecryptCallback = null;
+            aesCTR256EncryptCallback = null;
+            aesCTR256DecryptCallback = null;
+            hmacSha512Callback = null;
+            hmacSha256Callback = null;
+            sha256Callback = null;
+            secureRandomCallback = null;
+            signingRSAESPKCSCallback = null;
+        } else {
+            // We specify NoPadding here because the underlying C library is responsible for padding prior
+            // to executing the callback
+            aesCBC256EncryptCallback = new CipherCallback("AES", "AES/CBC/NoPadding", Cipher.ENCRYPT_MODE);
+            aesCBC256DecryptCallback = new CipherCallback("AES", "AES/CBC/NoPadding", Cipher.DECRYPT_MODE);
+            aesCTR256EncryptCallback = new CipherCallback("AES", "AES/CTR/NoPadding", Cipher.ENCRYPT_MODE);
+            aesCTR256DecryptCallback = new CipherCallback("AES", "AES/CTR/NoPadding", Cipher.DECRYPT_MODE);
+
+            hmacSha512Callback = new MacCallback("HmacSHA512");
+            hmacSha256Callback = new MacCallback("HmacSHA256");
+            sha256Callback = new MessageDigestCallback("SHA-256");
+            secureRandomCallback = new SecureRandomCallback(new SecureRandom());
+
+            configure(() -> mongocrypt_setopt_crypto_hooks(wrapped, aesCBC256EncryptCallback, aesCBC256DecryptCallback,
+                                                            secureRandomCallback, hmacSha512Callback, hmacSha256Callback,
+                                                            sha256Callback, null));
+
+            signingRSAESPKCSCallback = new SigningRSAESPKCSCallback();
+            configure(() -> mongocrypt_setopt_crypto_hook_sign_rsaes_pkcs1_v1_5(wrapped, signingRSAESPKCSCallback, null));
+            configure(() -> mongocrypt_setopt_aes_256_ctr(wrapped, aesCTR256EncryptCallback, aesCTR256DecryptCallback, null));
+        }
 
         configure(() -> mongocrypt_setopt_fle2v2(wrapped, true));
         
@@ -223,6 +236,19 @@ class MongoCryptImpl implements MongoCrypt {
         return new MongoCryptContextImpl(context);
     }
 
+    @Override
+    public MongoCryptContext createDecryptionContext(final ByteBuffer document) {
+        isTrue("open", !closed.get());
+        mongocrypt_ctx_t context = mongocrypt_ctx_new(wrapped);
+        if (context == null) {
+            throwExceptionFromStatus();
+        }
+        try (BinaryHolder documentBinaryHolder = toBinary(document)) {
+            configure(() -> mongocrypt_ctx_decrypt_init(context, documentBinaryHolder.getBinary()), context);
+        }
+        return new MongoCryptContextImpl(context);
+    }
+
     @Override
     public MongoCryptContext createDataKeyContext(final String kmsProvider, final MongoDataKeyOptions options) {
         isTrue("open", !closed.get());
@@ -388,6 +414,15 @@ class MongoCryptImpl implements MongoCrypt {
         throw e;
     }
 
+    private static boolean isNativeCryptoAvailable() {
+        try {
+            return CAPI.mongocrypt_is_crypto_available();
+        } catch (UnsatisfiedLinkError e) {
+            // libmongocrypt predates mongocrypt_is_crypto_available
+            return false;
+        }
+    }
+
     static class LogCallback implements mongocrypt_log_fn_t {
         @Override
         public void log(final int level, final cstring message, final int messageLength, final Pointer ctx) {
@@ -23,6 +23,7 @@ import org.bson.BsonBinarySubType;
 import org.bson.BsonDocument;
 import org.bson.BsonString;
 import org.bson.RawBsonDocument;
+import org.bson.codecs.BsonDocumentCodec;
 import org.junit.jupiter.api.Disabled;
 import org.junit.jupiter.api.Test;
 
@@ -44,6 +45,7 @@ import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertIterableEquals;
 import static org.junit.jupiter.api.Assertions.assertNotNull;
 import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
 
 
 @SuppressWarnings("SameParameterValue")
@@ -107,6 +109,40 @@ public class MongoCryptTest {
         mongoCrypt.close();
     }
 
+    @Test
+    public void testDecryptWithDirectByteBuffers() {
+        MongoCrypt mongoCrypt = createMongoCrypt();
+
+        MongoCryptContext decryptor = mongoCrypt.createDecryptionContext(getResourceAsDocument("encrypted-command-reply.json"));
+        assertEquals(State.NEED_MONGO_KEYS, decryptor.getState());
+        assertEquals(getResourceAsDocument("key-filter.json"), decryptor.getMongoOperation());
+
+        ByteBuffer keyDocument = toDirectByteBuffer(getResourceAsDocument("key-document.json"));
+        decryptor.addMongoOperationResult(keyDocument);
+        assertEquals(0, keyDocument.remaining());
+        decryptor.completeMongoOperation();
+
+        assertEquals(State.NEED_KMS, decryptor.getState());
+        MongoKeyDecryptor keyDecryptor = decryptor.nextKeyDecryptor();
+        keyDecryptor.feed(getHttpResourceAsByteBuffer("kms-reply.txt"));
+        assertNull(decryptor.nextKeyDecryptor());
+        decryptor.completeKeyDecryptors();
+
+        assertEquals(State.READY, decryptor.getState());
+        ByteBuffer decrypted = decryptor.finishAsByteBuffer();
+        assertEquals(State.DONE, decryptor.getState());
+        assertTrue(decrypted.isDirect());
+        assertTrue(decrypted.isReadOnly());
+
+        byte[] bytes = new byte[decrypted.remaining()];
+        decrypted.get(bytes);
+        assertEquals(getResourceAsDocument("command-reply.json"), new RawBsonDocument(bytes));
+
+        decryptor.close();
+
+        mongoCrypt.close();
+    }
+
     @Test
     public void testEmptyAwsCredentials() throws URISyntaxException, IOException {
         MongoCrypt mongoCrypt = MongoCrypts.create(MongoCryptOptions
@@ -316,6 +352,14 @@ public class MongoCryptTest {
         return BsonDocument.parse(getFileAsString(fileName, System.getProperty("line.separator")));
     }
 
+    private static ByteBuffer toDirectByteBuffer(final BsonDocument document) {
+        ByteBuffer source = new RawBsonDocument(document, new BsonDocumentCodec()).getByteBuffer().asNIO();
+        ByteBuffer direct = ByteBuffer.allocateDirect(source.remaining());
+        direct.put(source);
+        direct.flip();
+        return direct;
+    }
+
     private static ByteBuffer getHttpResourceAsByteBuffer(final String fileName) {
         return ByteBuffer.wrap(getFileAsString(fileName, "\r\n").getBytes(StandardCharsets.UTF_8));
     }
@@ -0,0 +1,107 @@
+'use strict';
+
+// Measures how long the event loop is blocked while many explicit
+// encryptions run concurrently, once with the synchronous context methods
+// and once with their `*Async` variants. Run with:
+//
+//   node etc/benchmarks/eventLoopLag.js [concurrency] [payloadBytes]
+//
+// The `*Async` variants only leave the main thread when the bindings were
+// built with native crypto, since JavaScript crypto callbacks must run on
+// the event loop.
+
+const { monitorEventLoopDelay, performance } = require('perf_hooks');
+const { BSON } = require('mongodb');
+const cryptoCallbacks = require('../../lib/cryptoCallbacks');
+const mc = require('bindings')('mongocrypt');
+
+const MONGOCRYPT_CTX_NEED_MONGO_KEYS = 3;
+const MONGOCRYPT_CTX_READY = 5;
+
+const concurrency = Number(process.argv[2] || 64);
+const payloadBytes = Number(process.argv[3] || 1024 * 1024);
+const iterations = 5;
+
+function createMongoCrypt() {
+  const options = { kmsProviders: BSON.serialize({ local: { key: Buffer.alloc(96, 1) } }) };
+  if (!mc.MongoCrypt.hasNativeCrypto) {
+    options.cryptoCallbacks = cryptoCallbacks;
+  }
+  return new mc.MongoCrypt(options);
+}
+
+function createDataKey(mongoCrypt) {
+  const context = mongoCrypt.makeDataKeyContext(BSON.serialize({ provider: 'local' }), {});
+  if (context.state !== MONGOCRYPT_CTX_READY) {
+    throw new Error(`unexpected data key state: ${context.state}`);
+  }
+  return context.finalize();
+}
+
+function makeContext(mongoCrypt, keyId, value) {
+  const context = mongoCrypt.makeExplicitEncryptionContext(value, {
+    keyId,
+    algorithm: 'AEAD_AES_256_CBC_HMAC_SHA_512-Random'
+  });
+  if (context.state !== MONGOCRYPT_CTX_NEED_MONGO_KEYS) {
+    throw new Error(`unexpected encryption state: ${context.state}`);
+  }
+  return context;
+}
+
+function encryptSync(mongoCrypt, keyDocument, keyId, value) {
+  const context = makeContext(mongoCrypt, keyId, value);
+  context.addMongoOperationResponse(keyDocument);
+  context.finishMongoOperation();
+  return Promise.resolve(context.finalize());
+}
+
+async function encryptAsync(mongoCrypt, keyDocument, keyId, value) {
+  const context = makeContext(mongoCrypt, keyId, value);
+  await context.addMongoOperationResponseAsync(keyDocument);
+  await context.finishMongoOperationAsync();
+  return context.finalizeAsync();
+}
+
+async function run(name, encrypt, mongoCrypt, keyDocument, keyId, value) {
+  const histogram = monitorEventLoopDelay({ resolution: 1 });
+  histogram.enable();
+  const start = performance.now();
+  for (let i = 0; i < iterations; i++) {
+    const pending = [];
+    for (let j = 0; j < concurrency; j++) {
+      // Yield between submissions so the lag monitor gets a chance to tick.
+      await new Promise(resolve => setImmediate(resolve));
+      pending.push(encrypt(mongoCrypt, keyDocument, keyId, value));
+    }
+    await Promise.all(pending);
+  }
+  const elapsed = performance.now() - start;
+  histogram.disable();
+
+  const ms = ns => (ns / 1e6).toFixed(2);
+  console.log(
+    `${name.padEnd(6)} total ${elapsed.toFixed(0)}ms, ` +
+      `event loop delay p50 ${ms(histogram.percentile(50))}ms, ` +
+      `p99 ${ms(histogram.percentile(99))}ms, max ${ms(histogram.max)}ms`
+  );
+}
+
+async function main() {
+  const mongoCrypt = createMongoCrypt();
+  const keyDocument = createDataKey(mongoCrypt);
+  const keyId = BSON.deserialize(keyDocument)._id.buffer;
+  const value = BSON.serialize({ v: 'x'.repeat(payloadBytes) });
+
+  console.log(
+    `libmongocrypt ${mc.MongoCrypt.libmongocryptVersion}, native crypto: ${mc.MongoCrypt.hasNativeCrypto}, ` +
+      `concurrency ${concurrency}, payload ${payloadBytes} bytes`
+  );
+  await run('sync', encryptSync, mongoCrypt, keyDocument, keyId, value);
+  await run('async', encryptAsync, mongoCrypt, keyDocument, keyId, value);
+}
+
+main().catch(err => {
+  console.error(err);
+  process.exitCode = 1;
+});
@@ -289,6 +289,14 @@ export interface ClientEncryptionOptions {
    * TLS options for kms providers to use.
    */
   tlsOptions?: { [kms in keyof KMSProviders]?: ClientEncryptionTlsOptions };
+
+  /**
+   * Use libmongocrypt's own crypto instead of Node's when the bindings were
+   * built with it. Without JavaScript crypto callbacks, CPU-bound steps such
+   * as finalizing a context run on the libuv threadpool instead of blocking
+   * the event loop. Ignored when native crypto is unavailable.
+   */
+  useNativeCrypto?: boolean;
 }
 
 /**
@@ -23,6 +23,7 @@ module.exports = function (modules) {
    * @property {boolean} [bypassAutoEncryption] Allows the user to bypass auto encryption, maintaining implicit decryption
    * @property {AutoEncrypter~logger} [options.logger] An optional hook to catch logging messages from the underlying encryption engine
    * @property {AutoEncrypter~AutoEncryptionExtraOptions} [extraOptions] Extra options related to the mongocryptd process
+   * @property {boolean} [useNativeCrypto=false] Use libmongocrypt's own crypto instead of Node's when the bindings were built with it, which lets CPU-bound work run on the libuv threadpool
    */
 
   /**
@@ -143,7 +144,9 @@ module.exports = function (modules) {
         mongoCryptOptions.cryptSharedLibSearchPaths = ['$SYSTEM'];
       }
 
-      Object.assign(mongoCryptOptions, { cryptoCallbacks });
+      if (!options.useNativeCrypto || !mc.MongoCrypt.hasNativeCrypto) {
+        Object.assign(mongoCryptOptions, { cryptoCallbacks });
+      }
       this._mongocrypt = new mc.MongoCrypt(mongoCryptOptions);
       this._contextCounter = 0;
 
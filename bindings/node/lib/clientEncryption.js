@@ -85,6 +85,7 @@ module.exports = function (modules) {
      * @param {object} options.tlsOptions An object that maps KMS provider names to TLS options.
      * @param {MongoClient} [options.keyVaultClient] A `MongoClient` used to fetch keys from a key vault. Defaults to `client`
      * @param {KMSProviders} [options.kmsProviders] options for specific KMS providers to use
+     * @param {boolean} [options.useNativeCrypto=false] Use libmongocrypt's own crypto instead of Node's when the bindings were built with it, which lets CPU-bound work run on the libuv threadpool
      *
      * @example
      * new ClientEncryption(mongoClient, {
@@ -118,7 +119,10 @@ module.exports = function (modules) {
         throw new TypeError('Missing required option `keyVaultNamespace`');
       }
 
-      const mongoCryptOptions = { ...options, cryptoCallbacks };
+      const mongoCryptOptions = { ...options };
+      if (!options.useNativeCrypto || !mc.MongoCrypt.hasNativeCrypto) {
+        mongoCryptOptions.cryptoCallbacks = cryptoCallbacks;
+      }
 
       mongoCryptOptions.kmsProviders = !Buffer.isBuffer(this._kmsProviders)
         ? this._bson.serialize(this._kmsProviders)
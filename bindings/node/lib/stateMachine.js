@@ -136,6 +136,14 @@ module.exports = function (modules) {
 
         case MONGOCRYPT_CTX_NEED_MONGO_MARKINGS: {
           const command = context.nextMongoOperation();
+          // Turning markings into ciphertexts is CPU-bound, so it runs off the event loop.
+          const onMarkedCommand = markedCommand => {
+            context
+              .addMongoOperationResponseAsync(markedCommand)
+              .then(() => context.finishMongoOperationAsync())
+              .then(() => this.execute(autoEncrypter, context, callback))
+              .catch(err => callback(err, null));
+          };
           this.markCommand(mongocryptdClient, context.ns, command, (err, markedCommand) => {
             if (err) {
               // If we are not bypassing spawning, then we should retry once on a MongoTimeoutError (server selection error)
@@ -149,20 +157,14 @@ module.exports = function (modules) {
                   this.markCommand(mongocryptdClient, context.ns, command, (err, markedCommand) => {
                     if (err) return callback(err, null);
 
-                    context.addMongoOperationResponse(markedCommand);
-                    context.finishMongoOperation();
-
-                    this.execute(autoEncrypter, context, callback);
+                    onMarkedCommand(markedCommand);
                   });
                 });
                 return;
               }
               return callback(err, null);
             }
-            context.addMongoOperationResponse(markedCommand);
-            context.finishMongoOperation();
-
-            this.execute(autoEncrypter, context, callback);
+            onMarkedCommand(markedCommand);
           });
 
           return;
@@ -208,8 +210,8 @@ module.exports = function (modules) {
           }
 
           Promise.all(promises)
+            .then(() => context.finishKMSRequestsAsync())
             .then(() => {
-              context.finishKMSRequests();
               this.execute(autoEncrypter, context, callback);
             })
             .catch(err => {
@@ -221,16 +223,27 @@ module.exports = function (modules) {
 
         // terminal states
         case MONGOCRYPT_CTX_READY: {
-          const finalizedContext = context.finalize();
-          // TODO: Maybe rework the logic here so that instead of doing
-          // the callback here, finalize stores the result, and then
-          // we wait to MONGOCRYPT_CTX_DONE to do the callback
-          if (context.state === MONGOCRYPT_CTX_ERROR) {
-            const message = context.status.message || 'Finalization error';
-            callback(new MongoCryptError(message));
-            return;
-          }
-          callback(null, bson.deserialize(finalizedContext, this.options));
+          context.finalizeAsync().then(
+            finalizedContext => {
+              // TODO: Maybe rework the logic here so that instead of doing
+              // the callback here, finalize stores the result, and then
+              // we wait to MONGOCRYPT_CTX_DONE to do the callback
+              if (context.state === MONGOCRYPT_CTX_ERROR) {
+                const message = context.status.message || 'Finalization error';
+                callback(new MongoCryptError(message));
+                return;
+              }
+              let result;
+              try {
+                result = bson.deserialize(finalizedContext, this.options);
+              } catch (err) {
+                callback(err, null);
+                return;
+              }
+              callback(null, result);
+            },
+            err => callback(err, null)
+          );
           return;
         }
         case MONGOCRYPT_CTX_ERROR: {
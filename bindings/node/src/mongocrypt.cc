@@ -1,5 +1,6 @@
 #include "mongocrypt.h"
 #include <cassert>
+#include <vector>
 
 #ifdef _MSC_VER 
 #define strncasecmp _strnicmp
@@ -101,6 +102,12 @@ E strToEnumValue(
         std::string("invalid enum value: '") + str + "' for " + option_name);
 }
 
+#ifdef MONGOCRYPT_ENABLE_CRYPTO
+constexpr bool kHasNativeCrypto = true;
+#else
+constexpr bool kHasNativeCrypto = false;
+#endif
+
 }  // anonymous namespace
 
 Function MongoCrypt::Init(Napi::Env env) {
@@ -116,7 +123,8 @@ Function MongoCrypt::Init(Napi::Env env) {
                     InstanceMethod("makeRewrapManyDataKeyContext", &MongoCrypt::MakeRewrapManyDataKeyContext),
                     InstanceAccessor("status", &MongoCrypt::Status, nullptr),
                     InstanceAccessor("cryptSharedLibVersionInfo", &MongoCrypt::CryptSharedLibVersionInfo, nullptr),
-                    StaticValue("libmongocryptVersion", String::New(env, mongocrypt_version(nullptr)))
+                    StaticValue("libmongocryptVersion", String::New(env, mongocrypt_version(nullptr))),
+                    StaticValue("hasNativeCrypto", Boolean::New(env, kHasNativeCrypto))
                   });
 }
 
@@ -430,6 +438,7 @@ MongoCrypt::MongoCrypt(const CallbackInfo& info)
     }
 
     if (options.Has("logger")) {
+        _calls_into_js = true;
         SetCallback("logger", options["logger"]);
         if (!mongocrypt_setopt_log_handler(
                 _mongo_crypt.get(), MongoCrypt::logHandler, this)) {
@@ -438,6 +447,7 @@ MongoCrypt::MongoCrypt(const CallbackInfo& info)
     }
 
     if (options.Has("cryptoCallbacks")) {
+        _calls_into_js = true;
         Object cryptoCallbacks = options.Get("cryptoCallbacks").ToObject();
 
         SetCallback("aes256CbcEncryptHook", cryptoCallbacks["aes256CbcEncryptHook"]);
@@ -522,7 +532,7 @@ Value MongoCrypt::MakeEncryptionContext(const CallbackInfo& info) {
         throw TypeError::New(Env(), errorStringFromStatus(context.get()));
     }
 
-    return MongoCryptContext::NewInstance(Env(), std::move(context));
+    return NewContext(std::move(context));
 }
 
 Value MongoCrypt::MakeExplicitEncryptionContext(const CallbackInfo& info) {
@@ -617,7 +627,7 @@ Value MongoCrypt::MakeExplicitEncryptionContext(const CallbackInfo& info) {
         throw TypeError::New(Env(), errorStringFromStatus(context.get()));
     }
 
-    return MongoCryptContext::NewInstance(Env(), std::move(context));
+    return NewContext(std::move(context));
 }
 
 Value MongoCrypt::MakeDecryptionContext(const CallbackInfo& info) {
@@ -634,7 +644,7 @@ Value MongoCrypt::MakeDecryptionContext(const CallbackInfo& info) {
         throw TypeError::New(Env(), errorStringFromStatus(context.get()));
     }
 
-    return MongoCryptContext::NewInstance(Env(), std::move(context));
+    return NewContext(std::move(context));
 }
 
 Value MongoCrypt::MakeExplicitDecryptionContext(const CallbackInfo& info) {
@@ -651,7 +661,7 @@ Value MongoCrypt::MakeExplicitDecryptionContext(const CallbackInfo& info) {
         throw TypeError::New(Env(), errorStringFromStatus(context.get()));
     }
 
-    return MongoCryptContext::NewInstance(Env(), std::move(context));
+    return NewContext(std::move(context));
 }
 
 Value MongoCrypt::MakeDataKeyContext(const CallbackInfo& info) {
@@ -715,7 +725,7 @@ Value MongoCrypt::MakeDataKeyContext(const CallbackInfo& info) {
         throw TypeError::New(Env(), errorStringFromStatus(context.get()));
     }
 
-    return MongoCryptContext::NewInstance(Env(), std::move(context));
+    return NewContext(std::move(context));
 }
 
 Value MongoCrypt::MakeRewrapManyDataKeyContext(const CallbackInfo& info) {
@@ -742,7 +752,15 @@ Value MongoCrypt::MakeRewrapManyDataKeyContext(const CallbackInfo& info) {
         throw TypeError::New(Env(), errorStringFromStatus(context.get()));
     }
 
-    return MongoCryptContext::NewInstance(Env(), std::move(context));
+    return NewContext(std::move(context));
+}
+
+Object MongoCrypt::NewContext(std::unique_ptr<mongocrypt_ctx_t, MongoCryptContextDeleter> context) {
+    Object result = MongoCryptContext::NewInstance(Env(), std::move(context), !_calls_into_js);
+    // A context may still be running on the threadpool after JS drops its
+    // last reference to this object, so the context keeps it alive.
+    result.Set("__mongoCrypt", Value());
+    return result;
 }
 
 // Store callbacks as nested properties on the MongoCrypt binding object
@@ -785,16 +803,23 @@ Function MongoCryptContext::Init(Napi::Env env) {
                     InstanceMethod("provideKMSProviders", &MongoCryptContext::ProvideKMSProviders),
                     InstanceMethod("finishKMSRequests", &MongoCryptContext::FinishKMSRequests),
                     InstanceMethod("finalize", &MongoCryptContext::FinalizeContext),
+                    InstanceMethod("addMongoOperationResponseAsync", &MongoCryptContext::AddMongoOperationResponseAsync),
+                    InstanceMethod("finishMongoOperationAsync", &MongoCryptContext::FinishMongoOperationAsync),
+                    InstanceMethod("finishKMSRequestsAsync", &MongoCryptContext::FinishKMSRequestsAsync),
+                    InstanceMethod("finalizeAsync", &MongoCryptContext::FinalizeContextAsync),
                     InstanceAccessor("status", &MongoCryptContext::Status, nullptr),
                     InstanceAccessor("state", &MongoCryptContext::State, nullptr)
                   });
 }
 
-Object MongoCryptContext::NewInstance(Napi::Env env, std::unique_ptr<mongocrypt_ctx_t, MongoCryptContextDeleter> context) {
+Object MongoCryptContext::NewInstance(Napi::Env env,
+                                      std::unique_ptr<mongocrypt_ctx_t, MongoCryptContextDeleter> context,
+                                      bool offloadable) {
     InstanceData* instance_data = env.GetInstanceData<InstanceData>();
     Object obj = instance_data->MongoCryptContextCtor.Value().New({});
     MongoCryptContext* instance = MongoCryptContext::Unwrap(obj);
     instance->_context = std::move(context);
+    instance->_offloadable = offloadable;
     return obj;
 }
 
@@ -802,22 +827,26 @@ MongoCryptContext::MongoCryptContext(const CallbackInfo& info)
     : ObjectWrap(info) {}
 
 Value MongoCryptContext::Status(const CallbackInfo& info) {
+    ThrowIfPending();
     std::unique_ptr<mongocrypt_status_t, MongoCryptStatusDeleter> status(mongocrypt_status_new());
     mongocrypt_ctx_status(_context.get(), status.get());
     return ExtractStatus(Env(), status.get());
 }
 
 Value MongoCryptContext::State(const CallbackInfo& info) {
+    ThrowIfPending();
     return Number::New(Env(), mongocrypt_ctx_state(_context.get()));
 }
 
 Value MongoCryptContext::NextMongoOperation(const CallbackInfo& info) {
+    ThrowIfPending();
     std::unique_ptr<mongocrypt_binary_t, MongoCryptBinaryDeleter> op_bson(mongocrypt_binary_new());
     mongocrypt_ctx_mongo_op(_context.get(), op_bson.get());
     return BufferFromBinary(Env(), op_bson.get());
 }
 
 void MongoCryptContext::AddMongoOperationResponse(const CallbackInfo& info) {
+    ThrowIfPending();
     if (info.Length() != 1 || !info[0].IsObject()) {
         throw TypeError::New(Env(), "Missing required parameter `buffer`");
     }
@@ -833,10 +862,12 @@ void MongoCryptContext::AddMongoOperationResponse(const CallbackInfo& info) {
 }
 
 void MongoCryptContext::FinishMongoOperation(const CallbackInfo& info) {
+    ThrowIfPending();
     mongocrypt_ctx_mongo_done(_context.get());
 }
 
 void MongoCryptContext::ProvideKMSProviders(const CallbackInfo& info) {
+    ThrowIfPending();
     if (info.Length() != 1 || !info[0].IsObject()) {
         throw TypeError::New(Env(), "Missing required parameter `buffer`");
     }
@@ -851,6 +882,7 @@ void MongoCryptContext::ProvideKMSProviders(const CallbackInfo& info) {
 }
 
 Value MongoCryptContext::NextKMSRequest(const CallbackInfo& info) {
+    ThrowIfPending();
     mongocrypt_kms_ctx_t* kms_context = mongocrypt_ctx_next_kms_ctx(_context.get());
     if (kms_context == nullptr) {
         return Env().Null();
@@ -866,15 +898,138 @@ Value MongoCryptContext::NextKMSRequest(const CallbackInfo& info) {
 }
 
 void MongoCryptContext::FinishKMSRequests(const CallbackInfo& info) {
+    ThrowIfPending();
     mongocrypt_ctx_kms_done(_context.get());
 }
 
 Value MongoCryptContext::FinalizeContext(const CallbackInfo& info) {
+    ThrowIfPending();
     std::unique_ptr<mongocrypt_binary_t, MongoCryptBinaryDeleter> output(mongocrypt_binary_new());
     mongocrypt_ctx_finalize(_context.get(), output.get());
     return BufferFromBinary(Env(), output.get());
 }
 
+// Runs one libmongocrypt context transition on the libuv threadpool and
+// settles a Promise with the result back on the main thread. libmongocrypt
+// reports failures through the context state, so the Promise only rejects
+// for errors in the binding itself.
+class ContextOperationWorker : public AsyncWorker {
+   public:
+    ContextOperationWorker(MongoCryptContext* context,
+                           MongoCryptContext::Operation operation,
+                           bool resolve_with_output)
+        : AsyncWorker(context->Env(), "MongoCryptContextOperation"),
+          _context(context),
+          _receiver(Persistent(context->Value())),
+          _operation(std::move(operation)),
+          _output(mongocrypt_binary_new()),
+          _resolve_with_output(resolve_with_output),
+          _deferred(Promise::Deferred::New(context->Env())) {}
+
+    Promise GetPromise() {
+        return _deferred.Promise();
+    }
+
+    void Execute() override {
+        _operation(_context->_context.get(), _output.get());
+    }
+
+    void OnOK() override {
+        _context->_pending = false;
+        _deferred.Resolve(Result());
+    }
+
+    void OnError(const Error& error) override {
+        _context->_pending = false;
+        _deferred.Reject(error.Value());
+    }
+
+   private:
+    Napi::Value Result() {
+        if (!_resolve_with_output) {
+            return Env().Undefined();
+        }
+        return BufferFromBinary(Env(), _output.get());
+    }
+
+    MongoCryptContext* _context;
+    // Keeps the context (and through it the MongoCrypt instance) alive until
+    // the operation completes.
+    ObjectReference _receiver;
+    MongoCryptContext::Operation _operation;
+    std::unique_ptr<mongocrypt_binary_t, MongoCryptBinaryDeleter> _output;
+    bool _resolve_with_output;
+    Promise::Deferred _deferred;
+};
+
+void MongoCryptContext::ThrowIfPending() {
+    if (_pending) {
+        throw Error::New(Env(), "Cannot use a context while an asynchronous operation on it is pending");
+    }
+}
+
+Value MongoCryptContext::RunOperation(Operation operation, bool resolve_with_output) {
+    ThrowIfPending();
+
+    if (!_offloadable) {
+        // Crypto hooks and the logger call into JavaScript, which is only
+        // allowed on the main thread.
+        std::unique_ptr<mongocrypt_binary_t, MongoCryptBinaryDeleter> output(mongocrypt_binary_new());
+        operation(_context.get(), output.get());
+        Promise::Deferred deferred = Promise::Deferred::New(Env());
+        if (resolve_with_output) {
+            deferred.Resolve(BufferFromBinary(Env(), output.get()));
+        } else {
+            deferred.Resolve(Env().Undefined());
+        }
+        return deferred.Promise();
+    }
+
+    // Deletes itself after OnOK/OnError.
+    ContextOperationWorker* worker = new ContextOperationWorker(this, std::move(operation), resolve_with_output);
+    Promise promise = worker->GetPromise();
+    _pending = true;
+    worker->Queue();
+    return promise;
+}
+
+Value MongoCryptContext::AddMongoOperationResponseAsync(const CallbackInfo& info) {
+    if (info.Length() != 1 || !info[0].IsObject()) {
+        throw TypeError::New(Env(), "Missing required parameter `buffer`");
+    }
+
+    if (!info[0].IsBuffer()) {
+        throw TypeError::New(Env(), "First parameter must be a Buffer");
+    }
+
+    // The JS buffer may be modified or collected while the worker runs.
+    Uint8Array buffer = info[0].As<Uint8Array>();
+    auto reply = std::make_shared<std::vector<uint8_t>>(buffer.Data(), buffer.Data() + buffer.ByteLength());
+    return RunOperation(
+        [reply](mongocrypt_ctx_t* context, mongocrypt_binary_t*) {
+            std::unique_ptr<mongocrypt_binary_t, MongoCryptBinaryDeleter> reply_bson(
+                mongocrypt_binary_new_from_data(reply->data(), static_cast<uint32_t>(reply->size())));
+            mongocrypt_ctx_mongo_feed(context, reply_bson.get());
+        },
+        false);
+}
+
+Value MongoCryptContext::FinishMongoOperationAsync(const CallbackInfo& info) {
+    return RunOperation(
+        [](mongocrypt_ctx_t* context, mongocrypt_binary_t*) { mongocrypt_ctx_mongo_done(context); }, false);
+}
+
+Value MongoCryptContext::FinishKMSRequestsAsync(const CallbackInfo& info) {
+    return RunOperation(
+        [](mongocrypt_ctx_t* context, mongocrypt_binary_t*) { mongocrypt_ctx_kms_done(context); }, false);
+}
+
+Value MongoCryptContext::FinalizeContextAsync(const CallbackInfo& info) {
+    return RunOperation(
+        [](mongocrypt_ctx_t* context, mongocrypt_binary_t* output) { mongocrypt_ctx_finalize(context, output); },
+        true);
+}
+
 Function MongoCryptKMSRequest::Init(Napi::Env env) {
   return
       DefineClass(env,
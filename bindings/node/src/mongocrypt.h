@@ -9,6 +9,7 @@
 #define NAPI_EXPERIMENTAL
 
 #include <napi.h>
+#include <functional>
 #include <memory>
 
 extern "C" {
@@ -63,13 +64,22 @@ class MongoCrypt : public Napi::ObjectWrap<MongoCrypt> {
                            uint32_t message_len,
                            void* ctx);
 
+    Napi::Object NewContext(std::unique_ptr<mongocrypt_ctx_t, MongoCryptContextDeleter> context);
+
     std::unique_ptr<mongocrypt_t, MongoCryptDeleter> _mongo_crypt;
+    // Set when libmongocrypt may call back into JavaScript (crypto hooks or a
+    // logger), which rules out running its work off the main thread.
+    bool _calls_into_js = false;
 };
 
+class ContextOperationWorker;
+
 class MongoCryptContext : public Napi::ObjectWrap<MongoCryptContext> {
    public:
     static Napi::Function Init(Napi::Env env);
-    static Napi::Object NewInstance(Napi::Env env, std::unique_ptr<mongocrypt_ctx_t, MongoCryptContextDeleter> context);
+    static Napi::Object NewInstance(Napi::Env env,
+                                    std::unique_ptr<mongocrypt_ctx_t, MongoCryptContextDeleter> context,
+                                    bool offloadable);
 
    private:
     Napi::Value NextMongoOperation(const Napi::CallbackInfo& info);
@@ -80,13 +90,28 @@ class MongoCryptContext : public Napi::ObjectWrap<MongoCryptContext> {
     void FinishKMSRequests(const Napi::CallbackInfo& info);
     Napi::Value FinalizeContext(const Napi::CallbackInfo& info);
 
+    // Promise-returning variants of the CPU-bound transitions above. They run
+    // on the libuv threadpool when the context is offloadable.
+    Napi::Value AddMongoOperationResponseAsync(const Napi::CallbackInfo& info);
+    Napi::Value FinishMongoOperationAsync(const Napi::CallbackInfo& info);
+    Napi::Value FinishKMSRequestsAsync(const Napi::CallbackInfo& info);
+    Napi::Value FinalizeContextAsync(const Napi::CallbackInfo& info);
+
     Napi::Value Status(const Napi::CallbackInfo& info);
     Napi::Value State(const Napi::CallbackInfo& info);
 
    private:
    friend class Napi::ObjectWrap<MongoCryptContext>;
+   friend class ContextOperationWorker;
     explicit MongoCryptContext(const Napi::CallbackInfo& info);
+
+    using Operation = std::function<void(mongocrypt_ctx_t*, mongocrypt_binary_t*)>;
+    Napi::Value RunOperation(Operation operation, bool resolve_with_output);
+    void ThrowIfPending();
+
     std::unique_ptr<mongocrypt_ctx_t, MongoCryptContextDeleter> _context;
+    bool _offloadable = false;
+    bool _pending = false;
 };
 
 class MongoCryptKMSRequest : public Napi::ObjectWrap<MongoCryptKMSRequest> {
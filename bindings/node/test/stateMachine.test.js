@@ -328,4 +328,48 @@ describe('StateMachine', function () {
       expect.fail('missed exception');
     });
   });
+
+  describe('asynchronous context operations', function () {
+    const mc = require('bindings')('mongocrypt');
+    const cryptoCallbacks = require('../lib/cryptoCallbacks');
+    const MONGOCRYPT_CTX_READY = 5;
+
+    function createMongoCrypt() {
+      const options = { kmsProviders: BSON.serialize({ local: { key: Buffer.alloc(96) } }) };
+      if (!mc.MongoCrypt.hasNativeCrypto) {
+        options.cryptoCallbacks = cryptoCallbacks;
+      }
+      return new mc.MongoCrypt(options);
+    }
+
+    it('finalizeAsync resolves with the finalized document', async function () {
+      const context = createMongoCrypt().makeDecryptionContext(BSON.serialize({ a: 'b' }));
+      expect(context.state).to.equal(MONGOCRYPT_CTX_READY);
+
+      const result = await context.finalizeAsync();
+      expect(BSON.deserialize(result)).to.deep.equal({ a: 'b' });
+    });
+
+    it('execute produces the same result as the synchronous path', function (done) {
+      const stateMachine = new StateMachine({ bson: BSON });
+      const context = createMongoCrypt().makeDecryptionContext(BSON.serialize({ a: 'b' }));
+
+      stateMachine.execute({}, context, (err, result) => {
+        expect(err).to.not.exist;
+        expect(result).to.deep.equal({ a: 'b' });
+        done();
+      });
+    });
+
+    it('rejects use of a context while an operation is pending', function () {
+      if (!mc.MongoCrypt.hasNativeCrypto) {
+        this.skip();
+      }
+      const context = createMongoCrypt().makeDecryptionContext(BSON.serialize({ a: 'b' }));
+
+      const pending = context.finalizeAsync();
+      expect(() => context.state).to.throw(/asynchronous operation/);
+      return pending;
+    });
+  });
 });
@@ -1335,6 +1335,19 @@ typedef bool (*mongocrypt_random_fn) (void *ctx,
                                       uint32_t count,
                                       mongocrypt_status_t *status);
 
+/**
+ * Returns true if libmongocrypt was built with native crypto support.
+ *
+ * If this returns false, crypto hooks must be set with @ref
+ * mongocrypt_setopt_crypto_hooks before calling @ref mongocrypt_init. If
+ * it returns true, bindings may omit the hooks and let libmongocrypt do
+ * crypto without calling back into the host language.
+ *
+ * @returns True if native crypto is available.
+ */
+bool
+mongocrypt_is_crypto_available (void);
+
 bool
 mongocrypt_setopt_crypto_hooks (mongocrypt_t *crypt,
                                 mongocrypt_crypto_fn aes_256_cbc_encrypt,
@@ -0,0 +1,116 @@
+# Copyright 2023-present MongoDB, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Benchmark explicit encryption and decryption throughput across threads.
+
+Run from bindings/python with::
+
+    python test/performance/perf_test.py [max_threads] [seconds]
+
+Throughput only scales with the thread count when libmongocrypt was built
+with native crypto, because the Python crypto hooks hold the GIL.
+"""
+
+import sys
+import threading
+import time
+
+import bson
+from bson.binary import UuidRepresentation
+from bson.codec_options import CodecOptions
+
+sys.path[0:0] = [""]
+
+from pymongocrypt.binding import libmongocrypt_version
+from pymongocrypt.explicit_encrypter import ExplicitEncrypter
+from pymongocrypt.mongocrypt import (MongoCryptOptions,
+                                     _native_crypto_available)
+from pymongocrypt.state_machine import MongoCryptCallback
+
+OPTS = CodecOptions(uuid_representation=UuidRepresentation.STANDARD)
+ALGORITHM = "AEAD_AES_256_CBC_HMAC_SHA_512-Deterministic"
+
+
+class LocalKeyVaultCallback(MongoCryptCallback):
+    """Keeps a single data key in memory."""
+
+    def __init__(self):
+        self.data_key = None
+
+    def kms_request(self, kms_context):
+        raise NotImplementedError
+
+    def collection_info(self, database, filter):
+        raise NotImplementedError
+
+    def mark_command(self, database, cmd):
+        raise NotImplementedError
+
+    def fetch_keys(self, filter):
+        return [self.data_key]
+
+    def insert_data_key(self, data_key):
+        self.data_key = data_key
+        return bson.decode(data_key, OPTS)['_id']
+
+    def bson_encode(self, doc):
+        return bson.encode(doc)
+
+    def close(self):
+        pass
+
+
+def run(encrypter, key_id, num_threads, seconds):
+    """Returns the number of encrypt+decrypt round trips per second."""
+    value = bson.encode({'v': 'x' * 1024})
+    counts = [0] * num_threads
+    deadline = time.monotonic() + seconds
+
+    def target(index):
+        while time.monotonic() < deadline:
+            encrypted = encrypter.encrypt(value, ALGORITHM, key_id=key_id)
+            encrypter.decrypt(encrypted)
+            counts[index] += 1
+
+    threads = [threading.Thread(target=target, args=(i,))
+               for i in range(num_threads)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return sum(counts) / seconds
+
+
+def main():
+    max_threads = int(sys.argv[1]) if len(sys.argv) > 1 else 8
+    seconds = float(sys.argv[2]) if len(sys.argv) > 2 else 5
+
+    callback = LocalKeyVaultCallback()
+    encrypter = ExplicitEncrypter(
+        callback, MongoCryptOptions({'local': {'key': b'\x00' * 96}}))
+    try:
+        key_id = encrypter.create_data_key('local').bytes
+        print("libmongocrypt %s, native crypto: %s" % (
+            libmongocrypt_version(), _native_crypto_available()))
+        num_threads = 1
+        while num_threads <= max_threads:
+            ops = run(encrypter, key_id, num_threads, seconds)
+            print("%2d thread(s): %10.1f ops/sec" % (num_threads, ops))
+            num_threads *= 2
+    finally:
+        encrypter.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -659,6 +659,14 @@ class TestExplicitEncryption(unittest.TestCase):
         key_alt_name = json_data('key-document.json')['keyAltNames'][0]
         self._test_encrypt_decrypt(key_alt_name=key_alt_name)
 
+    def test_encrypt_decrypt_python_crypto_hooks(self):
+        # Force the Python crypto hooks even if libmongocrypt has native
+        # crypto, the output must be identical.
+        with mock.patch('pymongocrypt.mongocrypt._native_crypto_available',
+                        return_value=False):
+            key_id = json_data('key-document.json')['_id']
+            self._test_encrypt_decrypt(key_id=key_id)
+
     def test_encrypt_errors(self):
         key_id = json_data('key-document.json')['_id']
         encrypter = ExplicitEncrypter(MockCallback(key_docs=[]), self.mongo_crypt_opts())
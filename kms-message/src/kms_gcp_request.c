@@ -24,6 +24,32 @@
  * one hour) */
 #define JWT_EXPIRATION_SECS 5 * 60
 #define SIGNATURE_LEN 256
+/* Only reuse a cached JWT assertion that is valid for at least this long. */
+#define JWT_REUSE_MARGIN_SECS 60
+
+/* Hash everything the JWT signature depends on, except the issue time. The
+ * email, audience and scope cannot contain a newline, and the private key is
+ * last, so the fields are unambiguous. */
+static bool
+jwt_claims_hash (kms_request_t *req,
+                 const char *email,
+                 const char *audience,
+                 const char *scope,
+                 const char *private_key_data,
+                 size_t private_key_len,
+                 unsigned char *hash_out)
+{
+   bool ret;
+   kms_request_str_t *str = kms_request_str_new ();
+
+   kms_request_str_appendf (str, "%s\n%s\n%s\n", email, audience, scope);
+   kms_request_str_append_chars (
+      str, private_key_data, (ssize_t) private_key_len);
+   ret = req->crypto.sha256 (req->crypto.ctx, str->str, str->len, hash_out);
+   memset (str->str, 0, str->len);
+   kms_request_str_destroy (str);
+   return ret;
+}
 
 kms_request_t *
 kms_gcp_request_oauth_new (const char *host,
@@ -45,6 +71,10 @@ kms_gcp_request_oauth_new (const char *host,
    char *jwt_signature_b64url = NULL;
    char *jwt_assertion_b64url = NULL;
    char *payload = NULL;
+   unsigned char claims_hash[32];
+   bool use_cache =
+      opt->gcp_assertion_cache.get && opt->gcp_assertion_cache.put;
+   bool reused = false;
 
    req = kms_request_new ("POST", "/token", opt);
    if (opt->provider != KMS_REQUEST_PROVIDER_GCP) {
@@ -56,9 +86,42 @@ kms_gcp_request_oauth_new (const char *host,
       goto done;
    }
 
+   req->crypto.sign_rsaes_pkcs1_v1_5 = kms_sign_rsaes_pkcs1_v1_5;
+   if (opt->crypto.sign_rsaes_pkcs1_v1_5) {
+      req->crypto.sign_rsaes_pkcs1_v1_5 = opt->crypto.sign_rsaes_pkcs1_v1_5;
+      req->crypto.sign_ctx = opt->crypto.sign_ctx;
+   }
+   jwt_signature = malloc (SIGNATURE_LEN);
+
    /* Produce the signed JWT <base64url header>.<base64url claims>.<base64url
     * signature> */
    issued_at = time (NULL);
+
+   /* Reuse a cached signature if its assertion has enough time left. Skip the
+    * cache if no SHA-256 is available to key it. */
+   if (use_cache && jwt_claims_hash (req,
+                                     email,
+                                     audience,
+                                     scope,
+                                     private_key_data,
+                                     private_key_len,
+                                     claims_hash)) {
+      uint64_t cached_issued_at;
+
+      if (opt->gcp_assertion_cache.get (opt->gcp_assertion_cache.ctx,
+                                        claims_hash,
+                                        &cached_issued_at,
+                                        jwt_signature) &&
+          cached_issued_at <= (uint64_t) issued_at &&
+          (uint64_t) issued_at + JWT_REUSE_MARGIN_SECS <
+             cached_issued_at + JWT_EXPIRATION_SECS) {
+         issued_at = (time_t) cached_issued_at;
+         reused = true;
+      }
+   } else {
+      use_cache = false;
+   }
+
    str = kms_request_str_new ();
    kms_request_str_appendf (str,
                             "{\"iss\": \"%s\", \"aud\": \"%s\", \"scope\": "
@@ -81,22 +144,23 @@ kms_gcp_request_oauth_new (const char *host,
    jwt_header_and_claims_b64url = kms_request_str_detach (str);
 
    /* Produce the signature of <base64url header>.<base64url claims> */
-   req->crypto.sign_rsaes_pkcs1_v1_5 = kms_sign_rsaes_pkcs1_v1_5;
-   if (opt->crypto.sign_rsaes_pkcs1_v1_5) {
-      req->crypto.sign_rsaes_pkcs1_v1_5 = opt->crypto.sign_rsaes_pkcs1_v1_5;
-      req->crypto.sign_ctx = opt->crypto.sign_ctx;
-   }
-
-   jwt_signature = malloc (SIGNATURE_LEN);
-   if (!req->crypto.sign_rsaes_pkcs1_v1_5 (
-          req->crypto.sign_ctx,
-          private_key_data,
-          private_key_len,
-          jwt_header_and_claims_b64url,
-          strlen (jwt_header_and_claims_b64url),
-          jwt_signature)) {
-      KMS_ERROR (req, "Failed to create GCP oauth request signature");
-      goto done;
+   if (!reused) {
+      if (!req->crypto.sign_rsaes_pkcs1_v1_5 (
+             req->crypto.sign_ctx,
+             private_key_data,
+             private_key_len,
+             jwt_header_and_claims_b64url,
+             strlen (jwt_header_and_claims_b64url),
+             jwt_signature)) {
+         KMS_ERROR (req, "Failed to create GCP oauth request signature");
+         goto done;
+      }
+      if (use_cache) {
+         opt->gcp_assertion_cache.put (opt->gcp_assertion_cache.ctx,
+                                       claims_hash,
+                                       (uint64_t) issued_at,
+                                       jwt_signature);
+      }
    }
 
    jwt_signature_b64url =
@@ -407,12 +407,13 @@ kmip_reader_read_string (kmip_reader_t *reader, uint8_t **ptr, size_t length)
    return kmip_reader_read_bytes (reader, ptr, length);
 }
 
-bool
-kmip_reader_find (kmip_reader_t *reader,
-                  kmip_tag_type_t search_tag,
-                  kmip_item_type_t type,
-                  size_t *pos,
-                  size_t *length)
+static bool
+kmip_reader_find_nth (kmip_reader_t *reader,
+                      kmip_tag_type_t search_tag,
+                      kmip_item_type_t type,
+                      size_t n,
+                      size_t *pos,
+                      size_t *length)
 {
    reader->pos = 0;
 
@@ -428,9 +429,12 @@ kmip_reader_find (kmip_reader_t *reader,
 
 
       if (read_tag == search_tag && read_type == type) {
-         *pos = reader->pos;
-         *length = read_length;
-         return true;
+         if (n == 0) {
+            *pos = reader->pos;
+            *length = read_length;
+            return true;
+         }
+         n--;
       }
 
       size_t advance_length = read_length;
@@ -445,13 +449,32 @@ kmip_reader_find (kmip_reader_t *reader,
    return false;
 }
 
+bool
+kmip_reader_find (kmip_reader_t *reader,
+                  kmip_tag_type_t search_tag,
+                  kmip_item_type_t type,
+                  size_t *pos,
+                  size_t *length)
+{
+   return kmip_reader_find_nth (reader, search_tag, type, 0, pos, length);
+}
+
 bool
 kmip_reader_find_and_recurse (kmip_reader_t *reader, kmip_tag_type_t tag)
+{
+   return kmip_reader_find_and_recurse_nth (reader, tag, 0);
+}
+
+bool
+kmip_reader_find_and_recurse_nth (kmip_reader_t *reader,
+                                  kmip_tag_type_t tag,
+                                  size_t n)
 {
    size_t pos;
    size_t length;
 
-   if (!kmip_reader_find (reader, tag, KMIP_ITEM_TYPE_Structure, &pos, &length)) {
+   if (!kmip_reader_find_nth (
+          reader, tag, KMIP_ITEM_TYPE_Structure, n, &pos, &length)) {
       return false;
    }
 
@@ -461,6 +484,42 @@ kmip_reader_find_and_recurse (kmip_reader_t *reader, kmip_tag_type_t tag)
    return true;
 }
 
+bool
+kmip_reader_find_and_recurse_with_bytes (kmip_reader_t *reader,
+                                         kmip_tag_type_t tag,
+                                         kmip_tag_type_t child_tag,
+                                         const uint8_t *value,
+                                         size_t value_len)
+{
+   size_t n;
+   size_t pos;
+   size_t length;
+
+   for (n = 0; kmip_reader_find_nth (
+           reader, tag, KMIP_ITEM_TYPE_Structure, n, &pos, &length);
+        n++) {
+      kmip_reader_t child;
+      uint8_t *child_value;
+      size_t child_len;
+
+      if (!kmip_reader_in_place (reader, pos, length, &child)) {
+         return false;
+      }
+
+      if (kmip_reader_find_and_read_bytes (
+             &child, child_tag, &child_value, &child_len) &&
+          child_len == value_len &&
+          0 == memcmp (child_value, value, value_len)) {
+         reader->pos = 0;
+         reader->ptr = reader->ptr + pos;
+         reader->len = length;
+         return true;
+      }
+   }
+
+   return false;
+}
+
 bool
 kmip_reader_find_and_read_enum (kmip_reader_t *reader,
                                 kmip_tag_type_t tag,
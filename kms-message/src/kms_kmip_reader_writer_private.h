@@ -136,6 +136,23 @@ kmip_reader_find (kmip_reader_t *reader,
 bool
 kmip_reader_find_and_recurse (kmip_reader_t *reader, kmip_tag_type_t tag);
 
+/* kmip_reader_find_and_recurse_nth is like kmip_reader_find_and_recurse, but
+ * descends into the n-th (0 based) structure with a matching tag. */
+bool
+kmip_reader_find_and_recurse_nth (kmip_reader_t *reader,
+                                  kmip_tag_type_t tag,
+                                  size_t n);
+
+/* kmip_reader_find_and_recurse_with_bytes is like
+ * kmip_reader_find_and_recurse, but descends into the first structure with a
+ * matching tag that has a ByteString child_tag equal to value. */
+bool
+kmip_reader_find_and_recurse_with_bytes (kmip_reader_t *reader,
+                                         kmip_tag_type_t tag,
+                                         kmip_tag_type_t child_tag,
+                                         const uint8_t *value,
+                                         size_t value_len);
+
 bool
 kmip_reader_find_and_read_enum (kmip_reader_t *reader,
                                 kmip_tag_type_t tag,
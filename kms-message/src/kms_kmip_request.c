@@ -17,6 +17,7 @@
 #include "kms_message/kms_kmip_request.h"
 
 #include "kms_message_private.h"
+#include "kms_endian_private.h"
 #include "kms_kmip_reader_writer_private.h"
 
 #include <inttypes.h>
@@ -199,32 +200,51 @@ kms_kmip_request_activate_new (void *reserved, const char *unique_identifer)
 
 kms_request_t *
 kms_kmip_request_get_new (void *reserved, const char *unique_identifer)
+{
+   return kms_kmip_request_get_batch_new (reserved, &unique_identifer, 1);
+}
+
+kms_request_t *
+kms_kmip_request_get_batch_new (void *reserved,
+                                const char *const *unique_identifiers,
+                                size_t count)
 {
    /*
-   Create a KMIP Get request of this form:
+   Create a KMIP Get request with one BatchItem per unique identifier:
    <RequestMessage tag="0x420078" type="Structure">
     <RequestHeader tag="0x420077" type="Structure">
      <ProtocolVersion tag="0x420069" type="Structure">
       <ProtocolVersionMajor tag="0x42006a" type="Integer" value="1"/>
       <ProtocolVersionMinor tag="0x42006b" type="Integer" value="0"/>
      </ProtocolVersion>
-     <BatchCount tag="0x42000d" type="Integer" value="1"/>
+     <BatchCount tag="0x42000d" type="Integer" value="count"/>
     </RequestHeader>
     <BatchItem tag="0x42000f" type="Structure">
      <Operation tag="0x42005c" type="Enumeration" value="10"/>
+     <UniqueBatchItemID tag="0x420093" type="ByteString" value="..."/>
      <RequestPayload tag="0x420079" type="Structure">
       <UniqueIdentifier tag="0x420094" type="TextString" value="..."/>
      </RequestPayload>
     </BatchItem>
+    ... repeated count times ...
    </RequestMessage>
+   UniqueBatchItemID is required if there is more than one BatchItem. It is
+   the index of the BatchItem as a big-endian uint32, which
+   kms_kmip_response_get_secretdata_at uses to match the reply.
    */
 
    kmip_writer_t *writer;
    kms_request_t *req;
+   size_t i;
 
    req = calloc (1, sizeof (kms_request_t));
    req->provider = KMS_REQUEST_PROVIDER_KMIP;
 
+   if (count == 0 || count > INT32_MAX) {
+      KMS_ERROR (req, "expected a batch count in [1, INT32_MAX]");
+      return req;
+   }
+
    writer = kmip_writer_new ();
    kmip_writer_begin_struct (writer, KMIP_TAG_RequestMessage);
 
@@ -233,20 +253,29 @@ kms_kmip_request_get_new (void *reserved, const char *unique_identifer)
    kmip_writer_write_integer (writer, KMIP_TAG_ProtocolVersionMajor, 1);
    kmip_writer_write_integer (writer, KMIP_TAG_ProtocolVersionMinor, 0);
    kmip_writer_close_struct (writer); /* KMIP_TAG_ProtocolVersion */
-   kmip_writer_write_integer (writer, KMIP_TAG_BatchCount, 1);
+   kmip_writer_write_integer (writer, KMIP_TAG_BatchCount, (int32_t) count);
    kmip_writer_close_struct (writer); /* KMIP_TAG_RequestHeader */
 
-   kmip_writer_begin_struct (writer, KMIP_TAG_BatchItem);
-   /* 0x0A == Get */
-   kmip_writer_write_enumeration (writer, KMIP_TAG_Operation, 0x0A);
-   kmip_writer_begin_struct (writer, KMIP_TAG_RequestPayload);
-   kmip_writer_write_string (writer,
-                             KMIP_TAG_UniqueIdentifier,
-                             unique_identifer,
-                             strlen (unique_identifer));
-   /* 0x01 = Raw */
-   kmip_writer_close_struct (writer); /* KMIP_TAG_RequestPayload */
-   kmip_writer_close_struct (writer); /* KMIP_TAG_BatchItem */
+   for (i = 0; i < count; i++) {
+      kmip_writer_begin_struct (writer, KMIP_TAG_BatchItem);
+      /* 0x0A == Get */
+      kmip_writer_write_enumeration (writer, KMIP_TAG_Operation, 0x0A);
+      if (count > 1) {
+         uint32_t batch_item_id = KMS_UINT32_TO_BE ((uint32_t) i);
+
+         kmip_writer_write_bytes (writer,
+                                  KMIP_TAG_UniqueBatchItemID,
+                                  (const char *) &batch_item_id,
+                                  sizeof (batch_item_id));
+      }
+      kmip_writer_begin_struct (writer, KMIP_TAG_RequestPayload);
+      kmip_writer_write_string (writer,
+                                KMIP_TAG_UniqueIdentifier,
+                                unique_identifiers[i],
+                                strlen (unique_identifiers[i]));
+      kmip_writer_close_struct (writer); /* KMIP_TAG_RequestPayload */
+      kmip_writer_close_struct (writer); /* KMIP_TAG_BatchItem */
+   }
    kmip_writer_close_struct (writer); /* KMIP_TAG_RequestMessage */
 
    /* Copy the KMIP writer buffer to a KMIP request. */
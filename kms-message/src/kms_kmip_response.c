@@ -1,6 +1,7 @@
 #include "kms_message/kms_kmip_response.h"
 
 #include "kms_message_private.h"
+#include "kms_endian_private.h"
 #include "kms_kmip_reader_writer_private.h"
 #include "kms_kmip_result_reason_private.h"
 #include "kms_kmip_result_status_private.h"
@@ -19,6 +20,79 @@ check_and_require_kmip (kms_response_t *res)
    return true;
 }
 
+/* kms_kmip_response_find_batch_item returns a reader descended into the
+ * BatchItem that answers the request BatchItem at index. A request with more
+ * than one BatchItem tags each with its index as a big-endian uint32
+ * UniqueBatchItemID (see kms_kmip_request_get_batch_new). Servers may reply in
+ * any order, so items are matched by that ID. A response without IDs must have
+ * one BatchItem, which answers index 0.
+ * - Returns NULL on error and sets an error on kms_response_t. */
+static kmip_reader_t *
+kms_kmip_response_find_batch_item (kms_response_t *res, size_t index)
+{
+   kmip_reader_t *reader = NULL;
+   uint32_t batch_item_id;
+   size_t pos;
+   size_t len;
+
+   reader = kmip_reader_new (res->kmip.data, res->kmip.len);
+
+   if (!kmip_reader_find_and_recurse (reader, KMIP_TAG_ResponseMessage)) {
+      KMS_ERROR (res,
+                 "unable to find tag: %s",
+                 kmip_tag_to_string (KMIP_TAG_ResponseMessage));
+      goto fail;
+   }
+
+   if (index <= INT32_MAX) {
+      batch_item_id = KMS_UINT32_TO_BE ((uint32_t) index);
+      if (kmip_reader_find_and_recurse_with_bytes (reader,
+                                                   KMIP_TAG_BatchItem,
+                                                   KMIP_TAG_UniqueBatchItemID,
+                                                   (uint8_t *) &batch_item_id,
+                                                   sizeof (batch_item_id))) {
+         return reader;
+      }
+   }
+
+   if (index != 0 ||
+       kmip_reader_find_and_recurse_nth (reader, KMIP_TAG_BatchItem, 1)) {
+      KMS_ERROR (res,
+                 "unable to find %s with %s: %zu",
+                 kmip_tag_to_string (KMIP_TAG_BatchItem),
+                 kmip_tag_to_string (KMIP_TAG_UniqueBatchItemID),
+                 index);
+      goto fail;
+   }
+
+   if (!kmip_reader_find_and_recurse (reader, KMIP_TAG_BatchItem)) {
+      KMS_ERROR (res,
+                 "unable to find tag: %s",
+                 kmip_tag_to_string (KMIP_TAG_BatchItem));
+      goto fail;
+   }
+
+   /* The only BatchItem answers another request BatchItem. */
+   if (kmip_reader_find (reader,
+                         KMIP_TAG_UniqueBatchItemID,
+                         KMIP_ITEM_TYPE_ByteString,
+                         &pos,
+                         &len)) {
+      KMS_ERROR (res,
+                 "unable to find %s with %s: %zu",
+                 kmip_tag_to_string (KMIP_TAG_BatchItem),
+                 kmip_tag_to_string (KMIP_TAG_UniqueBatchItemID),
+                 index);
+      goto fail;
+   }
+
+   return reader;
+
+fail:
+   kmip_reader_destroy (reader);
+   return NULL;
+}
+
 /*
 Example of an error message:
 <ResponseMessage tag="0x42007b" type="Structure">
@@ -40,7 +114,7 @@ value="ResultReasonItemNotFound"/>
 </ResponseMessage>
 */
 static bool
-kms_kmip_response_ok (kms_response_t *res)
+kms_kmip_response_ok (kms_response_t *res, size_t index)
 {
    kmip_reader_t *reader = NULL;
    size_t pos;
@@ -51,19 +125,8 @@ kms_kmip_response_ok (kms_response_t *res)
    uint32_t result_message_len = 0;
    bool ok = false;
 
-   reader = kmip_reader_new (res->kmip.data, res->kmip.len);
-
-   if (!kmip_reader_find_and_recurse (reader, KMIP_TAG_ResponseMessage)) {
-      KMS_ERROR (res,
-                 "unable to find tag: %s",
-                 kmip_tag_to_string (KMIP_TAG_ResponseMessage));
-      goto fail;
-   }
-
-   if (!kmip_reader_find_and_recurse (reader, KMIP_TAG_BatchItem)) {
-      KMS_ERROR (res,
-                 "unable to find tag: %s",
-                 kmip_tag_to_string (KMIP_TAG_BatchItem));
+   reader = kms_kmip_response_find_batch_item (res, index);
+   if (!reader) {
       goto fail;
    }
 
@@ -162,7 +225,7 @@ kms_kmip_response_get_unique_identifier (kms_response_t *res)
       goto fail;
    }
 
-   if (!kms_kmip_response_ok (res)) {
+   if (!kms_kmip_response_ok (res, 0)) {
       goto fail;
    }
 
@@ -241,6 +304,14 @@ Example of a successful response to a Get request:
 */
 uint8_t *
 kms_kmip_response_get_secretdata (kms_response_t *res, size_t *secretdatalen)
+{
+   return kms_kmip_response_get_secretdata_at (res, 0, secretdatalen);
+}
+
+uint8_t *
+kms_kmip_response_get_secretdata_at (kms_response_t *res,
+                                     size_t index,
+                                     size_t *secretdatalen)
 {
    kmip_reader_t *reader = NULL;
    size_t pos;
@@ -252,23 +323,12 @@ kms_kmip_response_get_secretdata (kms_response_t *res, size_t *secretdatalen)
       goto fail;
    }
 
-   if (!kms_kmip_response_ok (res)) {
+   if (!kms_kmip_response_ok (res, index)) {
       goto fail;
    }
 
-   reader = kmip_reader_new (res->kmip.data, res->kmip.len);
-
-   if (!kmip_reader_find_and_recurse (reader, KMIP_TAG_ResponseMessage)) {
-      KMS_ERROR (res,
-                 "unable to find tag: %s",
-                 kmip_tag_to_string (KMIP_TAG_ResponseMessage));
-      goto fail;
-   }
-
-   if (!kmip_reader_find_and_recurse (reader, KMIP_TAG_BatchItem)) {
-      KMS_ERROR (res,
-                 "unable to find tag: %s",
-                 kmip_tag_to_string (KMIP_TAG_BatchItem));
+   reader = kms_kmip_response_find_batch_item (res, index);
+   if (!reader) {
       goto fail;
    }
 
@@ -83,6 +83,20 @@ kms_kv_list_add (kms_kv_list_t *lst,
    ++lst->len;
 }
 
+void
+kms_kv_list_add_chars (kms_kv_list_t *lst, const char *key, const char *value)
+{
+   if (lst->len == lst->size) {
+      lst->size *= 2;
+      lst->kvs = realloc (lst->kvs, lst->size * sizeof (kms_kv_t));
+      KMS_ASSERT (lst->kvs);
+   }
+
+   lst->kvs[lst->len].key = kms_request_str_new_from_chars (key, -1);
+   lst->kvs[lst->len].value = kms_request_str_new_from_chars (value, -1);
+   ++lst->len;
+}
+
 const kms_kv_t *
 kms_kv_list_find (const kms_kv_list_t *lst, const char *key)
 {
@@ -44,6 +44,10 @@ void
 kms_kv_list_add (kms_kv_list_t *lst,
                  kms_request_str_t *key,
                  kms_request_str_t *value);
+/* Like kms_kv_list_add, but copies from C strings without the intermediate
+ * kms_request_str_t allocations. */
+void
+kms_kv_list_add_chars (kms_kv_list_t *lst, const char *key, const char *value);
 const kms_kv_t *
 kms_kv_list_find (const kms_kv_list_t *lst, const char *key);
 void
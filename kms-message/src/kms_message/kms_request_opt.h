@@ -20,6 +20,7 @@
 #include "kms_message_defines.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -73,6 +74,51 @@ kms_request_opt_set_crypto_hook_sign_rsaes_pkcs1_v1_5 (
                                   size_t input_len,
                                   unsigned char *signature_out),
    void *ctx);
+
+/* kms_request_opt_set_signing_key_cache_hooks sets optional hooks used to
+ * share derived AWS SigV4 signing keys between requests.
+ * - "get" returns true and copies the 32 byte signing key into "key_out" if
+ *   one is cached for "scope_hash". It returns false on a cache miss.
+ * - "put" stores the 32 byte "key" for "scope_hash".
+ * - "scope_hash" is 32 bytes identifying the secret key, date, region, and
+ *   service that the signing key was derived from.
+ * The hooks may be called concurrently from requests on different threads. */
+KMS_MSG_EXPORT (void)
+kms_request_opt_set_signing_key_cache_hooks (
+   kms_request_opt_t *opt,
+   bool (*get) (void *ctx,
+                const unsigned char *scope_hash,
+                unsigned char *key_out),
+   void (*put) (void *ctx,
+                const unsigned char *scope_hash,
+                const unsigned char *key),
+   void *ctx);
+
+/* kms_request_opt_set_gcp_assertion_cache_hooks sets optional hooks used to
+ * reuse a signed GCP OAuth JSON Web Token (JWT) assertion between requests,
+ * so kms_gcp_request_oauth_new does not sign a new one for every request.
+ * - "get" returns true, sets "issued_at_out", and copies the 256 byte
+ *   signature into "signature_out" if one is cached for "claims_hash". It
+ *   returns false on a cache miss.
+ * - "put" stores "issued_at" and the 256 byte "signature" for "claims_hash".
+ * - "claims_hash" is 32 bytes identifying the private key, email, audience,
+ *   and scope that the assertion was signed for.
+ * - "issued_at" is the "iat" claim, in seconds since the Unix epoch.
+ * A cached assertion is only reused while it stays valid for at least another
+ * minute. The hooks may be called concurrently from requests on different
+ * threads. */
+KMS_MSG_EXPORT (void)
+kms_request_opt_set_gcp_assertion_cache_hooks (
+   kms_request_opt_t *opt,
+   bool (*get) (void *ctx,
+                const unsigned char *claims_hash,
+                uint64_t *issued_at_out,
+                unsigned char *signature_out),
+   void (*put) (void *ctx,
+                const unsigned char *claims_hash,
+                uint64_t issued_at,
+                const unsigned char *signature),
+   void *ctx);
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
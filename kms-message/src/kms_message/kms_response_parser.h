@@ -44,6 +44,20 @@ kms_response_parser_feed (kms_response_parser_t *parser,
 KMS_MSG_EXPORT (kms_response_t *)
 kms_response_parser_get_response (kms_response_parser_t *parser);
 
+/* kms_response_parser_set_keep_alive configures an HTTP parser for a
+ * persistent connection, where responses arrive back-to-back on one stream.
+ * Bytes fed after the end of a response are kept instead of being rejected.
+ * kms_response_parser_get_response carries them over to the next response. */
+KMS_MSG_EXPORT (void)
+kms_response_parser_set_keep_alive (kms_response_parser_t *parser,
+                                    bool keep_alive);
+
+/* kms_response_parser_trailing returns the bytes fed after the end of the
+ * current response on a keep-alive stream, or NULL if there are none. The
+ * bytes are valid until the next call to kms_response_parser_get_response. */
+KMS_MSG_EXPORT (const uint8_t *)
+kms_response_parser_trailing (kms_response_parser_t *parser, uint32_t *len);
+
 /* kms_response_parser_status returns the HTTP response status if one was
  * parsed.
  * - Calling on a KMIP parser is an error.
@@ -23,6 +23,7 @@
 #include "kms_request_str.h"
 #include "kms_kv_list.h"
 #include "kms_crypto.h"
+#include "kms_request_opt_private.h"
 #include "kms_kmip_response_parser_private.h"
 
 /* Sadly, Windows does not define SSIZE_MAX. It is defined in bson-compat.h,
@@ -44,6 +45,7 @@ struct _kms_request_t {
    kms_request_str_t *secret_key;
    kms_request_str_t *datetime;
    kms_request_str_t *date;
+   _kms_signing_key_cache_t signing_key_cache;
    /* End: AWS specific */
    kms_request_str_t *method;
    kms_request_str_t *path;
@@ -51,6 +53,13 @@ struct _kms_request_t {
    kms_request_str_t *payload;
    kms_kv_list_t *query_params;
    kms_kv_list_t *header_fields;
+   /* header_fields sorted by name. Built once when first needed and shared by
+    * signing and serialization. Entries alias header_fields, so this is reset
+    * whenever header_fields changes. */
+   kms_kv_list_t sorted_header_fields;
+   /* SHA-256 of payload, computed once. */
+   unsigned char payload_hash[32];
+   bool payload_hashed;
    /* turn off for tests only, not in public kms_request_opt_t API */
    bool auto_content_length;
    _kms_crypto_t crypto;
@@ -112,6 +121,10 @@ struct _kms_response_parser_t {
    bool transfer_encoding_chunked;
    int chunk_size;
    kms_response_parser_state_t state;
+   /* If keep_alive is set, bytes fed after the end of a response are kept.
+    * They start at trailing_start in raw_response. */
+   bool keep_alive;
+   int trailing_start;
    /* TODO: MONGOCRYPT-348 reorganize this struct to better separate fields for
     * HTTP parsing and fields for KMIP parsing. */
    kms_kmip_response_parser_t *kmip;
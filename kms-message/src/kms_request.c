@@ -64,6 +64,15 @@ check_and_prohibit_kmip (kms_request_t *req)
    return true;
 }
 
+static void
+reset_sorted_header_fields (kms_request_t *request)
+{
+   free (request->sorted_header_fields.kvs);
+   request->sorted_header_fields.kvs = NULL;
+   request->sorted_header_fields.len = 0;
+   request->sorted_header_fields.size = 0;
+}
+
 kms_request_t *
 kms_request_new (const char *method,
                  const char *path_and_query,
@@ -132,6 +141,12 @@ kms_request_new (const char *method,
       request->crypto.sha256_hmac = kms_sha256_hmac;
    }
 
+   if (opt && opt->signing_key_cache.get && opt->signing_key_cache.put) {
+      memcpy (&request->signing_key_cache,
+              &opt->signing_key_cache,
+              sizeof (opt->signing_key_cache));
+   }
+
    return request;
 }
 
@@ -150,6 +165,7 @@ kms_request_destroy (kms_request_t *request)
    kms_request_str_destroy (request->date);
    kms_kv_list_destroy (request->query_params);
    kms_kv_list_destroy (request->header_fields);
+   reset_sorted_header_fields (request);
    kms_request_str_destroy (request->to_string);
    free (request->kmip.data);
    free (request);
@@ -197,6 +213,7 @@ kms_request_set_date (kms_request_t *request, const struct tm *tm)
    kms_request_str_set_chars (request->date, buf, sizeof "YYYYmmDD" - 1);
    kms_request_str_set_chars (request->datetime, buf, sizeof AMZ_DT_FORMAT - 1);
    kms_kv_list_del (request->header_fields, "X-Amz-Date");
+   reset_sorted_header_fields (request);
    if (!kms_request_add_header_field (request, "X-Amz-Date", buf)) {
       return false;
    }
@@ -251,19 +268,14 @@ kms_request_add_header_field (kms_request_t *request,
                               const char *field_name,
                               const char *value)
 {
-   kms_request_str_t *k, *v;
-
    CHECK_FAILED;
 
    if (!check_and_prohibit_kmip (request)) {
       return false;
    }
 
-   k = kms_request_str_new_from_chars (field_name, -1);
-   v = kms_request_str_new_from_chars (value, -1);
-   kms_kv_list_add (request->header_fields, k, v);
-   kms_request_str_destroy (k);
-   kms_request_str_destroy (v);
+   kms_kv_list_add_chars (request->header_fields, field_name, value);
+   reset_sorted_header_fields (request);
 
    return true;
 }
@@ -308,6 +320,7 @@ kms_request_append_payload (kms_request_t *request,
 
    KMS_ASSERT (len <= SSIZE_MAX);
    kms_request_str_append_chars (request->payload, payload, (ssize_t) len);
+   request->payload_hashed = false;
 
    return true;
 }
@@ -370,6 +383,10 @@ append_canonical_headers (kms_kv_list_t *lst, kms_request_str_t *str)
     * values in headers that have multiple values." */
    for (i = 0; i < lst->len; i++) {
       kv = &lst->kvs[i];
+      if (0 == kms_strcasecmp (kv->key->str, "connection")) {
+         continue;
+      }
+
       if (previous_key &&
           0 == kms_strcasecmp (previous_key->str, kv->key->str)) {
          /* duplicate header */
@@ -378,7 +395,7 @@ append_canonical_headers (kms_kv_list_t *lst, kms_request_str_t *str)
          continue;
       }
 
-      if (i > 0) {
+      if (previous_key) {
          kms_request_str_append_newline (str);
       }
 
@@ -411,11 +428,11 @@ append_signed_headers (kms_kv_list_t *lst, kms_request_str_t *str)
          continue;
       }
 
-      kms_request_str_append_lowercase (str, kv->key);
-      if (i < lst->len - 1) {
+      if (previous_key) {
          kms_request_str_append_char (str, ';');
       }
 
+      kms_request_str_append_lowercase (str, kv->key);
       previous_key = kv->key;
    }
 }
@@ -454,6 +471,7 @@ finalize (kms_request_t *request)
       kms_kv_list_add (lst, k, v);
       kms_request_str_destroy (k);
       kms_request_str_destroy (v);
+      reset_sorted_header_fields (request);
    }
 
    if (!kms_kv_list_find (lst, "Content-Length") && request->payload->len &&
@@ -464,6 +482,7 @@ finalize (kms_request_t *request)
       kms_kv_list_add (lst, k, v);
       kms_request_str_destroy (k);
       kms_request_str_destroy (v);
+      reset_sorted_header_fields (request);
    }
 
    return true;
@@ -482,18 +501,64 @@ cmp_header_field_names (const void *a, const void *b)
                           ((kms_kv_t *) b)->key->str);
 }
 
+/* Returns the header fields sorted by name. The list is built and sorted once
+ * and reused until the headers change. Entries alias request->header_fields,
+ * so the returned list must not be passed to kms_kv_list_destroy. */
 static kms_kv_list_t *
-canonical_headers (const kms_request_t *request)
+sorted_header_fields (kms_request_t *request)
 {
-   kms_kv_list_t *lst;
+   kms_kv_list_t *lst = &request->sorted_header_fields;
 
    KMS_ASSERT (request->finalized);
-   lst = kms_kv_list_dup (request->header_fields);
-   kms_kv_list_sort (lst, cmp_header_field_names);
-   kms_kv_list_del (lst, "Connection");
+   if (!lst->kvs) {
+      lst->len = lst->size = request->header_fields->len;
+      /* allocate at least one entry so kvs is non-NULL once built. */
+      lst->kvs = malloc ((lst->len ? lst->len : 1) * sizeof (kms_kv_t));
+      KMS_ASSERT (lst->kvs);
+      memcpy (lst->kvs,
+              request->header_fields->kvs,
+              lst->len * sizeof (kms_kv_t));
+      kms_kv_list_sort (lst, cmp_header_field_names);
+   }
+
    return lst;
 }
 
+/* Returns an upper bound on the length of the headers written one per line as
+ * "name:value\r\n". Used to size output buffers up front. */
+static size_t
+header_fields_len (const kms_kv_list_t *lst)
+{
+   size_t i;
+   size_t len = 0;
+
+   for (i = 0; i < lst->len; i++) {
+      len += lst->kvs[i].key->len + lst->kvs[i].value->len + 3;
+   }
+
+   return len;
+}
+
+/* Appends the hex-encoded SHA-256 of the payload. The hash is computed once
+ * and reused until the payload changes. */
+static bool
+append_payload_hash (kms_request_t *request, kms_request_str_t *str)
+{
+   if (!request->payload_hashed) {
+      if (!request->crypto.sha256 (request->crypto.ctx,
+                                   request->payload->str,
+                                   request->payload->len,
+                                   request->payload_hash)) {
+         return false;
+      }
+
+      request->payload_hashed = true;
+   }
+
+   return kms_request_str_append_hex (
+      str, request->payload_hash, sizeof (request->payload_hash));
+}
+
 char *
 kms_request_get_canonical (kms_request_t *request)
 {
@@ -513,7 +578,13 @@ kms_request_get_canonical (kms_request_t *request)
       return NULL;
    }
 
+   lst = sorted_header_fields (request);
    canonical = kms_request_str_new ();
+   /* Reserve enough for the common case up front. Escaping may still grow. */
+   kms_request_str_reserve (canonical,
+                            request->method->len + request->path->len +
+                               request->query->len + 2 * header_fields_len (lst) +
+                               64 + 8);
    kms_request_str_append (canonical, request->method);
    kms_request_str_append_newline (canonical);
    normalized = kms_request_str_path_normalized (request->path);
@@ -522,14 +593,11 @@ kms_request_get_canonical (kms_request_t *request)
    kms_request_str_append_newline (canonical);
    append_canonical_query (request, canonical);
    kms_request_str_append_newline (canonical);
-   lst = canonical_headers (request);
    append_canonical_headers (lst, canonical);
    kms_request_str_append_newline (canonical);
    append_signed_headers (lst, canonical);
-   kms_kv_list_destroy (lst);
    kms_request_str_append_newline (canonical);
-   if (!kms_request_str_append_hashed (
-          &request->crypto, canonical, request->payload)) {
+   if (!append_payload_hash (request, canonical)) {
       KMS_ERROR (request, "could not generate hash");
       kms_request_str_destroy (canonical);
       return NULL;
@@ -583,6 +651,10 @@ kms_request_get_string_to_sign (kms_request_t *request)
    }
 
    sts = kms_request_str_new ();
+   kms_request_str_reserve (sts,
+                            request->datetime->len + request->date->len +
+                               request->region->len + request->service->len +
+                               128);
    kms_request_str_append_chars (sts, "AWS4-HMAC-SHA256\n", -1);
    kms_request_str_append (sts, request->datetime);
    kms_request_str_append_newline (sts);
@@ -635,15 +707,40 @@ kms_request_hmac_again (_kms_crypto_t *crypto,
       crypto->ctx, (const char *) in, 32, data->str, data->len, out);
 }
 
+/* The signing key depends only on the secret key and the credential scope.
+ * Hash them together with unambiguous separators to key the signing key cache:
+ * "AWS4" + secret + "\n" + date + "/" + region + "/" + service */
+static bool
+signing_key_scope_hash (kms_request_t *request,
+                        kms_request_str_t *aws4_plus_secret,
+                        unsigned char *scope_hash)
+{
+   bool ret;
+   kms_request_str_t *scope = kms_request_str_dup (aws4_plus_secret);
+
+   kms_request_str_append_char (scope, '\n');
+   kms_request_str_append (scope, request->date);
+   kms_request_str_append_char (scope, '/');
+   kms_request_str_append (scope, request->region);
+   kms_request_str_append_char (scope, '/');
+   kms_request_str_append (scope, request->service);
+   ret = request->crypto.sha256 (
+      request->crypto.ctx, scope->str, scope->len, scope_hash);
+   memset (scope->str, 0, scope->len);
+   kms_request_str_destroy (scope);
+   return ret;
+}
+
 bool
 kms_request_get_signing_key (kms_request_t *request, unsigned char *key)
 {
    bool success = false;
    kms_request_str_t *aws4_plus_secret = NULL;
-   kms_request_str_t *aws4_request = NULL;
    unsigned char k_date[32];
    unsigned char k_region[32];
    unsigned char k_service[32];
+   unsigned char scope_hash[32];
+   bool use_cache = request->signing_key_cache.get != NULL;
 
    if (request->failed) {
       return false;
@@ -665,7 +762,17 @@ kms_request_get_signing_key (kms_request_t *request, unsigned char *key)
    aws4_plus_secret = kms_request_str_new_from_chars ("AWS4", -1);
    kms_request_str_append (aws4_plus_secret, request->secret_key);
 
-   aws4_request = kms_request_str_new_from_chars ("aws4_request", -1);
+   if (use_cache) {
+      if (!signing_key_scope_hash (request, aws4_plus_secret, scope_hash)) {
+         goto done;
+      }
+
+      if (request->signing_key_cache.get (
+             request->signing_key_cache.ctx, scope_hash, key)) {
+         success = true;
+         goto done;
+      }
+   }
 
    if (!(kms_request_hmac (
             &request->crypto, k_date, aws4_plus_secret, request->date) &&
@@ -673,15 +780,24 @@ kms_request_get_signing_key (kms_request_t *request, unsigned char *key)
             &request->crypto, k_region, k_date, request->region) &&
          kms_request_hmac_again (
             &request->crypto, k_service, k_region, request->service) &&
-         kms_request_hmac_again (
-            &request->crypto, key, k_service, aws4_request))) {
+         request->crypto.sha256_hmac (request->crypto.ctx,
+                                      (const char *) k_service,
+                                      sizeof (k_service),
+                                      "aws4_request",
+                                      sizeof ("aws4_request") - 1,
+                                      key))) {
       goto done;
    }
 
+   if (use_cache) {
+      request->signing_key_cache.put (
+         request->signing_key_cache.ctx, scope_hash, key);
+   }
+
    success = true;
 done:
+   memset (aws4_plus_secret->str, 0, aws4_plus_secret->len);
    kms_request_str_destroy (aws4_plus_secret);
-   kms_request_str_destroy (aws4_request);
 
    return success;
 }
@@ -709,7 +825,12 @@ kms_request_get_signature (kms_request_t *request)
       goto done;
    }
 
+   lst = sorted_header_fields (request);
    sig = kms_request_str_new ();
+   kms_request_str_reserve (sig,
+                            request->access_key_id->len + request->date->len +
+                               request->region->len + request->service->len +
+                               header_fields_len (lst) + 128);
    kms_request_str_append_chars (sig, "AWS4-HMAC-SHA256 Credential=", -1);
    kms_request_str_append (sig, request->access_key_id);
    kms_request_str_append_char (sig, '/');
@@ -719,7 +840,6 @@ kms_request_get_signature (kms_request_t *request)
    kms_request_str_append_char (sig, '/');
    kms_request_str_append (sig, request->service);
    kms_request_str_append_chars (sig, "/aws4_request, SignedHeaders=", -1);
-   lst = canonical_headers (request);
    append_signed_headers (lst, sig);
    kms_request_str_append_chars (sig, ", Signature=", -1);
    if (!(kms_request_get_signing_key (request, signing_key) &&
@@ -731,7 +851,6 @@ kms_request_get_signature (kms_request_t *request)
    kms_request_str_append_hex (sig, signature, sizeof (signature));
    success = true;
 done:
-   kms_kv_list_destroy (lst);
    kms_request_str_destroy (sts);
 
    if (!success) {
@@ -794,7 +913,17 @@ kms_request_get_signed (kms_request_t *request)
       return NULL;
    }
 
+   lst = sorted_header_fields (request);
    sreq = kms_request_str_new ();
+   /* Reserve room for the request line, headers, authorization header with
+    * signature, and payload so the message is built in a single buffer. */
+   kms_request_str_reserve (sreq,
+                            request->method->len + request->path->len +
+                               request->query->len + header_fields_len (lst) +
+                               request->access_key_id->len + request->date->len +
+                               request->region->len + request->service->len +
+                               header_fields_len (lst) + request->payload->len +
+                               256);
    /* like "POST / HTTP/1.1" */
    kms_request_str_append (sreq, request->method);
    kms_request_str_append_char (sreq, ' ');
@@ -808,8 +937,6 @@ kms_request_get_signed (kms_request_t *request)
    append_http_endofline (sreq);
 
    /* headers */
-   lst = kms_kv_list_dup (request->header_fields);
-   kms_kv_list_sort (lst, cmp_header_field_names);
    for (i = 0; i < lst->len; i++) {
       kms_request_str_append (sreq, lst->kvs[i].key);
       kms_request_str_append_char (sreq, ':');
@@ -837,7 +964,6 @@ kms_request_get_signed (kms_request_t *request)
    success = true;
 done:
    free (signature);
-   kms_kv_list_destroy (lst);
 
    if (!success) {
       kms_request_str_destroy (sreq);
@@ -866,7 +992,12 @@ kms_request_to_string (kms_request_t *request)
       return kms_request_str_detach (kms_request_str_dup (request->to_string));
    }
 
+   lst = sorted_header_fields (request);
    sreq = kms_request_str_new ();
+   kms_request_str_reserve (sreq,
+                            request->method->len + request->path->len +
+                               request->query->len + header_fields_len (lst) +
+                               request->payload->len + 16);
    /* like "POST / HTTP/1.1" */
    kms_request_str_append (sreq, request->method);
    kms_request_str_append_char (sreq, ' ');
@@ -880,8 +1011,6 @@ kms_request_to_string (kms_request_t *request)
    append_http_endofline (sreq);
 
    /* headers */
-   lst = kms_kv_list_dup (request->header_fields);
-   kms_kv_list_sort (lst, cmp_header_field_names);
    for (i = 0; i < lst->len; i++) {
       kms_request_str_append (sreq, lst->kvs[i].key);
       kms_request_str_append_char (sreq, ':');
@@ -896,7 +1025,6 @@ kms_request_to_string (kms_request_t *request)
       kms_request_str_append (sreq, request->payload);
    }
 
-   kms_kv_list_destroy (lst);
    request->to_string = kms_request_str_dup (sreq);
    return kms_request_str_detach (sreq);
 }
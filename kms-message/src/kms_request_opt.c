@@ -85,4 +85,38 @@ kms_request_opt_set_crypto_hook_sign_rsaes_pkcs1_v1_5 (
 {
    opt->crypto.sign_rsaes_pkcs1_v1_5 = sign_rsaes_pkcs1_v1_5;
    opt->crypto.sign_ctx = sign_ctx;
-}
\ No newline at end of file
+}
+
+void
+kms_request_opt_set_signing_key_cache_hooks (
+   kms_request_opt_t *opt,
+   bool (*get) (void *ctx,
+                const unsigned char *scope_hash,
+                unsigned char *key_out),
+   void (*put) (void *ctx,
+                const unsigned char *scope_hash,
+                const unsigned char *key),
+   void *ctx)
+{
+   opt->signing_key_cache.get = get;
+   opt->signing_key_cache.put = put;
+   opt->signing_key_cache.ctx = ctx;
+}
+
+void
+kms_request_opt_set_gcp_assertion_cache_hooks (
+   kms_request_opt_t *opt,
+   bool (*get) (void *ctx,
+                const unsigned char *claims_hash,
+                uint64_t *issued_at_out,
+                unsigned char *signature_out),
+   void (*put) (void *ctx,
+                const unsigned char *claims_hash,
+                uint64_t issued_at,
+                const unsigned char *signature),
+   void *ctx)
+{
+   opt->gcp_assertion_cache.get = get;
+   opt->gcp_assertion_cache.put = put;
+   opt->gcp_assertion_cache.ctx = ctx;
+}
@@ -23,10 +23,40 @@
 
 #include <stdbool.h>
 
+/* Hooks to look up and store a derived AWS SigV4 signing key. The cache is
+ * keyed by the SHA-256 of the secret key and credential scope so the secret
+ * itself never leaves kms_request_get_signing_key. */
+typedef struct {
+   bool (*get) (void *ctx,
+                const unsigned char *scope_hash,
+                unsigned char *key_out);
+   void (*put) (void *ctx,
+                const unsigned char *scope_hash,
+                const unsigned char *key);
+   void *ctx;
+} _kms_signing_key_cache_t;
+
+/* Hooks to look up and store the signature of a GCP OAuth JWT assertion. The
+ * cache is keyed by the SHA-256 of the private key and the claims other than
+ * the issue time. */
+typedef struct {
+   bool (*get) (void *ctx,
+                const unsigned char *claims_hash,
+                uint64_t *issued_at_out,
+                unsigned char *signature_out);
+   void (*put) (void *ctx,
+                const unsigned char *claims_hash,
+                uint64_t issued_at,
+                const unsigned char *signature);
+   void *ctx;
+} _kms_gcp_assertion_cache_t;
+
 struct _kms_request_opt_t {
    bool connection_close;
    _kms_crypto_t crypto;
    kms_request_provider_t provider;
+   _kms_signing_key_cache_t signing_key_cache;
+   _kms_gcp_assertion_cache_t gcp_assertion_cache;
 };
 
 #endif /* KMS_REQUEST_OPT_PRIVATE_H */
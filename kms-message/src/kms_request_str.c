@@ -367,17 +367,12 @@ kms_request_str_append_hashed (_kms_crypto_t *crypto,
                                kms_request_str_t *appended)
 {
    uint8_t hash[32];
-   char *hex_chars;
 
    if (!crypto->sha256 (crypto->ctx, appended->str, appended->len, hash)) {
       return false;
    }
 
-   hex_chars = hexlify (hash, sizeof (hash));
-   kms_request_str_append_chars (str, hex_chars, 2 * sizeof (hash));
-   free (hex_chars);
-
-   return true;
+   return kms_request_str_append_hex (str, hash, sizeof (hash));
 }
 
 bool
@@ -385,13 +380,24 @@ kms_request_str_append_hex (kms_request_str_t *str,
                             unsigned char *data,
                             size_t len)
 {
-   char *hex_chars;
+   static const char hex_chars[] = "0123456789abcdef";
+   char *out;
+   size_t i;
 
-   hex_chars = hexlify (data, len);
    KMS_ASSERT (len <= SSIZE_MAX / 2);
-   kms_request_str_append_chars (str, hex_chars, (ssize_t) (len * 2));
-   free (hex_chars);
+   if (!kms_request_str_reserve (str, len * 2)) {
+      return false;
+   }
+
+   /* encode directly into str rather than through a temporary hexlify. */
+   out = str->str + str->len;
+   for (i = 0; i < len; i++) {
+      *out++ = hex_chars[data[i] >> 4];
+      *out++ = hex_chars[data[i] & 0xf];
+   }
 
+   str->len += len * 2;
+   str->str[str->len] = '\0';
    return true;
 }
 
@@ -35,6 +35,7 @@ _parser_init (kms_response_parser_t *parser)
    parser->failed = false;
    parser->chunk_size = 0;
    parser->transfer_encoding_chunked = false;
+   parser->trailing_start = -1;
    parser->kmip = NULL;
 }
 
@@ -45,9 +46,30 @@ kms_response_parser_new (void)
    KMS_ASSERT (parser);
 
    _parser_init (parser);
+   parser->keep_alive = false;
    return parser;
 }
 
+void
+kms_response_parser_set_keep_alive (kms_response_parser_t *parser,
+                                    bool keep_alive)
+{
+   parser->keep_alive = keep_alive;
+}
+
+const uint8_t *
+kms_response_parser_trailing (kms_response_parser_t *parser, uint32_t *len)
+{
+   KMS_ASSERT (len);
+   *len = 0;
+   if (parser->kmip || parser->trailing_start < 0 ||
+       parser->trailing_start >= (int) parser->raw_response->len) {
+      return NULL;
+   }
+   *len = (uint32_t) ((int) parser->raw_response->len - parser->trailing_start);
+   return (const uint8_t *) parser->raw_response->str + parser->trailing_start;
+}
+
 int
 kms_response_parser_wants_bytes (kms_response_parser_t *parser, int32_t max)
 {
@@ -298,19 +320,21 @@ kms_response_parser_feed (kms_response_parser_t *parser,
          body_read = (int) raw->len - parser->start;
 
          if (parser->content_length == -1 ||
-             body_read > parser->content_length) {
+             (body_read > parser->content_length && !parser->keep_alive)) {
             KMS_ERROR (parser, "Unexpected: exceeded content length");
             return false;
          }
 
          /* check if we have the entire body. */
-         if (body_read == parser->content_length) {
+         if (body_read >= parser->content_length) {
             parser->response->body = kms_request_str_new_from_chars (
                raw->str + parser->start, parser->content_length);
             parser->state = PARSING_DONE;
+            /* on a keep-alive stream, the next response may follow. */
+            curr = parser->start + parser->content_length;
+         } else {
+            curr = (int) raw->len;
          }
-
-         curr = (int) raw->len;
          break;
       case PARSING_CHUNK:
          chunk_read = (int) raw->len - parser->start;
@@ -335,8 +359,16 @@ kms_response_parser_feed (kms_response_parser_t *parser,
          }
          break;
       case PARSING_DONE:
-         KMS_ERROR (parser, "Unexpected extra HTTP content");
-         return false;
+         if (!parser->keep_alive) {
+            KMS_ERROR (parser, "Unexpected extra HTTP content");
+            return false;
+         }
+         /* keep the start of the next response for the caller. */
+         if (parser->trailing_start < 0) {
+            parser->trailing_start = curr;
+         }
+         curr = (int) raw->len;
+         break;
       default:
          KMS_ASSERT (false && "Invalid kms_response_parser HTTP state");
       }
@@ -353,6 +385,9 @@ kms_response_t *
 kms_response_parser_get_response (kms_response_parser_t *parser)
 {
    kms_response_t *response;
+   const uint8_t *trailing;
+   uint32_t trailing_len;
+   kms_request_str_t *carry = NULL;
 
    if (parser->kmip) {
       return kms_kmip_response_parser_get_response (parser->kmip);
@@ -361,9 +396,24 @@ kms_response_parser_get_response (kms_response_parser_t *parser)
    response = parser->response;
 
    parser->response = NULL;
+
+   /* carry bytes of the next response on a keep-alive stream into the reset
+    * parser. */
+   trailing = kms_response_parser_trailing (parser, &trailing_len);
+   if (trailing) {
+      carry = kms_request_str_new_from_chars ((const char *) trailing,
+                                              (ssize_t) trailing_len);
+   }
+
    /* reset the parser. */
    _parser_destroy (parser);
    _parser_init (parser);
+
+   if (carry) {
+      kms_response_parser_feed (parser, (uint8_t *) carry->str,
+                                (uint32_t) carry->len);
+      kms_request_str_destroy (carry);
+   }
    return response;
 }
 
@@ -167,6 +167,81 @@ kms_kmip_request_get_test (void)
    kms_request_destroy (req);
 }
 
+/*
+<RequestMessage tag="0x420078" type="Structure">
+ <RequestHeader tag="0x420077" type="Structure">
+  <ProtocolVersion tag="0x420069" type="Structure">
+   <ProtocolVersionMajor tag="0x42006a" type="Integer" value="1"/>
+   <ProtocolVersionMinor tag="0x42006b" type="Integer" value="0"/>
+  </ProtocolVersion>
+  <BatchCount tag="0x42000d" type="Integer" value="2"/>
+ </RequestHeader>
+ <BatchItem tag="0x42000f" type="Structure">
+  <Operation tag="0x42005c" type="Enumeration" value="10"/>
+  <UniqueBatchItemID tag="0x420093" type="ByteString" value="00000000"/>
+  <RequestPayload tag="0x420079" type="Structure">
+   <UniqueIdentifier tag="0x420094" type="TextString"
+value="7FJYvnV6XkaUCWuY96bCSc6AuhvkPpqI"/>
+  </RequestPayload>
+ </BatchItem>
+ <BatchItem tag="0x42000f" type="Structure">
+  <Operation tag="0x42005c" type="Enumeration" value="10"/>
+  <UniqueBatchItemID tag="0x420093" type="ByteString" value="00000001"/>
+  <RequestPayload tag="0x420079" type="Structure">
+   <UniqueIdentifier tag="0x420094" type="TextString" value="2"/>
+  </RequestPayload>
+ </BatchItem>
+</RequestMessage>
+*/
+#define GET_BATCH_REQUEST                                                     \
+   0x42, 0x00, 0x78, 0x01, 0x00, 0x00, 0x00, 0xd8, 0x42, 0x00, 0x77, 0x01,    \
+      0x00, 0x00, 0x00, 0x38, 0x42, 0x00, 0x69, 0x01, 0x00, 0x00, 0x00, 0x20, \
+      0x42, 0x00, 0x6a, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, \
+      0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x6b, 0x02, 0x00, 0x00, 0x00, 0x04, \
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x0d, 0x02, \
+      0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, \
+      0x42, 0x00, 0x0f, 0x01, 0x00, 0x00, 0x00, 0x50, 0x42, 0x00, 0x5c, 0x05, \
+      0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, \
+      0x42, 0x00, 0x93, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, \
+      0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x79, 0x01, 0x00, 0x00, 0x00, 0x28, \
+      0x42, 0x00, 0x94, 0x07, 0x00, 0x00, 0x00, 0x20, 0x37, 0x46, 0x4a, 0x59, \
+      0x76, 0x6e, 0x56, 0x36, 0x58, 0x6b, 0x61, 0x55, 0x43, 0x57, 0x75, 0x59, \
+      0x39, 0x36, 0x62, 0x43, 0x53, 0x63, 0x36, 0x41, 0x75, 0x68, 0x76, 0x6b, \
+      0x50, 0x70, 0x71, 0x49, 0x42, 0x00, 0x0f, 0x01, 0x00, 0x00, 0x00, 0x38, \
+      0x42, 0x00, 0x5c, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x0a, \
+      0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x93, 0x08, 0x00, 0x00, 0x00, 0x04, \
+      0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x79, 0x01, \
+      0x00, 0x00, 0x00, 0x10, 0x42, 0x00, 0x94, 0x07, 0x00, 0x00, 0x00, 0x01, \
+      0x32, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+
+void
+kms_kmip_request_get_batch_test (void)
+{
+   kms_request_t *req;
+
+   const uint8_t *actual_bytes;
+   size_t actual_len;
+   uint8_t expected_bytes[] = {GET_BATCH_REQUEST};
+   size_t expected_len = sizeof (expected_bytes);
+   static const char *const GET_UNIQUE_IDENTIFIERS[] = {
+      "7FJYvnV6XkaUCWuY96bCSc6AuhvkPpqI", "2"};
+
+   req = kms_kmip_request_get_batch_new (NULL, GET_UNIQUE_IDENTIFIERS, 2);
+   ASSERT_REQUEST_OK (req);
+
+   actual_bytes = kms_request_to_bytes (req, &actual_len);
+
+   ASSERT (actual_bytes != NULL);
+   ASSERT_CMPBYTES (actual_bytes, actual_len, expected_bytes, expected_len);
+
+   kms_request_destroy (req);
+
+   /* An empty batch is an error. */
+   req = kms_kmip_request_get_batch_new (NULL, GET_UNIQUE_IDENTIFIERS, 0);
+   ASSERT_REQUEST_ERROR (req, "batch count");
+   kms_request_destroy (req);
+}
+
 
 /*
 <RequestMessage tag="0x420078" type="Structure">
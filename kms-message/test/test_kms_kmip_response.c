@@ -212,3 +212,175 @@ kms_kmip_response_get_secretdata_notfound_test (void)
    ASSERT_RESPONSE_ERROR (&res, "ResultReasonItemNotFound");
    ASSERT (NULL == secretdata);
 }
+
+/*
+<ResponseMessage tag="0x42007b" type="Structure">
+ <ResponseHeader tag="0x42007a" type="Structure">
+  <ProtocolVersion tag="0x420069" type="Structure">
+   <ProtocolVersionMajor tag="0x42006a" type="Integer" value="1"/>
+   <ProtocolVersionMinor tag="0x42006b" type="Integer" value="4"/>
+  </ProtocolVersion>
+  <TimeStamp tag="0x420092" type="DateTime" value="2021-10-12T14:09:25-0500"/>
+  <BatchCount tag="0x42000d" type="Integer" value="2"/>
+ </ResponseHeader>
+ <BatchItem tag="0x42000f" type="Structure">
+  ... the BatchItem of SUCCESS_GET_RESPONSE with
+  <UniqueBatchItemID tag="0x420093" type="ByteString" value="00000000"/> ...
+ </BatchItem>
+ <BatchItem tag="0x42000f" type="Structure">
+  ... the BatchItem of ERROR_GET_RESPOSE_NOTFOUND with
+  <UniqueBatchItemID tag="0x420093" type="ByteString" value="00000001"/> ...
+ </BatchItem>
+</ResponseMessage>
+*/
+static const uint8_t SUCCESS_AND_ERROR_GET_BATCH_RESPONSE[] = {
+   0x42, 0x00, 0x7b, 0x01, 0x00, 0x00, 0x01, 0xb8, 0x42, 0x00, 0x7a, 0x01, 0x00,
+   0x00, 0x00, 0x48, 0x42, 0x00, 0x69, 0x01, 0x00, 0x00, 0x00, 0x20, 0x42, 0x00,
+   0x6a, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+   0x00, 0x42, 0x00, 0x6b, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04,
+   0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x92, 0x09, 0x00, 0x00, 0x00, 0x08, 0x00,
+   0x00, 0x00, 0x00, 0x61, 0x65, 0x97, 0x15, 0x42, 0x00, 0x0d, 0x02, 0x00, 0x00,
+   0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x0f,
+   0x01, 0x00, 0x00, 0x00, 0xf8, 0x42, 0x00, 0x5c, 0x05, 0x00, 0x00, 0x00, 0x04,
+   0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x93, 0x08, 0x00,
+   0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00,
+   0x7f, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+   0x00, 0x42, 0x00, 0x7c, 0x01, 0x00, 0x00, 0x00, 0xc0, 0x42, 0x00, 0x57, 0x05,
+   0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x42,
+   0x00, 0x94, 0x07, 0x00, 0x00, 0x00, 0x02, 0x33, 0x39, 0x00, 0x00, 0x00, 0x00,
+   0x00, 0x00, 0x42, 0x00, 0x85, 0x01, 0x00, 0x00, 0x00, 0x98, 0x42, 0x00, 0x86,
+   0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+   0x42, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00, 0x80, 0x42, 0x00, 0x42, 0x05, 0x00,
+   0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00,
+   0x45, 0x01, 0x00, 0x00, 0x00, 0x68, 0x42, 0x00, 0x43, 0x08, 0x00, 0x00, 0x00,
+   0x60, 0xff, 0xa8, 0xcc, 0x79, 0xe8, 0xc3, 0x76, 0x3b, 0x01, 0x21, 0xfc, 0xd0,
+   0x6b, 0xb3, 0x48, 0x8c, 0x8b, 0xf4, 0x2c, 0x07, 0x74, 0x60, 0x46, 0x40, 0x27,
+   0x9b, 0x16, 0xb2, 0x64, 0x19, 0x40, 0x30, 0xee, 0xb0, 0x83, 0x96, 0x24, 0x1d,
+   0xef, 0xcc, 0x4d, 0x32, 0xd1, 0x6e, 0xa8, 0x31, 0xad, 0x77, 0x71, 0x38, 0xf0,
+   0x8e, 0x2f, 0x98, 0x56, 0x64, 0xc0, 0x04, 0xc2, 0x48, 0x5d, 0x6f, 0x49, 0x91,
+   0xeb, 0x3d, 0x9e, 0xc3, 0x28, 0x02, 0x53, 0x78, 0x36, 0xa9, 0x06, 0x6b, 0x4e,
+   0x10, 0xae, 0xb5, 0x6a, 0x5c, 0xcf, 0x6a, 0xa4, 0x69, 0x01, 0xe6, 0x25, 0xe3,
+   0x40, 0x0c, 0x78, 0x11, 0xd2, 0xec, 0x42, 0x00, 0x0f, 0x01, 0x00, 0x00, 0x00,
+   0x60, 0x42, 0x00, 0x5c, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x0a,
+   0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x93, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00,
+   0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x7f, 0x05, 0x00, 0x00,
+   0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x7e,
+   0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+   0x42, 0x00, 0x7d, 0x07, 0x00, 0x00, 0x00, 0x18, 0x52, 0x65, 0x73, 0x75, 0x6c,
+   0x74, 0x52, 0x65, 0x61, 0x73, 0x6f, 0x6e, 0x49, 0x74, 0x65, 0x6d, 0x4e, 0x6f,
+   0x74, 0x46, 0x6f, 0x75, 0x6e, 0x64};
+
+void
+kms_kmip_response_get_secretdata_batch_test (void)
+{
+   kms_response_t res = {0};
+   uint8_t *secretdata;
+   size_t secretdata_len;
+
+   res.provider = KMS_REQUEST_PROVIDER_KMIP;
+   res.kmip.data = (uint8_t *) SUCCESS_AND_ERROR_GET_BATCH_RESPONSE;
+   res.kmip.len = sizeof (SUCCESS_AND_ERROR_GET_BATCH_RESPONSE);
+
+   /* Each BatchItem has its own result. */
+   secretdata = kms_kmip_response_get_secretdata_at (&res, 0, &secretdata_len);
+   ASSERT_RESPONSE_OK (&res);
+   ASSERT_CMPBYTES (SUCCESS_GET_RESPONSE_SECRETDATA,
+                    sizeof (SUCCESS_GET_RESPONSE_SECRETDATA),
+                    secretdata,
+                    secretdata_len);
+   free (secretdata);
+
+   secretdata = kms_kmip_response_get_secretdata_at (&res, 1, &secretdata_len);
+   ASSERT_RESPONSE_ERROR (&res, "ResultReasonItemNotFound");
+   ASSERT (NULL == secretdata);
+}
+
+/* SUCCESS_AND_ERROR_GET_BATCH_RESPONSE with its BatchItems swapped. */
+static const uint8_t ERROR_AND_SUCCESS_GET_BATCH_RESPONSE[] = {
+   0x42, 0x00, 0x7b, 0x01, 0x00, 0x00, 0x01, 0xb8, 0x42, 0x00, 0x7a, 0x01, 0x00,
+   0x00, 0x00, 0x48, 0x42, 0x00, 0x69, 0x01, 0x00, 0x00, 0x00, 0x20, 0x42, 0x00,
+   0x6a, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+   0x00, 0x42, 0x00, 0x6b, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04,
+   0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x92, 0x09, 0x00, 0x00, 0x00, 0x08, 0x00,
+   0x00, 0x00, 0x00, 0x61, 0x65, 0x97, 0x15, 0x42, 0x00, 0x0d, 0x02, 0x00, 0x00,
+   0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x0f,
+   0x01, 0x00, 0x00, 0x00, 0x60, 0x42, 0x00, 0x5c, 0x05, 0x00, 0x00, 0x00, 0x04,
+   0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x93, 0x08, 0x00,
+   0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00,
+   0x7f, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+   0x00, 0x42, 0x00, 0x7e, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01,
+   0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x7d, 0x07, 0x00, 0x00, 0x00, 0x18, 0x52,
+   0x65, 0x73, 0x75, 0x6c, 0x74, 0x52, 0x65, 0x61, 0x73, 0x6f, 0x6e, 0x49, 0x74,
+   0x65, 0x6d, 0x4e, 0x6f, 0x74, 0x46, 0x6f, 0x75, 0x6e, 0x64, 0x42, 0x00, 0x0f,
+   0x01, 0x00, 0x00, 0x00, 0xf8, 0x42, 0x00, 0x5c, 0x05, 0x00, 0x00, 0x00, 0x04,
+   0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x93, 0x08, 0x00,
+   0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00,
+   0x7f, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+   0x00, 0x42, 0x00, 0x7c, 0x01, 0x00, 0x00, 0x00, 0xc0, 0x42, 0x00, 0x57, 0x05,
+   0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x42,
+   0x00, 0x94, 0x07, 0x00, 0x00, 0x00, 0x02, 0x33, 0x39, 0x00, 0x00, 0x00, 0x00,
+   0x00, 0x00, 0x42, 0x00, 0x85, 0x01, 0x00, 0x00, 0x00, 0x98, 0x42, 0x00, 0x86,
+   0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+   0x42, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00, 0x80, 0x42, 0x00, 0x42, 0x05, 0x00,
+   0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00,
+   0x45, 0x01, 0x00, 0x00, 0x00, 0x68, 0x42, 0x00, 0x43, 0x08, 0x00, 0x00, 0x00,
+   0x60, 0xff, 0xa8, 0xcc, 0x79, 0xe8, 0xc3, 0x76, 0x3b, 0x01, 0x21, 0xfc, 0xd0,
+   0x6b, 0xb3, 0x48, 0x8c, 0x8b, 0xf4, 0x2c, 0x07, 0x74, 0x60, 0x46, 0x40, 0x27,
+   0x9b, 0x16, 0xb2, 0x64, 0x19, 0x40, 0x30, 0xee, 0xb0, 0x83, 0x96, 0x24, 0x1d,
+   0xef, 0xcc, 0x4d, 0x32, 0xd1, 0x6e, 0xa8, 0x31, 0xad, 0x77, 0x71, 0x38, 0xf0,
+   0x8e, 0x2f, 0x98, 0x56, 0x64, 0xc0, 0x04, 0xc2, 0x48, 0x5d, 0x6f, 0x49, 0x91,
+   0xeb, 0x3d, 0x9e, 0xc3, 0x28, 0x02, 0x53, 0x78, 0x36, 0xa9, 0x06, 0x6b, 0x4e,
+   0x10, 0xae, 0xb5, 0x6a, 0x5c, 0xcf, 0x6a, 0xa4, 0x69, 0x01, 0xe6, 0x25, 0xe3,
+   0x40, 0x0c, 0x78, 0x11, 0xd2, 0xec};
+
+void
+kms_kmip_response_get_secretdata_batch_out_of_order_test (void)
+{
+   kms_response_t res = {0};
+   uint8_t *secretdata;
+   size_t secretdata_len;
+
+   res.provider = KMS_REQUEST_PROVIDER_KMIP;
+   res.kmip.data = (uint8_t *) ERROR_AND_SUCCESS_GET_BATCH_RESPONSE;
+   res.kmip.len = sizeof (ERROR_AND_SUCCESS_GET_BATCH_RESPONSE);
+
+   /* BatchItems are matched by UniqueBatchItemID, not position. */
+   secretdata = kms_kmip_response_get_secretdata_at (&res, 0, &secretdata_len);
+   ASSERT_RESPONSE_OK (&res);
+   ASSERT_CMPBYTES (SUCCESS_GET_RESPONSE_SECRETDATA,
+                    sizeof (SUCCESS_GET_RESPONSE_SECRETDATA),
+                    secretdata,
+                    secretdata_len);
+   free (secretdata);
+
+   secretdata = kms_kmip_response_get_secretdata_at (&res, 1, &secretdata_len);
+   ASSERT_RESPONSE_ERROR (&res, "ResultReasonItemNotFound");
+   ASSERT (NULL == secretdata);
+}
+
+void
+kms_kmip_response_get_secretdata_batch_missing_test (void)
+{
+   kms_response_t res = {0};
+   uint8_t *secretdata;
+   size_t secretdata_len;
+
+   res.provider = KMS_REQUEST_PROVIDER_KMIP;
+   res.kmip.data = (uint8_t *) SUCCESS_GET_RESPONSE;
+   res.kmip.len = sizeof (SUCCESS_GET_RESPONSE);
+
+   /* A response without UniqueBatchItemID only answers index 0. */
+   secretdata = kms_kmip_response_get_secretdata_at (&res, 1, &secretdata_len);
+   ASSERT_RESPONSE_ERROR (
+      &res, "unable to find BatchItem with UniqueBatchItemID: 1");
+   ASSERT (NULL == secretdata);
+
+   res.kmip.data = (uint8_t *) SUCCESS_AND_ERROR_GET_BATCH_RESPONSE;
+   res.kmip.len = sizeof (SUCCESS_AND_ERROR_GET_BATCH_RESPONSE);
+
+   /* A requested UniqueBatchItemID missing from the response is an error. */
+   secretdata = kms_kmip_response_get_secretdata_at (&res, 2, &secretdata_len);
+   ASSERT_RESPONSE_ERROR (
+      &res, "unable to find BatchItem with UniqueBatchItemID: 2");
+   ASSERT (NULL == secretdata);
+}
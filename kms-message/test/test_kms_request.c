@@ -34,6 +34,7 @@
 #include <time.h>
 #include "kms_message/kms_azure_request.h"
 #include "kms_message/kms_b64.h"
+#include "kms_message/kms_gcp_request.h"
 #include "hexlify.h"
 #include "kms_request_str.h"
 #include "kms_kv_list.h"
@@ -444,6 +445,268 @@ example_signature_test (void)
    kms_request_destroy (request);
 }
 
+typedef struct {
+   bool set;
+   unsigned char scope_hash[32];
+   unsigned char key[32];
+   int hits;
+   int puts;
+} test_signing_key_cache_t;
+
+static bool
+test_signing_key_cache_get (void *ctx,
+                            const unsigned char *scope_hash,
+                            unsigned char *key_out)
+{
+   test_signing_key_cache_t *cache = (test_signing_key_cache_t *) ctx;
+
+   if (!cache->set || 0 != memcmp (cache->scope_hash, scope_hash, 32)) {
+      return false;
+   }
+   memcpy (key_out, cache->key, 32);
+   cache->hits++;
+   return true;
+}
+
+static void
+test_signing_key_cache_put (void *ctx,
+                            const unsigned char *scope_hash,
+                            const unsigned char *key)
+{
+   test_signing_key_cache_t *cache = (test_signing_key_cache_t *) ctx;
+
+   memcpy (cache->scope_hash, scope_hash, 32);
+   memcpy (cache->key, key, 32);
+   cache->set = true;
+   cache->puts++;
+}
+
+static kms_request_t *
+make_signing_key_cache_request (kms_request_opt_t *opt, const char *region)
+{
+   kms_request_t *request = kms_decrypt_request_new (
+      (uint8_t *) "foobar", sizeof ("foobar") - 1, opt);
+
+   set_test_date (request);
+   kms_request_set_region (request, region);
+   kms_request_set_service (request, "service");
+   kms_request_set_access_key_id (request, "AKIDEXAMPLE");
+   kms_request_set_secret_key (request,
+                               "wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY");
+   return request;
+}
+
+/* Signed requests must be identical whether or not the signing key is served
+ * from the cache. */
+void
+signing_key_cache_test (void)
+{
+   test_signing_key_cache_t cache = {0};
+   kms_request_opt_t *opt;
+   kms_request_t *request;
+   char *uncached;
+   char *signed_req;
+
+   request = make_signing_key_cache_request (NULL, "us-east-1");
+   uncached = kms_request_get_signed (request);
+   KMS_ASSERT (uncached);
+   kms_request_destroy (request);
+
+   opt = kms_request_opt_new ();
+   kms_request_opt_set_signing_key_cache_hooks (
+      opt, test_signing_key_cache_get, test_signing_key_cache_put, &cache);
+
+   /* First request misses and populates the cache. */
+   request = make_signing_key_cache_request (opt, "us-east-1");
+   signed_req = kms_request_get_signed (request);
+   ASSERT_CMPSTR (uncached, signed_req);
+   ASSERT (cache.hits == 0);
+   ASSERT (cache.puts == 1);
+   free (signed_req);
+   kms_request_destroy (request);
+
+   /* Second request with the same scope hits the cache. */
+   request = make_signing_key_cache_request (opt, "us-east-1");
+   signed_req = kms_request_get_signed (request);
+   ASSERT_CMPSTR (uncached, signed_req);
+   ASSERT (cache.hits == 1);
+   ASSERT (cache.puts == 1);
+   free (signed_req);
+   kms_request_destroy (request);
+
+   /* A different region derives a different key. */
+   request = make_signing_key_cache_request (opt, "us-west-2");
+   signed_req = kms_request_get_signed (request);
+   KMS_ASSERT (signed_req);
+   ASSERT (0 != strcmp (uncached, signed_req));
+   ASSERT (cache.hits == 1);
+   ASSERT (cache.puts == 2);
+   free (signed_req);
+   kms_request_destroy (request);
+
+   kms_request_opt_destroy (opt);
+   free (uncached);
+}
+
+typedef struct {
+   bool set;
+   unsigned char claims_hash[32];
+   uint64_t issued_at;
+   unsigned char signature[256];
+   int hits;
+   int puts;
+} test_gcp_assertion_cache_t;
+
+static bool
+test_gcp_assertion_cache_get (void *ctx,
+                              const unsigned char *claims_hash,
+                              uint64_t *issued_at_out,
+                              unsigned char *signature_out)
+{
+   test_gcp_assertion_cache_t *cache = (test_gcp_assertion_cache_t *) ctx;
+
+   if (!cache->set || 0 != memcmp (cache->claims_hash, claims_hash, 32)) {
+      return false;
+   }
+   *issued_at_out = cache->issued_at;
+   memcpy (signature_out, cache->signature, 256);
+   cache->hits++;
+   return true;
+}
+
+static void
+test_gcp_assertion_cache_put (void *ctx,
+                              const unsigned char *claims_hash,
+                              uint64_t issued_at,
+                              const unsigned char *signature)
+{
+   test_gcp_assertion_cache_t *cache = (test_gcp_assertion_cache_t *) ctx;
+
+   memcpy (cache->claims_hash, claims_hash, 32);
+   cache->issued_at = issued_at;
+   memcpy (cache->signature, signature, 256);
+   cache->set = true;
+   cache->puts++;
+}
+
+/* Stands in for RSA. Each call produces a distinct signature. */
+static bool
+test_counting_sign (void *ctx,
+                    const char *private_key,
+                    size_t private_key_len,
+                    const char *input,
+                    size_t input_len,
+                    unsigned char *signature_out)
+{
+   int *calls = (int *) ctx;
+
+   (*calls)++;
+   memset (signature_out, *calls, 256);
+   return true;
+}
+
+static char *
+make_gcp_oauth_request (kms_request_opt_t *opt, const char *scope)
+{
+   kms_request_t *request;
+   char *str;
+
+   request = kms_gcp_request_oauth_new ("oauth2.googleapis.com",
+                                        "test@example.com",
+                                        "https://oauth2.googleapis.com/token",
+                                        scope,
+                                        "private key",
+                                        sizeof ("private key") - 1,
+                                        opt);
+   ASSERT_REQUEST_OK (request);
+   str = kms_request_to_string (request);
+   KMS_ASSERT (str);
+   kms_request_destroy (request);
+   return str;
+}
+
+/* A signed JWT assertion is reused until it is close to expiring. */
+void
+gcp_assertion_cache_test (void)
+{
+   test_gcp_assertion_cache_t cache = {0};
+   kms_request_opt_t *opt;
+   int sign_calls = 0;
+   char *first;
+   char *req;
+
+   opt = kms_request_opt_new ();
+   kms_request_opt_set_provider (opt, KMS_REQUEST_PROVIDER_GCP);
+   kms_request_opt_set_crypto_hook_sign_rsaes_pkcs1_v1_5 (
+      opt, test_counting_sign, &sign_calls);
+   kms_request_opt_set_gcp_assertion_cache_hooks (
+      opt, test_gcp_assertion_cache_get, test_gcp_assertion_cache_put, &cache);
+
+   /* First request signs and populates the cache. */
+   first = make_gcp_oauth_request (opt, "https://www.googleapis.com/auth/a");
+   ASSERT (sign_calls == 1);
+   ASSERT (cache.puts == 1);
+
+   /* Second request reuses the assertion, issue time included. */
+   req = make_gcp_oauth_request (opt, "https://www.googleapis.com/auth/a");
+   ASSERT_CMPSTR (first, req);
+   ASSERT (sign_calls == 1);
+   ASSERT (cache.hits == 1);
+   free (req);
+
+   /* Different claims need a new signature. */
+   req = make_gcp_oauth_request (opt, "https://www.googleapis.com/auth/b");
+   ASSERT (0 != strcmp (first, req));
+   ASSERT (sign_calls == 2);
+   ASSERT (cache.puts == 2);
+   free (req);
+
+   /* An assertion with less than a minute left is not reused. */
+   cache.issued_at -= 5 * 60 - 30;
+   req = make_gcp_oauth_request (opt, "https://www.googleapis.com/auth/b");
+   ASSERT (sign_calls == 3);
+   ASSERT (cache.puts == 3);
+   free (req);
+
+   kms_request_opt_destroy (opt);
+   free (first);
+}
+
+/* The sorted header list and payload hash are computed once per request, and
+ * must be recomputed if headers or payload change afterward. */
+void
+request_cached_state_reset_test (void)
+{
+   kms_request_t *request;
+   char *before;
+   char *after;
+
+   request = kms_request_new ("POST", "/", NULL);
+   set_test_date (request);
+   kms_request_set_region (request, "us-east-1");
+   kms_request_set_service (request, "service");
+   kms_request_append_payload (request, "a", 1);
+
+   before = kms_request_get_canonical (request);
+   KMS_ASSERT (before);
+   ASSERT (!strstr (before, "x-extra:value"));
+
+   KMS_ASSERT (kms_request_add_header_field (request, "X-Extra", "value"));
+   KMS_ASSERT (kms_request_append_payload (request, "b", 1));
+   after = kms_request_get_canonical (request);
+   KMS_ASSERT (after);
+   ASSERT (strstr (after, "x-extra:value\n"));
+   ASSERT (strstr (after, ";x-extra\n"));
+   /* hex SHA-256 of "ab" */
+   ASSERT (strstr (
+      after,
+      "fb8e20fc2e4c3f248c60c39bd652f3c1347298bb977b8b4d5903b85055620603"));
+
+   free (before);
+   free (after);
+   kms_request_destroy (request);
+}
+
 void
 path_normalization_test (void)
 {
@@ -873,6 +1136,87 @@ kms_response_parser_test (void)
    kms_response_parser_destroy (parser);
 }
 
+static void
+kms_response_parser_keep_alive_test (void)
+{
+   kms_response_parser_t *parser;
+   kms_response_t *response;
+   const uint8_t *trailing;
+   uint32_t trailing_len;
+   const char *stream = "HTTP/1.1 200 OK\r\n"
+                        "Content-Length: 5\r\n"
+                        "\r\n"
+                        "first"
+                        "HTTP/1.1 204 No Content\r\n"
+                        "\r\n"
+                        "HTTP/1.1 200 OK\r\n"
+                        "Transfer-Encoding: chunked\r\n"
+                        "\r\n"
+                        "6\r\n"
+                        "third.\r\n"
+                        "0\r\n"
+                        "\r\n";
+   const uint32_t stream_len = (uint32_t) strlen (stream);
+   /* length of the first response. */
+   const uint32_t first_len = 17 + 19 + 2 + 5;
+   uint32_t i;
+
+   /* Without keep-alive, a second response is rejected. */
+   parser = kms_response_parser_new ();
+   ASSERT (!kms_response_parser_feed (parser, (uint8_t *) stream, stream_len));
+   ASSERT (strstr (kms_response_parser_error (parser),
+                   "Unexpected: exceeded content length"));
+   kms_response_parser_destroy (parser);
+
+   /* With keep-alive, back-to-back responses parse from one stream. */
+   parser = kms_response_parser_new ();
+   kms_response_parser_set_keep_alive (parser, true);
+   ASSERT (kms_response_parser_feed (parser, (uint8_t *) stream, stream_len));
+   ASSERT (0 == kms_response_parser_wants_bytes (parser, 123));
+   trailing = kms_response_parser_trailing (parser, &trailing_len);
+   ASSERT (trailing);
+   ASSERT (trailing_len == stream_len - first_len);
+   ASSERT (0 == strncmp ((const char *) trailing, "HTTP/1.1 204", 12));
+
+   response = kms_response_parser_get_response (parser);
+   ASSERT (response->status == 200);
+   ASSERT_CMPSTR (response->body->str, "first");
+   kms_response_destroy (response);
+
+   ASSERT (0 == kms_response_parser_wants_bytes (parser, 123));
+   response = kms_response_parser_get_response (parser);
+   ASSERT (response->status == 204);
+   ASSERT_CMPSTR (response->body->str, "");
+   kms_response_destroy (response);
+
+   ASSERT (0 == kms_response_parser_wants_bytes (parser, 123));
+   trailing = kms_response_parser_trailing (parser, &trailing_len);
+   ASSERT (!trailing);
+   ASSERT (trailing_len == 0);
+   response = kms_response_parser_get_response (parser);
+   ASSERT (response->status == 200);
+   ASSERT_CMPSTR (response->body->str, "third.");
+   kms_response_destroy (response);
+
+   /* The parser is ready for the next response on the stream. */
+   ASSERT (kms_response_parser_wants_bytes (parser, 123) == 123);
+   kms_response_parser_destroy (parser);
+
+   /* Feeding one byte at a time gives the same result. */
+   parser = kms_response_parser_new ();
+   kms_response_parser_set_keep_alive (parser, true);
+   for (i = 0; i < stream_len; i++) {
+      ASSERT (kms_response_parser_feed (parser, (uint8_t *) stream + i, 1));
+      if (0 == kms_response_parser_wants_bytes (parser, 123)) {
+         response = kms_response_parser_get_response (parser);
+         ASSERT (response->status == 200 || response->status == 204);
+         kms_response_destroy (response);
+      }
+   }
+   ASSERT (kms_response_parser_wants_bytes (parser, 123) == 123);
+   kms_response_parser_destroy (parser);
+}
+
 typedef struct {
    const char *filepath;
    const char *expected_body;
@@ -1213,11 +1557,15 @@ extern void kms_kmip_reader_find_and_read_bytes_test (void);
 extern void kms_kmip_request_register_secretdata_test (void);
 extern void kms_kmip_request_register_secretdata_invalid_test (void);
 extern void kms_kmip_request_get_test (void);
+extern void kms_kmip_request_get_batch_test (void);
 extern void kms_kmip_request_activate_test (void);
 extern void kms_kmip_response_parser_test (void);
 extern void kms_kmip_response_get_unique_identifier_test (void);
 extern void kms_kmip_response_get_secretdata_test (void);
 extern void kms_kmip_response_get_secretdata_notfound_test (void);
+extern void kms_kmip_response_get_secretdata_batch_test (void);
+extern void kms_kmip_response_get_secretdata_batch_out_of_order_test (void);
+extern void kms_kmip_response_get_secretdata_batch_missing_test (void);
 extern void kms_kmip_response_parser_reuse_test (void);
 extern void kms_kmip_response_parser_excess_test (void);
 extern void kms_kmip_response_parser_notenough_test (void);
@@ -1245,6 +1593,9 @@ main (int argc, char *argv[])
    }
 
    RUN_TEST (example_signature_test);
+   RUN_TEST (signing_key_cache_test);
+   RUN_TEST (gcp_assertion_cache_test);
+   RUN_TEST (request_cached_state_reset_test);
    RUN_TEST (path_normalization_test);
    RUN_TEST (host_test);
    RUN_TEST (content_length_test);
@@ -1263,6 +1614,7 @@ main (int argc, char *argv[])
 
    RUN_TEST (kms_response_parser_test);
    RUN_TEST (kms_response_parser_files);
+   RUN_TEST (kms_response_parser_keep_alive_test);
    RUN_TEST (kms_request_validate_test);
 
    RUN_TEST (kms_signature_test);
@@ -1277,12 +1629,16 @@ main (int argc, char *argv[])
    RUN_TEST (kms_kmip_request_register_secretdata_test);
    RUN_TEST (kms_kmip_request_register_secretdata_invalid_test);
    RUN_TEST (kms_kmip_request_get_test);
+   RUN_TEST (kms_kmip_request_get_batch_test);
    RUN_TEST (kms_kmip_request_activate_test);
    RUN_TEST (kms_request_kmip_prohibited_test);
    RUN_TEST (kms_kmip_response_parser_test);
    RUN_TEST (kms_kmip_response_get_unique_identifier_test);
    RUN_TEST (kms_kmip_response_get_secretdata_test);
    RUN_TEST (kms_kmip_response_get_secretdata_notfound_test);
+   RUN_TEST (kms_kmip_response_get_secretdata_batch_test);
+   RUN_TEST (kms_kmip_response_get_secretdata_batch_out_of_order_test);
+   RUN_TEST (kms_kmip_response_get_secretdata_batch_missing_test);
    RUN_TEST (kms_kmip_response_parser_reuse_test);
    RUN_TEST (kms_kmip_response_parser_excess_test);
    RUN_TEST (kms_kmip_response_parser_notenough_test);
@@ -0,0 +1,1176 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Built-in crypto for builds without OpenSSL, CommonCrypto, or CNG.
+ *
+ * AES-256 uses AES-NI on x86-64 and the ARMv8 Cryptography Extensions when the
+ * compiler targets them. Otherwise it uses a constant-time software
+ * implementation: the S-box is computed as a GF(2^8) inversion on bitsliced
+ * bytes, so no table is indexed by secret data. SHA-256 uses mc-sha256 (SHA
+ * extensions or scalar). SHA-512 is portable C. */
+
+#include "../mongocrypt-crypto-private.h"
+#include "../mongocrypt-private.h"
+
+#ifdef MONGOCRYPT_ENABLE_CRYPTO_BUILTIN
+
+#include "../mc-sha256-private.h"
+#include "../mlib/thread.h"
+
+#include <errno.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+// windows.h must be included before bcrypt.h
+#include <bcrypt.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+#include <stdlib.h>
+#define BUILTIN_HAVE_ARC4RANDOM
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#endif
+
+#if defined(__GNUC__) && (defined(__clang__) || __GNUC__ >= 5) && defined(__x86_64__)
+#define BUILTIN_HAVE_AESNI
+#include <cpuid.h>
+#include <wmmintrin.h>
+#endif
+
+#if defined(__aarch64__) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define BUILTIN_HAVE_ARMV8_AES
+#include <arm_neon.h>
+#endif
+
+#define AES_BLOCK_LEN 16
+#define AES256_KEY_LEN 32
+#define AES256_ROUNDS 14
+/* Blocks processed per call to a block function. CTR and CBC decryption have
+ * independent blocks, so hardware and bitsliced kernels work on several at
+ * once. */
+#define AES_BATCH 4
+
+/* _secure_zero clears secrets in a way the compiler may not remove. */
+static void _secure_zero(void *p, size_t len) {
+    volatile uint8_t *v = p;
+    while (len--) {
+        *v++ = 0;
+    }
+}
+
+bool _native_crypto_initialized = false;
+
+void _native_crypto_init(void) {
+    _native_crypto_initialized = true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* AES-256 */
+
+typedef struct {
+    /* Encryption round keys. */
+    uint8_t enc[AES256_ROUNDS + 1][AES_BLOCK_LEN];
+    /* Round keys of the equivalent inverse cipher: enc in reverse order, with
+     * InvMixColumns applied to all but the first and last. */
+    uint8_t dec[AES256_ROUNDS + 1][AES_BLOCK_LEN];
+} _aes256_key_t;
+
+/* Encrypts or decrypts @n <= AES_BATCH blocks in place. */
+typedef void (*_aes_blocks_fn)(const _aes256_key_t *key, uint8_t *blocks, size_t n);
+
+/* _gf_mul multiplies bitsliced GF(2^8) elements: bit b of plane i is bit i of
+ * byte b. */
+static void _gf_mul(uint64_t r[8], const uint64_t a[8], const uint64_t b[8]) {
+    uint64_t p[15] = {0};
+
+    for (int i = 0; i < 8; i++) {
+        const uint64_t ai = a[i];
+        p[i] ^= ai & b[0];
+        p[i + 1] ^= ai & b[1];
+        p[i + 2] ^= ai & b[2];
+        p[i + 3] ^= ai & b[3];
+        p[i + 4] ^= ai & b[4];
+        p[i + 5] ^= ai & b[5];
+        p[i + 6] ^= ai & b[6];
+        p[i + 7] ^= ai & b[7];
+    }
+    /* Reduce modulo x^8 + x^4 + x^3 + x + 1. */
+    for (int k = 14; k >= 8; k--) {
+        p[k - 4] ^= p[k];
+        p[k - 5] ^= p[k];
+        p[k - 7] ^= p[k];
+        p[k - 8] ^= p[k];
+    }
+    memcpy(r, p, 8 * sizeof(uint64_t));
+}
+
+/* _gf_sqr squares bitsliced GF(2^8) elements. Squaring is linear, so each
+ * output plane is a fixed sum of input planes. */
+static void _gf_sqr(uint64_t r[8], const uint64_t a[8]) {
+    uint64_t t[8];
+
+    t[0] = a[0] ^ a[4] ^ a[6];
+    t[1] = a[4] ^ a[6] ^ a[7];
+    t[2] = a[1] ^ a[5];
+    t[3] = a[4] ^ a[5] ^ a[6] ^ a[7];
+    t[4] = a[2] ^ a[4] ^ a[7];
+    t[5] = a[5] ^ a[6];
+    t[6] = a[3] ^ a[5];
+    t[7] = a[6] ^ a[7];
+    memcpy(r, t, sizeof(t));
+}
+
+/* _gf_inv computes a^254, which is the inverse of a for a != 0, and 0 for 0. */
+static void _gf_inv(uint64_t a[8]) {
+    uint64_t x2[8], x3[8], x12[8], t[8];
+
+    _gf_sqr(x2, a);
+    _gf_mul(x3, x2, a);
+    _gf_sqr(t, x3);      /* x^6 */
+    _gf_sqr(x12, t);     /* x^12 */
+    _gf_mul(t, x12, x3); /* x^15 */
+    _gf_sqr(t, t);       /* x^30 */
+    _gf_sqr(t, t);       /* x^60 */
+    _gf_sqr(t, t);       /* x^120 */
+    _gf_sqr(t, t);       /* x^240 */
+    _gf_mul(t, t, x12);  /* x^252 */
+    _gf_mul(a, t, x2);   /* x^254 */
+}
+
+/* _transpose8 transposes an 8x8 bit matrix with row i in byte i. */
+static uint64_t _transpose8(uint64_t x) {
+    uint64_t t;
+
+    t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000cccc0000ccccULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+/* _sub_bytes applies the S-box, or the inverse S-box, to @len <= 64 bytes. */
+static void _sub_bytes(uint8_t *s, size_t len, bool inverse) {
+    uint64_t planes[8] = {0};
+    uint64_t t[8];
+
+    BSON_ASSERT(len <= 64);
+    /* Transpose each group of eight bytes into one byte of every plane. */
+    for (size_t g = 0; g * 8 < len; g++) {
+        uint64_t x = 0;
+        for (size_t b = 0; b < 8 && g * 8 + b < len; b++) {
+            x |= (uint64_t)s[g * 8 + b] << (8 * b);
+        }
+        x = _transpose8(x);
+        for (size_t i = 0; i < 8; i++) {
+            planes[i] |= ((x >> (8 * i)) & 0xffu) << (8 * g);
+        }
+    }
+
+    if (inverse) {
+        /* Inverse affine transform, then inversion. */
+        for (int i = 0; i < 8; i++) {
+            t[i] = planes[(i + 2) % 8] ^ planes[(i + 5) % 8] ^ planes[(i + 7) % 8];
+        }
+        t[0] = ~t[0];
+        t[2] = ~t[2];
+        memcpy(planes, t, sizeof(t));
+        _gf_inv(planes);
+    } else {
+        /* Inversion, then the affine transform with constant 0x63. */
+        _gf_inv(planes);
+        for (int i = 0; i < 8; i++) {
+            t[i] = planes[i] ^ planes[(i + 4) % 8] ^ planes[(i + 5) % 8] ^ planes[(i + 6) % 8] ^ planes[(i + 7) % 8];
+        }
+        t[0] = ~t[0];
+        t[1] = ~t[1];
+        t[5] = ~t[5];
+        t[6] = ~t[6];
+        memcpy(planes, t, sizeof(t));
+    }
+
+    for (size_t g = 0; g * 8 < len; g++) {
+        uint64_t x = 0;
+        for (size_t i = 0; i < 8; i++) {
+            x |= ((planes[i] >> (8 * g)) & 0xffu) << (8 * i);
+        }
+        x = _transpose8(x);
+        for (size_t b = 0; b < 8 && g * 8 + b < len; b++) {
+            s[g * 8 + b] = (uint8_t)(x >> (8 * b));
+        }
+    }
+}
+
+static uint8_t _xtime(uint8_t x) {
+    return (uint8_t)((x << 1) ^ (0x1b & -(x >> 7)));
+}
+
+/* State bytes are column-major: byte r + 4c is row r of column c. */
+static void _shift_rows(uint8_t s[AES_BLOCK_LEN]) {
+    uint8_t t[AES_BLOCK_LEN];
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            t[r + 4 * c] = s[r + 4 * ((c + r) % 4)];
+        }
+    }
+    memcpy(s, t, sizeof(t));
+}
+
+static void _inv_shift_rows(uint8_t s[AES_BLOCK_LEN]) {
+    uint8_t t[AES_BLOCK_LEN];
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            t[r + 4 * ((c + r) % 4)] = s[r + 4 * c];
+        }
+    }
+    memcpy(s, t, sizeof(t));
+}
+
+static void _mix_columns(uint8_t s[AES_BLOCK_LEN]) {
+    for (int c = 0; c < 4; c++) {
+        uint8_t *a = s + 4 * c;
+        const uint8_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+        const uint8_t t = (uint8_t)(a0 ^ a1 ^ a2 ^ a3);
+        a[0] = (uint8_t)(a0 ^ t ^ _xtime((uint8_t)(a0 ^ a1)));
+        a[1] = (uint8_t)(a1 ^ t ^ _xtime((uint8_t)(a1 ^ a2)));
+        a[2] = (uint8_t)(a2 ^ t ^ _xtime((uint8_t)(a2 ^ a3)));
+        a[3] = (uint8_t)(a3 ^ t ^ _xtime((uint8_t)(a3 ^ a0)));
+    }
+}
+
+static void _inv_mix_columns(uint8_t s[AES_BLOCK_LEN]) {
+    /* InvMixColumns is MixColumns after multiplying by {04}x^2 + {05}. */
+    for (int c = 0; c < 4; c++) {
+        uint8_t *a = s + 4 * c;
+        const uint8_t u = _xtime(_xtime((uint8_t)(a[0] ^ a[2])));
+        const uint8_t v = _xtime(_xtime((uint8_t)(a[1] ^ a[3])));
+        a[0] ^= u;
+        a[1] ^= v;
+        a[2] ^= u;
+        a[3] ^= v;
+    }
+    _mix_columns(s);
+}
+
+static void _add_round_key(uint8_t *s, const uint8_t rk[AES_BLOCK_LEN]) {
+    for (int i = 0; i < AES_BLOCK_LEN; i++) {
+        s[i] ^= rk[i];
+    }
+}
+
+static void _aes256_expand_key(_aes256_key_t *key, const uint8_t k[AES256_KEY_LEN]) {
+    uint8_t w[(AES256_ROUNDS + 1) * AES_BLOCK_LEN];
+    uint8_t rcon = 0x01;
+
+    memcpy(w, k, AES256_KEY_LEN);
+    for (size_t i = AES256_KEY_LEN / 4; i < sizeof(w) / 4; i++) {
+        uint8_t t[4];
+        memcpy(t, w + 4 * (i - 1), 4);
+        if (i % 8 == 0) {
+            const uint8_t t0 = t[0];
+            t[0] = t[1];
+            t[1] = t[2];
+            t[2] = t[3];
+            t[3] = t0;
+            _sub_bytes(t, 4, false);
+            t[0] ^= rcon;
+            rcon = _xtime(rcon);
+        } else if (i % 8 == 4) {
+            _sub_bytes(t, 4, false);
+        }
+        for (size_t j = 0; j < 4; j++) {
+            w[4 * i + j] = (uint8_t)(w[4 * (i - 8) + j] ^ t[j]);
+        }
+    }
+
+    memcpy(key->enc, w, sizeof(w));
+    for (int r = 0; r <= AES256_ROUNDS; r++) {
+        memcpy(key->dec[r], key->enc[AES256_ROUNDS - r], AES_BLOCK_LEN);
+        if (r != 0 && r != AES256_ROUNDS) {
+            _inv_mix_columns(key->dec[r]);
+        }
+    }
+    _secure_zero(w, sizeof(w));
+}
+
+static void _aes_encrypt_soft(const _aes256_key_t *key, uint8_t *blocks, size_t n) {
+    for (size_t b = 0; b < n; b++) {
+        _add_round_key(blocks + AES_BLOCK_LEN * b, key->enc[0]);
+    }
+    for (int r = 1; r <= AES256_ROUNDS; r++) {
+        /* One bitsliced S-box evaluation covers every block. */
+        _sub_bytes(blocks, AES_BLOCK_LEN * n, false);
+        for (size_t b = 0; b < n; b++) {
+            uint8_t *s = blocks + AES_BLOCK_LEN * b;
+            _shift_rows(s);
+            if (r != AES256_ROUNDS) {
+                _mix_columns(s);
+            }
+            _add_round_key(s, key->enc[r]);
+        }
+    }
+}
+
+static void _aes_decrypt_soft(const _aes256_key_t *key, uint8_t *blocks, size_t n) {
+    for (size_t b = 0; b < n; b++) {
+        _add_round_key(blocks + AES_BLOCK_LEN * b, key->dec[0]);
+    }
+    for (int r = 1; r <= AES256_ROUNDS; r++) {
+        for (size_t b = 0; b < n; b++) {
+            _inv_shift_rows(blocks + AES_BLOCK_LEN * b);
+        }
+        _sub_bytes(blocks, AES_BLOCK_LEN * n, true);
+        for (size_t b = 0; b < n; b++) {
+            uint8_t *s = blocks + AES_BLOCK_LEN * b;
+            if (r != AES256_ROUNDS) {
+                _inv_mix_columns(s);
+            }
+            _add_round_key(s, key->dec[r]);
+        }
+    }
+}
+
+#ifdef BUILTIN_HAVE_AESNI
+__attribute__((target("aes,sse2"))) static void
+_aes_encrypt_aesni(const _aes256_key_t *key, uint8_t *blocks, size_t n) {
+    __m128i rk[AES256_ROUNDS + 1];
+    __m128i x[AES_BATCH];
+
+    BSON_ASSERT(n <= AES_BATCH);
+    for (int r = 0; r <= AES256_ROUNDS; r++) {
+        rk[r] = _mm_loadu_si128((const __m128i *)(const void *)key->enc[r]);
+    }
+    for (size_t b = 0; b < n; b++) {
+        x[b] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(const void *)(blocks + AES_BLOCK_LEN * b)), rk[0]);
+    }
+    for (int r = 1; r < AES256_ROUNDS; r++) {
+        for (size_t b = 0; b < n; b++) {
+            x[b] = _mm_aesenc_si128(x[b], rk[r]);
+        }
+    }
+    for (size_t b = 0; b < n; b++) {
+        x[b] = _mm_aesenclast_si128(x[b], rk[AES256_ROUNDS]);
+        _mm_storeu_si128((__m128i *)(void *)(blocks + AES_BLOCK_LEN * b), x[b]);
+    }
+}
+
+__attribute__((target("aes,sse2"))) static void
+_aes_decrypt_aesni(const _aes256_key_t *key, uint8_t *blocks, size_t n) {
+    __m128i rk[AES256_ROUNDS + 1];
+    __m128i x[AES_BATCH];
+
+    BSON_ASSERT(n <= AES_BATCH);
+    for (int r = 0; r <= AES256_ROUNDS; r++) {
+        rk[r] = _mm_loadu_si128((const __m128i *)(const void *)key->dec[r]);
+    }
+    for (size_t b = 0; b < n; b++) {
+        x[b] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(const void *)(blocks + AES_BLOCK_LEN * b)), rk[0]);
+    }
+    for (int r = 1; r < AES256_ROUNDS; r++) {
+        for (size_t b = 0; b < n; b++) {
+            x[b] = _mm_aesdec_si128(x[b], rk[r]);
+        }
+    }
+    for (size_t b = 0; b < n; b++) {
+        x[b] = _mm_aesdeclast_si128(x[b], rk[AES256_ROUNDS]);
+        _mm_storeu_si128((__m128i *)(void *)(blocks + AES_BLOCK_LEN * b), x[b]);
+    }
+}
+
+static bool _aesni_supported;
+
+static void _detect_aesni(void) {
+    unsigned int eax, ebx, ecx, edx;
+    _aesni_supported = __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_AES);
+}
+#endif /* BUILTIN_HAVE_AESNI */
+
+#ifdef BUILTIN_HAVE_ARMV8_AES
+static void _aes_encrypt_armv8(const _aes256_key_t *key, uint8_t *blocks, size_t n) {
+    uint8x16_t rk[AES256_ROUNDS + 1];
+    uint8x16_t x[AES_BATCH];
+
+    BSON_ASSERT(n <= AES_BATCH);
+    for (int r = 0; r <= AES256_ROUNDS; r++) {
+        rk[r] = vld1q_u8(key->enc[r]);
+    }
+    for (size_t b = 0; b < n; b++) {
+        x[b] = vld1q_u8(blocks + AES_BLOCK_LEN * b);
+    }
+    /* AESE adds the round key before SubBytes and ShiftRows. */
+    for (int r = 0; r < AES256_ROUNDS - 1; r++) {
+        for (size_t b = 0; b < n; b++) {
+            x[b] = vaesmcq_u8(vaeseq_u8(x[b], rk[r]));
+        }
+    }
+    for (size_t b = 0; b < n; b++) {
+        x[b] = veorq_u8(vaeseq_u8(x[b], rk[AES256_ROUNDS - 1]), rk[AES256_ROUNDS]);
+        vst1q_u8(blocks + AES_BLOCK_LEN * b, x[b]);
+    }
+}
+
+static void _aes_decrypt_armv8(const _aes256_key_t *key, uint8_t *blocks, size_t n) {
+    uint8x16_t rk[AES256_ROUNDS + 1];
+    uint8x16_t x[AES_BATCH];
+
+    BSON_ASSERT(n <= AES_BATCH);
+    for (int r = 0; r <= AES256_ROUNDS; r++) {
+        rk[r] = vld1q_u8(key->dec[r]);
+    }
+    for (size_t b = 0; b < n; b++) {
+        x[b] = vld1q_u8(blocks + AES_BLOCK_LEN * b);
+    }
+    for (int r = 0; r < AES256_ROUNDS - 1; r++) {
+        for (size_t b = 0; b < n; b++) {
+            x[b] = vaesimcq_u8(vaesdq_u8(x[b], rk[r]));
+        }
+    }
+    for (size_t b = 0; b < n; b++) {
+        x[b] = veorq_u8(vaesdq_u8(x[b], rk[AES256_ROUNDS - 1]), rk[AES256_ROUNDS]);
+        vst1q_u8(blocks + AES_BLOCK_LEN * b, x[b]);
+    }
+}
+#endif /* BUILTIN_HAVE_ARMV8_AES */
+
+static _aes_blocks_fn _aes_encrypt_fn(void) {
+#if defined(BUILTIN_HAVE_AESNI)
+    static mlib_once_flag flag = MLIB_ONCE_INITIALIZER;
+    mlib_call_once(&flag, _detect_aesni);
+    if (_aesni_supported) {
+        return _aes_encrypt_aesni;
+    }
+#elif defined(BUILTIN_HAVE_ARMV8_AES)
+    return _aes_encrypt_armv8;
+#endif
+    return _aes_encrypt_soft;
+}
+
+static _aes_blocks_fn _aes_decrypt_fn(void) {
+#if defined(BUILTIN_HAVE_AESNI)
+    static mlib_once_flag flag = MLIB_ONCE_INITIALIZER;
+    mlib_call_once(&flag, _detect_aesni);
+    if (_aesni_supported) {
+        return _aes_decrypt_aesni;
+    }
+#elif defined(BUILTIN_HAVE_ARMV8_AES)
+    return _aes_decrypt_armv8;
+#endif
+    return _aes_decrypt_soft;
+}
+
+/* _check_aes_args validates @args for a mode that requires whole blocks if
+ * @whole_blocks is set. */
+static bool _check_aes_args(aes_256_args_t args, bool whole_blocks) {
+    mongocrypt_status_t *status = args.status;
+
+    BSON_ASSERT(args.key);
+    BSON_ASSERT(args.iv);
+    BSON_ASSERT(args.in);
+    BSON_ASSERT(args.out);
+    BSON_ASSERT(args.bytes_written);
+
+    if (args.key->len != AES256_KEY_LEN) {
+        CLIENT_ERR("expected AES-256 key of %d bytes, got %" PRIu32, AES256_KEY_LEN, args.key->len);
+        return false;
+    }
+    if (args.iv->len != AES_BLOCK_LEN) {
+        CLIENT_ERR("expected IV of %d bytes, got %" PRIu32, AES_BLOCK_LEN, args.iv->len);
+        return false;
+    }
+    if (whole_blocks && args.in->len % AES_BLOCK_LEN != 0) {
+        CLIENT_ERR("input length %" PRIu32 " is not a multiple of the AES block size", args.in->len);
+        return false;
+    }
+    if (args.out->len < args.in->len) {
+        CLIENT_ERR("output buffer of %" PRIu32 " bytes is too small for %" PRIu32 " bytes",
+                   args.out->len,
+                   args.in->len);
+        return false;
+    }
+    return true;
+}
+
+bool _native_crypto_aes_256_cbc_encrypt(aes_256_args_t args) {
+    _aes256_key_t key;
+    uint8_t block[AES_BLOCK_LEN];
+
+    if (!_check_aes_args(args, true)) {
+        return false;
+    }
+    const _aes_blocks_fn encrypt = _aes_encrypt_fn();
+    _aes256_expand_key(&key, args.key->data);
+
+    /* Each block depends on the previous ciphertext, so encrypt one at a
+     * time. */
+    memcpy(block, args.iv->data, AES_BLOCK_LEN);
+    for (uint32_t off = 0; off < args.in->len; off += AES_BLOCK_LEN) {
+        for (uint32_t i = 0; i < AES_BLOCK_LEN; i++) {
+            block[i] ^= args.in->data[off + i];
+        }
+        encrypt(&key, block, 1);
+        memcpy(args.out->data + off, block, AES_BLOCK_LEN);
+    }
+    *args.bytes_written = args.in->len;
+
+    _secure_zero(&key, sizeof(key));
+    _secure_zero(block, sizeof(block));
+    return true;
+}
+
+bool _native_crypto_aes_256_cbc_decrypt(aes_256_args_t args) {
+    _aes256_key_t key;
+    uint8_t prev[AES_BLOCK_LEN];
+    uint8_t next_prev[AES_BLOCK_LEN];
+    uint8_t blocks[AES_BATCH * AES_BLOCK_LEN];
+
+    if (!_check_aes_args(args, true)) {
+        return false;
+    }
+    const _aes_blocks_fn decrypt = _aes_decrypt_fn();
+    _aes256_expand_key(&key, args.key->data);
+
+    memcpy(prev, args.iv->data, AES_BLOCK_LEN);
+    for (uint32_t off = 0; off < args.in->len; off += AES_BATCH * AES_BLOCK_LEN) {
+        const uint32_t len = BSON_MIN(AES_BATCH * AES_BLOCK_LEN, args.in->len - off);
+        const size_t n = len / AES_BLOCK_LEN;
+
+        /* Copy the ciphertext first, so @in and @out may overlap. */
+        memcpy(blocks, args.in->data + off, len);
+        memcpy(next_prev, blocks + len - AES_BLOCK_LEN, AES_BLOCK_LEN);
+        decrypt(&key, blocks, n);
+        for (int i = 0; i < AES_BLOCK_LEN; i++) {
+            blocks[i] ^= prev[i];
+        }
+        for (uint32_t i = AES_BLOCK_LEN; i < len; i++) {
+            blocks[i] ^= args.in->data[off + i - AES_BLOCK_LEN];
+        }
+        memcpy(args.out->data + off, blocks, len);
+        memcpy(prev, next_prev, AES_BLOCK_LEN);
+    }
+    *args.bytes_written = args.in->len;
+
+    _secure_zero(&key, sizeof(key));
+    _secure_zero(blocks, sizeof(blocks));
+    return true;
+}
+
+/* _aes_256_ctr applies the CTR keystream to @args.in. The counter is the IV
+ * incremented as a 128-bit big-endian integer, matching OpenSSL. Encryption
+ * and decryption are the same operation. */
+static bool _aes_256_ctr(aes_256_args_t args) {
+    _aes256_key_t key;
+    uint8_t counter[AES_BLOCK_LEN];
+    uint8_t stream[AES_BATCH * AES_BLOCK_LEN];
+
+    if (!_check_aes_args(args, false)) {
+        return false;
+    }
+    const _aes_blocks_fn encrypt = _aes_encrypt_fn();
+    _aes256_expand_key(&key, args.key->data);
+
+    memcpy(counter, args.iv->data, AES_BLOCK_LEN);
+    for (uint32_t off = 0; off < args.in->len; off += AES_BATCH * AES_BLOCK_LEN) {
+        const uint32_t len = BSON_MIN(AES_BATCH * AES_BLOCK_LEN, args.in->len - off);
+        const size_t n = (len + AES_BLOCK_LEN - 1) / AES_BLOCK_LEN;
+
+        for (size_t b = 0; b < n; b++) {
+            memcpy(stream + AES_BLOCK_LEN * b, counter, AES_BLOCK_LEN);
+            for (int i = AES_BLOCK_LEN - 1; i >= 0; i--) {
+                if (++counter[i] != 0) {
+                    break;
+                }
+            }
+        }
+        encrypt(&key, stream, n);
+        for (uint32_t i = 0; i < len; i++) {
+            args.out->data[off + i] = (uint8_t)(args.in->data[off + i] ^ stream[i]);
+        }
+    }
+    *args.bytes_written = args.in->len;
+
+    _secure_zero(&key, sizeof(key));
+    _secure_zero(stream, sizeof(stream));
+    return true;
+}
+
+bool _native_crypto_aes_256_ctr_encrypt(aes_256_args_t args) {
+    return _aes_256_ctr(args);
+}
+
+bool _native_crypto_aes_256_ctr_decrypt(aes_256_args_t args) {
+    return _aes_256_ctr(args);
+}
+
+/* ------------------------------------------------------------------------- */
+/* SHA-512 and HMAC */
+
+#define SHA512_LEN 64
+#define SHA512_BLOCK_LEN 128
+
+static const uint64_t _sha512_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
+
+typedef struct {
+    uint64_t h[8];
+    uint8_t buf[SHA512_BLOCK_LEN];
+    size_t buf_len;
+    uint64_t total_len;
+} _sha512_ctx_t;
+
+static uint64_t _load_be64(const uint8_t *p) {
+    return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) | ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32)
+         | ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) | ((uint64_t)p[6] << 8) | (uint64_t)p[7];
+}
+
+static void _store_be64(uint8_t *p, uint64_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (56 - 8 * i));
+    }
+}
+
+#define ROTR64(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+static void _sha512_compress(uint64_t h[8], const uint8_t block[SHA512_BLOCK_LEN]) {
+    uint64_t w[80];
+    uint64_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = _load_be64(block + 8 * i);
+    }
+    for (int i = 16; i < 80; i++) {
+        const uint64_t s0 = ROTR64(w[i - 15], 1) ^ ROTR64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+        const uint64_t s1 = ROTR64(w[i - 2], 19) ^ ROTR64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    for (int i = 0; i < 80; i++) {
+        const uint64_t s1 = ROTR64(e, 14) ^ ROTR64(e, 18) ^ ROTR64(e, 41);
+        const uint64_t ch = (e & f) ^ (~e & g);
+        const uint64_t t1 = hh + s1 + ch + _sha512_k[i] + w[i];
+        const uint64_t s0 = ROTR64(a, 28) ^ ROTR64(a, 34) ^ ROTR64(a, 39);
+        const uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
+        const uint64_t t2 = s0 + maj;
+        hh = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+    h[5] += f;
+    h[6] += g;
+    h[7] += hh;
+    _secure_zero(w, sizeof(w));
+}
+
+static void _sha512_init(_sha512_ctx_t *ctx) {
+    static const uint64_t h0[8] = {0x6a09e667f3bcc908ULL,
+                                   0xbb67ae8584caa73bULL,
+                                   0x3c6ef372fe94f82bULL,
+                                   0xa54ff53a5f1d36f1ULL,
+                                   0x510e527fade682d1ULL,
+                                   0x9b05688c2b3e6c1fULL,
+                                   0x1f83d9abfb41bd6bULL,
+                                   0x5be0cd19137e2179ULL};
+
+    memcpy(ctx->h, h0, sizeof(h0));
+    ctx->buf_len = 0;
+    ctx->total_len = 0;
+}
+
+static void _sha512_update(_sha512_ctx_t *ctx, const uint8_t *data, size_t len) {
+    ctx->total_len += len;
+    if (ctx->buf_len > 0) {
+        const size_t take = BSON_MIN(len, SHA512_BLOCK_LEN - ctx->buf_len);
+        memcpy(ctx->buf + ctx->buf_len, data, take);
+        ctx->buf_len += take;
+        data += take;
+        len -= take;
+        if (ctx->buf_len < SHA512_BLOCK_LEN) {
+            return;
+        }
+        _sha512_compress(ctx->h, ctx->buf);
+        ctx->buf_len = 0;
+    }
+    for (; len >= SHA512_BLOCK_LEN; data += SHA512_BLOCK_LEN, len -= SHA512_BLOCK_LEN) {
+        _sha512_compress(ctx->h, data);
+    }
+    if (len > 0) {
+        memcpy(ctx->buf, data, len);
+        ctx->buf_len = len;
+    }
+}
+
+static void _sha512_final(_sha512_ctx_t *ctx, uint8_t out[SHA512_LEN]) {
+    /* Messages are shorter than 2^61 bytes, so the high 64 bits of the
+     * 128-bit length are zero. */
+    const uint64_t bits = ctx->total_len << 3;
+
+    ctx->buf[ctx->buf_len++] = 0x80;
+    if (ctx->buf_len > SHA512_BLOCK_LEN - 16) {
+        memset(ctx->buf + ctx->buf_len, 0, SHA512_BLOCK_LEN - ctx->buf_len);
+        _sha512_compress(ctx->h, ctx->buf);
+        ctx->buf_len = 0;
+    }
+    memset(ctx->buf + ctx->buf_len, 0, SHA512_BLOCK_LEN - 8 - ctx->buf_len);
+    _store_be64(ctx->buf + SHA512_BLOCK_LEN - 8, bits);
+    _sha512_compress(ctx->h, ctx->buf);
+    for (int i = 0; i < 8; i++) {
+        _store_be64(out + 8 * i, ctx->h[i]);
+    }
+    _secure_zero(ctx, sizeof(*ctx));
+}
+
+static void _hmac_sha512(const uint8_t *key, size_t key_len, const uint8_t *in, size_t in_len, uint8_t *out) {
+    _sha512_ctx_t ctx;
+    uint8_t k[SHA512_BLOCK_LEN] = {0};
+    uint8_t pad[SHA512_BLOCK_LEN];
+    uint8_t inner[SHA512_LEN];
+
+    if (key_len > SHA512_BLOCK_LEN) {
+        _sha512_init(&ctx);
+        _sha512_update(&ctx, key, key_len);
+        _sha512_final(&ctx, k);
+    } else if (key_len > 0) {
+        memcpy(k, key, key_len);
+    }
+
+    for (int i = 0; i < SHA512_BLOCK_LEN; i++) {
+        pad[i] = (uint8_t)(k[i] ^ 0x36);
+    }
+    _sha512_init(&ctx);
+    _sha512_update(&ctx, pad, sizeof(pad));
+    _sha512_update(&ctx, in, in_len);
+    _sha512_final(&ctx, inner);
+
+    for (int i = 0; i < SHA512_BLOCK_LEN; i++) {
+        pad[i] = (uint8_t)(k[i] ^ 0x5c);
+    }
+    _sha512_init(&ctx);
+    _sha512_update(&ctx, pad, sizeof(pad));
+    _sha512_update(&ctx, inner, sizeof(inner));
+    _sha512_final(&ctx, out);
+
+    _secure_zero(k, sizeof(k));
+    _secure_zero(pad, sizeof(pad));
+    _secure_zero(inner, sizeof(inner));
+}
+
+bool _native_crypto_hmac_sha_512(const _mongocrypt_buffer_t *key,
+                                 const _mongocrypt_buffer_t *in,
+                                 _mongocrypt_buffer_t *out,
+                                 mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(key);
+    BSON_ASSERT_PARAM(in);
+    BSON_ASSERT_PARAM(out);
+
+    if (out->len != SHA512_LEN) {
+        CLIENT_ERR("out does not contain %d bytes", SHA512_LEN);
+        return false;
+    }
+    _hmac_sha512(key->data, key->len, in->data, in->len, out->data);
+    return true;
+}
+
+bool _native_crypto_hmac_sha_256(const _mongocrypt_buffer_t *key,
+                                 const _mongocrypt_buffer_t *in,
+                                 _mongocrypt_buffer_t *out,
+                                 mongocrypt_status_t *status) {
+    mc_hmac_sha256_job_t job;
+
+    BSON_ASSERT_PARAM(key);
+    BSON_ASSERT_PARAM(in);
+    BSON_ASSERT_PARAM(out);
+
+    if (out->len != MC_SHA256_LEN) {
+        CLIENT_ERR("out does not contain %d bytes", MC_SHA256_LEN);
+        return false;
+    }
+    job.key = key->data;
+    job.key_len = key->len;
+    job.in = in->data;
+    job.in_len = in->len;
+    job.out = out->data;
+    mc_hmac_sha256_many(mc_sha256_impl_single(), &job, 1);
+    return true;
+}
+
+/* ------------------------------------------------------------------------- */
+/* Random */
+
+#if !defined(_WIN32) && !defined(BUILTIN_HAVE_ARC4RANDOM)
+static bool _read_urandom(uint8_t *buf, size_t len, mongocrypt_status_t *status) {
+    int fd;
+
+    do {
+        fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    if (fd < 0) {
+        CLIENT_ERR("failed to open /dev/urandom: %d", errno);
+        return false;
+    }
+    while (len > 0) {
+        const ssize_t got = read(fd, buf, len);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            CLIENT_ERR("failed to read /dev/urandom: %d", errno);
+            close(fd);
+            return false;
+        }
+        buf += got;
+        len -= (size_t)got;
+    }
+    close(fd);
+    return true;
+}
+#endif
+
+bool _native_crypto_random(_mongocrypt_buffer_t *out, uint32_t count, mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(out);
+    BSON_ASSERT(count <= out->len);
+
+#if defined(_WIN32)
+    NTSTATUS nt_status = BCryptGenRandom(NULL, out->data, count, BCRYPT_USE_SYSTEM_PREFERRED_RNG);
+    if (!BCRYPT_SUCCESS(nt_status)) {
+        CLIENT_ERR("BCryptGenRandom Failed: 0x%x", (int)nt_status);
+        return false;
+    }
+    return true;
+#elif defined(BUILTIN_HAVE_ARC4RANDOM)
+    arc4random_buf(out->data, count);
+    return true;
+#else
+    uint8_t *buf = out->data;
+    size_t len = count;
+#if defined(__linux__) && defined(SYS_getrandom)
+    /* getrandom blocks until the kernel pool is seeded, then never fails for
+     * requests up to 256 bytes. Fall back to /dev/urandom on old kernels. */
+    while (len > 0) {
+        const long got = syscall(SYS_getrandom, buf, len, 0);
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got < 0 && errno == ENOSYS) {
+            break;
+        }
+        if (got <= 0) {
+            CLIENT_ERR("getrandom failed: %d", errno);
+            return false;
+        }
+        buf += got;
+        len -= (size_t)got;
+    }
+#endif
+    return len == 0 || _read_urandom(buf, len, status);
+#endif
+}
+
+/* ------------------------------------------------------------------------- */
+/* RSASSA-PKCS1-v1_5 with SHA-256 */
+
+/* Moduli are up to 4096 bits, in 32-bit limbs. */
+#define RSA_MAX_LIMBS 128
+
+typedef struct {
+    uint32_t v[RSA_MAX_LIMBS];
+} _bn_t;
+
+/* _der_next reads one DER element of type @tag from [*p, end). On success it
+ * sets *content and *content_len and advances *p past the element. */
+static bool
+_der_next(const uint8_t **p, const uint8_t *end, uint8_t tag, const uint8_t **content, size_t *content_len) {
+    const uint8_t *q = *p;
+    size_t len;
+
+    if (end - q < 2 || q[0] != tag) {
+        return false;
+    }
+    q++;
+    if (*q < 0x80) {
+        len = *q++;
+    } else {
+        const size_t nlen = *q++ & 0x7fu;
+        if (nlen == 0 || nlen > sizeof(size_t) || (size_t)(end - q) < nlen) {
+            return false;
+        }
+        len = 0;
+        for (size_t i = 0; i < nlen; i++) {
+            len = (len << 8) | *q++;
+        }
+    }
+    if ((size_t)(end - q) < len) {
+        return false;
+    }
+    *content = q;
+    *content_len = len;
+    *p = q + len;
+    return true;
+}
+
+/* _der_integer reads a non-negative DER INTEGER into @out, with its length in
+ * bytes without leading zeros in @out_len. */
+static bool _der_integer(const uint8_t **p, const uint8_t *end, _bn_t *out, size_t *out_len) {
+    const uint8_t *content;
+    size_t len;
+
+    if (!_der_next(p, end, 0x02, &content, &len) || len == 0 || (content[0] & 0x80)) {
+        return false;
+    }
+    while (len > 0 && content[0] == 0) {
+        content++;
+        len--;
+    }
+    if (len > RSA_MAX_LIMBS * 4) {
+        return false;
+    }
+    memset(out, 0, sizeof(*out));
+    for (size_t i = 0; i < len; i++) {
+        const size_t bit = 8 * (len - 1 - i);
+        out->v[bit / 32] |= (uint32_t)content[i] << (bit % 32);
+    }
+    *out_len = len;
+    return true;
+}
+
+/* _parse_rsa_private_key reads the modulus and private exponent from a DER
+ * PKCS#8 PrivateKeyInfo, as in GCP service account keys, or a PKCS#1
+ * RSAPrivateKey. */
+static bool _parse_rsa_private_key(const uint8_t *der, size_t der_len, _bn_t *n, size_t *n_len, _bn_t *d) {
+    const uint8_t *p = der, *end = der + der_len;
+    const uint8_t *seq, *content;
+    size_t len, d_len;
+    _bn_t version;
+
+    if (!_der_next(&p, end, 0x30, &seq, &len)) {
+        return false;
+    }
+    p = seq;
+    end = seq + len;
+    if (!_der_integer(&p, end, &version, &len)) {
+        return false;
+    }
+    if (p < end && *p == 0x30) {
+        /* PKCS#8: skip the AlgorithmIdentifier, then parse the RSAPrivateKey
+         * in the OCTET STRING. */
+        if (!_der_next(&p, end, 0x30, &content, &len) || !_der_next(&p, end, 0x04, &content, &len)) {
+            return false;
+        }
+        return _parse_rsa_private_key(content, len, n, n_len, d);
+    }
+    /* RSAPrivateKey: version, modulus, publicExponent, privateExponent, ... */
+    if (!_der_integer(&p, end, n, n_len) || !_der_integer(&p, end, d, &d_len)
+        || !_der_integer(&p, end, d, &d_len)) {
+        return false;
+    }
+    return true;
+}
+
+/* _mont_mul computes a * b / R mod n in constant time, with R = 2^(32 * nl).
+ * @r may alias @a or @b. */
+static void _mont_mul(uint32_t *r, const uint32_t *a, const uint32_t *b, const uint32_t *n, uint32_t n0inv, size_t nl) {
+    uint32_t t[RSA_MAX_LIMBS + 2] = {0};
+    uint32_t s[RSA_MAX_LIMBS];
+    uint32_t borrow = 0;
+
+    for (size_t i = 0; i < nl; i++) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < nl; j++) {
+            const uint64_t x = (uint64_t)a[j] * b[i] + t[j] + carry;
+            t[j] = (uint32_t)x;
+            carry = x >> 32;
+        }
+        uint64_t x = (uint64_t)t[nl] + carry;
+        t[nl] = (uint32_t)x;
+        t[nl + 1] = (uint32_t)(x >> 32);
+
+        const uint32_t m = t[0] * n0inv;
+        x = (uint64_t)m * n[0] + t[0];
+        carry = x >> 32;
+        for (size_t j = 1; j < nl; j++) {
+            x = (uint64_t)m * n[j] + t[j] + carry;
+            t[j - 1] = (uint32_t)x;
+            carry = x >> 32;
+        }
+        x = (uint64_t)t[nl] + carry;
+        t[nl - 1] = (uint32_t)x;
+        t[nl] = t[nl + 1] + (uint32_t)(x >> 32);
+    }
+
+    /* Subtract n if t >= n, selecting the result with a mask. */
+    for (size_t j = 0; j < nl; j++) {
+        const uint64_t x = (uint64_t)t[j] - n[j] - borrow;
+        s[j] = (uint32_t)x;
+        borrow = (uint32_t)(x >> 63);
+    }
+    /* Keep t if it was smaller than n: no high limb and a final borrow. */
+    const uint32_t keep_t = (uint32_t)0 - (borrow & (uint32_t)(t[nl] == 0));
+    for (size_t j = 0; j < nl; j++) {
+        r[j] = (t[j] & keep_t) | (s[j] & ~keep_t);
+    }
+}
+
+/* _rsa_private computes m^d mod n with a fixed sequence of operations for
+ * every bit of d. */
+static void _rsa_private(uint32_t *out, const uint32_t *m, const _bn_t *d, const _bn_t *n, size_t nl) {
+    uint32_t r2[RSA_MAX_LIMBS] = {0};
+    uint32_t acc[RSA_MAX_LIMBS], base[RSA_MAX_LIMBS], prod[RSA_MAX_LIMBS];
+    uint32_t one[RSA_MAX_LIMBS] = {0};
+    uint32_t n0inv = 1;
+
+    /* n0inv = -n^-1 mod 2^32 by Newton's iteration. n is odd. */
+    for (int i = 0; i < 5; i++) {
+        n0inv *= 2u - n->v[0] * n0inv;
+    }
+    n0inv = (uint32_t)0 - n0inv;
+
+    /* R^2 mod n, by doubling 1 modulo n. n is public, so this may branch. */
+    r2[0] = 1;
+    for (size_t i = 0; i < 2 * 32 * nl; i++) {
+        uint32_t carry = 0;
+        for (size_t j = 0; j < nl; j++) {
+            const uint32_t next = r2[j] >> 31;
+            r2[j] = (r2[j] << 1) | carry;
+            carry = next;
+        }
+        bool ge = carry != 0;
+        if (!ge) {
+            ge = true;
+            for (size_t j = nl; j-- > 0;) {
+                if (r2[j] != n->v[j]) {
+                    ge = r2[j] > n->v[j];
+                    break;
+                }
+            }
+        }
+        if (ge) {
+            uint32_t borrow = 0;
+            for (size_t j = 0; j < nl; j++) {
+                const uint64_t x = (uint64_t)r2[j] - n->v[j] - borrow;
+                r2[j] = (uint32_t)x;
+                borrow = (uint32_t)(x >> 63);
+            }
+        }
+    }
+
+    one[0] = 1;
+    _mont_mul(base, m, r2, n->v, n0inv, nl);
+    _mont_mul(acc, one, r2, n->v, n0inv, nl);
+    for (size_t i = 32 * nl; i-- > 0;) {
+        const uint32_t bit = (d->v[i / 32] >> (i % 32)) & 1u;
+        const uint32_t mask = (uint32_t)0 - bit;
+
+        _mont_mul(acc, acc, acc, n->v, n0inv, nl);
+        _mont_mul(prod, acc, base, n->v, n0inv, nl);
+        for (size_t j = 0; j < nl; j++) {
+            acc[j] = (prod[j] & mask) | (acc[j] & ~mask);
+        }
+    }
+    _mont_mul(out, acc, one, n->v, n0inv, nl);
+
+    _secure_zero(acc, sizeof(acc));
+    _secure_zero(prod, sizeof(prod));
+}
+
+bool _builtin_crypto_sign_rsaes_pkcs1_v1_5(const _mongocrypt_buffer_t *key,
+                                           const _mongocrypt_buffer_t *in,
+                                           _mongocrypt_buffer_t *out,
+                                           mongocrypt_status_t *status) {
+    /* DER encoding of the DigestInfo prefix for SHA-256 (RFC 8017 9.2). */
+    static const uint8_t sha256_prefix[] = {0x30, 0x31, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+                                            0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x04, 0x20};
+    _bn_t n, d, m;
+    size_t n_len;
+    uint32_t s[RSA_MAX_LIMBS];
+    uint8_t em[RSA_MAX_LIMBS * 4];
+    bool ret = false;
+
+    BSON_ASSERT_PARAM(key);
+    BSON_ASSERT_PARAM(in);
+    BSON_ASSERT_PARAM(out);
+
+    if (!_parse_rsa_private_key(key->data, key->len, &n, &n_len, &d)) {
+        CLIENT_ERR("failed to parse RSA private key");
+        goto done;
+    }
+    if ((n.v[0] & 1u) == 0 || n_len < sizeof(sha256_prefix) + MC_SHA256_LEN + 11) {
+        CLIENT_ERR("invalid RSA modulus");
+        goto done;
+    }
+    if (out->len != n_len) {
+        CLIENT_ERR("out does not contain %zu bytes", n_len);
+        goto done;
+    }
+
+    /* EM = 0x00 || 0x01 || 0xff... || 0x00 || DigestInfo. */
+    memset(em, 0xff, n_len);
+    em[0] = 0x00;
+    em[1] = 0x01;
+    em[n_len - sizeof(sha256_prefix) - MC_SHA256_LEN - 1] = 0x00;
+    memcpy(em + n_len - sizeof(sha256_prefix) - MC_SHA256_LEN, sha256_prefix, sizeof(sha256_prefix));
+    mc_sha256(in->data, in->len, em + n_len - MC_SHA256_LEN);
+
+    const size_t nl = (n_len + 3) / 4;
+    memset(&m, 0, sizeof(m));
+    for (size_t i = 0; i < n_len; i++) {
+        const size_t bit = 8 * (n_len - 1 - i);
+        m.v[bit / 32] |= (uint32_t)em[i] << (bit % 32);
+    }
+    _rsa_private(s, m.v, &d, &n, nl);
+    for (size_t i = 0; i < n_len; i++) {
+        const size_t bit = 8 * (n_len - 1 - i);
+        out->data[i] = (uint8_t)(s[bit / 32] >> (bit % 32));
+    }
+    ret = true;
+
+done:
+    _secure_zero(&d, sizeof(d));
+    _secure_zero(s, sizeof(s));
+    return ret;
+}
+
+#endif /* MONGOCRYPT_ENABLE_CRYPTO_BUILTIN */
@@ -20,6 +20,7 @@
 #include <bson/bson.h>
 
 #include "mc-array-private.h"
+#include "mc-tokens-private.h"
 #include "mongocrypt-buffer-private.h"
 #include "mongocrypt-private.h"
 #include "mongocrypt.h"
@@ -62,16 +63,16 @@
  */
 
 typedef struct {
-    _mongocrypt_buffer_t edcDerivedToken;            // d
-    _mongocrypt_buffer_t escDerivedToken;            // s
-    _mongocrypt_buffer_t encryptedTokens;            // p
-    _mongocrypt_buffer_t indexKeyId;                 // u
-    bson_type_t valueType;                           // t
-    _mongocrypt_buffer_t value;                      // v
-    _mongocrypt_buffer_t serverEncryptionToken;      // e
-    _mongocrypt_buffer_t serverDerivedFromDataToken; // l
-    int64_t contentionFactor;                        // k
-    mc_array_t edgeTokenSetArray;                    // g
+    mc_EDCDerivedFromDataTokenAndCounterValue_t edcDerivedToken;     // d
+    mc_ESCDerivedFromDataTokenAndCounterValue_t escDerivedToken;     // s
+    _mongocrypt_buffer_t encryptedTokens;                            // p
+    _mongocrypt_buffer_t indexKeyId;                                 // u
+    bson_type_t valueType;                                           // t
+    _mongocrypt_buffer_t value;                                      // v
+    mc_ServerDataEncryptionLevel1TokenValue_t serverEncryptionToken; // e
+    mc_ServerDerivedFromDataTokenValue_t serverDerivedFromDataToken; // l
+    int64_t contentionFactor;                                        // k
+    mc_array_t edgeTokenSetArray;                                    // g
     _mongocrypt_buffer_t plaintext;
     _mongocrypt_buffer_t userKeyId;
 } mc_FLE2InsertUpdatePayloadV2_t;
@@ -88,14 +89,17 @@ typedef struct {
  * mc_FLE2InsertUpdatePayloadV2_cleanup.
  */
 typedef struct {
-    _mongocrypt_buffer_t edcDerivedToken;            // d
-    _mongocrypt_buffer_t escDerivedToken;            // s
-    _mongocrypt_buffer_t serverDerivedFromDataToken; // l
-    _mongocrypt_buffer_t encryptedTokens;            // p
+    mc_EDCDerivedFromDataTokenAndCounterValue_t edcDerivedToken;     // d
+    mc_ESCDerivedFromDataTokenAndCounterValue_t escDerivedToken;     // s
+    mc_ServerDerivedFromDataTokenValue_t serverDerivedFromDataToken; // l
+    _mongocrypt_buffer_t encryptedTokens;                            // p
 } mc_EdgeTokenSetV2_t;
 
 void mc_FLE2InsertUpdatePayloadV2_init(mc_FLE2InsertUpdatePayloadV2_t *payload);
 
+/* mc_FLE2InsertUpdatePayloadV2_parse parses @in into @out. The 32 byte tokens
+ * are copied into @out. Other fields are not copied, so @in must outlive @out.
+ * Returns false and sets @status on error. */
 bool mc_FLE2InsertUpdatePayloadV2_parse(mc_FLE2InsertUpdatePayloadV2_t *out,
                                         const _mongocrypt_buffer_t *in,
                                         mongocrypt_status_t *status);
@@ -112,6 +116,22 @@ bool mc_FLE2InsertUpdatePayloadV2_serialize(const mc_FLE2InsertUpdatePayloadV2_t
 
 bool mc_FLE2InsertUpdatePayloadV2_serializeForRange(const mc_FLE2InsertUpdatePayloadV2_t *payload, bson_t *out);
 
+/* mc_FLE2InsertUpdatePayloadV2_serializeWithSubtype serializes @payload as the
+ * full BSON binary subtype 6 payload: the MC_SUBTYPE_FLE2InsertUpdatePayloadV2
+ * byte followed by the document mc_FLE2InsertUpdatePayloadV2_serialize builds.
+ * The size is computed first and @out is allocated once. Returns false and sets
+ * @status on error. */
+bool mc_FLE2InsertUpdatePayloadV2_serializeWithSubtype(const mc_FLE2InsertUpdatePayloadV2_t *payload,
+                                                       _mongocrypt_buffer_t *out,
+                                                       mongocrypt_status_t *status);
+
+/* mc_FLE2InsertUpdatePayloadV2_serializeForRangeWithSubtype is
+ * mc_FLE2InsertUpdatePayloadV2_serializeWithSubtype with the "g" array of
+ * mc_FLE2InsertUpdatePayloadV2_serializeForRange. */
+bool mc_FLE2InsertUpdatePayloadV2_serializeForRangeWithSubtype(const mc_FLE2InsertUpdatePayloadV2_t *payload,
+                                                               _mongocrypt_buffer_t *out,
+                                                               mongocrypt_status_t *status);
+
 void mc_FLE2InsertUpdatePayloadV2_cleanup(mc_FLE2InsertUpdatePayloadV2_t *payload);
 
 #endif /* MC_FLE2_INSERT_UPDATE_PAYLOAD_PRIVATE_V2_H */
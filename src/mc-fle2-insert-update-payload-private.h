@@ -95,6 +95,8 @@ typedef struct {
 
 void mc_FLE2InsertUpdatePayload_init(mc_FLE2InsertUpdatePayload_t *payload);
 
+/* mc_FLE2InsertUpdatePayload_parse parses @in into @out without copying.
+ * @in must outlive @out. Returns false and sets @status on error. */
 bool mc_FLE2InsertUpdatePayload_parse(mc_FLE2InsertUpdatePayload_t *out,
                                       const _mongocrypt_buffer_t *in,
                                       mongocrypt_status_t *status);
@@ -16,7 +16,9 @@
 
 #include <bson/bson.h>
 
+#include "mc-fle-blob-subtype-private.h"
 #include "mc-fle2-insert-update-payload-private-v2.h"
+#include "mc-writer-private.h"
 #include "mongocrypt-buffer-private.h"
 #include "mongocrypt.h"
 
@@ -30,27 +32,26 @@ void mc_FLE2InsertUpdatePayloadV2_init(mc_FLE2InsertUpdatePayloadV2_t *payload)
 static void mc_EdgeTokenSetV2_cleanup(mc_EdgeTokenSetV2_t *etc) {
     BSON_ASSERT_PARAM(etc);
 
-    _mongocrypt_buffer_cleanup(&etc->edcDerivedToken);
-    _mongocrypt_buffer_cleanup(&etc->escDerivedToken);
-    _mongocrypt_buffer_cleanup(&etc->serverDerivedFromDataToken);
+    mc_EDCDerivedFromDataTokenAndCounterValue_cleanup(&etc->edcDerivedToken);
+    mc_ESCDerivedFromDataTokenAndCounterValue_cleanup(&etc->escDerivedToken);
+    mc_ServerDerivedFromDataTokenValue_cleanup(&etc->serverDerivedFromDataToken);
     _mongocrypt_buffer_cleanup(&etc->encryptedTokens);
 }
 
 void mc_FLE2InsertUpdatePayloadV2_cleanup(mc_FLE2InsertUpdatePayloadV2_t *payload) {
     BSON_ASSERT_PARAM(payload);
 
-    _mongocrypt_buffer_cleanup(&payload->edcDerivedToken);
-    _mongocrypt_buffer_cleanup(&payload->escDerivedToken);
+    mc_EDCDerivedFromDataTokenAndCounterValue_cleanup(&payload->edcDerivedToken);
+    mc_ESCDerivedFromDataTokenAndCounterValue_cleanup(&payload->escDerivedToken);
     _mongocrypt_buffer_cleanup(&payload->encryptedTokens);
     _mongocrypt_buffer_cleanup(&payload->indexKeyId);
     _mongocrypt_buffer_cleanup(&payload->value);
-    _mongocrypt_buffer_cleanup(&payload->serverEncryptionToken);
-    _mongocrypt_buffer_cleanup(&payload->serverDerivedFromDataToken);
+    mc_ServerDataEncryptionLevel1TokenValue_cleanup(&payload->serverEncryptionToken);
+    mc_ServerDerivedFromDataTokenValue_cleanup(&payload->serverDerivedFromDataToken);
     _mongocrypt_buffer_cleanup(&payload->plaintext);
     // Free all EdgeTokenSet entries.
     for (size_t i = 0; i < payload->edgeTokenSetArray.len; i++) {
-        mc_EdgeTokenSetV2_t entry = _mc_array_index(&payload->edgeTokenSetArray, mc_EdgeTokenSetV2_t, i);
-        mc_EdgeTokenSetV2_cleanup(&entry);
+        mc_EdgeTokenSetV2_cleanup(&_mc_array_index(&payload->edgeTokenSetArray, mc_EdgeTokenSetV2_t, i));
     }
     _mc_array_destroy(&payload->edgeTokenSetArray);
 }
@@ -81,7 +82,7 @@ void mc_FLE2InsertUpdatePayloadV2_cleanup(mc_FLE2InsertUpdatePayloadV2_t *payloa
             CLIENT_ERR("Field '" #Name "' expected to be bindata subtype %d, got: %d", Type, subtype);                 \
             goto fail;                                                                                                 \
         }                                                                                                              \
-        if (!_mongocrypt_buffer_copy_from_binary_iter(&out->Dest, &iter)) {                                            \
+        if (!_mongocrypt_buffer_from_binary_iter(&out->Dest, &iter)) {                                                 \
             CLIENT_ERR("Unable to create mongocrypt buffer for BSON binary "                                           \
                        "field in '" #Name "'");                                                                        \
             goto fail;                                                                                                 \
@@ -91,6 +92,34 @@ void mc_FLE2InsertUpdatePayloadV2_cleanup(mc_FLE2InsertUpdatePayloadV2_t *payloa
 
 #define PARSE_BINARY(Name, Dest) PARSE_BINDATA(Name, BSON_SUBTYPE_BINARY, Dest)
 
+// Parse a 32 byte token of the value type with the given prefix.
+#define PARSE_TOKEN(Name, Prefix, Dest)                                                                                \
+    IF_FIELD(Name) {                                                                                                   \
+        _mongocrypt_buffer_t buf;                                                                                      \
+        if (!BSON_ITER_HOLDS_BINARY(&iter)) {                                                                          \
+            CLIENT_ERR("Field '" #Name "' expected to be bindata, got: %d", bson_iter_type(&iter));                    \
+            goto fail;                                                                                                 \
+        }                                                                                                              \
+        if (!_mongocrypt_buffer_from_binary_iter(&buf, &iter)) {                                                       \
+            CLIENT_ERR("Unable to create mongocrypt buffer for BSON binary "                                           \
+                       "field in '" #Name "'");                                                                        \
+            goto fail;                                                                                                 \
+        }                                                                                                              \
+        if (buf.subtype != BSON_SUBTYPE_BINARY) {                                                                      \
+            CLIENT_ERR("Field '" #Name "' expected to be bindata subtype %d, got: %d",                                 \
+                       BSON_SUBTYPE_BINARY,                                                                            \
+                       buf.subtype);                                                                                   \
+            goto fail;                                                                                                 \
+        }                                                                                                              \
+        if (!CONCAT(Prefix, _init_from_buffer)(&out->Dest, &buf)) {                                                    \
+            CLIENT_ERR("Field '" #Name "' expected to be %d bytes, got: %" PRIu32,                                     \
+                       MONGOCRYPT_HMAC_SHA256_LEN,                                                                     \
+                       buf.len);                                                                                       \
+            goto fail;                                                                                                 \
+        }                                                                                                              \
+    }                                                                                                                  \
+    END_IF_FIELD
+
 #define CHECK_HAS(Name)                                                                                                \
     if (!has_##Name) {                                                                                                 \
         CLIENT_ERR("Missing field '" #Name "' in payload");                                                            \
@@ -128,8 +157,8 @@ bool mc_FLE2InsertUpdatePayloadV2_parse(mc_FLE2InsertUpdatePayloadV2_t *out,
         const char *field = bson_iter_key(&iter);
         BSON_ASSERT(field);
 
-        PARSE_BINARY(d, edcDerivedToken)
-        PARSE_BINARY(s, escDerivedToken)
+        PARSE_TOKEN(d, mc_EDCDerivedFromDataTokenAndCounterValue, edcDerivedToken)
+        PARSE_TOKEN(s, mc_ESCDerivedFromDataTokenAndCounterValue, escDerivedToken)
         PARSE_BINARY(p, encryptedTokens)
         PARSE_BINDATA(u, BSON_SUBTYPE_UUID, indexKeyId)
         IF_FIELD(t) {
@@ -161,8 +190,8 @@ bool mc_FLE2InsertUpdatePayloadV2_parse(mc_FLE2InsertUpdatePayloadV2_t *out,
         END_IF_FIELD
 
         PARSE_BINARY(v, value)
-        PARSE_BINARY(e, serverEncryptionToken)
-        PARSE_BINARY(l, serverDerivedFromDataToken)
+        PARSE_TOKEN(e, mc_ServerDataEncryptionLevel1TokenValue, serverEncryptionToken)
+        PARSE_TOKEN(l, mc_ServerDerivedFromDataTokenValue, serverDerivedFromDataToken)
     }
 
     CHECK_HAS(d);
@@ -196,16 +225,21 @@ bool mc_FLE2InsertUpdatePayloadV2_serialize(const mc_FLE2InsertUpdatePayloadV2_t
     BSON_ASSERT_PARAM(out);
     BSON_ASSERT_PARAM(payload);
 
-    IUPS_APPEND_BINDATA(out, "d", BSON_SUBTYPE_BINARY, payload->edcDerivedToken);
-    IUPS_APPEND_BINDATA(out, "s", BSON_SUBTYPE_BINARY, payload->escDerivedToken);
+    const _mongocrypt_buffer_t d = mc_EDCDerivedFromDataTokenAndCounterValue_get(&payload->edcDerivedToken);
+    const _mongocrypt_buffer_t s = mc_ESCDerivedFromDataTokenAndCounterValue_get(&payload->escDerivedToken);
+    const _mongocrypt_buffer_t e = mc_ServerDataEncryptionLevel1TokenValue_get(&payload->serverEncryptionToken);
+    const _mongocrypt_buffer_t l = mc_ServerDerivedFromDataTokenValue_get(&payload->serverDerivedFromDataToken);
+
+    IUPS_APPEND_BINDATA(out, "d", BSON_SUBTYPE_BINARY, d);
+    IUPS_APPEND_BINDATA(out, "s", BSON_SUBTYPE_BINARY, s);
     IUPS_APPEND_BINDATA(out, "p", BSON_SUBTYPE_BINARY, payload->encryptedTokens);
     IUPS_APPEND_BINDATA(out, "u", BSON_SUBTYPE_UUID, payload->indexKeyId);
     if (!BSON_APPEND_INT32(out, "t", payload->valueType)) {
         return false;
     }
     IUPS_APPEND_BINDATA(out, "v", BSON_SUBTYPE_BINARY, payload->value);
-    IUPS_APPEND_BINDATA(out, "e", BSON_SUBTYPE_BINARY, payload->serverEncryptionToken);
-    IUPS_APPEND_BINDATA(out, "l", BSON_SUBTYPE_BINARY, payload->serverDerivedFromDataToken);
+    IUPS_APPEND_BINDATA(out, "e", BSON_SUBTYPE_BINARY, e);
+    IUPS_APPEND_BINDATA(out, "l", BSON_SUBTYPE_BINARY, l);
     if (!BSON_APPEND_INT64(out, "k", payload->contentionFactor)) {
         return false;
     }
@@ -228,7 +262,10 @@ bool mc_FLE2InsertUpdatePayloadV2_serializeForRange(const mc_FLE2InsertUpdatePay
 
     uint32_t g_index = 0;
     for (size_t i = 0; i < payload->edgeTokenSetArray.len; i++) {
-        mc_EdgeTokenSetV2_t etc = _mc_array_index(&payload->edgeTokenSetArray, mc_EdgeTokenSetV2_t, i);
+        const mc_EdgeTokenSetV2_t *etc = &_mc_array_index(&payload->edgeTokenSetArray, mc_EdgeTokenSetV2_t, i);
+        const _mongocrypt_buffer_t d = mc_EDCDerivedFromDataTokenAndCounterValue_get(&etc->edcDerivedToken);
+        const _mongocrypt_buffer_t s = mc_ESCDerivedFromDataTokenAndCounterValue_get(&etc->escDerivedToken);
+        const _mongocrypt_buffer_t l = mc_ServerDerivedFromDataTokenValue_get(&etc->serverDerivedFromDataToken);
         bson_t etc_bson;
 
         const char *g_index_string;
@@ -239,10 +276,10 @@ bool mc_FLE2InsertUpdatePayloadV2_serializeForRange(const mc_FLE2InsertUpdatePay
             return false;
         }
 
-        IUPS_APPEND_BINDATA(&etc_bson, "d", BSON_SUBTYPE_BINARY, etc.edcDerivedToken);
-        IUPS_APPEND_BINDATA(&etc_bson, "s", BSON_SUBTYPE_BINARY, etc.escDerivedToken);
-        IUPS_APPEND_BINDATA(&etc_bson, "l", BSON_SUBTYPE_BINARY, etc.serverDerivedFromDataToken);
-        IUPS_APPEND_BINDATA(&etc_bson, "p", BSON_SUBTYPE_BINARY, etc.encryptedTokens);
+        IUPS_APPEND_BINDATA(&etc_bson, "d", BSON_SUBTYPE_BINARY, d);
+        IUPS_APPEND_BINDATA(&etc_bson, "s", BSON_SUBTYPE_BINARY, s);
+        IUPS_APPEND_BINDATA(&etc_bson, "l", BSON_SUBTYPE_BINARY, l);
+        IUPS_APPEND_BINDATA(&etc_bson, "p", BSON_SUBTYPE_BINARY, etc->encryptedTokens);
 
         if (!bson_append_document_end(&g_bson, &etc_bson)) {
             return false;
@@ -262,6 +299,177 @@ bool mc_FLE2InsertUpdatePayloadV2_serializeForRange(const mc_FLE2InsertUpdatePay
 
 #undef IUPS_APPEND_BINDATA
 
+#define CHECK_AND_RETURN(x)                                                                                            \
+    if (!(x)) {                                                                                                        \
+        return false;                                                                                                  \
+    }
+
+// Sizes of BSON elements with a key of length `key_len`.
+#define IUPS_BINDATA_LEN(key_len, len) (1u + (key_len) + 1u + sizeof(uint32_t) + 1u + (uint64_t)(len))
+#define IUPS_BINARY_LEN(key_len, value) IUPS_BINDATA_LEN(key_len, (value).len)
+#define IUPS_TOKEN_LEN(key_len) IUPS_BINDATA_LEN(key_len, MONGOCRYPT_HMAC_SHA256_LEN)
+#define IUPS_INT32_LEN(key_len) (1u + (key_len) + 1u + sizeof(int32_t))
+#define IUPS_INT64_LEN(key_len) (1u + (key_len) + 1u + sizeof(int64_t))
+// An empty document is a length prefix and a trailing NUL.
+#define IUPS_EMPTY_DOCUMENT_LEN (sizeof(int32_t) + 1u)
+
+static uint64_t _mc_EdgeTokenSetV2_len(const mc_EdgeTokenSetV2_t *etc) {
+    BSON_ASSERT_PARAM(etc);
+
+    return IUPS_EMPTY_DOCUMENT_LEN + IUPS_TOKEN_LEN(1u) + IUPS_TOKEN_LEN(1u) + IUPS_TOKEN_LEN(1u)
+         + IUPS_BINARY_LEN(1u, etc->encryptedTokens);
+}
+
+static bool _iups_write_key(mc_writer_t *writer,
+                            bson_type_t type,
+                            const char *key,
+                            size_t key_len,
+                            mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(writer);
+    BSON_ASSERT_PARAM(key);
+    BSON_ASSERT(key_len < UINT32_MAX);
+
+    _mongocrypt_buffer_t key_buf;
+    _mongocrypt_buffer_init(&key_buf);
+    key_buf.data = (uint8_t *)key;
+    // Include the NUL terminator.
+    key_buf.len = (uint32_t)key_len + 1u;
+
+    CHECK_AND_RETURN(mc_writer_write_u8(writer, (uint8_t)type, status));
+    CHECK_AND_RETURN(mc_writer_write_buffer(writer, &key_buf, key_buf.len, status));
+    return true;
+}
+
+static bool _iups_write_binary(mc_writer_t *writer,
+                               const char *key,
+                               const _mongocrypt_buffer_t *value,
+                               mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(writer);
+    BSON_ASSERT_PARAM(key);
+    BSON_ASSERT_PARAM(value);
+
+    if (value->subtype == BSON_SUBTYPE_BINARY_DEPRECATED) {
+        // bson_append_binary nests another length prefix for subtype 2.
+        CLIENT_ERR("%s cannot write field '%s' with binary subtype 2", writer->parser_name, key);
+        return false;
+    }
+
+    CHECK_AND_RETURN(_iups_write_key(writer, BSON_TYPE_BINARY, key, strlen(key), status));
+    CHECK_AND_RETURN(mc_writer_write_u32(writer, value->len, status));
+    CHECK_AND_RETURN(mc_writer_write_u8(writer, (uint8_t)value->subtype, status));
+    if (value->len > 0) {
+        CHECK_AND_RETURN(mc_writer_write_buffer(writer, value, value->len, status));
+    }
+    return true;
+}
+
+static bool _mc_FLE2InsertUpdatePayloadV2_serializeWithSubtype(const mc_FLE2InsertUpdatePayloadV2_t *payload,
+                                                               bool for_range,
+                                                               _mongocrypt_buffer_t *out,
+                                                               mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(payload);
+    BSON_ASSERT_PARAM(out);
+
+    const mc_array_t *etcs = &payload->edgeTokenSetArray;
+    if (etcs->len > UINT32_MAX) {
+        CLIENT_ERR("too many edge token sets: %zu", etcs->len);
+        return false;
+    }
+
+    // Size the document first so the output is allocated once.
+    uint64_t g_len = IUPS_EMPTY_DOCUMENT_LEN;
+    if (for_range) {
+        for (uint32_t i = 0; i < (uint32_t)etcs->len; i++) {
+            const char *key;
+            char storage[16];
+            size_t key_len = bson_uint32_to_string(i, &key, storage, sizeof(storage));
+            const mc_EdgeTokenSetV2_t *etc = &_mc_array_index(etcs, mc_EdgeTokenSetV2_t, i);
+            g_len += 1u + key_len + 1u + _mc_EdgeTokenSetV2_len(etc);
+        }
+    }
+
+    uint64_t doc_len = IUPS_EMPTY_DOCUMENT_LEN + IUPS_TOKEN_LEN(1u) + IUPS_TOKEN_LEN(1u)
+                     + IUPS_BINARY_LEN(1u, payload->encryptedTokens) + IUPS_BINARY_LEN(1u, payload->indexKeyId)
+                     + IUPS_INT32_LEN(1u) + IUPS_BINARY_LEN(1u, payload->value) + IUPS_TOKEN_LEN(1u)
+                     + IUPS_TOKEN_LEN(1u) + IUPS_INT64_LEN(1u);
+    if (for_range) {
+        doc_len += 1u + 1u + 1u + g_len;
+    }
+    if (doc_len > (uint64_t)INT32_MAX) {
+        CLIENT_ERR("FLE2InsertUpdatePayloadV2 length %" PRIu64 " exceeds maximum BSON document size", doc_len);
+        return false;
+    }
+
+    const _mongocrypt_buffer_t d = mc_EDCDerivedFromDataTokenAndCounterValue_get(&payload->edcDerivedToken);
+    const _mongocrypt_buffer_t s = mc_ESCDerivedFromDataTokenAndCounterValue_get(&payload->escDerivedToken);
+    const _mongocrypt_buffer_t e = mc_ServerDataEncryptionLevel1TokenValue_get(&payload->serverEncryptionToken);
+    const _mongocrypt_buffer_t l = mc_ServerDerivedFromDataTokenValue_get(&payload->serverDerivedFromDataToken);
+
+    _mongocrypt_buffer_init_size(out, 1u + (uint32_t)doc_len);
+    mc_writer_t writer;
+    mc_writer_init_from_buffer(&writer, out, __FUNCTION__);
+
+    CHECK_AND_RETURN(mc_writer_write_u8(&writer, MC_SUBTYPE_FLE2InsertUpdatePayloadV2, status));
+    CHECK_AND_RETURN(mc_writer_write_u32(&writer, (uint32_t)doc_len, status));
+    CHECK_AND_RETURN(_iups_write_binary(&writer, "d", &d, status));
+    CHECK_AND_RETURN(_iups_write_binary(&writer, "s", &s, status));
+    CHECK_AND_RETURN(_iups_write_binary(&writer, "p", &payload->encryptedTokens, status));
+    CHECK_AND_RETURN(_iups_write_binary(&writer, "u", &payload->indexKeyId, status));
+    CHECK_AND_RETURN(_iups_write_key(&writer, BSON_TYPE_INT32, "t", 1u, status));
+    CHECK_AND_RETURN(mc_writer_write_u32(&writer, (uint32_t)payload->valueType, status));
+    CHECK_AND_RETURN(_iups_write_binary(&writer, "v", &payload->value, status));
+    CHECK_AND_RETURN(_iups_write_binary(&writer, "e", &e, status));
+    CHECK_AND_RETURN(_iups_write_binary(&writer, "l", &l, status));
+    CHECK_AND_RETURN(_iups_write_key(&writer, BSON_TYPE_INT64, "k", 1u, status));
+    CHECK_AND_RETURN(mc_writer_write_u64(&writer, (uint64_t)payload->contentionFactor, status));
+
+    if (for_range) {
+        CHECK_AND_RETURN(_iups_write_key(&writer, BSON_TYPE_ARRAY, "g", 1u, status));
+        CHECK_AND_RETURN(mc_writer_write_u32(&writer, (uint32_t)g_len, status));
+        for (uint32_t i = 0; i < (uint32_t)etcs->len; i++) {
+            const char *key;
+            char storage[16];
+            size_t key_len = bson_uint32_to_string(i, &key, storage, sizeof(storage));
+            const mc_EdgeTokenSetV2_t *etc = &_mc_array_index(etcs, mc_EdgeTokenSetV2_t, i);
+            const _mongocrypt_buffer_t etc_d = mc_EDCDerivedFromDataTokenAndCounterValue_get(&etc->edcDerivedToken);
+            const _mongocrypt_buffer_t etc_s = mc_ESCDerivedFromDataTokenAndCounterValue_get(&etc->escDerivedToken);
+            const _mongocrypt_buffer_t etc_l = mc_ServerDerivedFromDataTokenValue_get(&etc->serverDerivedFromDataToken);
+
+            CHECK_AND_RETURN(_iups_write_key(&writer, BSON_TYPE_DOCUMENT, key, key_len, status));
+            CHECK_AND_RETURN(mc_writer_write_u32(&writer, (uint32_t)_mc_EdgeTokenSetV2_len(etc), status));
+            CHECK_AND_RETURN(_iups_write_binary(&writer, "d", &etc_d, status));
+            CHECK_AND_RETURN(_iups_write_binary(&writer, "s", &etc_s, status));
+            CHECK_AND_RETURN(_iups_write_binary(&writer, "l", &etc_l, status));
+            CHECK_AND_RETURN(_iups_write_binary(&writer, "p", &etc->encryptedTokens, status));
+            CHECK_AND_RETURN(mc_writer_write_u8(&writer, 0, status));
+        }
+        CHECK_AND_RETURN(mc_writer_write_u8(&writer, 0, status));
+    }
+
+    CHECK_AND_RETURN(mc_writer_write_u8(&writer, 0, status));
+    BSON_ASSERT(writer.pos == writer.len);
+    return true;
+}
+
+bool mc_FLE2InsertUpdatePayloadV2_serializeWithSubtype(const mc_FLE2InsertUpdatePayloadV2_t *payload,
+                                                       _mongocrypt_buffer_t *out,
+                                                       mongocrypt_status_t *status) {
+    return _mc_FLE2InsertUpdatePayloadV2_serializeWithSubtype(payload, false, out, status);
+}
+
+bool mc_FLE2InsertUpdatePayloadV2_serializeForRangeWithSubtype(const mc_FLE2InsertUpdatePayloadV2_t *payload,
+                                                               _mongocrypt_buffer_t *out,
+                                                               mongocrypt_status_t *status) {
+    return _mc_FLE2InsertUpdatePayloadV2_serializeWithSubtype(payload, true, out, status);
+}
+
+#undef IUPS_EMPTY_DOCUMENT_LEN
+#undef IUPS_INT64_LEN
+#undef IUPS_INT32_LEN
+#undef IUPS_TOKEN_LEN
+#undef IUPS_BINARY_LEN
+#undef IUPS_BINDATA_LEN
+
 const _mongocrypt_buffer_t *mc_FLE2InsertUpdatePayloadV2_decrypt(_mongocrypt_crypto_t *crypto,
                                                                  mc_FLE2InsertUpdatePayloadV2_t *iup,
                                                                  const _mongocrypt_buffer_t *user_key,
@@ -81,7 +81,7 @@ void mc_FLE2InsertUpdatePayload_cleanup(mc_FLE2InsertUpdatePayload_t *payload) {
             CLIENT_ERR("Field '" #Name "' expected to be bindata subtype %d, got: %d", Type, subtype);                 \
             goto fail;                                                                                                 \
         }                                                                                                              \
-        if (!_mongocrypt_buffer_copy_from_binary_iter(&out->Dest, &iter)) {                                            \
+        if (!_mongocrypt_buffer_from_binary_iter(&out->Dest, &iter)) {                                                 \
             CLIENT_ERR("Unable to create mongocrypt buffer for BSON binary "                                           \
                        "field in '" #Name "'");                                                                        \
             goto fail;                                                                                                 \
@@ -43,6 +43,8 @@ typedef struct _mc_FLE2IndexedEncryptedValueV2_t mc_FLE2IndexedEncryptedValueV2_
 
 mc_FLE2IndexedEncryptedValueV2_t *mc_FLE2IndexedEncryptedValueV2_new(void);
 
+/* mc_FLE2IndexedEncryptedValueV2_parse parses @buf into @iev without copying.
+ * @buf must outlive @iev. Returns false and sets @status on error. */
 bool mc_FLE2IndexedEncryptedValueV2_parse(mc_FLE2IndexedEncryptedValueV2_t *iev,
                                           const _mongocrypt_buffer_t *buf,
                                           mongocrypt_status_t *status);
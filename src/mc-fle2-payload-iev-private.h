@@ -106,6 +106,8 @@ bool mc_FLE2IndexedEqualityEncryptedValueTokens_init_from_buffer(mc_FLE2IndexedE
                                                                  _mongocrypt_buffer_t *buf,
                                                                  mongocrypt_status_t *status);
 
+/* mc_FLE2IndexedEncryptedValue_parse parses @buf into @iev without copying.
+ * @buf must outlive @iev. Returns false and sets @status on error. */
 bool mc_FLE2IndexedEncryptedValue_parse(mc_FLE2IndexedEncryptedValue_t *iev,
                                         const _mongocrypt_buffer_t *buf,
                                         mongocrypt_status_t *status);
@@ -354,7 +354,7 @@ bool mc_FLE2IndexedEqualityEncryptedValueV2_parse(mc_FLE2IndexedEncryptedValueV2
     }
 
     /* Read S_KeyId. */
-    CHECK_AND_RETURN(mc_reader_read_uuid_buffer(&reader, &iev->S_KeyId, status));
+    CHECK_AND_RETURN(mc_reader_borrow_uuid_buffer(&reader, &iev->S_KeyId, status));
 
     /* Read original_bson_type. */
     CHECK_AND_RETURN(mc_reader_read_u8(&reader, &iev->bson_value_type, status));
@@ -368,7 +368,7 @@ bool mc_FLE2IndexedEqualityEncryptedValueV2_parse(mc_FLE2IndexedEncryptedValueV2
         return false;
     }
     const uint64_t SEV_len = SEV_and_metadata_len - kMetadataLen;
-    CHECK_AND_RETURN(mc_reader_read_buffer(&reader, &iev->ServerEncryptedValue, SEV_len, status));
+    CHECK_AND_RETURN(mc_reader_borrow_buffer(&reader, &iev->ServerEncryptedValue, SEV_len, status));
 
     // Ignore Metadata block.
     BSON_ASSERT(mc_reader_get_remaining_length(&reader) == kMetadataLen);
@@ -406,7 +406,7 @@ bool mc_FLE2IndexedRangeEncryptedValueV2_parse(mc_FLE2IndexedEncryptedValueV2_t
     }
 
     /* Read S_KeyId. */
-    CHECK_AND_RETURN(mc_reader_read_uuid_buffer(&reader, &iev->S_KeyId, status));
+    CHECK_AND_RETURN(mc_reader_borrow_uuid_buffer(&reader, &iev->S_KeyId, status));
 
     /* Read original_bson_type. */
     CHECK_AND_RETURN(mc_reader_read_u8(&reader, &iev->bson_value_type, status));
@@ -427,7 +427,7 @@ bool mc_FLE2IndexedRangeEncryptedValueV2_parse(mc_FLE2IndexedEncryptedValueV2_t
         return false;
     }
     const uint64_t SEV_len = SEV_and_edges_len - edges_len;
-    CHECK_AND_RETURN(mc_reader_read_buffer(&reader, &iev->ServerEncryptedValue, SEV_len, status));
+    CHECK_AND_RETURN(mc_reader_borrow_buffer(&reader, &iev->ServerEncryptedValue, SEV_len, status));
 
     // Ignore Metadata block.
     BSON_ASSERT(mc_reader_get_remaining_length(&reader) == edges_len);
@@ -273,13 +273,13 @@ bool mc_FLE2IndexedEncryptedValue_parse(mc_FLE2IndexedEncryptedValue_t *iev,
     }
 
     /* Read S_KeyId. */
-    CHECK_AND_RETURN(mc_reader_read_uuid_buffer(&reader, &iev->S_KeyId, status));
+    CHECK_AND_RETURN(mc_reader_borrow_uuid_buffer(&reader, &iev->S_KeyId, status));
 
     /* Read original_bson_type. */
     CHECK_AND_RETURN(mc_reader_read_u8(&reader, &iev->original_bson_type, status));
 
     /* Read InnerEncrypted. */
-    CHECK_AND_RETURN(mc_reader_read_buffer_to_end(&reader, &iev->InnerEncrypted, status));
+    CHECK_AND_RETURN(mc_reader_borrow_buffer_to_end(&reader, &iev->InnerEncrypted, status));
 
     iev->parsed = true;
     return true;
@@ -393,7 +393,7 @@ static bool mc_FLE2IndexedEncryptedValue_decrypt(_mongocrypt_crypto_t *crypto,
     CHECK_AND_RETURN(mc_reader_read_u64(&reader, &length, status));
 
     /* Read K_KeyId. */
-    CHECK_AND_RETURN(mc_reader_read_uuid_buffer(&reader, &iev->K_KeyId, status));
+    CHECK_AND_RETURN(mc_reader_borrow_uuid_buffer(&reader, &iev->K_KeyId, status));
 
     /* Read ClientEncryptedValue. */
     uint64_t expected_length = mc_reader_get_consumed_length(&reader) + length - 16;
@@ -405,7 +405,7 @@ static bool mc_FLE2IndexedEncryptedValue_decrypt(_mongocrypt_crypto_t *crypto,
         return false;
     }
 
-    CHECK_AND_RETURN(mc_reader_read_buffer(&reader, &iev->ClientEncryptedValue, length - 16, status));
+    CHECK_AND_RETURN(mc_reader_borrow_buffer(&reader, &iev->ClientEncryptedValue, length - 16, status));
 
     // Caller has asked us to parse the other tokens
     if (indexed_tokens != NULL) {
@@ -25,9 +25,9 @@
 /**
  * Deserializes the data in @buf and assigns the parsed values to
  * to the output parameters.
- * Callers are expected to call _mongocrypt_buffer_init() on the
- * @key_uuid and @ciphertext output buffers prior to this call, and
- * call _mongocrypt_buffer_cleanup() afterwards.
+ * @key_uuid and @ciphertext are initialized as non-owning buffers into @buf,
+ * which must outlive them. Callers are expected to call
+ * _mongocrypt_buffer_cleanup() on them afterwards.
  * Returns false and sets @status on error.
  */
 bool _mc_FLE2UnindexedEncryptedValueCommon_parse(const _mongocrypt_buffer_t *buf,
@@ -42,14 +42,14 @@ bool _mc_FLE2UnindexedEncryptedValueCommon_parse(const _mongocrypt_buffer_t *buf
     CHECK_AND_RETURN(mc_reader_read_u8(&reader, fle_blob_subtype, status));
 
     /* Read key_uuid. */
-    CHECK_AND_RETURN(mc_reader_read_buffer(&reader, key_uuid, 16, status));
+    CHECK_AND_RETURN(mc_reader_borrow_buffer(&reader, key_uuid, 16, status));
     key_uuid->subtype = BSON_SUBTYPE_UUID;
 
     /* Read original_bson_type. */
     CHECK_AND_RETURN(mc_reader_read_u8(&reader, original_bson_type, status));
 
     /* Read ciphertext. */
-    CHECK_AND_RETURN(mc_reader_read_buffer(&reader, ciphertext, mc_reader_get_remaining_length(&reader), status));
+    CHECK_AND_RETURN(mc_reader_borrow_buffer(&reader, ciphertext, mc_reader_get_remaining_length(&reader), status));
 
     return true;
 }
@@ -45,6 +45,8 @@ typedef struct _mc_FLE2UnindexedEncryptedValue_t mc_FLE2UnindexedEncryptedValue_
 
 mc_FLE2UnindexedEncryptedValue_t *mc_FLE2UnindexedEncryptedValue_new(void);
 
+/* mc_FLE2UnindexedEncryptedValue_parse parses @buf into @uev without copying.
+ * @buf must outlive @uev. Returns false and sets @status on error. */
 bool mc_FLE2UnindexedEncryptedValue_parse(mc_FLE2UnindexedEncryptedValue_t *uev,
                                           const _mongocrypt_buffer_t *buf,
                                           mongocrypt_status_t *status);
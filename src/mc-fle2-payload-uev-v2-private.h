@@ -45,6 +45,8 @@ typedef struct _mc_FLE2UnindexedEncryptedValueV2_t mc_FLE2UnindexedEncryptedValu
 
 mc_FLE2UnindexedEncryptedValueV2_t *mc_FLE2UnindexedEncryptedValueV2_new(void);
 
+/* mc_FLE2UnindexedEncryptedValueV2_parse parses @buf into @uev without
+ * copying. @buf must outlive @uev. Returns false and sets @status on error. */
 bool mc_FLE2UnindexedEncryptedValueV2_parse(mc_FLE2UnindexedEncryptedValueV2_t *uev,
                                             const _mongocrypt_buffer_t *buf,
                                             mongocrypt_status_t *status);
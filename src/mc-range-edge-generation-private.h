@@ -19,6 +19,7 @@
 
 #include "mc-dec128.h"
 #include "mc-optional-private.h"
+#include "mc-range-encoding-private.h"
 #include "mongocrypt-status-private.h"
 #include <mlib/int128.h>
 #include <stddef.h> // size_t
@@ -65,6 +66,8 @@ typedef struct {
     mc_optional_double_t min;
     mc_optional_double_t max;
     mc_optional_uint32_t precision;
+    // If set, `min`, `max`, and `precision` are ignored and taken from `plan`.
+    const mc_RangePlanDouble_t *plan;
 } mc_getEdgesDouble_args_t;
 
 // mc_getEdgesDouble implements the Edge Generation algorithm described in
@@ -77,6 +80,8 @@ typedef struct {
     size_t sparsity;
     mc_optional_dec128_t min, max;
     mc_optional_uint32_t precision;
+    // If set, `min`, `max`, and `precision` are ignored and taken from `plan`.
+    const mc_RangePlanDecimal128_t *plan;
 } mc_getEdgesDecimal128_args_t;
 
 mc_edges_t *mc_getEdgesDecimal128(mc_getEdgesDecimal128_args_t args, mongocrypt_status_t *status);
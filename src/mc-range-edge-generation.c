@@ -163,13 +163,16 @@ mc_edges_t *mc_getEdgesInt64(mc_getEdgesInt64_args_t args, mongocrypt_status_t *
 }
 
 mc_edges_t *mc_getEdgesDouble(mc_getEdgesDouble_args_t args, mongocrypt_status_t *status) {
+    mc_RangePlanDouble_t plan;
+    if (!args.plan) {
+        if (!mc_RangePlanDouble_init(&plan, args.min, args.max, args.precision, status)) {
+            return NULL;
+        }
+        args.plan = &plan;
+    }
+
     mc_OSTType_Double got;
-    if (!mc_getTypeInfoDouble((mc_getTypeInfoDouble_args_t){.value = args.value,
-                                                            .min = args.min,
-                                                            .max = args.max,
-                                                            .precision = args.precision},
-                              &got,
-                              status)) {
+    if (!mc_getTypeInfoDoubleWithPlan(args.value, args.plan, &got, status)) {
         return NULL;
     }
 
@@ -187,16 +190,16 @@ mc_edges_t *mc_getEdgesDouble(mc_getEdgesDouble_args_t args, mongocrypt_status_t
 
 #if MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
 mc_edges_t *mc_getEdgesDecimal128(mc_getEdgesDecimal128_args_t args, mongocrypt_status_t *status) {
+    mc_RangePlanDecimal128_t plan;
+    if (!args.plan) {
+        if (!mc_RangePlanDecimal128_init(&plan, args.min, args.max, args.precision, status)) {
+            return NULL;
+        }
+        args.plan = &plan;
+    }
+
     mc_OSTType_Decimal128 got;
-    if (!mc_getTypeInfoDecimal128(
-            (mc_getTypeInfoDecimal128_args_t){
-                .value = args.value,
-                .min = args.min,
-                .max = args.max,
-                .precision = args.precision,
-            },
-            &got,
-            status)) {
+    if (!mc_getTypeInfoDecimal128WithPlan(args.value, args.plan, &got, status)) {
         return NULL;
     }
 
@@ -92,6 +92,37 @@ bool mc_getTypeInfoDouble(mc_getTypeInfoDouble_args_t args,
                           mc_OSTType_Double *out,
                           mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
 
+/* mc_RangePlanDouble_t holds what mc_getTypeInfoDouble derives from min, max,
+ * and precision. It depends only on a field's range options, so it can be built
+ * once per field and reused to encode every value of the field. */
+typedef struct {
+    mc_optional_double_t min;
+    mc_optional_double_t max;
+    mc_optional_uint32_t precision;
+    /* True if values are encoded as precision-truncated integers. The
+     * remaining members are only set in precision mode. */
+    bool use_precision_mode;
+    /* 10^precision */
+    double scale;
+    /* The OST maximum: 2^bits_range - 1 */
+    uint64_t max_value;
+} mc_RangePlanDouble_t;
+
+/* mc_RangePlanDouble_init validates `min`, `max`, and `precision` and builds a
+ * plan from them. Returns false and sets `status` on error. */
+bool mc_RangePlanDouble_init(mc_RangePlanDouble_t *plan,
+                             mc_optional_double_t min,
+                             mc_optional_double_t max,
+                             mc_optional_uint32_t precision,
+                             mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
+
+/* mc_getTypeInfoDoubleWithPlan is mc_getTypeInfoDouble with the range options
+ * of `plan`. */
+bool mc_getTypeInfoDoubleWithPlan(double value,
+                                  const mc_RangePlanDouble_t *plan,
+                                  mc_OSTType_Double *out,
+                                  mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
+
 #if MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
 /**
  * @brief OST-encoding of a Decimal128
@@ -117,6 +148,54 @@ typedef struct {
 bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
                               mc_OSTType_Decimal128 *out,
                               mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
+
+/* mc_dec128_parts_t is a finite Decimal128 with a canonical coefficient, split
+ * into sign, coefficient, and unbiased exponent. */
+typedef struct {
+    bool negative;
+    mlib_int128 coeff;
+    int32_t exp;
+} mc_dec128_parts_t;
+
+/* mc_RangePlanDecimal128_t holds what mc_getTypeInfoDecimal128 derives from
+ * min, max, and precision. Like mc_RangePlanDouble_t, it can be built once per
+ * field. */
+typedef struct {
+    mc_optional_dec128_t min;
+    mc_optional_dec128_t max;
+    mc_optional_uint32_t precision;
+    /* True if `min` and `max` are set and were decoded into `min_parts` and
+     * `max_parts`. Values can then be bounds-checked without DFP calls. */
+    bool bounds_decoded;
+    mc_dec128_parts_t min_parts;
+    mc_dec128_parts_t max_parts;
+    /* True if values are encoded as precision-truncated integers. The
+     * remaining members are only set in precision mode. */
+    bool use_precision_mode;
+    /* The number of bits required to hold an encoded value */
+    uint8_t bits_range;
+    /* The OST maximum: 2^bits_range - 1 */
+    mlib_int128 ost_max;
+    /* True if min×10^precision is an integer less than 10^34 in magnitude,
+     * stored in `min_scaled`. Values can then be encoded without DFP calls. */
+    bool min_scaled_exact;
+    mlib_int128 min_scaled;
+} mc_RangePlanDecimal128_t;
+
+/* mc_RangePlanDecimal128_init validates `min`, `max`, and `precision` and
+ * builds a plan from them. Returns false and sets `status` on error. */
+bool mc_RangePlanDecimal128_init(mc_RangePlanDecimal128_t *plan,
+                                 mc_optional_dec128_t min,
+                                 mc_optional_dec128_t max,
+                                 mc_optional_uint32_t precision,
+                                 mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
+
+/* mc_getTypeInfoDecimal128WithPlan is mc_getTypeInfoDecimal128 with the range
+ * options of `plan`. */
+bool mc_getTypeInfoDecimal128WithPlan(mc_dec128 value,
+                                      const mc_RangePlanDecimal128_t *plan,
+                                      mc_OSTType_Decimal128 *out,
+                                      mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
 #endif // MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
 
 #endif /* MC_RANGE_ENCODING_PRIVATE_H */
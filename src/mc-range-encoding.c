@@ -163,60 +163,42 @@ bool mc_getTypeInfo64(mc_getTypeInfo64_args_t args, mc_OSTType_Int64 *out, mongo
 
 #define exp10Double(x) pow(10, x)
 
-bool mc_getTypeInfoDouble(mc_getTypeInfoDouble_args_t args, mc_OSTType_Double *out, mongocrypt_status_t *status) {
-    if (args.min.set != args.max.set || args.min.set != args.precision.set) {
+bool mc_RangePlanDouble_init(mc_RangePlanDouble_t *plan,
+                             mc_optional_double_t min,
+                             mc_optional_double_t max,
+                             mc_optional_uint32_t precision,
+                             mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(plan);
+
+    *plan = (mc_RangePlanDouble_t){.min = min, .max = max, .precision = precision};
+
+    if (min.set != max.set || min.set != precision.set) {
         CLIENT_ERR("min, max, and precision must all be set or must all be unset");
         return false;
     }
 
-    if (mc_isinf(args.value) || mc_isnan(args.value)) {
-        CLIENT_ERR("Infinity and NaN double values are not supported.");
+    if (min.set && min.value >= max.value) {
+        CLIENT_ERR("The minimum value must be less than the maximum value, got "
+                   "min: %g, max: %g",
+                   min.value,
+                   max.value);
         return false;
     }
 
-    if (args.min.set) {
-        if (args.min.value >= args.max.value) {
-            CLIENT_ERR("The minimum value must be less than the maximum value, got "
-                       "min: %g, max: %g",
-                       args.min.value,
-                       args.max.value);
-            return false;
-        }
-
-        if (args.value > args.max.value || args.value < args.min.value) {
-            CLIENT_ERR("Value must be greater than or equal to the minimum value "
-                       "and less than or equal to the maximum value, got "
-                       "min: %g, max: %g, value: %g",
-                       args.min.value,
-                       args.max.value,
-                       args.value);
-            return false;
-        }
-    }
-
-    const bool is_neg = args.value < 0.0;
-
-    // Map negative 0 to zero so sign bit is 0.
-    if (args.value == 0.0) {
-        args.value = 0.0;
-    }
-
     // When we use precision mode, we try to represent as a double value that
     // fits in [-2^63, 2^63] (i.e. is a valid int64)
     //
     // This check determines if we can represent the precision truncated value as
     // a 64-bit integer I.e. Is ((ub - lb) * 10^precision) < 64 bits.
     //
-    bool use_precision_mode = false;
-    uint32_t bits_range;
-    if (args.precision.set) {
+    if (precision.set) {
         // Subnormal representations can support up to 5x10^-324 as a number
-        if (args.precision.value > 324) {
-            CLIENT_ERR("Precision must be between 0 and 324 inclusive, got: %" PRIu32, args.precision.value);
+        if (precision.value > 324) {
+            CLIENT_ERR("Precision must be between 0 and 324 inclusive, got: %" PRIu32, precision.value);
             return false;
         }
 
-        double range = args.max.value - args.min.value;
+        double range = max.value - min.value;
 
         // We can overflow if max = max double and min = min double so make sure
         // we have finite number after we do subtraction
@@ -225,35 +207,78 @@ bool mc_getTypeInfoDouble(mc_getTypeInfoDouble_args_t args, mc_OSTType_Double *o
             // This creates a range which is wider then we permit by our min/max
             // bounds check with the +1 but it is as the algorithm is written in
             // WRITING-11907.
-            double rangeAndPrecision = (range + 1) * exp10Double(args.precision.value);
+            const double scale = exp10Double(precision.value);
+            double rangeAndPrecision = (range + 1) * scale;
 
             if (mc_isfinite(rangeAndPrecision)) {
                 double bits_range_double = log2(rangeAndPrecision);
-                bits_range = (uint32_t)ceil(bits_range_double);
+                uint32_t bits_range = (uint32_t)ceil(bits_range_double);
 
                 if (bits_range < 64) {
-                    use_precision_mode = true;
+                    plan->use_precision_mode = true;
+                    plan->scale = scale;
+                    // The maximum value is the max bit range. This will be used
+                    // by getEdges/minCover to trim bits.
+                    plan->max_value = (UINT64_C(1) << bits_range) - 1;
                 }
             }
         }
     }
 
-    if (use_precision_mode) {
+    return true;
+}
+
+bool mc_getTypeInfoDouble(mc_getTypeInfoDouble_args_t args, mc_OSTType_Double *out, mongocrypt_status_t *status) {
+    mc_RangePlanDouble_t plan;
+    if (!mc_RangePlanDouble_init(&plan, args.min, args.max, args.precision, status)) {
+        return false;
+    }
+    return mc_getTypeInfoDoubleWithPlan(args.value, &plan, out, status);
+}
+
+bool mc_getTypeInfoDoubleWithPlan(double value,
+                                  const mc_RangePlanDouble_t *plan,
+                                  mc_OSTType_Double *out,
+                                  mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(plan);
+    BSON_ASSERT_PARAM(out);
+
+    if (mc_isinf(value) || mc_isnan(value)) {
+        CLIENT_ERR("Infinity and NaN double values are not supported.");
+        return false;
+    }
+
+    if (plan->min.set) {
+        if (value > plan->max.value || value < plan->min.value) {
+            CLIENT_ERR("Value must be greater than or equal to the minimum value "
+                       "and less than or equal to the maximum value, got "
+                       "min: %g, max: %g, value: %g",
+                       plan->min.value,
+                       plan->max.value,
+                       value);
+            return false;
+        }
+    }
+
+    const bool is_neg = value < 0.0;
+
+    // Map negative 0 to zero so sign bit is 0.
+    if (value == 0.0) {
+        value = 0.0;
+    }
+
+    if (plan->use_precision_mode) {
         // Take a number of xxxx.ppppp and truncate it xxxx.ppp if precision = 3.
         // We do not change the digits before the decimal place.
-        double v_prime = trunc(args.value * exp10Double(args.precision.value)) / exp10Double(args.precision.value);
-        int64_t v_prime2 = (int64_t)((v_prime - args.min.value) * exp10Double(args.precision.value));
+        double v_prime = trunc(value * plan->scale) / plan->scale;
+        int64_t v_prime2 = (int64_t)((v_prime - plan->min.value) * plan->scale);
 
         BSON_ASSERT(v_prime2 < INT64_MAX && v_prime2 >= 0);
 
         uint64_t ret = (uint64_t)v_prime2;
+        BSON_ASSERT(ret <= plan->max_value);
 
-        // Adjust maximum value to be the max bit range. This will be used by
-        // getEdges/minCover to trim bits.
-        uint64_t max_value = (UINT64_C(1) << bits_range) - 1;
-        BSON_ASSERT(ret <= max_value);
-
-        *out = (mc_OSTType_Double){ret, 0, max_value};
+        *out = (mc_OSTType_Double){ret, 0, plan->max_value};
         return true;
     }
 
@@ -265,7 +290,7 @@ bool mc_getTypeInfoDouble(mc_getTypeInfoDouble_args_t args, mc_OSTType_Double *o
     // When we translate the double into "bits", the sign bit means that the
     // negative numbers get mapped into the higher 63 bits of a 64-bit integer.
     // We want them to  map into the lower 64-bits so we invert the sign bit.
-    args.value *= -1.0;
+    value *= -1.0;
 
     // On Endianness, we support two sets of architectures
     // 1. Little Endian (ppc64le, x64, aarch64) - in these architectures, int64
@@ -277,7 +302,7 @@ bool mc_getTypeInfoDouble(mc_getTypeInfoDouble_args_t args, mc_OSTType_Double *o
     // itself, the conversion below converts a double into correct 64-bit integer
     // that produces the same behavior across plaforms.
     uint64_t uv;
-    memcpy(&uv, &args.value, sizeof(uint64_t));
+    memcpy(&uv, &value, sizeof(uint64_t));
 
     if (is_neg) {
         uint64_t new_zero = UINT64_C(1) << 63;
@@ -323,42 +348,132 @@ static mlib_int128 dec128_to_int128(mc_dec128 dec) {
     return ret;
 }
 
-bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
-                              mc_OSTType_Decimal128 *out,
-                              mongocrypt_status_t *status) {
-    /// Basic param checks
-    if (args.min.set != args.max.set || args.min.set != args.precision.set) {
-        CLIENT_ERR("min, max, and precision must all be set or must all be unset");
+// 10^34 - 1: The largest coefficient of a canonical Decimal128
+static mlib_int128 dec128_coeff_max(void) {
+    return mlib_int128_sub(mlib_int128_pow10(34), MLIB_INT128(1));
+}
+
+/**
+ * @brief Decode a Decimal128 by reading the BID fields directly.
+ *
+ * @return false for Infinity, NaN, and non-canonical encodings. Those are left
+ * to the DFP library.
+ */
+static bool dec128_decode(mc_dec128 dec, mc_dec128_parts_t *out) {
+    const uint32_t combo = mc_dec128_combination(dec);
+    if (combo >= MC_DEC128_COMBO_NONCANONICAL) {
         return false;
     }
-
-    // We only accept normal numbers
-    if (mc_dec128_is_inf(args.value) || mc_dec128_is_nan(args.value)) {
-        CLIENT_ERR("Infinity and Nan Decimal128 values are not supported.");
+    const mlib_int128 coeff = mc_dec128_coeff(dec);
+    if (mlib_int128_ucmp(coeff, dec128_coeff_max()) > 0) {
+        // DFP treats an out-of-range coefficient as zero.
         return false;
     }
+    out->negative = (dec._words[MLIB_IS_LITTLE_ENDIAN ? 1 : 0] >> 63) != 0;
+    out->coeff = coeff;
+    out->exp = (int32_t)(combo >> 3) - MC_DEC128_EXPONENT_BIAS;
+    return true;
+}
 
-    // Check boundary if a range is set
-    if (args.min.set) {
-        // [min,max] must be valid
-        if (mc_dec128_greater_equal(args.min.value, args.max.value)) {
-            CLIENT_ERR("The minimum value must be less than the maximum value, got "
-                       "min: %s, max: %s",
-                       mc_dec128_to_string(args.min.value).str,
-                       mc_dec128_to_string(args.max.value).str);
-            return false;
-        }
+// Compare |a| with |b|. Returns <0, 0, or >0.
+static int dec128_parts_cmp_magnitude(const mc_dec128_parts_t *a, const mc_dec128_parts_t *b) {
+    if (a->exp < b->exp) {
+        return -dec128_parts_cmp_magnitude(b, a);
+    }
+    const bool a_zero = mlib_int128_eq(a->coeff, MLIB_INT128(0));
+    const bool b_zero = mlib_int128_eq(b->coeff, MLIB_INT128(0));
+    if (a_zero || b_zero) {
+        return (int)!a_zero - (int)!b_zero;
+    }
+    // Bring `a` to the exponent of `b`. The coefficient of `b` is below 10^34,
+    // so if the scaled coefficient of `a` is not, `a` is greater.
+    const int32_t shift = a->exp - b->exp;
+    if (shift >= 34 || mlib_int128_ucmp(a->coeff, mlib_int128_pow10((uint8_t)(34 - shift))) >= 0) {
+        return 1;
+    }
+    return mlib_int128_ucmp(mlib_int128_mul(a->coeff, mlib_int128_pow10((uint8_t)shift)), b->coeff);
+}
 
-        // Value must be within [min,max)
-        if (mc_dec128_greater(args.value, args.max.value) || mc_dec128_less(args.value, args.min.value)) {
-            CLIENT_ERR("Value must be greater than or equal to the minimum value "
-                       "and less than or equal to the maximum value, got "
-                       "min: %s, max: %s, value: %s",
-                       mc_dec128_to_string(args.min.value).str,
-                       mc_dec128_to_string(args.max.value).str,
-                       mc_dec128_to_string(args.value).str);
+// Compare a with b, the same as the quiet DFP comparisons. Returns <0, 0, or >0.
+static int dec128_parts_cmp(const mc_dec128_parts_t *a, const mc_dec128_parts_t *b) {
+    // Zeros compare equal regardless of sign.
+    const int a_sign = mlib_int128_eq(a->coeff, MLIB_INT128(0)) ? 0 : (a->negative ? -1 : 1);
+    const int b_sign = mlib_int128_eq(b->coeff, MLIB_INT128(0)) ? 0 : (b->negative ? -1 : 1);
+    if (a_sign != b_sign) {
+        return a_sign < b_sign ? -1 : 1;
+    }
+    const int mag = dec128_parts_cmp_magnitude(a, b);
+    return a_sign < 0 ? -mag : mag;
+}
+
+/**
+ * @brief Compute trunc(value×10^p) - min×10^p with integer arithmetic.
+ *
+ * This is the result of the DFP steps of the precision mode encoding whenever
+ * each of those steps is exact. That holds if the truncated value and the
+ * result are below 10^34 in magnitude, since then every intermediate fits in
+ * the 34 digit coefficient of a Decimal128.
+ *
+ * @return false if the result could not be computed exactly. The caller falls
+ * back to DFP.
+ */
+static bool dec128_precision_encode_exact(const mc_dec128_parts_t *value,
+                                          const mc_RangePlanDecimal128_t *plan,
+                                          mlib_int128 *out) {
+    BSON_ASSERT(plan->min_scaled_exact);
+    const mlib_int128 coeff_max = dec128_coeff_max();
+    const int32_t shift = value->exp + (int32_t)plan->precision.value;
+    mlib_int128 trunc;
+    if (mlib_int128_eq(value->coeff, MLIB_INT128(0)) || shift <= -34) {
+        trunc = MLIB_INT128(0);
+    } else if (shift < 0) {
+        trunc = mlib_int128_div(value->coeff, mlib_int128_pow10((uint8_t)-shift));
+    } else if (shift < 34 && mlib_int128_ucmp(value->coeff, mlib_int128_pow10((uint8_t)(34 - shift))) < 0) {
+        trunc = mlib_int128_mul(value->coeff, mlib_int128_pow10((uint8_t)shift));
+    } else {
+        return false;
+    }
+    if (value->negative) {
+        if (mlib_int128_eq(trunc, MLIB_INT128(0))) {
+            // DFP carries the sign of a negative zero through the subtraction.
             return false;
         }
+        trunc = mlib_int128_negate(trunc);
+    }
+    const mlib_int128 ret = mlib_int128_sub(trunc, plan->min_scaled);
+    if (mlib_int128_scmp(ret, MLIB_INT128(0)) < 0 || mlib_int128_ucmp(ret, coeff_max) > 0) {
+        return false;
+    }
+    *out = ret;
+    return true;
+}
+
+bool mc_RangePlanDecimal128_init(mc_RangePlanDecimal128_t *plan,
+                                 mc_optional_dec128_t min,
+                                 mc_optional_dec128_t max,
+                                 mc_optional_uint32_t precision,
+                                 mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(plan);
+
+    *plan = (mc_RangePlanDecimal128_t){.min = min, .max = max, .precision = precision};
+
+    /// Basic param checks
+    if (min.set != max.set || min.set != precision.set) {
+        CLIENT_ERR("min, max, and precision must all be set or must all be unset");
+        return false;
+    }
+
+    // [min,max] must be valid
+    if (min.set && mc_dec128_greater_equal(min.value, max.value)) {
+        CLIENT_ERR("The minimum value must be less than the maximum value, got "
+                   "min: %s, max: %s",
+                   mc_dec128_to_string(min.value).str,
+                   mc_dec128_to_string(max.value).str);
+        return false;
+    }
+
+    if (min.set) {
+        plan->bounds_decoded = dec128_decode(min.value, &plan->min_parts) && dec128_decode(max.value, &plan->max_parts);
     }
 
     // Should we use precision mode?
@@ -373,18 +488,15 @@ bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
     // fit, regardless of the value to be encoded, because the encoding for
     // precision-truncated-decimal128 is incompatible with the encoding of the
     // full range.
-    bool use_precision_mode = false;
-    // The number of bits required to hold the result (used for precision mode)
-    uint8_t bits_range = 0;
-    if (args.precision.set) {
+    if (precision.set) {
         // Subnormal representations can support up to 5x10^-6182 as a number
-        if (args.precision.value > 6182) {
-            CLIENT_ERR("Precision must be between 0 and 6182 inclusive, got: %" PRIu32, args.precision.value);
+        if (precision.value > 6182) {
+            CLIENT_ERR("Precision must be between 0 and 6182 inclusive, got: %" PRIu32, precision.value);
             return false;
         }
 
         // max - min
-        mc_dec128 bounds_n1 = mc_dec128_sub(args.max.value, args.min.value);
+        mc_dec128 bounds_n1 = mc_dec128_sub(max.value, min.value);
         // The size of [min, max]: (max - min) + 1
         mc_dec128 bounds = mc_dec128_add(bounds_n1, MC_DEC128_ONE);
 
@@ -394,7 +506,7 @@ bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
             // This creates a range which is wider then we permit by our min/max
             // bounds check with the +1 but it is as the algorithm is written in
             // WRITING-11907.
-            mc_dec128 precision_scaled_bounds = mc_dec128_scale(bounds, args.precision.value);
+            mc_dec128 precision_scaled_bounds = mc_dec128_scale(bounds, precision.value);
             /// The number of bits required to hold the result for the given
             /// precision (as decimal)
             mc_dec128 bits_range_dec = mc_dec128_log2(precision_scaled_bounds);
@@ -407,15 +519,78 @@ bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
                 BSON_ASSERT(r >= 0);
                 BSON_ASSERT(r <= UINT8_MAX);
                 // We've computed the proper 'bits_range'
-                bits_range = (uint8_t)r;
-
-                if (bits_range < 128) {
-                    use_precision_mode = true;
+                plan->bits_range = (uint8_t)r;
+
+                if (plan->bits_range < 128) {
+                    plan->use_precision_mode = true;
+                    // Resulting OST maximum
+                    plan->ost_max = mlib_int128_sub(mlib_int128_pow2(plan->bits_range), MLIB_INT128(1));
+
+                    // If min×10^precision is a small enough integer, values
+                    // can be encoded with integer arithmetic.
+                    const mc_dec128_parts_t *mp = &plan->min_parts;
+                    const int32_t shift = plan->bounds_decoded ? mp->exp + (int32_t)precision.value : -1;
+                    if (shift >= 0 && shift < 34
+                        && mlib_int128_ucmp(mp->coeff, mlib_int128_pow10((uint8_t)(34 - shift))) < 0) {
+                        plan->min_scaled_exact = true;
+                        plan->min_scaled = mlib_int128_mul(mp->coeff, mlib_int128_pow10((uint8_t)shift));
+                        if (mp->negative) {
+                            plan->min_scaled = mlib_int128_negate(plan->min_scaled);
+                        }
+                    }
                 }
             }
         }
     }
 
+    return true;
+}
+
+bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
+                              mc_OSTType_Decimal128 *out,
+                              mongocrypt_status_t *status) {
+    mc_RangePlanDecimal128_t plan;
+    if (!mc_RangePlanDecimal128_init(&plan, args.min, args.max, args.precision, status)) {
+        return false;
+    }
+    return mc_getTypeInfoDecimal128WithPlan(args.value, &plan, out, status);
+}
+
+bool mc_getTypeInfoDecimal128WithPlan(mc_dec128 value,
+                                      const mc_RangePlanDecimal128_t *plan,
+                                      mc_OSTType_Decimal128 *out,
+                                      mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(plan);
+    BSON_ASSERT_PARAM(out);
+
+    // Most values can be decoded and encoded with integer arithmetic. DFP is
+    // only needed for the remaining cases.
+    mc_dec128_parts_t parts;
+    const bool decoded = dec128_decode(value, &parts);
+
+    // We only accept normal numbers
+    if (!decoded && (mc_dec128_is_inf(value) || mc_dec128_is_nan(value))) {
+        CLIENT_ERR("Infinity and Nan Decimal128 values are not supported.");
+        return false;
+    }
+
+    // Value must be within [min,max]
+    bool in_bounds = true;
+    if (decoded && plan->bounds_decoded) {
+        in_bounds = dec128_parts_cmp(&parts, &plan->max_parts) <= 0 && dec128_parts_cmp(&parts, &plan->min_parts) >= 0;
+    } else if (plan->min.set) {
+        in_bounds = !mc_dec128_greater(value, plan->max.value) && !mc_dec128_less(value, plan->min.value);
+    }
+    if (!in_bounds) {
+        CLIENT_ERR("Value must be greater than or equal to the minimum value "
+                   "and less than or equal to the maximum value, got "
+                   "min: %s, max: %s, value: %s",
+                   mc_dec128_to_string(plan->min.value).str,
+                   mc_dec128_to_string(plan->max.value).str,
+                   mc_dec128_to_string(value).str);
+        return false;
+    }
+
     // Constant zero
     const mlib_int128 i128_zero = MLIB_INT128(0);
     // Constant 1
@@ -427,14 +602,25 @@ bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
     // ↑ Coincidentally has the same bit pattern as INT128_SMIN, but we're
     // treating it as an unsigned number here, so don't get confused!
 
-    if (use_precision_mode) {
-        BSON_ASSERT(args.precision.set);
+    if (plan->use_precision_mode) {
+        BSON_ASSERT(plan->precision.set);
+
+        mlib_int128 exact;
+        if (decoded && plan->min_scaled_exact && dec128_precision_encode_exact(&parts, plan, &exact)) {
+            *out = (mc_OSTType_Decimal128){
+                .value = exact,
+                .min = i128_zero,
+                .max = plan->ost_max,
+            };
+            return true;
+        }
+
         // Example value: 31.4159
         // Example Precision = 2
 
         // Shift the number up
         // Returns: 3141.9
-        mc_dec128 valScaled = mc_dec128_scale(args.value, args.precision.value);
+        mc_dec128 valScaled = mc_dec128_scale(value, plan->precision.value);
 
         // Round the number down
         // Returns 3141.0
@@ -442,13 +628,13 @@ bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
 
         // Shift the number down
         // Returns: 31.41
-        mc_dec128 v_prime = mc_dec128_scale(valTrunc, -(int32_t)args.precision.value);
+        mc_dec128 v_prime = mc_dec128_scale(valTrunc, -(int32_t)plan->precision.value);
 
         // Adjust the number by the lower bound
         // Make it an integer by scaling the number
         //
         // Returns 3141.0
-        mc_dec128 v_prime2 = mc_dec128_scale(mc_dec128_sub(v_prime, args.min.value), args.precision.value);
+        mc_dec128 v_prime2 = mc_dec128_scale(mc_dec128_sub(v_prime, plan->min.value), plan->precision.value);
         // Round the number down again. min may have a fractional value with more
         // decimal places than the precision (e.g. .001). Subtracting min may have
         // resulted in v_prime2 with a non-zero fraction. v_prime2 is expected to
@@ -457,15 +643,12 @@ bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
 
         BSON_ASSERT(mc_dec128_less(mc_dec128_log2(v_prime2), MC_DEC128(128)));
 
-        // Resulting OST maximum
-        mlib_int128 ost_max = mlib_int128_sub(mlib_int128_pow2(bits_range), i128_one);
-
         // Now we need to get the Decimal128 out as a 128-bit integer
         // But Decimal128 does not support conversion to Int128.
         //
         // If we think the Decimal128 fits in the range, based on the maximum
         // value, we try to convert to int64 directly.
-        if (bits_range < 64) {
+        if (plan->bits_range < 64) {
             // Try conversion to int64, it may fail but since it is easy we try
             // this first.
             mc_dec128_flagset flags = {0};
@@ -475,7 +658,7 @@ bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
                 *out = (mc_OSTType_Decimal128){
                     .value = MLIB_INT128_CAST(as64),
                     .min = i128_zero,
-                    .max = ost_max,
+                    .max = plan->ost_max,
                 };
                 return true;
             } else {
@@ -489,14 +672,14 @@ bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
         *out = (mc_OSTType_Decimal128){
             .value = u_ret,
             .min = i128_zero,
-            .max = ost_max,
+            .max = plan->ost_max,
         };
 
         return true;
     }
 
     // The coefficient of the number, without exponent/sign
-    const mlib_int128 coeff = mc_dec128_coeff(args.value);
+    const mlib_int128 coeff = mc_dec128_coeff(value);
 
     if (mlib_int128_eq(coeff, i128_zero)) {
         // If the coefficient is zero, the result is encoded as the midpoint
@@ -511,7 +694,7 @@ bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
 
     // Coefficient is an unsigned value. We'll later scale our answer based on
     // the sign of the actual Decimal128
-    const bool isNegative = mc_dec128_is_negative(args.value);
+    const bool isNegative = decoded ? parts.negative : mc_dec128_is_negative(value);
 
     // cMax = 10^34 - 1 (The largest integer representable in Decimal128)
     const mlib_int128 cMax = mlib_int128_sub(mlib_int128_pow10(34), MLIB_INT128_CAST(1));
@@ -519,7 +702,7 @@ bool mc_getTypeInfoDecimal128(mc_getTypeInfoDecimal128_args_t args,
 
     // The biased exponent from the decimal number. The paper refers to the
     // expression (e - e_min), which is the value of the biased exponent.
-    const uint32_t exp_biased = mc_dec128_get_biased_exp(args.value);
+    const uint32_t exp_biased = mc_dec128_get_biased_exp(value);
 
     // ρ (rho) is the greatest integer such that: coeff×10^ρ <= cMax
     unsigned rho = 0;
@@ -19,6 +19,7 @@
 
 #include "mc-dec128.h"
 #include "mc-optional-private.h"
+#include "mc-range-encoding-private.h"
 #include "mongocrypt-status-private.h"
 #include <stddef.h> // size_t
 #include <stdint.h>
@@ -75,6 +76,8 @@ typedef struct {
     mc_optional_double_t min;
     mc_optional_double_t max;
     mc_optional_uint32_t precision;
+    // If set, `min`, `max`, and `precision` are ignored and taken from `plan`.
+    const mc_RangePlanDouble_t *plan;
 } mc_getMincoverDouble_args_t;
 
 // mc_getMincoverDouble implements the Mincover Generation algorithm described
@@ -91,6 +94,8 @@ typedef struct {
     size_t sparsity;
     mc_optional_dec128_t min, max;
     mc_optional_uint32_t precision;
+    // If set, `min`, `max`, and `precision` are ignored and taken from `plan`.
+    const mc_RangePlanDecimal128_t *plan;
 } mc_getMincoverDecimal128_args_t;
 
 // mc_getMincoverDecimal128 implements the Mincover Generation algorithm
@@ -193,23 +193,26 @@ mc_mincover_t *mc_getMincoverInt64(mc_getMincoverInt64_args_t args, mongocrypt_s
 // in SERVER-68600 for double.
 mc_mincover_t *mc_getMincoverDouble(mc_getMincoverDouble_args_t args, mongocrypt_status_t *status) {
     BSON_ASSERT_PARAM(status);
+    if (args.plan) {
+        args.min = args.plan->min;
+        args.max = args.plan->max;
+    }
     CHECK_BOUNDS(args, "g", IDENTITY, LESSTHAN);
 
+    // Both bounds share one plan.
+    mc_RangePlanDouble_t plan;
+    if (!args.plan) {
+        if (!mc_RangePlanDouble_init(&plan, args.min, args.max, args.precision, status)) {
+            return NULL;
+        }
+        args.plan = &plan;
+    }
+
     mc_OSTType_Double a, b;
-    if (!mc_getTypeInfoDouble((mc_getTypeInfoDouble_args_t){.value = args.lowerBound,
-                                                            .min = args.min,
-                                                            .max = args.max,
-                                                            .precision = args.precision},
-                              &a,
-                              status)) {
+    if (!mc_getTypeInfoDoubleWithPlan(args.lowerBound, args.plan, &a, status)) {
         return NULL;
     }
-    if (!mc_getTypeInfoDouble((mc_getTypeInfoDouble_args_t){.value = args.upperBound,
-                                                            .min = args.min,
-                                                            .max = args.max,
-                                                            .precision = args.precision},
-                              &b,
-                              status)) {
+    if (!mc_getTypeInfoDoubleWithPlan(args.upperBound, args.plan, &b, status)) {
         return NULL;
     }
 
@@ -233,23 +236,26 @@ mc_mincover_t *mc_getMincoverDouble(mc_getMincoverDouble_args_t args, mongocrypt
 mc_mincover_t *mc_getMincoverDecimal128(mc_getMincoverDecimal128_args_t args, mongocrypt_status_t *status) {
     BSON_ASSERT_PARAM(status);
 #define ToString(Dec) (mc_dec128_to_string(Dec).str)
+    if (args.plan) {
+        args.min = args.plan->min;
+        args.max = args.plan->max;
+    }
     CHECK_BOUNDS(args, "s", ToString, mc_dec128_less);
 
+    // Both bounds share one plan.
+    mc_RangePlanDecimal128_t plan;
+    if (!args.plan) {
+        if (!mc_RangePlanDecimal128_init(&plan, args.min, args.max, args.precision, status)) {
+            return NULL;
+        }
+        args.plan = &plan;
+    }
+
     mc_OSTType_Decimal128 a, b;
-    if (!mc_getTypeInfoDecimal128((mc_getTypeInfoDecimal128_args_t){.value = args.lowerBound,
-                                                                    .min = args.min,
-                                                                    .max = args.max,
-                                                                    .precision = args.precision},
-                                  &a,
-                                  status)) {
+    if (!mc_getTypeInfoDecimal128WithPlan(args.lowerBound, args.plan, &a, status)) {
         return NULL;
     }
-    if (!mc_getTypeInfoDecimal128((mc_getTypeInfoDecimal128_args_t){.value = args.upperBound,
-                                                                    .min = args.min,
-                                                                    .max = args.max,
-                                                                    .precision = args.precision},
-                                  &b,
-                                  status)) {
+    if (!mc_getTypeInfoDecimal128WithPlan(args.upperBound, args.plan, &b, status)) {
         return NULL;
     }
 
@@ -92,4 +92,18 @@ bool mc_reader_read_prfblock_buffer(mc_reader_t *reader, _mongocrypt_buffer_t *b
 
 bool mc_reader_read_buffer_to_end(mc_reader_t *reader, _mongocrypt_buffer_t *buf, mongocrypt_status_t *status);
 
+/* The mc_reader_borrow_* functions read like their mc_reader_read_*
+ * counterparts, but do not copy. @buf is initialized as a non-owning buffer
+ * pointing into the data being read, which must outlive @buf. */
+bool mc_reader_borrow_buffer(mc_reader_t *reader,
+                             _mongocrypt_buffer_t *buf,
+                             uint64_t length,
+                             mongocrypt_status_t *status);
+
+bool mc_reader_borrow_uuid_buffer(mc_reader_t *reader, _mongocrypt_buffer_t *buf, mongocrypt_status_t *status);
+
+bool mc_reader_borrow_prfblock_buffer(mc_reader_t *reader, _mongocrypt_buffer_t *buf, mongocrypt_status_t *status);
+
+bool mc_reader_borrow_buffer_to_end(mc_reader_t *reader, _mongocrypt_buffer_t *buf, mongocrypt_status_t *status);
+
 #endif /* MONGOCRYPT_READER_PRIVATE_H */
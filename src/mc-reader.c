@@ -180,3 +180,56 @@ bool mc_reader_read_buffer_to_end(mc_reader_t *reader, _mongocrypt_buffer_t *buf
     uint64_t length = reader->len - reader->pos;
     return mc_reader_read_buffer(reader, buf, length, status);
 }
+
+bool mc_reader_borrow_buffer(mc_reader_t *reader,
+                             _mongocrypt_buffer_t *buf,
+                             uint64_t length,
+                             mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(reader);
+    BSON_ASSERT_PARAM(buf);
+
+    const uint8_t *ptr;
+    CHECK_AND_RETURN(mc_reader_read_bytes(reader, &ptr, length, status));
+
+    if (length > UINT32_MAX) {
+        CLIENT_ERR("%s failed to borrow "
+                   "data of length %" PRIu64,
+                   reader->parser_name,
+                   length);
+        return false;
+    }
+
+    _mongocrypt_buffer_init(buf);
+    buf->data = (uint8_t *)ptr;
+    buf->len = (uint32_t)length;
+
+    return true;
+}
+
+bool mc_reader_borrow_uuid_buffer(mc_reader_t *reader, _mongocrypt_buffer_t *buf, mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(reader);
+    BSON_ASSERT_PARAM(buf);
+
+    CHECK_AND_RETURN(mc_reader_borrow_buffer(reader, buf, 16, status));
+    buf->subtype = BSON_SUBTYPE_UUID;
+
+    return true;
+}
+
+bool mc_reader_borrow_prfblock_buffer(mc_reader_t *reader, _mongocrypt_buffer_t *buf, mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(reader);
+    BSON_ASSERT_PARAM(buf);
+
+    CHECK_AND_RETURN(mc_reader_borrow_buffer(reader, buf, 32, status));
+    buf->subtype = BSON_SUBTYPE_ENCRYPTED;
+
+    return true;
+}
+
+bool mc_reader_borrow_buffer_to_end(mc_reader_t *reader, _mongocrypt_buffer_t *buf, mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(reader);
+    BSON_ASSERT_PARAM(buf);
+
+    uint64_t length = reader->len - reader->pos;
+    return mc_reader_borrow_buffer(reader, buf, length, status);
+}
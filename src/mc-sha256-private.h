@@ -0,0 +1,81 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MC_SHA256_PRIVATE_H
+#define MC_SHA256_PRIVATE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define MC_SHA256_LEN 32
+#define MC_SHA256_BLOCK_LEN 64
+
+/* mc_sha256_impl_t selects a SHA-256 compression kernel. The multi-lane
+ * kernels hash several independent messages at once, one per SIMD lane. */
+typedef enum {
+    /* The widest kernel supported by the CPU. */
+    MC_SHA256_IMPL_AUTO,
+    /* One message at a time. Always supported. */
+    MC_SHA256_IMPL_SCALAR,
+    /* Four lanes with SSE2 on x86-64. */
+    MC_SHA256_IMPL_SSE2,
+    /* Four lanes with NEON on ARM64. */
+    MC_SHA256_IMPL_NEON,
+    /* Eight lanes with AVX2 on x86-64, if the CPU supports it. */
+    MC_SHA256_IMPL_AVX2,
+    /* One message at a time with the x86-64 SHA extensions, if the CPU
+     * supports them. */
+    MC_SHA256_IMPL_SHANI,
+} mc_sha256_impl_t;
+
+/* mc_hmac_sha256_job_t is one HMAC-SHA256 computation for
+ * mc_hmac_sha256_many. */
+typedef struct {
+    const uint8_t *key;
+    size_t key_len;
+    const uint8_t *in;
+    size_t in_len;
+    /* Receives MC_SHA256_LEN bytes. */
+    uint8_t *out;
+} mc_hmac_sha256_job_t;
+
+/* mc_sha256_impl_supported returns true if @impl can run on this CPU. */
+bool mc_sha256_impl_supported(mc_sha256_impl_t impl);
+
+/* mc_sha256_impl_resolve returns the kernel used for @impl. For
+ * MC_SHA256_IMPL_AUTO this is the widest supported kernel. */
+mc_sha256_impl_t mc_sha256_impl_resolve(mc_sha256_impl_t impl);
+
+/* mc_sha256_impl_single returns the fastest kernel for one message at a time:
+ * MC_SHA256_IMPL_SHANI if supported, otherwise MC_SHA256_IMPL_SCALAR. */
+mc_sha256_impl_t mc_sha256_impl_single(void);
+
+/* mc_sha256_impl_lanes returns the number of messages @impl hashes at once. */
+size_t mc_sha256_impl_lanes(mc_sha256_impl_t impl);
+
+/* mc_sha256_impl_name returns a name for @impl for logs and benchmarks. */
+const char *mc_sha256_impl_name(mc_sha256_impl_t impl);
+
+/* mc_sha256 computes the SHA-256 digest of @len bytes at @data. */
+void mc_sha256(const uint8_t *data, size_t len, uint8_t out[MC_SHA256_LEN]);
+
+/* mc_hmac_sha256_many computes every job in @jobs with @impl, which must be
+ * supported. Jobs with the same number of blocks are hashed together, so
+ * batches of similar-length inputs use all lanes. */
+void mc_hmac_sha256_many(mc_sha256_impl_t impl, const mc_hmac_sha256_job_t *jobs, size_t count);
+
+#endif /* MC_SHA256_PRIVATE_H */
@@ -0,0 +1,535 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mongocrypt-private.h"
+
+#include "mc-sha256-private.h"
+#include "mlib/thread.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MC_SHA256_HAVE_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && (defined(__clang__) || __GNUC__ >= 5)
+/* GCC and Clang can compile AVX2 and SHA extensions code in one function with
+ * the target attribute, and select it at runtime. */
+#define MC_SHA256_HAVE_AVX2
+#define MC_SHA256_HAVE_SHANI
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define MC_SHA256_HAVE_NEON
+#include <arm_neon.h>
+#endif
+
+#define MC_SHA256_MAX_LANES 8
+
+static const uint32_t _sha256_h0[8] =
+    {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+static const uint32_t _sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+/* The state and message words are stored transposed, with one column per
+ * lane, so each row loads into one vector. */
+typedef void (*_compress_fn)(uint32_t state[8][MC_SHA256_MAX_LANES], const uint32_t block[16][MC_SHA256_MAX_LANES]);
+
+/* MC_SHA256_DEFINE_COMPRESS defines one SHA-256 compression function over the
+ * vector type V. Every kernel shares this definition, so they only differ in
+ * the operations passed in. AndNot(x, y) computes ~x & y. */
+#define MC_SHA256_DEFINE_COMPRESS(Name, Attr, V, Load, Store, Set1, Add, Xor, And, Or, AndNot, Shr, Shl)           \
+    Attr static void Name(uint32_t state[8][MC_SHA256_MAX_LANES], const uint32_t block[16][MC_SHA256_MAX_LANES]) {    \
+        V w[16];                                                                                                       \
+        V a = Load(state[0]), b = Load(state[1]), c = Load(state[2]), d = Load(state[3]);                              \
+        V e = Load(state[4]), f = Load(state[5]), g = Load(state[6]), h = Load(state[7]);                              \
+        for (size_t t = 0; t < 64; t++) {                                                                              \
+            V wt;                                                                                                      \
+            if (t < 16) {                                                                                              \
+                wt = Load(block[t]);                                                                                   \
+            } else {                                                                                                   \
+                V w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];                                                        \
+                V s0 = Xor(Xor(Or(Shr(w15, 7), Shl(w15, 25)), Or(Shr(w15, 18), Shl(w15, 14))), Shr(w15, 3));          \
+                V s1 = Xor(Xor(Or(Shr(w2, 17), Shl(w2, 15)), Or(Shr(w2, 19), Shl(w2, 13))), Shr(w2, 10));             \
+                wt = Add(Add(w[t & 15], s0), Add(w[(t - 7) & 15], s1));                                                \
+            }                                                                                                          \
+            w[t & 15] = wt;                                                                                            \
+            V S1 = Xor(Xor(Or(Shr(e, 6), Shl(e, 26)), Or(Shr(e, 11), Shl(e, 21))), Or(Shr(e, 25), Shl(e, 7)));        \
+            V ch = Xor(And(e, f), AndNot(e, g));                                                                       \
+            V t1 = Add(Add(Add(h, S1), Add(ch, Set1(_sha256_k[t]))), wt);                                              \
+            V S0 = Xor(Xor(Or(Shr(a, 2), Shl(a, 30)), Or(Shr(a, 13), Shl(a, 19))), Or(Shr(a, 22), Shl(a, 10)));       \
+            V maj = Xor(Xor(And(a, b), And(a, c)), And(b, c));                                                         \
+            h = g;                                                                                                     \
+            g = f;                                                                                                     \
+            f = e;                                                                                                     \
+            e = Add(d, t1);                                                                                            \
+            d = c;                                                                                                     \
+            c = b;                                                                                                     \
+            b = a;                                                                                                     \
+            a = Add(t1, Add(S0, maj));                                                                                 \
+        }                                                                                                              \
+        Store(state[0], Add(Load(state[0]), a));                                                                       \
+        Store(state[1], Add(Load(state[1]), b));                                                                       \
+        Store(state[2], Add(Load(state[2]), c));                                                                       \
+        Store(state[3], Add(Load(state[3]), d));                                                                       \
+        Store(state[4], Add(Load(state[4]), e));                                                                       \
+        Store(state[5], Add(Load(state[5]), f));                                                                       \
+        Store(state[6], Add(Load(state[6]), g));                                                                       \
+        Store(state[7], Add(Load(state[7]), h));                                                                       \
+    }
+
+#define SCALAR_LOAD(p) (*(p))
+#define SCALAR_STORE(p, v) (*(p) = (v))
+#define SCALAR_SET1(x) (x)
+#define SCALAR_ADD(x, y) ((x) + (y))
+#define SCALAR_XOR(x, y) ((x) ^ (y))
+#define SCALAR_AND(x, y) ((x) & (y))
+#define SCALAR_OR(x, y) ((x) | (y))
+#define SCALAR_ANDNOT(x, y) (~(x) & (y))
+#define SCALAR_SHR(x, n) ((x) >> (n))
+#define SCALAR_SHL(x, n) ((x) << (n))
+
+MC_SHA256_DEFINE_COMPRESS(_compress_scalar,
+                          /* no attributes */,
+                          uint32_t,
+                          SCALAR_LOAD,
+                          SCALAR_STORE,
+                          SCALAR_SET1,
+                          SCALAR_ADD,
+                          SCALAR_XOR,
+                          SCALAR_AND,
+                          SCALAR_OR,
+                          SCALAR_ANDNOT,
+                          SCALAR_SHR,
+                          SCALAR_SHL)
+
+#ifdef MC_SHA256_HAVE_SSE2
+#define SSE2_LOAD(p) _mm_loadu_si128((const __m128i *)(const void *)(p))
+#define SSE2_STORE(p, v) _mm_storeu_si128((__m128i *)(void *)(p), (v))
+#define SSE2_SET1(x) _mm_set1_epi32((int)(x))
+
+MC_SHA256_DEFINE_COMPRESS(_compress_sse2,
+                          /* no attributes */,
+                          __m128i,
+                          SSE2_LOAD,
+                          SSE2_STORE,
+                          SSE2_SET1,
+                          _mm_add_epi32,
+                          _mm_xor_si128,
+                          _mm_and_si128,
+                          _mm_or_si128,
+                          _mm_andnot_si128,
+                          _mm_srli_epi32,
+                          _mm_slli_epi32)
+#endif
+
+#ifdef MC_SHA256_HAVE_AVX2
+#define AVX2_LOAD(p) _mm256_loadu_si256((const __m256i *)(const void *)(p))
+#define AVX2_STORE(p, v) _mm256_storeu_si256((__m256i *)(void *)(p), (v))
+#define AVX2_SET1(x) _mm256_set1_epi32((int)(x))
+
+MC_SHA256_DEFINE_COMPRESS(_compress_avx2,
+                          __attribute__((target("avx2"))),
+                          __m256i,
+                          AVX2_LOAD,
+                          AVX2_STORE,
+                          AVX2_SET1,
+                          _mm256_add_epi32,
+                          _mm256_xor_si256,
+                          _mm256_and_si256,
+                          _mm256_or_si256,
+                          _mm256_andnot_si256,
+                          _mm256_srli_epi32,
+                          _mm256_slli_epi32)
+#endif
+
+#ifdef MC_SHA256_HAVE_NEON
+#define NEON_ANDNOT(x, y) vbicq_u32((y), (x))
+
+MC_SHA256_DEFINE_COMPRESS(_compress_neon,
+                          /* no attributes */,
+                          uint32x4_t,
+                          vld1q_u32,
+                          vst1q_u32,
+                          vdupq_n_u32,
+                          vaddq_u32,
+                          veorq_u32,
+                          vandq_u32,
+                          vorrq_u32,
+                          NEON_ANDNOT,
+                          vshrq_n_u32,
+                          vshlq_n_u32)
+#endif
+
+#ifdef MC_SHA256_HAVE_SHANI
+/* _compress_shani compresses one block of lane 0 with the SHA extensions. The
+ * state is kept as ABEF and CDGH, the order the sha256rnds2 instruction
+ * expects. */
+__attribute__((target("sha,sse4.1"))) static void _compress_shani(uint32_t state[8][MC_SHA256_MAX_LANES],
+                                                                   const uint32_t block[16][MC_SHA256_MAX_LANES]) {
+    __m128i w[4];
+    __m128i tmp;
+    __m128i abef = _mm_set_epi32((int)state[0][0], (int)state[1][0], (int)state[4][0], (int)state[5][0]);
+    __m128i cdgh = _mm_set_epi32((int)state[2][0], (int)state[3][0], (int)state[6][0], (int)state[7][0]);
+    const __m128i abef_save = abef;
+    const __m128i cdgh_save = cdgh;
+
+    for (size_t j = 0; j < 16; j++) {
+        __m128i m;
+        if (j < 4) {
+            m = _mm_set_epi32((int)block[4 * j + 3][0],
+                              (int)block[4 * j + 2][0],
+                              (int)block[4 * j + 1][0],
+                              (int)block[4 * j][0]);
+        } else {
+            m = _mm_sha256msg1_epu32(w[j & 3], w[(j - 3) & 3]);
+            m = _mm_add_epi32(m, _mm_alignr_epi8(w[(j - 1) & 3], w[(j - 2) & 3], 4));
+            m = _mm_sha256msg2_epu32(m, w[(j - 1) & 3]);
+        }
+        w[j & 3] = m;
+        tmp = _mm_add_epi32(m, _mm_loadu_si128((const __m128i *)(const void *)&_sha256_k[4 * j]));
+        cdgh = _mm_sha256rnds2_epu32(cdgh, abef, tmp);
+        abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(tmp, 0x0E));
+    }
+    abef = _mm_add_epi32(abef, abef_save);
+    cdgh = _mm_add_epi32(cdgh, cdgh_save);
+
+    state[0][0] = (uint32_t)_mm_extract_epi32(abef, 3);
+    state[1][0] = (uint32_t)_mm_extract_epi32(abef, 2);
+    state[4][0] = (uint32_t)_mm_extract_epi32(abef, 1);
+    state[5][0] = (uint32_t)_mm_extract_epi32(abef, 0);
+    state[2][0] = (uint32_t)_mm_extract_epi32(cdgh, 3);
+    state[3][0] = (uint32_t)_mm_extract_epi32(cdgh, 2);
+    state[6][0] = (uint32_t)_mm_extract_epi32(cdgh, 1);
+    state[7][0] = (uint32_t)_mm_extract_epi32(cdgh, 0);
+}
+
+static bool _cpu_has_shani(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSE4_1)) {
+        return false;
+    }
+    /* __get_cpuid_count is only in GCC 7 and newer. Check the maximum leaf and
+     * use __cpuid_count instead. */
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return false;
+    }
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    /* CPUID.(EAX=7,ECX=0):EBX bit 29 reports the SHA extensions. */
+    return (ebx & (1u << 29)) != 0;
+}
+
+/* CPUID may trap under a hypervisor, so query it once. */
+static bool _shani_supported;
+
+static void _detect_shani(void) {
+    _shani_supported = _cpu_has_shani();
+}
+
+static bool _shani_usable(void) {
+    static mlib_once_flag flag = MLIB_ONCE_INITIALIZER;
+    mlib_call_once(&flag, _detect_shani);
+    return _shani_supported;
+}
+#endif
+
+/* _lane_t is one message hashed by one lane. The message is an optional
+ * 64-byte prefix followed by @in. HMAC uses the prefix for the padded key so
+ * the key and message are never copied into one buffer. */
+typedef struct {
+    const uint8_t *prefix;
+    const uint8_t *in;
+    size_t in_len;
+    size_t nblocks;
+    uint8_t *out;
+} _lane_t;
+
+static void _lane_init(_lane_t *lane, const uint8_t *prefix, const uint8_t *in, size_t in_len, uint8_t *out) {
+    BSON_ASSERT_PARAM(lane);
+
+    const size_t total = (prefix ? MC_SHA256_BLOCK_LEN : 0u) + in_len;
+    BSON_ASSERT(total <= SIZE_MAX / 8u - MC_SHA256_BLOCK_LEN);
+    lane->prefix = prefix;
+    lane->in = in;
+    lane->in_len = in_len;
+    /* Add one byte for the 0x80 terminator and eight for the bit length. */
+    lane->nblocks = (total + 9u + MC_SHA256_BLOCK_LEN - 1u) / MC_SHA256_BLOCK_LEN;
+    lane->out = out;
+}
+
+/* _lane_block writes block @index of the padded message of @lane. */
+static void _lane_block(const _lane_t *lane, size_t index, uint8_t block[MC_SHA256_BLOCK_LEN]) {
+    const size_t prefix_len = lane->prefix ? MC_SHA256_BLOCK_LEN : 0u;
+    const size_t total = prefix_len + lane->in_len;
+    const size_t start = index * MC_SHA256_BLOCK_LEN;
+
+    memset(block, 0, MC_SHA256_BLOCK_LEN);
+    if (start < prefix_len) {
+        memcpy(block, lane->prefix, MC_SHA256_BLOCK_LEN);
+    } else if (start < total) {
+        memcpy(block, lane->in + (start - prefix_len), BSON_MIN(total - start, (size_t)MC_SHA256_BLOCK_LEN));
+    }
+    if (total >= start && total - start < MC_SHA256_BLOCK_LEN) {
+        block[total - start] = 0x80;
+    }
+    if (index == lane->nblocks - 1u) {
+        const uint64_t bits = (uint64_t)total * 8u;
+        for (size_t i = 0; i < 8; i++) {
+            block[MC_SHA256_BLOCK_LEN - 1u - i] = (uint8_t)(bits >> (8u * i));
+        }
+    }
+}
+
+/* _hash_lanes hashes up to MC_SHA256_MAX_LANES messages in lockstep. A lane
+ * that runs out of blocks keeps compressing zeros, but its digest was already
+ * written after its last block. */
+static void _hash_lanes(_compress_fn compress, const _lane_t *lanes, size_t n) {
+    uint32_t state[8][MC_SHA256_MAX_LANES];
+    uint32_t words[16][MC_SHA256_MAX_LANES];
+    uint8_t block[MC_SHA256_BLOCK_LEN];
+    size_t nblocks = 0;
+
+    BSON_ASSERT(n <= MC_SHA256_MAX_LANES);
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t l = 0; l < MC_SHA256_MAX_LANES; l++) {
+            state[i][l] = _sha256_h0[i];
+        }
+    }
+    for (size_t l = 0; l < n; l++) {
+        nblocks = BSON_MAX(nblocks, lanes[l].nblocks);
+    }
+
+    memset(words, 0, sizeof(words));
+    for (size_t b = 0; b < nblocks; b++) {
+        for (size_t l = 0; l < n; l++) {
+            if (b >= lanes[l].nblocks) {
+                continue;
+            }
+            _lane_block(&lanes[l], b, block);
+            for (size_t t = 0; t < 16; t++) {
+                const uint8_t *p = block + 4u * t;
+                words[t][l] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+            }
+        }
+        compress(state, (const uint32_t(*)[MC_SHA256_MAX_LANES])words);
+        for (size_t l = 0; l < n; l++) {
+            if (b + 1u != lanes[l].nblocks) {
+                continue;
+            }
+            for (size_t i = 0; i < 8; i++) {
+                lanes[l].out[4u * i] = (uint8_t)(state[i][l] >> 24);
+                lanes[l].out[4u * i + 1u] = (uint8_t)(state[i][l] >> 16);
+                lanes[l].out[4u * i + 2u] = (uint8_t)(state[i][l] >> 8);
+                lanes[l].out[4u * i + 3u] = (uint8_t)state[i][l];
+            }
+        }
+    }
+
+    /* The blocks may hold padded HMAC keys. */
+    memset(block, 0, sizeof(block));
+    memset(words, 0, sizeof(words));
+    memset(state, 0, sizeof(state));
+}
+
+bool mc_sha256_impl_supported(mc_sha256_impl_t impl) {
+    switch (impl) {
+    case MC_SHA256_IMPL_AUTO:
+    case MC_SHA256_IMPL_SCALAR: return true;
+#ifdef MC_SHA256_HAVE_SSE2
+    case MC_SHA256_IMPL_SSE2: return true;
+#endif
+#ifdef MC_SHA256_HAVE_AVX2
+    case MC_SHA256_IMPL_AVX2: return __builtin_cpu_supports("avx2") != 0;
+#endif
+#ifdef MC_SHA256_HAVE_SHANI
+    case MC_SHA256_IMPL_SHANI: return _shani_usable();
+#endif
+#ifdef MC_SHA256_HAVE_NEON
+    case MC_SHA256_IMPL_NEON: return true;
+#endif
+    default: return false;
+    }
+}
+
+mc_sha256_impl_t mc_sha256_impl_resolve(mc_sha256_impl_t impl) {
+    if (impl != MC_SHA256_IMPL_AUTO) {
+        return impl;
+    }
+    if (mc_sha256_impl_supported(MC_SHA256_IMPL_AVX2)) {
+        return MC_SHA256_IMPL_AVX2;
+    }
+    if (mc_sha256_impl_supported(MC_SHA256_IMPL_SSE2)) {
+        return MC_SHA256_IMPL_SSE2;
+    }
+    if (mc_sha256_impl_supported(MC_SHA256_IMPL_NEON)) {
+        return MC_SHA256_IMPL_NEON;
+    }
+    return MC_SHA256_IMPL_SCALAR;
+}
+
+mc_sha256_impl_t mc_sha256_impl_single(void) {
+    return mc_sha256_impl_supported(MC_SHA256_IMPL_SHANI) ? MC_SHA256_IMPL_SHANI : MC_SHA256_IMPL_SCALAR;
+}
+
+size_t mc_sha256_impl_lanes(mc_sha256_impl_t impl) {
+    switch (mc_sha256_impl_resolve(impl)) {
+    case MC_SHA256_IMPL_SSE2:
+    case MC_SHA256_IMPL_NEON: return 4;
+    case MC_SHA256_IMPL_AVX2: return 8;
+    case MC_SHA256_IMPL_AUTO:
+    case MC_SHA256_IMPL_SCALAR:
+    case MC_SHA256_IMPL_SHANI:
+    default: return 1;
+    }
+}
+
+const char *mc_sha256_impl_name(mc_sha256_impl_t impl) {
+    switch (impl) {
+    case MC_SHA256_IMPL_AUTO: return "auto";
+    case MC_SHA256_IMPL_SCALAR: return "scalar";
+    case MC_SHA256_IMPL_SSE2: return "sse2";
+    case MC_SHA256_IMPL_NEON: return "neon";
+    case MC_SHA256_IMPL_AVX2: return "avx2";
+    case MC_SHA256_IMPL_SHANI: return "shani";
+    default: return "unknown";
+    }
+}
+
+static _compress_fn _impl_compress(mc_sha256_impl_t impl) {
+    switch (mc_sha256_impl_resolve(impl)) {
+#ifdef MC_SHA256_HAVE_SSE2
+    case MC_SHA256_IMPL_SSE2: return _compress_sse2;
+#endif
+#ifdef MC_SHA256_HAVE_AVX2
+    case MC_SHA256_IMPL_AVX2: return _compress_avx2;
+#endif
+#ifdef MC_SHA256_HAVE_SHANI
+    case MC_SHA256_IMPL_SHANI: return _compress_shani;
+#endif
+#ifdef MC_SHA256_HAVE_NEON
+    case MC_SHA256_IMPL_NEON: return _compress_neon;
+#endif
+    default: return _compress_scalar;
+    }
+}
+
+void mc_sha256(const uint8_t *data, size_t len, uint8_t out[MC_SHA256_LEN]) {
+    _lane_t lane;
+
+    BSON_ASSERT(data || len == 0);
+    BSON_ASSERT_PARAM(out);
+
+    _lane_init(&lane, NULL, data, len, out);
+    _hash_lanes(_impl_compress(mc_sha256_impl_single()), &lane, 1);
+}
+
+typedef struct {
+    size_t index;
+    size_t in_len;
+} _job_order_t;
+
+static int _job_order_cmp(const void *a, const void *b) {
+    const _job_order_t *x = a, *y = b;
+    if (x->in_len != y->in_len) {
+        return x->in_len < y->in_len ? -1 : 1;
+    }
+    return x->index < y->index ? -1 : (x->index > y->index ? 1 : 0);
+}
+
+/* _hmac_group computes up to one vector of HMAC jobs. */
+static void _hmac_group(_compress_fn compress, const mc_hmac_sha256_job_t *const *jobs, size_t n) {
+    uint8_t ipad[MC_SHA256_MAX_LANES][MC_SHA256_BLOCK_LEN];
+    uint8_t opad[MC_SHA256_MAX_LANES][MC_SHA256_BLOCK_LEN];
+    uint8_t inner[MC_SHA256_MAX_LANES][MC_SHA256_LEN];
+    _lane_t lanes[MC_SHA256_MAX_LANES] = {{0}};
+
+    BSON_ASSERT(n <= MC_SHA256_MAX_LANES);
+    if (n == 0) {
+        return;
+    }
+    for (size_t l = 0; l < n; l++) {
+        const mc_hmac_sha256_job_t *job = jobs[l];
+        uint8_t key[MC_SHA256_BLOCK_LEN] = {0};
+
+        BSON_ASSERT(job->key || job->key_len == 0);
+        BSON_ASSERT(job->in || job->in_len == 0);
+        BSON_ASSERT_PARAM(job->out);
+        if (job->key_len > MC_SHA256_BLOCK_LEN) {
+            mc_sha256(job->key, job->key_len, key);
+        } else if (job->key_len > 0) {
+            memcpy(key, job->key, job->key_len);
+        }
+        for (size_t i = 0; i < MC_SHA256_BLOCK_LEN; i++) {
+            ipad[l][i] = (uint8_t)(key[i] ^ 0x36);
+            opad[l][i] = (uint8_t)(key[i] ^ 0x5c);
+        }
+        memset(key, 0, sizeof(key));
+        _lane_init(&lanes[l], ipad[l], job->in, job->in_len, inner[l]);
+    }
+    _hash_lanes(compress, lanes, n);
+
+    for (size_t l = 0; l < n; l++) {
+        _lane_init(&lanes[l], opad[l], inner[l], MC_SHA256_LEN, jobs[l]->out);
+    }
+    _hash_lanes(compress, lanes, n);
+
+    memset(ipad, 0, sizeof(ipad));
+    memset(opad, 0, sizeof(opad));
+    memset(inner, 0, sizeof(inner));
+}
+
+void mc_hmac_sha256_many(mc_sha256_impl_t impl, const mc_hmac_sha256_job_t *jobs, size_t count) {
+    BSON_ASSERT(jobs || count == 0);
+    BSON_ASSERT(mc_sha256_impl_supported(impl));
+
+    const _compress_fn compress = _impl_compress(impl);
+    const size_t width = mc_sha256_impl_lanes(impl);
+    const mc_hmac_sha256_job_t *group[MC_SHA256_MAX_LANES];
+
+    if (count <= width) {
+        for (size_t i = 0; i < count; i++) {
+            group[i] = &jobs[i];
+        }
+        _hmac_group(compress, group, count);
+        return;
+    }
+
+    /* Hash jobs of similar length together so lanes finish together. */
+    BSON_ASSERT(count <= SIZE_MAX / sizeof(_job_order_t));
+    _job_order_t *order = bson_malloc(count * sizeof(_job_order_t));
+    for (size_t i = 0; i < count; i++) {
+        order[i].index = i;
+        order[i].in_len = jobs[i].in_len;
+    }
+    qsort(order, count, sizeof(_job_order_t), _job_order_cmp);
+
+    for (size_t i = 0; i < count; i += width) {
+        const size_t n = BSON_MIN(width, count - i);
+        for (size_t l = 0; l < n; l++) {
+            group[l] = &jobs[order[i + l].index];
+        }
+        _hmac_group(compress, group, n);
+    }
+    bson_free(order);
+}
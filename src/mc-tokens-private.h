@@ -118,7 +118,64 @@ DECL_TOKEN_TYPE(mc_ServerCountAndContentionFactorEncryptionToken,
                 const mc_ServerDerivedFromDataToken_t *serverDerivedFromDataToken);
 DECL_TOKEN_TYPE(mc_ServerZerosEncryptionToken, const mc_ServerDerivedFromDataToken_t *serverDerivedFromDataToken);
 
+/// Declare a value token type named 'NameValue_t' for the token type named
+/// 'Name', with initializer parameters given by the remaining arguments. A
+/// value token holds its 32 bytes inline and owns no heap memory, so it may be
+/// declared on the stack, embedded in other structs and copied by assignment.
+/// Each initializer also has the implicit first arguments 'NameValue_t* self,
+/// _mongocrypt_crypto_t* crypto' and a final argument 'mongocrypt_status_t*
+/// status'
+#define DECL_TOKEN_VALUE_TYPE(Name, ...)                                                                               \
+    DECL_TOKEN_VALUE_TYPE_1(CONCAT(Name, Value), CONCAT(Name, Value_t), __VA_ARGS__)
+
+#define DECL_TOKEN_VALUE_TYPE_1(Prefix, T, ...)                                                                        \
+    typedef struct {                                                                                                   \
+        uint8_t data[MONGOCRYPT_HMAC_SHA256_LEN];                                                                      \
+    } T;                                                                                                               \
+    /* Data-getter. Returns a non-owning view of the token data. */                                                    \
+    extern _mongocrypt_buffer_t CONCAT(Prefix, _get)(const T *t);                                                      \
+    /* Cleanup. Zeroes the token. */                                                                                   \
+    extern void CONCAT(Prefix, _cleanup)(T * t);                                                                       \
+    /* Initializer from a raw buffer. Returns false if @buf is not 32 bytes. */                                        \
+    extern bool CONCAT(Prefix, _init_from_buffer)(T * t, const _mongocrypt_buffer_t *buf);                             \
+    /* Initializer. Parameter list given as variadic args */                                                           \
+    extern bool CONCAT(Prefix, _init)(T * t, _mongocrypt_crypto_t * crypto, __VA_ARGS__, mongocrypt_status_t * status)
+
+DECL_TOKEN_VALUE_TYPE(mc_CollectionsLevel1Token, const _mongocrypt_buffer_t *RootKey);
+DECL_TOKEN_VALUE_TYPE(mc_ServerTokenDerivationLevel1Token, const _mongocrypt_buffer_t *RootKey);
+DECL_TOKEN_VALUE_TYPE(mc_ServerDataEncryptionLevel1Token, const _mongocrypt_buffer_t *RootKey);
+
+DECL_TOKEN_VALUE_TYPE(mc_EDCToken, const mc_CollectionsLevel1TokenValue_t *CollectionsLevel1Token);
+DECL_TOKEN_VALUE_TYPE(mc_ESCToken, const mc_CollectionsLevel1TokenValue_t *CollectionsLevel1Token);
+DECL_TOKEN_VALUE_TYPE(mc_ECCToken, const mc_CollectionsLevel1TokenValue_t *CollectionsLevel1Token);
+DECL_TOKEN_VALUE_TYPE(mc_ECOCToken, const mc_CollectionsLevel1TokenValue_t *CollectionsLevel1Token);
+
+DECL_TOKEN_VALUE_TYPE(mc_EDCDerivedFromDataToken, const mc_EDCTokenValue_t *EDCToken, const _mongocrypt_buffer_t *v);
+DECL_TOKEN_VALUE_TYPE(mc_ECCDerivedFromDataToken, const mc_ECCTokenValue_t *ECCToken, const _mongocrypt_buffer_t *v);
+DECL_TOKEN_VALUE_TYPE(mc_ESCDerivedFromDataToken, const mc_ESCTokenValue_t *ESCToken, const _mongocrypt_buffer_t *v);
+
+DECL_TOKEN_VALUE_TYPE(mc_EDCDerivedFromDataTokenAndCounter,
+                      const mc_EDCDerivedFromDataTokenValue_t *EDCDerivedFromDataToken,
+                      uint64_t u);
+DECL_TOKEN_VALUE_TYPE(mc_ESCDerivedFromDataTokenAndCounter,
+                      const mc_ESCDerivedFromDataTokenValue_t *ESCDerivedFromDataToken,
+                      uint64_t u);
+DECL_TOKEN_VALUE_TYPE(mc_ECCDerivedFromDataTokenAndCounter,
+                      const mc_ECCDerivedFromDataTokenValue_t *ECCDerivedFromDataToken,
+                      uint64_t u);
+
+DECL_TOKEN_VALUE_TYPE(mc_ServerDerivedFromDataToken,
+                      const mc_ServerTokenDerivationLevel1TokenValue_t *ServerTokenDerivationToken,
+                      const _mongocrypt_buffer_t *v);
+
+DECL_TOKEN_VALUE_TYPE(mc_ServerCountAndContentionFactorEncryptionToken,
+                      const mc_ServerDerivedFromDataTokenValue_t *serverDerivedFromDataToken);
+DECL_TOKEN_VALUE_TYPE(mc_ServerZerosEncryptionToken,
+                      const mc_ServerDerivedFromDataTokenValue_t *serverDerivedFromDataToken);
+
 #undef DECL_TOKEN_TYPE
 #undef DECL_TOKEN_TYPE_1
+#undef DECL_TOKEN_VALUE_TYPE
+#undef DECL_TOKEN_VALUE_TYPE_1
 
 #endif /* MONGOCRYPT_TOKENS_PRIVATE_H */
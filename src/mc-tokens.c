@@ -16,16 +16,95 @@
 
 #include "mc-tokens-private.h"
 
-/// Define a token type of the given name, with constructor parameters given as
-/// the remaining arguments. This macro usage should be followed by the
-/// constructor body, with the implicit first argument '_mongocrypt_crypto_t*
-/// crypto' and final argument 'mongocrypt_status_t* status'
+// _mc_token_hmac computes HMAC-SHA256(key, in) into the 32 bytes at `out`.
+static bool _mc_token_hmac(_mongocrypt_crypto_t *crypto,
+                           const _mongocrypt_buffer_t *key,
+                           const _mongocrypt_buffer_t *in,
+                           uint8_t *out,
+                           mongocrypt_status_t *status) {
+    _mongocrypt_buffer_t out_buf;
+
+    _mongocrypt_buffer_init(&out_buf);
+    out_buf.data = out;
+    out_buf.len = MONGOCRYPT_HMAC_SHA256_LEN;
+    return _mongocrypt_hmac_sha_256(crypto, key, in, &out_buf, status);
+}
+
+// _mc_token_hmac_u64 computes HMAC-SHA256(key, LE64(u)) into the 32 bytes at
+// `out`.
+static bool _mc_token_hmac_u64(_mongocrypt_crypto_t *crypto,
+                               const _mongocrypt_buffer_t *key,
+                               uint64_t u,
+                               uint8_t *out,
+                               mongocrypt_status_t *status) {
+    _mongocrypt_buffer_t in;
+    uint64_t u_le = BSON_UINT64_TO_LE(u);
+
+    _mongocrypt_buffer_init(&in);
+    in.data = (uint8_t *)&u_le;
+    in.len = (uint32_t)sizeof(u_le);
+    return _mc_token_hmac(crypto, key, &in, out, status);
+}
+
+/// Define a value token type for the token of the given name, with
+/// initializer parameters given as the remaining arguments. This macro usage
+/// should be followed by the initializer body, with the implicit first
+/// arguments 'T* self, _mongocrypt_crypto_t* crypto' and final argument
+/// 'mongocrypt_status_t* status'
+#define DEF_TOKEN_VALUE_TYPE(Name, ...) DEF_TOKEN_VALUE_TYPE_1(CONCAT(Name, Value), CONCAT(Name, Value_t), __VA_ARGS__)
+
+#define DEF_TOKEN_VALUE_TYPE_1(Prefix, T, ...)                                                                         \
+    /* Data-getter */                                                                                                  \
+    _mongocrypt_buffer_t CONCAT(Prefix, _get)(const T *self) {                                                         \
+        _mongocrypt_buffer_t buf;                                                                                      \
+        _mongocrypt_buffer_init(&buf);                                                                                 \
+        buf.data = (uint8_t *)self->data;                                                                              \
+        buf.len = MONGOCRYPT_HMAC_SHA256_LEN;                                                                          \
+        return buf;                                                                                                    \
+    }                                                                                                                  \
+    /* Cleanup. Zeroes the token. */                                                                                   \
+    void CONCAT(Prefix, _cleanup)(T * self) {                                                                          \
+        if (!self) {                                                                                                   \
+            return;                                                                                                    \
+        }                                                                                                              \
+        memset(self->data, 0, sizeof(self->data));                                                                     \
+    }                                                                                                                  \
+    /* Initializer. From raw buffer */                                                                                 \
+    bool CONCAT(Prefix, _init_from_buffer)(T * self, const _mongocrypt_buffer_t *buf) {                                \
+        if (buf->len != MONGOCRYPT_HMAC_SHA256_LEN) {                                                                  \
+            return false;                                                                                              \
+        }                                                                                                              \
+        memcpy(self->data, buf->data, MONGOCRYPT_HMAC_SHA256_LEN);                                                     \
+        return true;                                                                                                   \
+    }                                                                                                                  \
+    /* Initializer. Parameter list given as variadic args. */                                                          \
+    bool CONCAT(Prefix, _init)(T * self, _mongocrypt_crypto_t * crypto, __VA_ARGS__, mongocrypt_status_t * status)
+
+// Define the initializer of a value token where Arg is a _mongocrypt_buffer_t.
+#define IMPL_TOKEN_VALUE_INIT(Key, Arg)                                                                                \
+    {                                                                                                                  \
+        const _mongocrypt_buffer_t key = Key;                                                                          \
+        return _mc_token_hmac(crypto, &key, Arg, self->data, status);                                                  \
+    }
+
+// Define the initializer of a value token where Arg is a uint64_t.
+#define IMPL_TOKEN_VALUE_INIT_CONST(Key, Arg)                                                                          \
+    {                                                                                                                  \
+        const _mongocrypt_buffer_t key = Key;                                                                          \
+        return _mc_token_hmac_u64(crypto, &key, Arg, self->data, status);                                              \
+    }
+
+/// Define a heap token type of the given name, wrapping the value token type
+/// of the same name. Constructor parameters are given as the remaining
+/// arguments. This macro usage should be followed by IMPL_TOKEN_NEW.
 #define DEF_TOKEN_TYPE(Name, ...) DEF_TOKEN_TYPE_1(Name, CONCAT(Name, _t), __VA_ARGS__)
 
 #define DEF_TOKEN_TYPE_1(Prefix, T, ...)                                                                               \
     /* Define the struct for the token */                                                                              \
     struct T {                                                                                                         \
+        /* Refers to value.data. */                                                                                    \
         _mongocrypt_buffer_t data;                                                                                     \
+        CONCAT(Prefix, Value_t) value;                                                                                 \
     };                                                                                                                 \
     /* Data-getter */                                                                                                  \
     const _mongocrypt_buffer_t *CONCAT(Prefix, _get)(const T *self) { return &self->data; }                            \
@@ -34,102 +113,135 @@
         if (!self) {                                                                                                   \
             return;                                                                                                    \
         }                                                                                                              \
-        _mongocrypt_buffer_cleanup(&self->data);                                                                       \
+        CONCAT(Prefix, Value_cleanup)(&self->value);                                                                   \
         bson_free(self);                                                                                               \
     }                                                                                                                  \
+    /* Allocate a token with data referring to value. */                                                               \
+    static T *CONCAT(Prefix, _alloc)(void) {                                                                           \
+        T *t = bson_malloc(sizeof(T));                                                                                 \
+        _mongocrypt_buffer_init(&t->data);                                                                             \
+        t->data.data = t->value.data;                                                                                  \
+        t->data.len = MONGOCRYPT_HMAC_SHA256_LEN;                                                                      \
+        return t;                                                                                                      \
+    }                                                                                                                  \
     /* Constructor. From raw buffer */                                                                                 \
     T *CONCAT(Prefix, _new_from_buffer)(_mongocrypt_buffer_t * buf) {                                                  \
-        BSON_ASSERT(buf->len == MONGOCRYPT_HMAC_SHA256_LEN);                                                           \
-        T *t = bson_malloc(sizeof(T));                                                                                 \
-        _mongocrypt_buffer_set_to(buf, &t->data);                                                                      \
+        T *t = CONCAT(Prefix, _alloc)();                                                                               \
+        BSON_ASSERT(CONCAT(Prefix, Value_init_from_buffer)(&t->value, buf));                                           \
         return t;                                                                                                      \
     }                                                                                                                  \
     /* Constructor. Parameter list given as variadic args. */                                                          \
     T *CONCAT(Prefix, _new)(_mongocrypt_crypto_t * crypto, __VA_ARGS__, mongocrypt_status_t * status)
 
-#define IMPL_TOKEN_NEW_1(Name, Key, Arg, Clean)                                                                        \
+/// Define the constructor body. The remaining arguments are passed to the
+/// value token initializer between 'crypto' and 'status'.
+#define IMPL_TOKEN_NEW(Name, ...)                                                                                      \
     {                                                                                                                  \
-        CONCAT(Name, _t) *t = bson_malloc(sizeof(CONCAT(Name, _t)));                                                   \
-        _mongocrypt_buffer_init(&t->data);                                                                             \
-        _mongocrypt_buffer_resize(&t->data, MONGOCRYPT_HMAC_SHA256_LEN);                                               \
-                                                                                                                       \
-        if (!_mongocrypt_hmac_sha_256(crypto, Key, Arg, &t->data, status)) {                                           \
+        CONCAT(Name, _t) *t = CONCAT(Name, _alloc)();                                                                  \
+        if (!CONCAT(Name, Value_init)(&t->value, crypto, __VA_ARGS__, status)) {                                       \
             CONCAT(Name, _destroy)(t);                                                                                 \
-            Clean;                                                                                                     \
             return NULL;                                                                                               \
         }                                                                                                              \
-        Clean;                                                                                                         \
         return t;                                                                                                      \
     }
 
-// Define the implementation of a token where Arg is a _mongocrypt_buffer_t.
-#define IMPL_TOKEN_NEW(Name, Key, Arg) IMPL_TOKEN_NEW_1(Name, Key, Arg, (void)0)
-
-// Define the implementation of a token where Arg is a uint64_t.
-#define IMPL_TOKEN_NEW_CONST(Name, Key, Arg)                                                                           \
-    {                                                                                                                  \
-        _mongocrypt_buffer_t to_hash;                                                                                  \
-        _mongocrypt_buffer_copy_from_uint64_le(&to_hash, Arg);                                                         \
-        IMPL_TOKEN_NEW_1(Name, Key, &to_hash, _mongocrypt_buffer_cleanup(&to_hash))                                    \
-    }
-
+DEF_TOKEN_VALUE_TYPE(mc_CollectionsLevel1Token, const _mongocrypt_buffer_t *RootKey)
+IMPL_TOKEN_VALUE_INIT_CONST(*RootKey, 1)
 DEF_TOKEN_TYPE(mc_CollectionsLevel1Token, const _mongocrypt_buffer_t *RootKey)
-IMPL_TOKEN_NEW_CONST(mc_CollectionsLevel1Token, RootKey, 1)
+IMPL_TOKEN_NEW(mc_CollectionsLevel1Token, RootKey)
 
+DEF_TOKEN_VALUE_TYPE(mc_EDCToken, const mc_CollectionsLevel1TokenValue_t *CollectionsLevel1Token)
+IMPL_TOKEN_VALUE_INIT_CONST(mc_CollectionsLevel1TokenValue_get(CollectionsLevel1Token), 1)
 DEF_TOKEN_TYPE(mc_EDCToken, const mc_CollectionsLevel1Token_t *CollectionsLevel1Token)
-IMPL_TOKEN_NEW_CONST(mc_EDCToken, mc_CollectionsLevel1Token_get(CollectionsLevel1Token), 1)
+IMPL_TOKEN_NEW(mc_EDCToken, &CollectionsLevel1Token->value)
 
+DEF_TOKEN_VALUE_TYPE(mc_ESCToken, const mc_CollectionsLevel1TokenValue_t *CollectionsLevel1Token)
+IMPL_TOKEN_VALUE_INIT_CONST(mc_CollectionsLevel1TokenValue_get(CollectionsLevel1Token), 2)
 DEF_TOKEN_TYPE(mc_ESCToken, const mc_CollectionsLevel1Token_t *CollectionsLevel1Token)
-IMPL_TOKEN_NEW_CONST(mc_ESCToken, mc_CollectionsLevel1Token_get(CollectionsLevel1Token), 2)
+IMPL_TOKEN_NEW(mc_ESCToken, &CollectionsLevel1Token->value)
 
+DEF_TOKEN_VALUE_TYPE(mc_ECCToken, const mc_CollectionsLevel1TokenValue_t *CollectionsLevel1Token)
+IMPL_TOKEN_VALUE_INIT_CONST(mc_CollectionsLevel1TokenValue_get(CollectionsLevel1Token), 3)
 DEF_TOKEN_TYPE(mc_ECCToken, const mc_CollectionsLevel1Token_t *CollectionsLevel1Token)
-IMPL_TOKEN_NEW_CONST(mc_ECCToken, mc_CollectionsLevel1Token_get(CollectionsLevel1Token), 3)
+IMPL_TOKEN_NEW(mc_ECCToken, &CollectionsLevel1Token->value)
 
+DEF_TOKEN_VALUE_TYPE(mc_ECOCToken, const mc_CollectionsLevel1TokenValue_t *CollectionsLevel1Token)
+IMPL_TOKEN_VALUE_INIT_CONST(mc_CollectionsLevel1TokenValue_get(CollectionsLevel1Token), 4)
 DEF_TOKEN_TYPE(mc_ECOCToken, const mc_CollectionsLevel1Token_t *CollectionsLevel1Token)
-IMPL_TOKEN_NEW_CONST(mc_ECOCToken, mc_CollectionsLevel1Token_get(CollectionsLevel1Token), 4)
+IMPL_TOKEN_NEW(mc_ECOCToken, &CollectionsLevel1Token->value)
 
+DEF_TOKEN_VALUE_TYPE(mc_EDCDerivedFromDataToken, const mc_EDCTokenValue_t *EDCToken, const _mongocrypt_buffer_t *v)
+IMPL_TOKEN_VALUE_INIT(mc_EDCTokenValue_get(EDCToken), v)
 DEF_TOKEN_TYPE(mc_EDCDerivedFromDataToken, const mc_EDCToken_t *EDCToken, const _mongocrypt_buffer_t *v)
-IMPL_TOKEN_NEW(mc_EDCDerivedFromDataToken, mc_EDCToken_get(EDCToken), v)
+IMPL_TOKEN_NEW(mc_EDCDerivedFromDataToken, &EDCToken->value, v)
 
+DEF_TOKEN_VALUE_TYPE(mc_ESCDerivedFromDataToken, const mc_ESCTokenValue_t *ESCToken, const _mongocrypt_buffer_t *v)
+IMPL_TOKEN_VALUE_INIT(mc_ESCTokenValue_get(ESCToken), v)
 DEF_TOKEN_TYPE(mc_ESCDerivedFromDataToken, const mc_ESCToken_t *ESCToken, const _mongocrypt_buffer_t *v)
-IMPL_TOKEN_NEW(mc_ESCDerivedFromDataToken, mc_ESCToken_get(ESCToken), v)
+IMPL_TOKEN_NEW(mc_ESCDerivedFromDataToken, &ESCToken->value, v)
 
+DEF_TOKEN_VALUE_TYPE(mc_ECCDerivedFromDataToken, const mc_ECCTokenValue_t *ECCToken, const _mongocrypt_buffer_t *v)
+IMPL_TOKEN_VALUE_INIT(mc_ECCTokenValue_get(ECCToken), v)
 DEF_TOKEN_TYPE(mc_ECCDerivedFromDataToken, const mc_ECCToken_t *ECCToken, const _mongocrypt_buffer_t *v)
-IMPL_TOKEN_NEW(mc_ECCDerivedFromDataToken, mc_ECCToken_get(ECCToken), v)
+IMPL_TOKEN_NEW(mc_ECCDerivedFromDataToken, &ECCToken->value, v)
 
+DEF_TOKEN_VALUE_TYPE(mc_ServerDataEncryptionLevel1Token, const _mongocrypt_buffer_t *RootKey)
+IMPL_TOKEN_VALUE_INIT_CONST(*RootKey, 3)
 DEF_TOKEN_TYPE(mc_ServerDataEncryptionLevel1Token, const _mongocrypt_buffer_t *RootKey)
-IMPL_TOKEN_NEW_CONST(mc_ServerDataEncryptionLevel1Token, RootKey, 3)
+IMPL_TOKEN_NEW(mc_ServerDataEncryptionLevel1Token, RootKey)
 
+DEF_TOKEN_VALUE_TYPE(mc_EDCDerivedFromDataTokenAndCounter,
+                     const mc_EDCDerivedFromDataTokenValue_t *EDCDerivedFromDataToken,
+                     uint64_t u)
+IMPL_TOKEN_VALUE_INIT_CONST(mc_EDCDerivedFromDataTokenValue_get(EDCDerivedFromDataToken), u)
 DEF_TOKEN_TYPE(mc_EDCDerivedFromDataTokenAndCounter,
                const mc_EDCDerivedFromDataToken_t *EDCDerivedFromDataToken,
                uint64_t u)
-IMPL_TOKEN_NEW_CONST(mc_EDCDerivedFromDataTokenAndCounter, mc_EDCDerivedFromDataToken_get(EDCDerivedFromDataToken), u)
+IMPL_TOKEN_NEW(mc_EDCDerivedFromDataTokenAndCounter, &EDCDerivedFromDataToken->value, u)
 
+DEF_TOKEN_VALUE_TYPE(mc_ESCDerivedFromDataTokenAndCounter,
+                     const mc_ESCDerivedFromDataTokenValue_t *ESCDerivedFromDataToken,
+                     uint64_t u)
+IMPL_TOKEN_VALUE_INIT_CONST(mc_ESCDerivedFromDataTokenValue_get(ESCDerivedFromDataToken), u)
 DEF_TOKEN_TYPE(mc_ESCDerivedFromDataTokenAndCounter,
                const mc_ESCDerivedFromDataToken_t *ESCDerivedFromDataToken,
                uint64_t u)
-IMPL_TOKEN_NEW_CONST(mc_ESCDerivedFromDataTokenAndCounter, mc_ESCDerivedFromDataToken_get(ESCDerivedFromDataToken), u)
+IMPL_TOKEN_NEW(mc_ESCDerivedFromDataTokenAndCounter, &ESCDerivedFromDataToken->value, u)
 
+DEF_TOKEN_VALUE_TYPE(mc_ECCDerivedFromDataTokenAndCounter,
+                     const mc_ECCDerivedFromDataTokenValue_t *ECCDerivedFromDataToken,
+                     uint64_t u)
+IMPL_TOKEN_VALUE_INIT_CONST(mc_ECCDerivedFromDataTokenValue_get(ECCDerivedFromDataToken), u)
 DEF_TOKEN_TYPE(mc_ECCDerivedFromDataTokenAndCounter,
                const mc_ECCDerivedFromDataToken_t *ECCDerivedFromDataToken,
                uint64_t u)
-IMPL_TOKEN_NEW_CONST(mc_ECCDerivedFromDataTokenAndCounter, mc_ECCDerivedFromDataToken_get(ECCDerivedFromDataToken), u)
+IMPL_TOKEN_NEW(mc_ECCDerivedFromDataTokenAndCounter, &ECCDerivedFromDataToken->value, u)
 
 /* FLE2v2 */
 
+DEF_TOKEN_VALUE_TYPE(mc_ServerTokenDerivationLevel1Token, const _mongocrypt_buffer_t *RootKey)
+IMPL_TOKEN_VALUE_INIT_CONST(*RootKey, 2)
 DEF_TOKEN_TYPE(mc_ServerTokenDerivationLevel1Token, const _mongocrypt_buffer_t *RootKey)
-IMPL_TOKEN_NEW_CONST(mc_ServerTokenDerivationLevel1Token, RootKey, 2)
+IMPL_TOKEN_NEW(mc_ServerTokenDerivationLevel1Token, RootKey)
 
+DEF_TOKEN_VALUE_TYPE(mc_ServerDerivedFromDataToken,
+                     const mc_ServerTokenDerivationLevel1TokenValue_t *ServerTokenDerivationToken,
+                     const _mongocrypt_buffer_t *v)
+IMPL_TOKEN_VALUE_INIT(mc_ServerTokenDerivationLevel1TokenValue_get(ServerTokenDerivationToken), v)
 DEF_TOKEN_TYPE(mc_ServerDerivedFromDataToken,
                const mc_ServerTokenDerivationLevel1Token_t *ServerTokenDerivationToken,
                const _mongocrypt_buffer_t *v)
-IMPL_TOKEN_NEW(mc_ServerDerivedFromDataToken, mc_ServerTokenDerivationLevel1Token_get(ServerTokenDerivationToken), v)
+IMPL_TOKEN_NEW(mc_ServerDerivedFromDataToken, &ServerTokenDerivationToken->value, v)
 
+DEF_TOKEN_VALUE_TYPE(mc_ServerCountAndContentionFactorEncryptionToken,
+                     const mc_ServerDerivedFromDataTokenValue_t *serverDerivedFromDataToken)
+IMPL_TOKEN_VALUE_INIT_CONST(mc_ServerDerivedFromDataTokenValue_get(serverDerivedFromDataToken), 1)
 DEF_TOKEN_TYPE(mc_ServerCountAndContentionFactorEncryptionToken,
                const mc_ServerDerivedFromDataToken_t *serverDerivedFromDataToken)
-IMPL_TOKEN_NEW_CONST(mc_ServerCountAndContentionFactorEncryptionToken,
-                     mc_ServerDerivedFromDataToken_get(serverDerivedFromDataToken),
-                     1)
+IMPL_TOKEN_NEW(mc_ServerCountAndContentionFactorEncryptionToken, &serverDerivedFromDataToken->value)
 
+DEF_TOKEN_VALUE_TYPE(mc_ServerZerosEncryptionToken,
+                     const mc_ServerDerivedFromDataTokenValue_t *serverDerivedFromDataToken)
+IMPL_TOKEN_VALUE_INIT_CONST(mc_ServerDerivedFromDataTokenValue_get(serverDerivedFromDataToken), 2)
 DEF_TOKEN_TYPE(mc_ServerZerosEncryptionToken, const mc_ServerDerivedFromDataToken_t *serverDerivedFromDataToken)
-IMPL_TOKEN_NEW_CONST(mc_ServerZerosEncryptionToken, mc_ServerDerivedFromDataToken_get(serverDerivedFromDataToken), 2)
+IMPL_TOKEN_NEW(mc_ServerZerosEncryptionToken, &serverDerivedFromDataToken->value)
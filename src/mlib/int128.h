@@ -59,6 +59,37 @@ typedef union {
 /// Maximum value of int128, when treated as an unsigned integer
 #define MLIB_INT128_UMAX MLIB_INT128_FROM_PARTS(UINT64_MAX, UINT64_MAX)
 
+/**
+ * @brief Whether mlib_int128 multiplication and division use the compiler's
+ * native `unsigned __int128`.
+ *
+ * Enabled for GCC and Clang on x86-64 and aarch64, where the native operations
+ * compile to a few instructions or a single runtime library call. MSVC and
+ * other targets use the portable implementation. Define
+ * MLIB_INT128_FORCE_PORTABLE to use the portable implementation everywhere.
+ */
+#if defined(__SIZEOF_INT128__) && (defined(__x86_64__) || defined(__aarch64__)) && !defined(_MSC_VER)               \
+    && !defined(MLIB_INT128_FORCE_PORTABLE)
+#define MLIB_INT128_HAVE_NATIVE 1
+#else
+#define MLIB_INT128_HAVE_NATIVE 0
+#endif
+
+#if MLIB_INT128_HAVE_NATIVE
+__extension__ typedef unsigned __int128 _mlib_native_u128;
+
+// Convert to a native integer. Uses arithmetic rather than the union members so
+// that it is usable in constant expressions and independent of endianness.
+static mlib_constexpr_fn _mlib_native_u128 _mlibInt128ToNative(mlib_int128 v) {
+    return ((_mlib_native_u128)v.r.hi << 64) | v.r.lo;
+}
+
+// Convert from a native integer
+static mlib_constexpr_fn mlib_int128 _mlibInt128FromNative(_mlib_native_u128 v) {
+    return MLIB_INIT(mlib_int128) MLIB_INT128_FROM_PARTS((uint64_t)v, (uint64_t)(v >> 64));
+}
+#endif // MLIB_INT128_HAVE_NATIVE
+
 /**
  * @brief Compare two 128-bit integers as unsigned integers
  *
@@ -220,10 +251,8 @@ static mlib_constexpr_fn mlib_int128 _mlibUnsignedMult128(uint64_t left, uint64_
     return MLIB_INIT(mlib_int128) MLIB_INT128_FROM_PARTS(((uint64_t)w[1] << 32) | w[0], ((uint64_t)w[3] << 32) | w[2]);
 }
 
-/**
- * @brief Multiply two mlib_int128s together. Overflow will wrap.
- */
-static mlib_constexpr_fn mlib_int128 mlib_int128_mul(mlib_int128 l, mlib_int128 r) {
+// Portable implementation of mlib_int128_mul
+static mlib_constexpr_fn mlib_int128 _mlibInt128MulPortable(mlib_int128 l, mlib_int128 r) {
     // Multiply the low-order word
     mlib_int128 ret = _mlibUnsignedMult128(l.r.lo, r.r.lo);
     // Accumulate the high-order parts:
@@ -232,6 +261,17 @@ static mlib_constexpr_fn mlib_int128 mlib_int128_mul(mlib_int128 l, mlib_int128
     return ret;
 }
 
+/**
+ * @brief Multiply two mlib_int128s together. Overflow will wrap.
+ */
+static mlib_constexpr_fn mlib_int128 mlib_int128_mul(mlib_int128 l, mlib_int128 r) {
+#if MLIB_INT128_HAVE_NATIVE
+    return _mlibInt128FromNative(_mlibInt128ToNative(l) * _mlibInt128ToNative(r));
+#else
+    return _mlibInt128MulPortable(l, r);
+#endif
+}
+
 /// Get the number of leading zeros in a 64bit number.
 static mlib_constexpr_fn int _mlibCountLeadingZeros_u64(uint64_t bits) {
     int n = 0;
@@ -408,14 +448,8 @@ static mlib_constexpr_fn struct mlib_int128_divmod_result _mlibDivide_u128_by_u6
     };
 }
 
-/**
- * @brief Perform a combined division+remainder of two 128-bit numbers
- *
- * @param numer The dividend
- * @param denom The divisor
- * @return A struct with .quotient and .remainder results
- */
-static mlib_constexpr_fn mlib_int128_divmod_result mlib_int128_divmod(mlib_int128 numer, mlib_int128 denom) {
+// Portable implementation of mlib_int128_divmod
+static mlib_constexpr_fn mlib_int128_divmod_result _mlibInt128DivmodPortable(mlib_int128 numer, mlib_int128 denom) {
     const uint64_t nhi = numer.r.hi;
     const uint64_t nlo = numer.r.lo;
     const uint64_t dhi = denom.r.hi;
@@ -498,6 +532,28 @@ static mlib_constexpr_fn mlib_int128_divmod_result mlib_int128_divmod(mlib_int12
     }
 }
 
+/**
+ * @brief Perform a combined division+remainder of two 128-bit numbers
+ *
+ * @param numer The dividend
+ * @param denom The divisor
+ * @return A struct with .quotient and .remainder results
+ */
+static mlib_constexpr_fn mlib_int128_divmod_result mlib_int128_divmod(mlib_int128 numer, mlib_int128 denom) {
+#if MLIB_INT128_HAVE_NATIVE
+    const _mlib_native_u128 n = _mlibInt128ToNative(numer);
+    const _mlib_native_u128 d = _mlibInt128ToNative(denom);
+    // Derive the remainder from the quotient rather than dividing twice
+    const _mlib_native_u128 q = n / d;
+    return MLIB_INIT(mlib_int128_divmod_result){
+        _mlibInt128FromNative(q),
+        _mlibInt128FromNative(n - q * d),
+    };
+#else
+    return _mlibInt128DivmodPortable(numer, denom);
+#endif
+}
+
 /**
  * @brief Perform a division of two 128-bit numbers
  */
@@ -512,12 +568,63 @@ static mlib_constexpr_fn mlib_int128 mlib_int128_mod(mlib_int128 numer, mlib_int
     return mlib_int128_divmod(numer, denom).remainder;
 }
 
+/// The number of powers of ten that fit in 128 bits: 10^0 through 10^38
+#define MLIB_INT128_POW10_COUNT 39
+
+/// 10^N for N in [0, MLIB_INT128_POW10_COUNT)
+static mlib_constexpr_var mlib_int128 _mlibInt128Pow10Table[MLIB_INT128_POW10_COUNT] = {
+    MLIB_INT128_FROM_PARTS(UINT64_C(1), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(10), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(100), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(1000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(10000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(100000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(1000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(10000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(100000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(1000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(10000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(100000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(1000000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(10000000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(100000000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(1000000000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(10000000000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(100000000000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(1000000000000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(10000000000000000000), UINT64_C(0)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(7766279631452241920), UINT64_C(5)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(3875820019684212736), UINT64_C(54)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(1864712049423024128), UINT64_C(542)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(200376420520689664), UINT64_C(5421)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(2003764205206896640), UINT64_C(54210)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(1590897978359414784), UINT64_C(542101)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(15908979783594147840), UINT64_C(5421010)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(11515845246265065472), UINT64_C(54210108)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(4477988020393345024), UINT64_C(542101086)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(7886392056514347008), UINT64_C(5421010862)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(5076944270305263616), UINT64_C(54210108624)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(13875954555633532928), UINT64_C(542101086242)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(9632337040368467968), UINT64_C(5421010862427)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(4089650035136921600), UINT64_C(54210108624275)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(4003012203950112768), UINT64_C(542101086242752)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(3136633892082024448), UINT64_C(5421010862427522)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(12919594847110692864), UINT64_C(54210108624275221)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(68739955140067328), UINT64_C(542101086242752217)),
+    MLIB_INT128_FROM_PARTS(UINT64_C(687399551400673280), UINT64_C(5421010862427522170)),
+};
+
 /**
  * @brief Get the nth power of ten as a 128-bit number
+ *
+ * Powers greater than 10^38 overflow and wrap.
  */
 static mlib_constexpr_fn mlib_int128 mlib_int128_pow10(uint8_t nth) {
-    mlib_int128 r = MLIB_INT128(1);
-    while (nth-- > 0) {
+    if (nth < MLIB_INT128_POW10_COUNT) {
+        return _mlibInt128Pow10Table[nth];
+    }
+    mlib_int128 r = _mlibInt128Pow10Table[MLIB_INT128_POW10_COUNT - 1];
+    for (nth = (uint8_t)(nth - (MLIB_INT128_POW10_COUNT - 1)); nth > 0; --nth) {
         r = mlib_int128_mul(r, MLIB_INT128(10));
     }
     return r;
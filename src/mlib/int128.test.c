@@ -1,3 +1,69 @@
 #include "./int128.h"
 
-// This file checks for C compilability. Other tests are defined in .test.cpp
+#include <stdio.h>
+
+// This file checks for C compilability and cross-checks the native backend
+// against the portable implementation. Other tests are defined in .test.cpp
+
+#define CHECK(Expr)                                                                                                    \
+    ((Expr) ? 0 : ((fprintf(stderr, "%s:%d: Check '%s' failed\n", __FILE__, __LINE__, #Expr), abort()), 0))
+
+// xorshift64: Deterministic, so failures can be reproduced
+static uint64_t next_random(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+// Generate a number with the 32-bit digits selected by the low four bits of
+// `digits` filled with random bits
+static mlib_int128 random_int128(uint64_t *state, unsigned digits) {
+    uint64_t lo = 0, hi = 0;
+    const uint64_t r1 = next_random(state), r2 = next_random(state);
+    if (digits & 1) {
+        lo |= r1 & UINT32_MAX;
+    }
+    if (digits & 2) {
+        lo |= r1 & ~(uint64_t)UINT32_MAX;
+    }
+    if (digits & 4) {
+        hi |= r2 & UINT32_MAX;
+    }
+    if (digits & 8) {
+        hi |= r2 & ~(uint64_t)UINT32_MAX;
+    }
+    return MLIB_INIT(mlib_int128) MLIB_INT128_FROM_PARTS(lo, hi);
+}
+
+int main(void) {
+    // The table of powers of ten matches repeated multiplication
+    mlib_int128 p = MLIB_INT128(1);
+    for (int n = 0; n < 64; ++n) {
+        CHECK(mlib_int128_eq(mlib_int128_pow10((uint8_t)n), p));
+        p = _mlibInt128MulPortable(p, MLIB_INT128(10));
+    }
+
+    uint64_t state = UINT64_C(0x9e3779b97f4a7c15);
+    for (unsigned nbits = 0; nbits < 16; ++nbits) {
+        for (unsigned dbits = 1; dbits < 16; ++dbits) {
+            for (int i = 0; i < 2000; ++i) {
+                const mlib_int128 num = random_int128(&state, nbits);
+                mlib_int128 den = random_int128(&state, dbits);
+                if (mlib_int128_eq(den, MLIB_INT128(0))) {
+                    den = MLIB_INT128(1);
+                }
+                CHECK(mlib_int128_eq(mlib_int128_mul(num, den), _mlibInt128MulPortable(num, den)));
+                const mlib_int128_divmod_result got = mlib_int128_divmod(num, den);
+                const mlib_int128_divmod_result expect = _mlibInt128DivmodPortable(num, den);
+                CHECK(mlib_int128_eq(got.quotient, expect.quotient));
+                CHECK(mlib_int128_eq(got.remainder, expect.remainder));
+            }
+        }
+    }
+
+    printf("mlib_int128 backend: %s\n", MLIB_INT128_HAVE_NATIVE ? "native" : "portable");
+    return 0;
+}
@@ -99,6 +99,23 @@ static_assert(mlib_int128_mod(2795722437127403543495742528_i128, 708945413_i128)
 
 // 10-div:
 static_assert(mlib_int128_div(MLIB_INT128_SMAX, 10_i128) == 17014118346046923173168730371588410572_i128, "fail");
+
+// Powers of ten up to 10^38 come from a table. Larger powers wrap:
+static_assert(mlib_int128_pow10(0) == 1_i128, "fail");
+static_assert(mlib_int128_pow10(19) == 10000000000000000000_i128, "fail");
+static_assert(mlib_int128_pow10(34) == 10000000000000000000000000000000000_i128, "fail");
+static_assert(mlib_int128_pow10(38) == 100000000000000000000000000000000000000_i128, "fail");
+static_assert(mlib_int128_pow10(39) == mlib_int128_mul(mlib_int128_pow10(38), 10_i128), "fail");
+
+// The native backend (if enabled) agrees with the portable implementation:
+static_assert(mlib_int128_mul(28468554863115876158655557_i128, 73_i128)
+                  == _mlibInt128MulPortable(28468554863115876158655557_i128, 73_i128),
+              "fail");
+static_assert(_mlibInt128DivmodPortable(31322872034807296605612234499929458960_i128,
+                                        34573864092216774938021667884_i128)
+                      .quotient
+                  == mlib_int128_div(31322872034807296605612234499929458960_i128, 34573864092216774938021667884_i128),
+              "fail");
 #endif // BROKEN_CONSTEXPR
 
 inline std::ostream &operator<<(std::ostream &out, const mlib_int128 &v) {
@@ -172,6 +189,11 @@ static mlib_int128_divmod_result div_check(mlib_int128 num, mlib_int128 den) {
     CHECK(expect.quotient == res.quotient);
     CHECK(expect.remainder == res.remainder);
 #endif
+    // Check the selected backend against the portable implementation
+    mlib_int128_divmod_result portable = _mlibInt128DivmodPortable(num, den);
+    CHECK(portable.quotient == res.quotient);
+    CHECK(portable.remainder == res.remainder);
+    CHECK(_mlibInt128MulPortable(num, den) == mlib_int128_mul(num, den));
     // Check inversion by multiplication provides the correct result
     auto invert = mlib_int128_mul(res.quotient, den);
     invert = mlib_int128_add(invert, res.remainder);
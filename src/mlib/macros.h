@@ -30,8 +30,10 @@
 #if (defined(__cpp_constexpr) && __cpp_constexpr >= 201304L) || (defined(__cplusplus) && __cplusplus >= 201402L)       \
     || (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
 #define _mlibConstexprFn constexpr inline
+#define _mlibConstexprVar constexpr
 #else
 #define _mlibConstexprFn inline
+#define _mlibConstexprVar const
 #endif
 
 /**
@@ -42,6 +44,14 @@
  */
 #define mlib_constexpr_fn _mlibConstexprFn
 
+/**
+ * @brief Mark a variable as constexpr, so that it may be read by
+ * mlib_constexpr_fn functions
+ *
+ * Expands to `constexpr` in C++14 and above. "const" otherwise.
+ */
+#define mlib_constexpr_var _mlibConstexprVar
+
 #ifdef __GNUC__
 #define MLIB_ANNOTATE_PRINTF(FStringArgAt, VarArgsStartAt)                                                             \
     __attribute__((format(__printf__, FStringArgAt, VarArgsStartAt)))
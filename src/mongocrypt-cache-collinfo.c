@@ -62,4 +62,6 @@ void _mongocrypt_cache_collinfo_init(_mongocrypt_cache_t *cache) {
     _mongocrypt_mutex_init(&cache->mutex);
     cache->pair = NULL;
     cache->expiration = CACHE_EXPIRATION_MS;
+    cache->on_evict = NULL;
+    cache->on_evict_ctx = NULL;
 }
@@ -129,6 +129,8 @@ void _mongocrypt_cache_key_init(_mongocrypt_cache_t *cache) {
     _mongocrypt_mutex_init(&cache->mutex);
     cache->pair = NULL;
     cache->expiration = CACHE_EXPIRATION_MS;
+    cache->on_evict = NULL;
+    cache->on_evict_ctx = NULL;
 }
 
 /* Since key cache may be looked up by either _id or keyAltName,
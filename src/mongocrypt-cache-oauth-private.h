@@ -24,6 +24,23 @@ typedef struct {
     bson_t *entry;
     char *access_token;
     int64_t expiration_time_us;
+    /* The time after which the token is still usable but a new one should be
+     * fetched. Equal to expiration_time_us if proactive refresh is disabled. */
+    int64_t refresh_time_us;
+    /* Fraction of "expires_in" after which to refresh. 0 disables refresh. */
+    double refresh_fraction;
+    /* Set while one context has claimed fetching a new token. */
+    bool fetch_in_flight;
+    /* The thread that took the claim. */
+    mongocrypt_thread_id_t claim_thread;
+    /* Broadcast when a claim is released. */
+    mongocrypt_cond_t claim_released;
+    /* The last signed GCP OAuth JWT assertion, reused while it is valid. Only
+     * used by the GCP cache. */
+    bool assertion_set;
+    uint8_t assertion_claims_hash[32];
+    uint64_t assertion_issued_at;
+    uint8_t assertion_signature[256];
     mongocrypt_mutex_t mutex; /* global lock of cache. */
 } _mongocrypt_cache_oauth_t;
 
@@ -37,4 +54,38 @@ bool _mongocrypt_cache_oauth_add(_mongocrypt_cache_oauth_t *cache, bson_t *oauth
  * cached. */
 char *_mongocrypt_cache_oauth_get(_mongocrypt_cache_oauth_t *cache);
 
+/* Returns a copy of the base64 encoded oauth token, or NULL if the caller must
+ * fetch a new one. Sets *claimed to true if the caller is the one context
+ * responsible for fetching a new token. A claim is held until the claimant
+ * calls _mongocrypt_cache_oauth_release, normally right after
+ * _mongocrypt_cache_oauth_add.
+ *
+ * If the cached token has passed its refresh time and no other fetch is in
+ * flight, NULL is returned and the caller claims the refresh. Other callers
+ * continue to receive the cached token until it expires.
+ *
+ * If no usable token is cached and another thread holds the claim, waits up to
+ * MONGOCRYPT_OAUTH_CLAIM_WAIT_US for that fetch and returns its token. If the
+ * wait times out, or the claim is held by the calling thread, NULL is returned
+ * and the caller fetches without a claim. */
+char *_mongocrypt_cache_oauth_get_or_claim(_mongocrypt_cache_oauth_t *cache, bool *claimed);
+
+/* Release a claim obtained from _mongocrypt_cache_oauth_get_or_claim. Only the
+ * claimant may call this. Wakes callers waiting on the claim. */
+void _mongocrypt_cache_oauth_release(_mongocrypt_cache_oauth_t *cache);
+
+/* Copies the signature of the cached GCP JWT assertion for @claims_hash into
+ * @signature_out and sets @issued_at_out. Returns false if none is cached.
+ * @claims_hash is 32 bytes and @signature_out is 256 bytes. */
+bool _mongocrypt_cache_oauth_get_assertion(_mongocrypt_cache_oauth_t *cache,
+                                           const uint8_t *claims_hash,
+                                           uint64_t *issued_at_out,
+                                           uint8_t *signature_out);
+
+/* Caches the signature of a GCP JWT assertion, replacing any other. */
+void _mongocrypt_cache_oauth_add_assertion(_mongocrypt_cache_oauth_t *cache,
+                                           const uint8_t *claims_hash,
+                                           uint64_t issued_at,
+                                           const uint8_t *signature);
+
 #endif /* MONGOCRYPT_CACHE_OAUTH_PRIVATE_H */
\ No newline at end of file
@@ -24,20 +24,29 @@
  */
 #define MONGOCRYPT_OAUTH_CACHE_EVICTION_PERIOD_US 5000 * 1000
 
+/* How long a context with no usable token waits for a fetch claimed by another
+ * thread before fetching one itself. Long enough for a typical OAuth exchange,
+ * short enough that a stalled claimant does not stall other contexts for long.
+ */
+#define MONGOCRYPT_OAUTH_CLAIM_WAIT_US 2000 * 1000
+
 _mongocrypt_cache_oauth_t *_mongocrypt_cache_oauth_new(void) {
     _mongocrypt_cache_oauth_t *cache;
 
     cache = bson_malloc0(sizeof(_mongocrypt_cache_oauth_t));
     _mongocrypt_mutex_init(&cache->mutex);
+    _mongocrypt_cond_init(&cache->claim_released);
     return cache;
 }
 
 void _mongocrypt_cache_oauth_destroy(_mongocrypt_cache_oauth_t *cache) {
     BSON_ASSERT_PARAM(cache);
 
+    _mongocrypt_cond_cleanup(&cache->claim_released);
     _mongocrypt_mutex_cleanup(&cache->mutex);
     bson_destroy(cache->entry);
     bson_free(cache->access_token);
+    memset(cache->assertion_signature, 0, sizeof(cache->assertion_signature));
     bson_free(cache);
 }
 
@@ -79,13 +88,41 @@ bool _mongocrypt_cache_oauth_add(_mongocrypt_cache_oauth_t *cache,
         bson_destroy(cache->entry);
         cache->entry = bson_copy(oauth_response);
         cache->expiration_time_us = expiration_time_us;
+        cache->refresh_time_us = expiration_time_us;
+        if (cache->refresh_fraction > 0) {
+            int64_t refresh_time_us = cache_time_us + (int64_t)((double)expires_in_us * cache->refresh_fraction);
+            if (refresh_time_us < expiration_time_us) {
+                cache->refresh_time_us = refresh_time_us;
+            }
+        }
         bson_free(cache->access_token);
         cache->access_token = bson_strdup(access_token);
     }
+    /* The claim is left for the claimant to release. A context that fetched
+     * without a claim must not clear another context's claim. */
     _mongocrypt_mutex_unlock(&cache->mutex);
     return true;
 }
 
+/* Evicts the entry if expired. Returns true if an unexpired entry remains.
+ * Requires cache->mutex to be held. */
+static bool _evict_if_expired(_mongocrypt_cache_oauth_t *cache, int64_t now_us) {
+    BSON_ASSERT_PARAM(cache);
+
+    if (!cache->entry) {
+        return false;
+    }
+
+    if (now_us >= cache->expiration_time_us) {
+        bson_destroy(cache->entry);
+        cache->entry = NULL;
+        cache->expiration_time_us = 0;
+        cache->refresh_time_us = 0;
+        return false;
+    }
+    return true;
+}
+
 /* Returns a copy of the base64 encoded oauth token, or NULL if nothing is
  * cached. */
 char *_mongocrypt_cache_oauth_get(_mongocrypt_cache_oauth_t *cache) {
@@ -94,15 +131,68 @@ char *_mongocrypt_cache_oauth_get(_mongocrypt_cache_oauth_t *cache) {
     BSON_ASSERT_PARAM(cache);
 
     _mongocrypt_mutex_lock(&cache->mutex);
-    if (!cache->entry) {
+    if (!_evict_if_expired(cache, bson_get_monotonic_time())) {
         _mongocrypt_mutex_unlock(&cache->mutex);
         return NULL;
     }
 
-    if (bson_get_monotonic_time() >= cache->expiration_time_us) {
-        bson_destroy(cache->entry);
-        cache->entry = NULL;
-        cache->expiration_time_us = 0;
+    access_token = bson_strdup(cache->access_token);
+    _mongocrypt_mutex_unlock(&cache->mutex);
+
+    return access_token;
+}
+
+/* Requires cache->mutex to be held. */
+static void _claim(_mongocrypt_cache_oauth_t *cache, bool *claimed) {
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(claimed);
+
+    cache->fetch_in_flight = true;
+    cache->claim_thread = _mongocrypt_thread_id_self();
+    *claimed = true;
+}
+
+char *_mongocrypt_cache_oauth_get_or_claim(_mongocrypt_cache_oauth_t *cache, bool *claimed) {
+    char *access_token;
+    int64_t now_us;
+
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(claimed);
+
+    *claimed = false;
+    now_us = bson_get_monotonic_time();
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    if (!_evict_if_expired(cache, now_us)) {
+        /* Nothing usable is cached. Wait for a fetch claimed on another thread.
+         * A claim held by this thread cannot complete while it waits, which
+         * happens when one thread drives several contexts. */
+        if (cache->fetch_in_flight && !_mongocrypt_thread_id_equal(cache->claim_thread, _mongocrypt_thread_id_self())) {
+            const int64_t deadline_us = now_us + MONGOCRYPT_OAUTH_CLAIM_WAIT_US;
+
+            while (cache->fetch_in_flight && now_us < deadline_us) {
+                _mongocrypt_cond_timedwait(&cache->claim_released, &cache->mutex, deadline_us - now_us);
+                now_us = bson_get_monotonic_time();
+            }
+            if (_evict_if_expired(cache, now_us)) {
+                access_token = bson_strdup(cache->access_token);
+                _mongocrypt_mutex_unlock(&cache->mutex);
+                return access_token;
+            }
+        }
+
+        /* The claimant gave up, or the wait timed out. The caller fetches, and
+         * claims the fetch if it is free. */
+        if (!cache->fetch_in_flight) {
+            _claim(cache, claimed);
+        }
+        _mongocrypt_mutex_unlock(&cache->mutex);
+        return NULL;
+    }
+
+    if (now_us >= cache->refresh_time_us && !cache->fetch_in_flight) {
+        /* Only one context refreshes. Others keep using the cached token. */
+        _claim(cache, claimed);
         _mongocrypt_mutex_unlock(&cache->mutex);
         return NULL;
     }
@@ -112,3 +202,50 @@ char *_mongocrypt_cache_oauth_get(_mongocrypt_cache_oauth_t *cache) {
 
     return access_token;
 }
+
+void _mongocrypt_cache_oauth_release(_mongocrypt_cache_oauth_t *cache) {
+    BSON_ASSERT_PARAM(cache);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    cache->fetch_in_flight = false;
+    _mongocrypt_cond_broadcast(&cache->claim_released);
+    _mongocrypt_mutex_unlock(&cache->mutex);
+}
+
+bool _mongocrypt_cache_oauth_get_assertion(_mongocrypt_cache_oauth_t *cache,
+                                           const uint8_t *claims_hash,
+                                           uint64_t *issued_at_out,
+                                           uint8_t *signature_out) {
+    bool found = false;
+
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(claims_hash);
+    BSON_ASSERT_PARAM(issued_at_out);
+    BSON_ASSERT_PARAM(signature_out);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    if (cache->assertion_set
+        && 0 == memcmp(cache->assertion_claims_hash, claims_hash, sizeof(cache->assertion_claims_hash))) {
+        *issued_at_out = cache->assertion_issued_at;
+        memcpy(signature_out, cache->assertion_signature, sizeof(cache->assertion_signature));
+        found = true;
+    }
+    _mongocrypt_mutex_unlock(&cache->mutex);
+    return found;
+}
+
+void _mongocrypt_cache_oauth_add_assertion(_mongocrypt_cache_oauth_t *cache,
+                                           const uint8_t *claims_hash,
+                                           uint64_t issued_at,
+                                           const uint8_t *signature) {
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(claims_hash);
+    BSON_ASSERT_PARAM(signature);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    memcpy(cache->assertion_claims_hash, claims_hash, sizeof(cache->assertion_claims_hash));
+    cache->assertion_issued_at = issued_at;
+    memcpy(cache->assertion_signature, signature, sizeof(cache->assertion_signature));
+    cache->assertion_set = true;
+    _mongocrypt_mutex_unlock(&cache->mutex);
+}
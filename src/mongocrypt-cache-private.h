@@ -31,6 +31,7 @@ typedef bool (*cache_compare_fn)(void *thing_a, void *thing_b, int *out);
 typedef void (*cache_destroy_fn)(void *thing);
 typedef void *(*cache_copy_fn)(void *thing);
 typedef void (*cache_dump_fn)(void *thing);
+typedef void (*cache_evict_fn)(void *ctx, void *value);
 
 typedef struct __mongocrypt_cache_pair_t {
     void *attr;
@@ -49,6 +50,10 @@ typedef struct {
     _mongocrypt_cache_pair_t *pair;
     mongocrypt_mutex_t mutex; /* global lock of cache. */
     uint64_t expiration;
+    /* Optional. Called with on_evict_ctx for each value removed because it
+     * expired, while the cache mutex is held. */
+    cache_evict_fn on_evict;
+    void *on_evict_ctx;
 } _mongocrypt_cache_t;
 
 /* Attempt to get an entry.
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MONGOCRYPT_CACHE_QUERY_PRIVATE_H
+#define MONGOCRYPT_CACHE_QUERY_PRIVATE_H
+
+#include "mongocrypt-buffer-private.h"
+#include "mongocrypt-ciphertext-private.h"
+#include "mongocrypt-mutex-private.h"
+
+/* A bounded LRU cache of FLE2 find payloads shared by all contexts created from
+ * one mongocrypt_t. Find payloads are deterministic given the placeholder and
+ * the index key, so the attribute is a serialization of the placeholder fields
+ * (see _mongocrypt_marking_to_ciphertext). Entries expire with the same
+ * lifetime as the key cache and are removed when the key cache evicts the DEK
+ * they were derived from, so a payload never outlives its cached DEK. Entries
+ * hold derived tokens and are zeroed when removed.
+ *
+ * The same structure caches FLE1 deterministic ciphertexts. There the
+ * attribute is an HMAC of the key material, associated data and plaintext.
+ *
+ * The cache is disabled (capacity 0) until a capacity is set. */
+typedef struct __mongocrypt_cache_query_entry_t {
+    uint64_t hash;
+    _mongocrypt_buffer_t attr;
+    /* The id of the DEK the entry was derived from. Empty if not known. */
+    _mongocrypt_buffer_t key_id;
+    _mongocrypt_ciphertext_t ciphertext;
+    int64_t last_updated;
+    struct __mongocrypt_cache_query_entry_t *bucket_next;
+    struct __mongocrypt_cache_query_entry_t *lru_prev;
+    struct __mongocrypt_cache_query_entry_t *lru_next;
+} _mongocrypt_cache_query_entry_t;
+
+typedef struct {
+    _mongocrypt_cache_query_entry_t **buckets;
+    size_t num_buckets;
+    /* Most recently used entry is at lru_head. */
+    _mongocrypt_cache_query_entry_t *lru_head;
+    _mongocrypt_cache_query_entry_t *lru_tail;
+    uint32_t capacity;
+    uint32_t count;
+    uint64_t hits;
+    uint64_t misses;
+    mongocrypt_mutex_t mutex; /* global lock of cache. */
+} _mongocrypt_cache_query_t;
+
+_mongocrypt_cache_query_t *_mongocrypt_cache_query_new(void);
+
+void _mongocrypt_cache_query_destroy(_mongocrypt_cache_query_t *cache);
+
+/* Sets the maximum number of entries and removes all entries. 0 disables the
+ * cache. */
+void _mongocrypt_cache_query_set_capacity(_mongocrypt_cache_query_t *cache, uint32_t capacity);
+
+/* Copies the cached payload for @attr into @out and returns true on a hit.
+ * Entries older than @expiration_ms are removed. @out must be initialized. */
+bool _mongocrypt_cache_query_get(_mongocrypt_cache_query_t *cache,
+                                 const _mongocrypt_buffer_t *attr,
+                                 uint64_t expiration_ms,
+                                 _mongocrypt_ciphertext_t *out);
+
+/* Adds a copy of @ciphertext for @attr. @key_id identifies the DEK it was
+ * derived from. If @key_id is NULL the entry is not removed by
+ * _mongocrypt_cache_query_remove_key. */
+void _mongocrypt_cache_query_add(_mongocrypt_cache_query_t *cache,
+                                 const _mongocrypt_buffer_t *attr,
+                                 const _mongocrypt_buffer_t *key_id,
+                                 const _mongocrypt_ciphertext_t *ciphertext);
+
+/* Removes all entries derived from the DEK with id @key_id. */
+void _mongocrypt_cache_query_remove_key(_mongocrypt_cache_query_t *cache, const _mongocrypt_buffer_t *key_id);
+
+void _mongocrypt_cache_query_stats(_mongocrypt_cache_query_t *cache, uint64_t *hits, uint64_t *misses);
+
+uint32_t _mongocrypt_cache_query_num_entries(_mongocrypt_cache_query_t *cache);
+
+#endif /* MONGOCRYPT_CACHE_QUERY_PRIVATE_H */
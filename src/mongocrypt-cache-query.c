@@ -0,0 +1,324 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mongocrypt-cache-query-private.h"
+
+#include "mongocrypt-private.h"
+
+/* FNV-1a. Only used to pick a bucket; attributes are compared in full. */
+static uint64_t _hash_attr(const _mongocrypt_buffer_t *attr) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    BSON_ASSERT_PARAM(attr);
+
+    for (uint32_t i = 0; i < attr->len; i++) {
+        hash ^= attr->data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void _copy_ciphertext(const _mongocrypt_ciphertext_t *src, _mongocrypt_ciphertext_t *dst) {
+    BSON_ASSERT_PARAM(src);
+    BSON_ASSERT_PARAM(dst);
+
+    _mongocrypt_buffer_copy_to(&src->key_id, &dst->key_id);
+    _mongocrypt_buffer_copy_to(&src->data, &dst->data);
+    dst->blob_subtype = src->blob_subtype;
+    dst->original_bson_type = src->original_bson_type;
+    dst->data_has_subtype = src->data_has_subtype;
+}
+
+/* Caller must hold lock. */
+static void _lru_unlink(_mongocrypt_cache_query_t *cache, _mongocrypt_cache_query_entry_t *entry) {
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(entry);
+
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        cache->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        cache->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+/* Caller must hold lock. */
+static void _lru_push_front(_mongocrypt_cache_query_t *cache, _mongocrypt_cache_query_entry_t *entry) {
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(entry);
+
+    entry->lru_prev = NULL;
+    entry->lru_next = cache->lru_head;
+    if (cache->lru_head) {
+        cache->lru_head->lru_prev = entry;
+    } else {
+        cache->lru_tail = entry;
+    }
+    cache->lru_head = entry;
+}
+
+/* Zeroes a buffer before it is freed. */
+static void _zero_buffer(_mongocrypt_buffer_t *buf) {
+    BSON_ASSERT_PARAM(buf);
+
+    if (buf->data && buf->len > 0) {
+        memset(buf->data, 0, buf->len);
+    }
+}
+
+static void _entry_destroy(_mongocrypt_cache_query_entry_t *entry) {
+    if (!entry) {
+        return;
+    }
+    /* Entries hold tokens derived from the DEK. */
+    _zero_buffer(&entry->attr);
+    _zero_buffer(&entry->ciphertext.data);
+    _mongocrypt_buffer_cleanup(&entry->attr);
+    _mongocrypt_buffer_cleanup(&entry->key_id);
+    _mongocrypt_ciphertext_cleanup(&entry->ciphertext);
+    bson_free(entry);
+}
+
+/* Unlink from its bucket and the LRU list, then destroy. Caller must hold
+ * lock. */
+static void _remove_entry(_mongocrypt_cache_query_t *cache, _mongocrypt_cache_query_entry_t *entry) {
+    _mongocrypt_cache_query_entry_t **link;
+
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(entry);
+
+    link = &cache->buckets[entry->hash & (cache->num_buckets - 1)];
+    while (*link != entry) {
+        BSON_ASSERT(*link);
+        link = &(*link)->bucket_next;
+    }
+    *link = entry->bucket_next;
+    _lru_unlink(cache, entry);
+    _entry_destroy(entry);
+    cache->count--;
+}
+
+/* Caller must hold lock. */
+static _mongocrypt_cache_query_entry_t *
+_find_entry(_mongocrypt_cache_query_t *cache, const _mongocrypt_buffer_t *attr, uint64_t hash) {
+    _mongocrypt_cache_query_entry_t *entry;
+
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(attr);
+
+    for (entry = cache->buckets[hash & (cache->num_buckets - 1)]; entry; entry = entry->bucket_next) {
+        if (entry->hash == hash && 0 == _mongocrypt_buffer_cmp(&entry->attr, attr)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* Caller must hold lock. */
+static void _clear(_mongocrypt_cache_query_t *cache) {
+    _mongocrypt_cache_query_entry_t *entry, *tmp;
+
+    BSON_ASSERT_PARAM(cache);
+
+    entry = cache->lru_head;
+    while (entry) {
+        tmp = entry->lru_next;
+        _entry_destroy(entry);
+        entry = tmp;
+    }
+    bson_free(cache->buckets);
+    cache->buckets = NULL;
+    cache->num_buckets = 0;
+    cache->lru_head = NULL;
+    cache->lru_tail = NULL;
+    cache->count = 0;
+}
+
+_mongocrypt_cache_query_t *_mongocrypt_cache_query_new(void) {
+    _mongocrypt_cache_query_t *cache;
+
+    cache = bson_malloc0(sizeof(_mongocrypt_cache_query_t));
+    BSON_ASSERT(cache);
+    _mongocrypt_mutex_init(&cache->mutex);
+    return cache;
+}
+
+void _mongocrypt_cache_query_destroy(_mongocrypt_cache_query_t *cache) {
+    if (!cache) {
+        return;
+    }
+
+    _clear(cache);
+    _mongocrypt_mutex_cleanup(&cache->mutex);
+    bson_free(cache);
+}
+
+void _mongocrypt_cache_query_set_capacity(_mongocrypt_cache_query_t *cache, uint32_t capacity) {
+    BSON_ASSERT_PARAM(cache);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    _clear(cache);
+    cache->capacity = capacity;
+    if (capacity > 0) {
+        /* A power of two at least as large as capacity, so the average chain
+         * length stays at most one. */
+        cache->num_buckets = 1;
+        while (cache->num_buckets < capacity) {
+            cache->num_buckets *= 2;
+        }
+        cache->buckets = bson_malloc0(cache->num_buckets * sizeof(_mongocrypt_cache_query_entry_t *));
+        BSON_ASSERT(cache->buckets);
+    }
+    _mongocrypt_mutex_unlock(&cache->mutex);
+}
+
+bool _mongocrypt_cache_query_get(_mongocrypt_cache_query_t *cache,
+                                 const _mongocrypt_buffer_t *attr,
+                                 uint64_t expiration_ms,
+                                 _mongocrypt_ciphertext_t *out) {
+    _mongocrypt_cache_query_entry_t *entry;
+    uint64_t hash;
+    int64_t current;
+    bool found = false;
+
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(attr);
+    BSON_ASSERT_PARAM(out);
+
+    if (0 == cache->capacity) {
+        return false;
+    }
+
+    hash = _hash_attr(attr);
+    current = bson_get_monotonic_time() / 1000;
+    BSON_ASSERT(expiration_ms <= INT64_MAX);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    entry = _find_entry(cache, attr, hash);
+    if (entry && (current - entry->last_updated) > (int64_t)expiration_ms) {
+        _remove_entry(cache, entry);
+        entry = NULL;
+    }
+
+    if (entry) {
+        _copy_ciphertext(&entry->ciphertext, out);
+        _lru_unlink(cache, entry);
+        _lru_push_front(cache, entry);
+        cache->hits++;
+        found = true;
+    } else {
+        cache->misses++;
+    }
+    _mongocrypt_mutex_unlock(&cache->mutex);
+    return found;
+}
+
+void _mongocrypt_cache_query_add(_mongocrypt_cache_query_t *cache,
+                                 const _mongocrypt_buffer_t *attr,
+                                 const _mongocrypt_buffer_t *key_id,
+                                 const _mongocrypt_ciphertext_t *ciphertext) {
+    _mongocrypt_cache_query_entry_t *entry;
+    _mongocrypt_cache_query_entry_t **bucket;
+    uint64_t hash;
+
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(attr);
+    /* key_id may be NULL. */
+    BSON_ASSERT_PARAM(ciphertext);
+
+    if (0 == cache->capacity) {
+        return;
+    }
+
+    hash = _hash_attr(attr);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    /* Another context may have added the same payload concurrently. */
+    entry = _find_entry(cache, attr, hash);
+    if (entry) {
+        _remove_entry(cache, entry);
+    }
+
+    if (cache->count == cache->capacity) {
+        _remove_entry(cache, cache->lru_tail);
+    }
+
+    entry = bson_malloc0(sizeof(_mongocrypt_cache_query_entry_t));
+    BSON_ASSERT(entry);
+    entry->hash = hash;
+    _mongocrypt_buffer_copy_to(attr, &entry->attr);
+    if (key_id) {
+        _mongocrypt_buffer_copy_to(key_id, &entry->key_id);
+    }
+    _mongocrypt_ciphertext_init(&entry->ciphertext);
+    _copy_ciphertext(ciphertext, &entry->ciphertext);
+    entry->last_updated = bson_get_monotonic_time() / 1000;
+
+    bucket = &cache->buckets[hash & (cache->num_buckets - 1)];
+    entry->bucket_next = *bucket;
+    *bucket = entry;
+    _lru_push_front(cache, entry);
+    cache->count++;
+    _mongocrypt_mutex_unlock(&cache->mutex);
+}
+
+void _mongocrypt_cache_query_remove_key(_mongocrypt_cache_query_t *cache, const _mongocrypt_buffer_t *key_id) {
+    _mongocrypt_cache_query_entry_t *entry, *tmp;
+
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(key_id);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    entry = cache->lru_head;
+    while (entry) {
+        tmp = entry->lru_next;
+        if (0 == _mongocrypt_buffer_cmp(&entry->key_id, key_id)) {
+            _remove_entry(cache, entry);
+        }
+        entry = tmp;
+    }
+    _mongocrypt_mutex_unlock(&cache->mutex);
+}
+
+void _mongocrypt_cache_query_stats(_mongocrypt_cache_query_t *cache, uint64_t *hits, uint64_t *misses) {
+    BSON_ASSERT_PARAM(cache);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    if (hits) {
+        *hits = cache->hits;
+    }
+    if (misses) {
+        *misses = cache->misses;
+    }
+    _mongocrypt_mutex_unlock(&cache->mutex);
+}
+
+uint32_t _mongocrypt_cache_query_num_entries(_mongocrypt_cache_query_t *cache) {
+    uint32_t count;
+
+    BSON_ASSERT_PARAM(cache);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    count = cache->count;
+    _mongocrypt_mutex_unlock(&cache->mutex);
+    return count;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MONGOCRYPT_CACHE_SIGNING_KEY_PRIVATE_H
+#define MONGOCRYPT_CACHE_SIGNING_KEY_PRIVATE_H
+
+#include "mongocrypt-mutex-private.h"
+
+#define MONGOCRYPT_SIGNING_KEY_LEN 32
+#define MONGOCRYPT_SIGNING_KEY_CACHE_SIZE 8
+
+/* A small cache of derived AWS SigV4 signing keys shared by all KMS requests
+ * created from one mongocrypt_t. Entries are keyed by a hash of the secret key
+ * and credential scope (date, region, service) computed by kms-message. The
+ * least recently used entry is replaced when the cache is full. */
+typedef struct {
+    uint8_t scope_hash[MONGOCRYPT_SIGNING_KEY_LEN];
+    uint8_t key[MONGOCRYPT_SIGNING_KEY_LEN];
+    uint64_t last_used;
+    bool set;
+} _mongocrypt_cache_signing_key_entry_t;
+
+typedef struct {
+    _mongocrypt_cache_signing_key_entry_t entries[MONGOCRYPT_SIGNING_KEY_CACHE_SIZE];
+    uint64_t counter;
+    mongocrypt_mutex_t mutex; /* global lock of cache. */
+} _mongocrypt_cache_signing_key_t;
+
+_mongocrypt_cache_signing_key_t *_mongocrypt_cache_signing_key_new(void);
+
+void _mongocrypt_cache_signing_key_destroy(_mongocrypt_cache_signing_key_t *cache);
+
+/* Copies the signing key for @scope_hash into @key_out and returns true if it
+ * is cached. Returns false on a cache miss. */
+bool _mongocrypt_cache_signing_key_get(_mongocrypt_cache_signing_key_t *cache,
+                                       const uint8_t *scope_hash,
+                                       uint8_t *key_out);
+
+void _mongocrypt_cache_signing_key_add(_mongocrypt_cache_signing_key_t *cache,
+                                       const uint8_t *scope_hash,
+                                       const uint8_t *key);
+
+#endif /* MONGOCRYPT_CACHE_SIGNING_KEY_PRIVATE_H */
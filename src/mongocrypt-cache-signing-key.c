@@ -0,0 +1,94 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "mongocrypt-cache-signing-key-private.h"
+
+#include "mongocrypt-private.h"
+
+_mongocrypt_cache_signing_key_t *_mongocrypt_cache_signing_key_new(void) {
+    _mongocrypt_cache_signing_key_t *cache;
+
+    cache = bson_malloc0(sizeof(_mongocrypt_cache_signing_key_t));
+    _mongocrypt_mutex_init(&cache->mutex);
+    return cache;
+}
+
+void _mongocrypt_cache_signing_key_destroy(_mongocrypt_cache_signing_key_t *cache) {
+    if (!cache) {
+        return;
+    }
+
+    _mongocrypt_mutex_cleanup(&cache->mutex);
+    /* Signing keys are secret. Zero them before freeing. */
+    bson_zero_free(cache, sizeof(*cache));
+}
+
+bool _mongocrypt_cache_signing_key_get(_mongocrypt_cache_signing_key_t *cache,
+                                       const uint8_t *scope_hash,
+                                       uint8_t *key_out) {
+    bool found = false;
+
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(scope_hash);
+    BSON_ASSERT_PARAM(key_out);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    for (size_t i = 0; i < MONGOCRYPT_SIGNING_KEY_CACHE_SIZE; i++) {
+        _mongocrypt_cache_signing_key_entry_t *entry = &cache->entries[i];
+
+        if (entry->set && 0 == memcmp(entry->scope_hash, scope_hash, MONGOCRYPT_SIGNING_KEY_LEN)) {
+            memcpy(key_out, entry->key, MONGOCRYPT_SIGNING_KEY_LEN);
+            entry->last_used = ++cache->counter;
+            found = true;
+            break;
+        }
+    }
+    _mongocrypt_mutex_unlock(&cache->mutex);
+    return found;
+}
+
+void _mongocrypt_cache_signing_key_add(_mongocrypt_cache_signing_key_t *cache,
+                                       const uint8_t *scope_hash,
+                                       const uint8_t *key) {
+    _mongocrypt_cache_signing_key_entry_t *victim;
+
+    BSON_ASSERT_PARAM(cache);
+    BSON_ASSERT_PARAM(scope_hash);
+    BSON_ASSERT_PARAM(key);
+
+    _mongocrypt_mutex_lock(&cache->mutex);
+    victim = &cache->entries[0];
+    for (size_t i = 0; i < MONGOCRYPT_SIGNING_KEY_CACHE_SIZE; i++) {
+        _mongocrypt_cache_signing_key_entry_t *entry = &cache->entries[i];
+
+        /* Another thread may have added the same key concurrently. */
+        if (entry->set && 0 == memcmp(entry->scope_hash, scope_hash, MONGOCRYPT_SIGNING_KEY_LEN)) {
+            victim = entry;
+            break;
+        }
+        if (!entry->set) {
+            victim = entry;
+        } else if (victim->set && entry->last_used < victim->last_used) {
+            victim = entry;
+        }
+    }
+    memcpy(victim->scope_hash, scope_hash, MONGOCRYPT_SIGNING_KEY_LEN);
+    memcpy(victim->key, key, MONGOCRYPT_SIGNING_KEY_LEN);
+    victim->last_used = ++cache->counter;
+    victim->set = true;
+    _mongocrypt_mutex_unlock(&cache->mutex);
+}
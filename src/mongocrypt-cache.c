@@ -67,6 +67,9 @@ static void _mongocrypt_cache_evict(_mongocrypt_cache_t *cache) {
     pair = cache->pair;
     while (pair) {
         if (_pair_expired(cache, pair)) {
+            if (cache->on_evict) {
+                cache->on_evict(cache->on_evict_ctx, pair->value);
+            }
             pair = _destroy_pair(cache, prev, pair);
             continue;
         }
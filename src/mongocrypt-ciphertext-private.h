@@ -33,6 +33,9 @@ typedef struct {
     mc_fle_blob_subtype_t blob_subtype;
     uint8_t original_bson_type;
     _mongocrypt_buffer_t data;
+    /* True if data is already the complete BSON binary subtype 6 payload,
+     * starting with the blob_subtype byte. */
+    bool data_has_subtype;
 } _mongocrypt_ciphertext_t;
 
 void _mongocrypt_ciphertext_init(_mongocrypt_ciphertext_t *ciphertext);
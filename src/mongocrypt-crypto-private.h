@@ -166,6 +166,25 @@ bool _mongocrypt_hmac_sha_256(_mongocrypt_crypto_t *crypto,
                               _mongocrypt_buffer_t *out,
                               mongocrypt_status_t *status);
 
+/*
+ * _mongocrypt_hmac_sha_256_many computes @count HMAC SHA-256 values, with
+ * @out[i] = HMAC(@keys[i], @in[i]).
+ *
+ * Without hooks, independent inputs are hashed together on SIMD lanes.
+ * With hooks, each input calls the hmac_sha_256 hook.
+ *
+ * Each @out[i] must have length 32 bytes.
+ *
+ * Returns true if no error occurred.
+ * Returns false sets @status if an error occurred.
+ */
+bool _mongocrypt_hmac_sha_256_many(_mongocrypt_crypto_t *crypto,
+                                   const _mongocrypt_buffer_t *const *keys,
+                                   const _mongocrypt_buffer_t *const *in,
+                                   _mongocrypt_buffer_t *out,
+                                   size_t count,
+                                   mongocrypt_status_t *status);
+
 /* Crypto implementations must implement these functions. */
 
 /* This variable must be defined in implementation
@@ -206,4 +225,15 @@ bool _native_crypto_hmac_sha_256(const _mongocrypt_buffer_t *key,
                                  _mongocrypt_buffer_t *out,
                                  mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
 
+#ifdef MONGOCRYPT_ENABLE_CRYPTO_BUILTIN
+/* _builtin_crypto_sign_rsaes_pkcs1_v1_5 signs @in with RSASSA-PKCS1-v1_5 and
+ * SHA-256. @key is a DER PKCS#8 or PKCS#1 RSA private key. @out must be the
+ * length of the modulus. Used for GCP since the built-in crypto has no
+ * libcrypto for kms-message. */
+bool _builtin_crypto_sign_rsaes_pkcs1_v1_5(const _mongocrypt_buffer_t *key,
+                                           const _mongocrypt_buffer_t *in,
+                                           _mongocrypt_buffer_t *out,
+                                           mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
+#endif
+
 #endif /* MONGOCRYPT_CRYPTO_PRIVATE_H */
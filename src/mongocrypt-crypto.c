@@ -21,6 +21,7 @@
 
 #include <bson/bson.h>
 
+#include "mc-sha256-private.h"
 #include "mongocrypt-binary-private.h"
 #include "mongocrypt-buffer-private.h"
 #include "mongocrypt-crypto-private.h"
@@ -318,6 +319,59 @@ bool _mongocrypt_hmac_sha_256(_mongocrypt_crypto_t *crypto,
     return _native_crypto_hmac_sha_256(key, in, out, status);
 }
 
+bool _mongocrypt_hmac_sha_256_many(_mongocrypt_crypto_t *crypto,
+                                   const _mongocrypt_buffer_t *const *keys,
+                                   const _mongocrypt_buffer_t *const *in,
+                                   _mongocrypt_buffer_t *out,
+                                   size_t count,
+                                   mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(crypto);
+    BSON_ASSERT(keys || count == 0);
+    BSON_ASSERT(in || count == 0);
+    BSON_ASSERT(out || count == 0);
+
+    bool batch = false;
+#ifdef MONGOCRYPT_ENABLE_CRYPTO
+    /* Hooks and single inputs go through the regular path. */
+    batch = !crypto->hooks_enabled && count > 1 && mc_sha256_impl_lanes(MC_SHA256_IMPL_AUTO) > 1;
+#endif
+    if (!batch) {
+        for (size_t i = 0; i < count; i++) {
+            if (!_mongocrypt_hmac_sha_256(crypto, keys[i], in[i], &out[i], status)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    BSON_ASSERT(count <= SIZE_MAX / sizeof(mc_hmac_sha256_job_t));
+    mc_hmac_sha256_job_t *jobs = bson_malloc(count * sizeof(mc_hmac_sha256_job_t));
+    for (size_t i = 0; i < count; i++) {
+        BSON_ASSERT_PARAM(keys[i]);
+        BSON_ASSERT_PARAM(in[i]);
+        if (keys[i]->len != MONGOCRYPT_MAC_KEY_LEN) {
+            CLIENT_ERR("invalid hmac_sha_256 key length. Got %" PRIu32 ", expected: %" PRIu32,
+                       keys[i]->len,
+                       MONGOCRYPT_MAC_KEY_LEN);
+            bson_free(jobs);
+            return false;
+        }
+        if (out[i].len != MC_SHA256_LEN) {
+            CLIENT_ERR("out does not contain %d bytes", MC_SHA256_LEN);
+            bson_free(jobs);
+            return false;
+        }
+        jobs[i].key = keys[i]->data;
+        jobs[i].key_len = keys[i]->len;
+        jobs[i].in = in[i]->data;
+        jobs[i].in_len = in[i]->len;
+        jobs[i].out = out[i].data;
+    }
+    mc_hmac_sha256_many(MC_SHA256_IMPL_AUTO, jobs, count);
+    bson_free(jobs);
+    return true;
+}
+
 static bool
 _crypto_random(_mongocrypt_crypto_t *crypto, _mongocrypt_buffer_t *out, uint32_t count, mongocrypt_status_t *status) {
     BSON_ASSERT_PARAM(crypto);
@@ -31,6 +31,14 @@ static void _cleanup(mongocrypt_ctx_t *ctx) {
     _mongocrypt_buffer_cleanup(&dkctx->plaintext_key_material);
     _mongocrypt_buffer_cleanup(&dkctx->kmip_secretdata);
     bson_free((void *)dkctx->kmip_unique_identifier);
+    /* Let another context fetch a token if this one did not finish. */
+    if (dkctx->oauth_claimed) {
+        if (ctx->opts.kek.kms_provider == MONGOCRYPT_KMS_PROVIDER_AZURE) {
+            _mongocrypt_cache_oauth_release(ctx->crypt->cache_oauth_azure);
+        } else if (ctx->opts.kek.kms_provider == MONGOCRYPT_KMS_PROVIDER_GCP) {
+            _mongocrypt_cache_oauth_release(ctx->crypt->cache_oauth_gcp);
+        }
+    }
 }
 
 static mongocrypt_kms_ctx_t *_next_kms_ctx(mongocrypt_ctx_t *ctx) {
@@ -204,7 +212,9 @@ static bool _kms_start(mongocrypt_ctx_t *ctx) {
                                                   &ctx->opts,
                                                   &dkctx->plaintext_key_material,
                                                   &ctx->crypt->log,
-                                                  ctx->crypt->crypto)) {
+                                                  ctx->crypt->crypto,
+                                                  ctx->crypt->cache_signing_key,
+                                                  ctx->crypt->opts.use_kms_keep_alive)) {
             mongocrypt_kms_ctx_status(&dkctx->kms, ctx->status);
             _mongocrypt_ctx_fail(ctx);
             goto done;
@@ -215,7 +225,12 @@ static bool _kms_start(mongocrypt_ctx_t *ctx) {
         if (ctx->kms_providers.azure.access_token) {
             access_token = bson_strdup(ctx->kms_providers.azure.access_token);
         } else {
-            access_token = _mongocrypt_cache_oauth_get(ctx->crypt->cache_oauth_azure);
+            bool claimed;
+
+            access_token = _mongocrypt_cache_oauth_get_or_claim(ctx->crypt->cache_oauth_azure, &claimed);
+            if (claimed) {
+                dkctx->oauth_claimed = true;
+            }
         }
         if (access_token) {
             if (!_mongocrypt_kms_ctx_init_azure_wrapkey(&dkctx->kms,
@@ -223,7 +238,8 @@ static bool _kms_start(mongocrypt_ctx_t *ctx) {
                                                         kms_providers,
                                                         &ctx->opts,
                                                         access_token,
-                                                        &dkctx->plaintext_key_material)) {
+                                                        &dkctx->plaintext_key_material,
+                                                        ctx->crypt->opts.use_kms_keep_alive)) {
                 mongocrypt_kms_ctx_status(&dkctx->kms, ctx->status);
                 _mongocrypt_ctx_fail(ctx);
                 goto done;
@@ -232,7 +248,8 @@ static bool _kms_start(mongocrypt_ctx_t *ctx) {
             if (!_mongocrypt_kms_ctx_init_azure_auth(&dkctx->kms,
                                                      &ctx->crypt->log,
                                                      kms_providers,
-                                                     ctx->opts.kek.provider.azure.key_vault_endpoint)) {
+                                                     ctx->opts.kek.provider.azure.key_vault_endpoint,
+                                                     ctx->crypt->opts.use_kms_keep_alive)) {
                 mongocrypt_kms_ctx_status(&dkctx->kms, ctx->status);
                 _mongocrypt_ctx_fail(ctx);
                 goto done;
@@ -243,7 +260,12 @@ static bool _kms_start(mongocrypt_ctx_t *ctx) {
         if (NULL != ctx->kms_providers.gcp.access_token) {
             access_token = bson_strdup((const char *)ctx->kms_providers.gcp.access_token);
         } else {
-            access_token = _mongocrypt_cache_oauth_get(ctx->crypt->cache_oauth_gcp);
+            bool claimed;
+
+            access_token = _mongocrypt_cache_oauth_get_or_claim(ctx->crypt->cache_oauth_gcp, &claimed);
+            if (claimed) {
+                dkctx->oauth_claimed = true;
+            }
         }
         if (access_token) {
             if (!_mongocrypt_kms_ctx_init_gcp_encrypt(&dkctx->kms,
@@ -251,7 +273,8 @@ static bool _kms_start(mongocrypt_ctx_t *ctx) {
                                                       kms_providers,
                                                       &ctx->opts,
                                                       access_token,
-                                                      &dkctx->plaintext_key_material)) {
+                                                      &dkctx->plaintext_key_material,
+                                                      ctx->crypt->opts.use_kms_keep_alive)) {
                 mongocrypt_kms_ctx_status(&dkctx->kms, ctx->status);
                 _mongocrypt_ctx_fail(ctx);
                 goto done;
@@ -260,8 +283,11 @@ static bool _kms_start(mongocrypt_ctx_t *ctx) {
             if (!_mongocrypt_kms_ctx_init_gcp_auth(&dkctx->kms,
                                                    &ctx->crypt->log,
                                                    &ctx->crypt->opts,
+                                                   ctx->crypt->crypto,
+                                                   ctx->crypt->cache_oauth_gcp,
                                                    kms_providers,
-                                                   ctx->opts.kek.provider.gcp.endpoint)) {
+                                                   ctx->opts.kek.provider.gcp.endpoint,
+                                                   ctx->crypt->opts.use_kms_keep_alive)) {
                 mongocrypt_kms_ctx_status(&dkctx->kms, ctx->status);
                 _mongocrypt_ctx_fail(ctx);
                 goto done;
@@ -286,6 +312,7 @@ done:
 static bool _kms_done(mongocrypt_ctx_t *ctx) {
     _mongocrypt_ctx_datakey_t *dkctx;
     mongocrypt_status_t *status;
+    bool ok;
 
     BSON_ASSERT_PARAM(ctx);
 
@@ -305,7 +332,14 @@ static bool _kms_done(mongocrypt_ctx_t *ctx) {
         bson_t oauth_response;
 
         BSON_ASSERT(_mongocrypt_buffer_to_bson(&dkctx->kms.result, &oauth_response));
-        if (!_mongocrypt_cache_oauth_add(ctx->crypt->cache_oauth_azure, &oauth_response, status)) {
+        ok = _mongocrypt_cache_oauth_add(ctx->crypt->cache_oauth_azure, &oauth_response, status);
+        /* Only the claimant releases the claim, whether or not the token was
+         * added. */
+        if (dkctx->oauth_claimed) {
+            _mongocrypt_cache_oauth_release(ctx->crypt->cache_oauth_azure);
+            dkctx->oauth_claimed = false;
+        }
+        if (!ok) {
             return _mongocrypt_ctx_fail(ctx);
         }
         return _kms_start(ctx);
@@ -313,7 +347,14 @@ static bool _kms_done(mongocrypt_ctx_t *ctx) {
         bson_t oauth_response;
 
         BSON_ASSERT(_mongocrypt_buffer_to_bson(&dkctx->kms.result, &oauth_response));
-        if (!_mongocrypt_cache_oauth_add(ctx->crypt->cache_oauth_gcp, &oauth_response, status)) {
+        ok = _mongocrypt_cache_oauth_add(ctx->crypt->cache_oauth_gcp, &oauth_response, status);
+        /* Only the claimant releases the claim, whether or not the token was
+         * added. */
+        if (dkctx->oauth_claimed) {
+            _mongocrypt_cache_oauth_release(ctx->crypt->cache_oauth_gcp);
+            dkctx->oauth_claimed = false;
+        }
+        if (!ok) {
             return _mongocrypt_ctx_fail(ctx);
         }
         return _kms_start(ctx);
@@ -404,6 +404,13 @@ static bool _replace_ciphertext_with_plaintext(void *ctx,
     }
 }
 
+/* _decrypt_paths returns the paths set by mongocrypt_ctx_setopt_decrypt_paths,
+ * or NULL to decrypt everything. */
+static const mc_array_t *_decrypt_paths(const mongocrypt_ctx_t *ctx) {
+    BSON_ASSERT_PARAM(ctx);
+    return ctx->opts.decrypt_paths.set ? &ctx->opts.decrypt_paths.value : NULL;
+}
+
 static bool _finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
     bson_t as_bson, final_bson;
     bson_iter_t iter;
@@ -421,7 +428,12 @@ static bool _finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
     dctx = (_mongocrypt_ctx_decrypt_t *)ctx;
 
     if (ctx->nothing_to_do) {
+        /* original_doc is the caller's data if borrow_input is set. */
         _mongocrypt_buffer_to_binary(&dctx->original_doc, out);
+        MONGOCRYPT_WITH_MUTEX(ctx->crypt->mutex) {
+            ctx->crypt->decrypt_finalized++;
+            ctx->crypt->decrypt_passthrough++;
+        }
         ctx->state = MONGOCRYPT_CTX_DONE;
         return true;
     }
@@ -432,12 +444,13 @@ static bool _finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
 
     bson_iter_init(&iter, &as_bson);
     bson_init(&final_bson);
-    res = _mongocrypt_transform_binary_in_bson(_replace_ciphertext_with_plaintext,
-                                               &ctx->kb,
-                                               TRAVERSE_MATCH_CIPHERTEXT,
-                                               &iter,
-                                               &final_bson,
-                                               ctx->status);
+    res = _mongocrypt_transform_binary_in_bson_at_paths(_replace_ciphertext_with_plaintext,
+                                                        &ctx->kb,
+                                                        TRAVERSE_MATCH_CIPHERTEXT,
+                                                        _decrypt_paths(ctx),
+                                                        &iter,
+                                                        &final_bson,
+                                                        ctx->status);
     if (!res) {
         bson_destroy(&final_bson);
         return _mongocrypt_ctx_fail(ctx);
@@ -446,6 +459,9 @@ static bool _finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
     _mongocrypt_buffer_steal_from_bson(&dctx->decrypted_doc, &final_bson);
     out->data = dctx->decrypted_doc.data;
     out->len = dctx->decrypted_doc.len;
+    MONGOCRYPT_WITH_MUTEX(ctx->crypt->mutex) {
+        ctx->crypt->decrypt_finalized++;
+    }
     ctx->state = MONGOCRYPT_CTX_DONE;
     return true;
 }
@@ -611,11 +627,12 @@ static bool _check_for_K_KeyId(mongocrypt_ctx_t *ctx) {
     }
     bson_iter_init(&iter, &as_bson);
 
-    if (!_mongocrypt_traverse_binary_in_bson(_collect_K_KeyIDs,
-                                             &ctx->kb,
-                                             TRAVERSE_MATCH_CIPHERTEXT,
-                                             &iter,
-                                             ctx->status)) {
+    if (!_mongocrypt_traverse_binary_in_bson_at_paths(_collect_K_KeyIDs,
+                                                      &ctx->kb,
+                                                      TRAVERSE_MATCH_CIPHERTEXT,
+                                                      _decrypt_paths(ctx),
+                                                      &iter,
+                                                      ctx->status)) {
         return _mongocrypt_ctx_fail(ctx);
     }
 
@@ -771,6 +788,10 @@ bool mongocrypt_ctx_explicit_decrypt_init(mongocrypt_ctx_t *ctx, mongocrypt_bina
         return _mongocrypt_ctx_fail_w_msg(ctx, "invalid msg");
     }
 
+    if (ctx->opts.decrypt_paths.set) {
+        return _mongocrypt_ctx_fail_w_msg(ctx, "decrypt paths are prohibited on explicit decryption");
+    }
+
     if (ctx->crypt->log.trace_enabled) {
         char *msg_val;
         msg_val = _mongocrypt_new_json_string_from_binary(msg);
@@ -847,6 +868,8 @@ bool mongocrypt_ctx_decrypt_init(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *doc
     _mongocrypt_ctx_opts_spec_t opts_spec;
 
     memset(&opts_spec, 0, sizeof(opts_spec));
+    opts_spec.borrow_input = OPT_OPTIONAL;
+    opts_spec.decrypt_paths = OPT_OPTIONAL;
     if (!ctx) {
         return false;
     }
@@ -872,18 +895,33 @@ bool mongocrypt_ctx_decrypt_init(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *doc
     ctx->vtable.mongo_done_keys = _mongo_done_keys;
     ctx->vtable.kms_done = _kms_done;
 
-    _mongocrypt_buffer_copy_from_binary(&dctx->original_doc, doc);
+    if (ctx->opts.borrow_input) {
+        _mongocrypt_buffer_from_binary(&dctx->original_doc, doc);
+    } else {
+        _mongocrypt_buffer_copy_from_binary(&dctx->original_doc, doc);
+    }
+
+    /* Most replies contain no ciphertexts. Skim the raw bytes to skip both
+     * traversals below. finalize then returns original_doc as-is. */
+    size_t num_ciphertexts;
+    if (_mongocrypt_scan_binary_in_bson(&dctx->original_doc, TRAVERSE_MATCH_CIPHERTEXT, NULL, &num_ciphertexts)
+        && num_ciphertexts == 0) {
+        (void)_mongocrypt_key_broker_requests_done(&ctx->kb);
+        return _mongocrypt_ctx_state_from_key_broker(ctx);
+    }
+
     /* get keys. */
     if (!_mongocrypt_buffer_to_bson(&dctx->original_doc, &as_bson)) {
         return _mongocrypt_ctx_fail_w_msg(ctx, "malformed bson");
     }
 
     bson_iter_init(&iter, &as_bson);
-    if (!_mongocrypt_traverse_binary_in_bson(_collect_key_from_ciphertext,
-                                             &ctx->kb,
-                                             TRAVERSE_MATCH_CIPHERTEXT,
-                                             &iter,
-                                             ctx->status)) {
+    if (!_mongocrypt_traverse_binary_in_bson_at_paths(_collect_key_from_ciphertext,
+                                                      &ctx->kb,
+                                                      TRAVERSE_MATCH_CIPHERTEXT,
+                                                      _decrypt_paths(ctx),
+                                                      &iter,
+                                                      ctx->status)) {
         return _mongocrypt_ctx_fail(ctx);
     }
 
@@ -562,7 +562,50 @@ static bool _mongo_done_collinfo(mongocrypt_ctx_t *ctx) {
     return _try_run_csfle_marking(ctx);
 }
 
-static bool _fle2_mongo_op_markings(mongocrypt_ctx_t *ctx, bson_t *out) {
+/* Room reserved for the fields appended to a command sent for query analysis:
+ * 'jsonSchema' and 'isRemoteSchema' or 'encryptionInformation', and '$db'. */
+#define MARKINGS_CMD_OVERHEAD 256
+
+/* _bson_init_sized initializes @p out with capacity for @p size bytes. Large
+ * commands are then built without repeatedly growing and copying the buffer. */
+static void _bson_init_sized(bson_t *out, size_t size) {
+    BSON_ASSERT_PARAM(out);
+
+    bson_t *sized = bson_sized_new(BSON_MIN(size, BSON_MAX_SIZE));
+    BSON_ASSERT(bson_steal(out, sized));
+}
+
+/* _release_buffer frees a buffer that is no longer needed before the context
+ * is destroyed. */
+static void _release_buffer(_mongocrypt_buffer_t *buf) {
+    BSON_ASSERT_PARAM(buf);
+
+    _mongocrypt_buffer_cleanup(buf);
+    _mongocrypt_buffer_init(buf);
+}
+
+/* _original_cmd_copy_len returns the length of original_cmd, less the
+ * "documents" array if @p omit_documents is set. */
+static size_t _original_cmd_copy_len(_mongocrypt_ctx_encrypt_t *ectx, bool omit_documents) {
+    bson_t cmd_bson;
+    bson_iter_t iter;
+    const uint8_t *documents_data;
+    uint32_t documents_len;
+
+    BSON_ASSERT_PARAM(ectx);
+
+    if (!omit_documents || !_mongocrypt_buffer_to_bson(&ectx->original_cmd, &cmd_bson)
+        || !bson_iter_init_find(&iter, &cmd_bson, "documents") || !BSON_ITER_HOLDS_ARRAY(&iter)) {
+        return ectx->original_cmd.len;
+    }
+    bson_iter_array(&iter, &documents_len, &documents_data);
+    return ectx->original_cmd.len - BSON_MIN(ectx->original_cmd.len, documents_len);
+}
+
+/* _fle2_mongo_op_markings creates the command for query analysis. If
+ * @p omit_documents is set, the "documents" array is not copied so it can be
+ * analyzed in slices. */
+static bool _fle2_mongo_op_markings(mongocrypt_ctx_t *ctx, bson_t *out, bool omit_documents) {
     _mongocrypt_ctx_encrypt_t *ectx;
     bson_t cmd_bson = BSON_INITIALIZER, encrypted_field_config_bson = BSON_INITIALIZER;
 
@@ -587,8 +630,10 @@ static bool _fle2_mongo_op_markings(mongocrypt_ctx_t *ctx, bson_t *out) {
     // If input command included $db, do not include it in the command to
     // mongocryptd. Drivers are expected to append $db in the RunCommand helper
     // used to send the command.
-    bson_init(out);
-    bson_copy_to_excluding_noinit(&cmd_bson, out, "$db", NULL);
+    _bson_init_sized(out,
+                     _original_cmd_copy_len(ectx, omit_documents) + ectx->encrypted_field_config.len
+                         + strlen(ectx->ns) + MARKINGS_CMD_OVERHEAD);
+    bson_copy_to_excluding_noinit(&cmd_bson, out, "$db", omit_documents ? "documents" : NULL, NULL);
     if (!_fle2_insert_encryptionInformation(ctx,
                                             cmd_name,
                                             out,
@@ -609,10 +654,12 @@ static bool _fle2_mongo_op_markings(mongocrypt_ctx_t *ctx, bson_t *out) {
  *
  * @param ctx The encryption context.
  * @param out The destination of the generated BSON document
+ * @param omit_documents If true, the "documents" array of an insert is not
+ * copied. See @ref _csfle_analyze_insert_in_chunks.
  * @return true On success
  * @return false Otherwise. Sets a failing status message in this case.
  */
-static bool _create_markings_cmd_bson(mongocrypt_ctx_t *ctx, bson_t *out) {
+static bool _create_markings_cmd_bson(mongocrypt_ctx_t *ctx, bson_t *out, bool omit_documents) {
     _mongocrypt_ctx_encrypt_t *ectx = (_mongocrypt_ctx_encrypt_t *)ctx;
 
     BSON_ASSERT_PARAM(ctx);
@@ -620,7 +667,7 @@ static bool _create_markings_cmd_bson(mongocrypt_ctx_t *ctx, bson_t *out) {
 
     if (context_uses_fle2(ctx)) {
         // Defer to FLE2 to generate the markings command
-        return _fle2_mongo_op_markings(ctx, out);
+        return _fle2_mongo_op_markings(ctx, out, omit_documents);
     }
 
     // For FLE1:
@@ -635,8 +682,10 @@ static bool _create_markings_cmd_bson(mongocrypt_ctx_t *ctx, bson_t *out) {
     // If input command included $db, do not include it in the command to
     // mongocryptd. Drivers are expected to append $db in the RunCommand helper
     // used to send the command.
-    bson_init(out);
-    bson_copy_to_excluding_noinit(&bson_view, out, "$db", NULL);
+    _bson_init_sized(out,
+                     _original_cmd_copy_len(ectx, omit_documents) + ectx->schema.len + strlen(ectx->db_name)
+                         + MARKINGS_CMD_OVERHEAD);
+    bson_copy_to_excluding_noinit(&bson_view, out, "$db", omit_documents ? "documents" : NULL, NULL);
 
     if (!_mongocrypt_buffer_empty(&ectx->schema)) {
         // We have a schema buffer. View it as BSON:
@@ -678,7 +727,7 @@ static bool _mongo_op_markings(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out)
     if (_mongocrypt_buffer_empty(&ectx->mongocryptd_cmd)) {
         // We need to generate the command document
         bson_t cmd_bson = BSON_INITIALIZER;
-        if (!_create_markings_cmd_bson(ctx, &cmd_bson)) {
+        if (!_create_markings_cmd_bson(ctx, &cmd_bson, false /* omit_documents */)) {
             // Failed
             bson_destroy(&cmd_bson);
             return false;
@@ -695,13 +744,15 @@ static bool _mongo_op_markings(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out)
 
 static bool _collect_key_from_marking(void *ctx, _mongocrypt_buffer_t *in, mongocrypt_status_t *status) {
     _mongocrypt_marking_t marking;
+    _mongocrypt_ctx_encrypt_t *ectx;
     _mongocrypt_key_broker_t *kb;
     bool res;
 
     BSON_ASSERT_PARAM(ctx);
     BSON_ASSERT_PARAM(in);
 
-    kb = (_mongocrypt_key_broker_t *)ctx;
+    ectx = (_mongocrypt_ctx_encrypt_t *)ctx;
+    kb = &ectx->parent.kb;
 
     if (!_mongocrypt_marking_parse_unowned(in, &marking, status)) {
         _mongocrypt_marking_cleanup(&marking);
@@ -710,8 +761,10 @@ static bool _collect_key_from_marking(void *ctx, _mongocrypt_buffer_t *in, mongo
 
     if (marking.type == MONGOCRYPT_MARKING_FLE1_BY_ID) {
         res = _mongocrypt_key_broker_request_id(kb, &marking.key_id);
+        ectx->num_fle1_markings++;
     } else if (marking.type == MONGOCRYPT_MARKING_FLE1_BY_ALTNAME) {
         res = _mongocrypt_key_broker_request_name(kb, &marking.key_alt_name);
+        ectx->num_fle1_markings++;
     } else {
         BSON_ASSERT(marking.type == MONGOCRYPT_MARKING_FLE2_ENCRYPTION);
         res = _mongocrypt_key_broker_request_id(kb, &marking.fle2.index_key_id)
@@ -794,13 +847,19 @@ static bool _mongo_feed_markings(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *in)
         return _mongocrypt_ctx_fail_w_msg(ctx, "malformed marking, could not recurse into 'result'");
     }
     if (!_mongocrypt_traverse_binary_in_bson(_collect_key_from_marking,
-                                             (void *)&ctx->kb,
+                                             (void *)ectx,
                                              TRAVERSE_MATCH_MARKING,
                                              &iter,
                                              ctx->status)) {
         return _mongocrypt_ctx_fail(ctx);
     }
 
+    /* If keys were requested, finalize encrypts marked_cmd and original_cmd is
+     * no longer needed. Otherwise, original_cmd is returned unchanged. */
+    if (ctx->kb.key_requests) {
+        _release_buffer(&ectx->original_cmd);
+    }
+
     return true;
 }
 
@@ -914,6 +973,14 @@ fail:
  * to generate the markings by passing a special command to a mongocryptd daemon
  * process. Instead, we'll do it ourselves here, if possible.
  */
+static bool _insert_needs_chunks(mongocrypt_ctx_t *ctx);
+
+static bool _csfle_analyze_insert_in_chunks(mongocrypt_ctx_t *ctx,
+                                            mongo_crypt_v1_query_analyzer *qa,
+                                            mongo_crypt_v1_status *status,
+                                            const bson_t *cmd,
+                                            bson_t *out);
+
 static bool _try_run_csfle_marking(mongocrypt_ctx_t *ctx) {
     BSON_ASSERT_PARAM(ctx);
 
@@ -936,10 +1003,15 @@ static bool _try_run_csfle_marking(mongocrypt_ctx_t *ctx) {
     mongo_crypt_v1_lib *csfle_lib = ctx->crypt->csfle_lib;
     BSON_ASSERT(csfle_lib);
     bool okay = false;
+    bson_t chunked_reply = BSON_INITIALIZER;
+    uint8_t *marked_bson = NULL;
+    mongocrypt_binary_t *marked = NULL;
 
-    // Obtain the command for markings
+    // Obtain the command for markings. A large insert is analyzed in slices of
+    // its "documents" array, which are added to the command separately.
+    const bool in_chunks = _insert_needs_chunks(ctx);
     bson_t cmd = BSON_INITIALIZER;
-    if (!_create_markings_cmd_bson(ctx, &cmd)) {
+    if (!_create_markings_cmd_bson(ctx, &cmd, in_chunks)) {
         goto fail_create_cmd;
     }
 
@@ -972,13 +1044,28 @@ static bool _try_run_csfle_marking(mongocrypt_ctx_t *ctx) {
     mongo_crypt_v1_query_analyzer *qa = csfle.query_analyzer_create(csfle_lib, status);
     CHECK_CSFLE_ERROR("query_analyzer_create", fail_qa_create);
 
-    uint32_t marked_bson_len = 0;
-    uint8_t *marked_bson =
-        csfle.analyze_query(qa, bson_get_data(&cmd), ectx->ns, (uint32_t)strlen(ectx->ns), &marked_bson_len, status);
-    CHECK_CSFLE_ERROR("analyze_query", fail_analyze_query);
+    if (in_chunks) {
+        if (!_csfle_analyze_insert_in_chunks(ctx, qa, status, &cmd, &chunked_reply)) {
+            goto fail_analyze_query;
+        }
+        marked = mongocrypt_binary_new_from_data((uint8_t *)bson_get_data(&chunked_reply), chunked_reply.len);
+    } else {
+        uint32_t marked_bson_len = 0;
+        marked_bson = csfle.analyze_query(qa,
+                                          bson_get_data(&cmd),
+                                          ectx->ns,
+                                          (uint32_t)strlen(ectx->ns),
+                                          &marked_bson_len,
+                                          status);
+        CHECK_CSFLE_ERROR("analyze_query", fail_analyze_query);
+        marked = mongocrypt_binary_new_from_data(marked_bson, marked_bson_len);
+    }
+
+    // Release the markings command before the marked document is copied.
+    bson_destroy(&cmd);
+    bson_init(&cmd);
 
     // Copy out the marked document.
-    mongocrypt_binary_t *marked = mongocrypt_binary_new_from_data(marked_bson, marked_bson_len);
     if (!_mongo_feed_markings(ctx, marked)) {
         // Wrap error with additional information.
         _mongocrypt_set_error(ctx->status,
@@ -1001,16 +1088,230 @@ static bool _try_run_csfle_marking(mongocrypt_ctx_t *ctx) {
 
 fail_feed_markings:
     mongocrypt_binary_destroy(marked);
-    csfle.bson_free(marked_bson);
+    if (marked_bson) {
+        csfle.bson_free(marked_bson);
+    }
 fail_analyze_query:
     csfle.query_analyzer_destroy(qa);
 fail_qa_create:
     csfle.status_destroy(status);
 fail_create_cmd:
     bson_destroy(&cmd);
+    bson_destroy(&chunked_reply);
     return okay;
 }
 
+/* _insert_needs_chunks returns true if the command is an insert with more
+ * documents than the insert chunk size set on the mongocrypt_t. */
+static bool _insert_needs_chunks(mongocrypt_ctx_t *ctx) {
+    _mongocrypt_ctx_encrypt_t *ectx = (_mongocrypt_ctx_encrypt_t *)ctx;
+    const uint32_t chunk_size = ctx->crypt->opts.insert_chunk_size;
+    bson_t cmd_bson;
+    bson_iter_t iter;
+    uint32_t num_documents = 0;
+
+    BSON_ASSERT_PARAM(ctx);
+
+    if (chunk_size == 0 || 0 != strcmp(ectx->cmd_name, "insert")) {
+        return false;
+    }
+
+    if (!_mongocrypt_buffer_to_bson(&ectx->original_cmd, &cmd_bson)
+        || !bson_iter_init_find(&iter, &cmd_bson, "documents") || !BSON_ITER_HOLDS_ARRAY(&iter)
+        || !bson_iter_recurse(&iter, &iter)) {
+        return false;
+    }
+
+    while (bson_iter_next(&iter)) {
+        if (++num_documents > chunk_size) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* _append_documents_slice appends the next slice of at most @p chunk_size
+ * documents from @p documents to @p cmd as "documents". @p more is set to
+ * whether documents remain. */
+static void _append_documents_slice(bson_t *cmd, bson_iter_t *documents, uint32_t chunk_size, bool *more) {
+    bson_t slice;
+
+    BSON_ASSERT_PARAM(cmd);
+    BSON_ASSERT_PARAM(documents);
+    BSON_ASSERT_PARAM(more);
+
+    BSON_APPEND_ARRAY_BEGIN(cmd, "documents", &slice);
+    for (uint32_t i = 0; *more && i < chunk_size; i++) {
+        char storage[16];
+        const char *key;
+
+        bson_uint32_to_string(i, &key, storage, sizeof(storage));
+        BSON_ASSERT(bson_append_iter(&slice, key, -1, documents));
+        *more = bson_iter_next(documents);
+    }
+    bson_append_array_end(cmd, &slice);
+}
+
+/**
+ * @brief Run query analysis on an insert in slices of its "documents" array.
+ *
+ * Each slice is appended to @p cmd and analyzed separately, so crypt_shared
+ * never holds the whole batch. The marked documents are joined into @p out,
+ * which has the form of a mongocryptd reply for the full command.
+ *
+ * @param ctx A context which has state NEED_MONGO_MARKINGS
+ * @param cmd The markings command without "documents".
+ * @param out An initialized document that receives the joined reply.
+ * @return false On error. Sets a failing status on @p ctx.
+ */
+static bool _csfle_analyze_insert_in_chunks(mongocrypt_ctx_t *ctx,
+                                            mongo_crypt_v1_query_analyzer *qa,
+                                            mongo_crypt_v1_status *status,
+                                            const bson_t *cmd,
+                                            bson_t *out) {
+    _mongocrypt_ctx_encrypt_t *ectx = (_mongocrypt_ctx_encrypt_t *)ctx;
+    _mongo_crypt_v1_vtable csfle = ctx->crypt->csfle;
+    const uint32_t chunk_size = ctx->crypt->opts.insert_chunk_size;
+    bson_t original_cmd_bson, result, result_documents;
+    /* Fields of the first result after "documents". */
+    bson_t trailing = BSON_INITIALIZER;
+    bson_iter_t documents;
+    uint8_t *reply_data = NULL;
+    uint32_t num_documents = 0;
+    /* The number of fields of @p cmd that precede "documents" in the original
+     * command. @p cmd is the original command without "documents" and "$db",
+     * with fields for query analysis appended. */
+    uint32_t documents_index = 0;
+    bool found_schema_requires_encryption = false, schema_requires_encryption = false;
+    bool found_has_encrypted_placeholders = false, has_encrypted_placeholders = false;
+    bool more;
+    bool ok = false;
+
+    BSON_ASSERT_PARAM(ctx);
+    BSON_ASSERT_PARAM(qa);
+    BSON_ASSERT_PARAM(status);
+    BSON_ASSERT_PARAM(cmd);
+    BSON_ASSERT_PARAM(out);
+
+    // _insert_needs_chunks already validated "documents".
+    BSON_ASSERT(_mongocrypt_buffer_to_bson(&ectx->original_cmd, &original_cmd_bson));
+    BSON_ASSERT(bson_iter_init(&documents, &original_cmd_bson));
+    while (bson_iter_next(&documents) && 0 != strcmp(bson_iter_key(&documents), "documents")) {
+        if (0 != strcmp(bson_iter_key(&documents), "$db")) {
+            documents_index++;
+        }
+    }
+    BSON_ASSERT(BSON_ITER_HOLDS_ARRAY(&documents));
+    BSON_ASSERT(bson_iter_recurse(&documents, &documents));
+    more = bson_iter_next(&documents);
+
+    BSON_APPEND_DOCUMENT_BEGIN(out, "result", &result);
+
+    for (bool first = true; more; first = false) {
+        bson_t chunk_cmd = BSON_INITIALIZER, reply;
+        bson_iter_t iter;
+        uint32_t reply_len = 0;
+        uint32_t num_fields = 0;
+
+        // Put the slice where "documents" was in the original command, so the
+        // analyzed command has the same field order.
+        BSON_ASSERT(bson_iter_init(&iter, cmd));
+        while (bson_iter_next(&iter)) {
+            if (num_fields++ == documents_index) {
+                _append_documents_slice(&chunk_cmd, &documents, chunk_size, &more);
+            }
+            BSON_ASSERT(bson_append_iter(&chunk_cmd, NULL, 0, &iter));
+        }
+        if (num_fields <= documents_index) {
+            _append_documents_slice(&chunk_cmd, &documents, chunk_size, &more);
+        }
+
+        reply_data = csfle.analyze_query(qa,
+                                         bson_get_data(&chunk_cmd),
+                                         ectx->ns,
+                                         (uint32_t)strlen(ectx->ns),
+                                         &reply_len,
+                                         status);
+        bson_destroy(&chunk_cmd);
+        CHECK_CSFLE_ERROR("analyze_query", fail);
+
+        if (!bson_init_static(&reply, reply_data, reply_len)) {
+            _mongocrypt_ctx_fail_w_msg(ctx, "malformed BSON from csfle analyze_query");
+            goto fail;
+        }
+
+        if (bson_iter_init_find(&iter, &reply, "schemaRequiresEncryption")) {
+            found_schema_requires_encryption = true;
+            schema_requires_encryption |= bson_iter_as_bool(&iter);
+        }
+        if (bson_iter_init_find(&iter, &reply, "hasEncryptedPlaceholders")) {
+            found_has_encrypted_placeholders = true;
+            has_encrypted_placeholders |= bson_iter_as_bool(&iter);
+        }
+
+        if (!bson_iter_init_find(&iter, &reply, "result") || !BSON_ITER_HOLDS_DOCUMENT(&iter)) {
+            _mongocrypt_ctx_fail_w_msg(ctx, "malformed marking, 'result' must be a document");
+            goto fail;
+        }
+
+        if (first) {
+            // Keep all fields of the first result. The documents of all results
+            // replace its "documents" in place.
+            bson_iter_t field;
+            bool after_documents = false;
+
+            BSON_ASSERT(bson_iter_recurse(&iter, &field));
+            while (bson_iter_next(&field)) {
+                if (!after_documents && 0 == strcmp(bson_iter_key(&field), "documents")) {
+                    BSON_APPEND_ARRAY_BEGIN(&result, "documents", &result_documents);
+                    after_documents = true;
+                } else {
+                    BSON_ASSERT(bson_append_iter(after_documents ? &trailing : &result, NULL, 0, &field));
+                }
+            }
+            if (!after_documents) {
+                _mongocrypt_ctx_fail_w_msg(ctx, "malformed marking, 'result.documents' must be an array");
+                goto fail;
+            }
+        }
+
+        if (!bson_iter_recurse(&iter, &iter) || !bson_iter_find(&iter, "documents") || !BSON_ITER_HOLDS_ARRAY(&iter)
+            || !bson_iter_recurse(&iter, &iter)) {
+            _mongocrypt_ctx_fail_w_msg(ctx, "malformed marking, 'result.documents' must be an array");
+            goto fail;
+        }
+
+        while (bson_iter_next(&iter)) {
+            char storage[16];
+            const char *key;
+
+            bson_uint32_to_string(num_documents++, &key, storage, sizeof(storage));
+            BSON_ASSERT(bson_append_iter(&result_documents, key, -1, &iter));
+        }
+
+        csfle.bson_free(reply_data);
+        reply_data = NULL;
+    }
+
+    bson_append_array_end(&result, &result_documents);
+    BSON_ASSERT(bson_concat(&result, &trailing));
+    bson_append_document_end(out, &result);
+    if (found_schema_requires_encryption) {
+        BSON_APPEND_BOOL(out, "schemaRequiresEncryption", schema_requires_encryption);
+    }
+    if (found_has_encrypted_placeholders) {
+        BSON_APPEND_BOOL(out, "hasEncryptedPlaceholders", has_encrypted_placeholders);
+    }
+    ok = true;
+
+fail:
+    if (reply_data) {
+        csfle.bson_free(reply_data);
+    }
+    bson_destroy(&trailing);
+    return ok;
+}
+
 static bool _mongocrypt_fle2_insert_update_find(mc_fle_blob_subtype_t subtype) {
     return (subtype == MC_SUBTYPE_FLE2InsertUpdatePayload) || (subtype == MC_SUBTYPE_FLE2InsertUpdatePayloadV2)
         || (subtype == MC_SUBTYPE_FLE2FindEqualityPayload) || (subtype == MC_SUBTYPE_FLE2FindEqualityPayloadV2)
@@ -1033,7 +1334,9 @@ _marking_to_bson_value(void *ctx, _mongocrypt_marking_t *marking, bson_value_t *
         goto fail;
     }
 
-    if (_mongocrypt_fle2_insert_update_find(ciphertext.blob_subtype)) {
+    if (ciphertext.data_has_subtype) {
+        _mongocrypt_buffer_steal(&serialized_ciphertext, &ciphertext.data);
+    } else if (_mongocrypt_fle2_insert_update_find(ciphertext.blob_subtype)) {
         /* ciphertext_data is already a BSON object, just need to prepend
          * blob_subtype */
         if (ciphertext.data.len > UINT32_MAX - 1u) {
@@ -1421,7 +1724,6 @@ static bool _fle2_finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
     bson_t converted;
     _mongocrypt_ctx_encrypt_t *ectx;
     bson_t encrypted_field_config_bson;
-    bson_t original_cmd_bson;
 
     BSON_ASSERT_PARAM(ctx);
     BSON_ASSERT_PARAM(out);
@@ -1439,12 +1741,14 @@ static bool _fle2_finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
         return _mongocrypt_ctx_fail_w_msg(ctx, "malformed bson in encrypted_field_config_bson");
     }
 
-    if (!_mongocrypt_buffer_to_bson(&ectx->original_cmd, &original_cmd_bson)) {
-        return _mongocrypt_ctx_fail_w_msg(ctx, "malformed bson in original_cmd");
-    }
-
     /* If marked_cmd buffer is empty, there are no markings to encrypt. */
     if (_mongocrypt_buffer_empty(&ectx->marked_cmd)) {
+        bson_t original_cmd_bson;
+
+        if (!_mongocrypt_buffer_to_bson(&ectx->original_cmd, &original_cmd_bson)) {
+            return _mongocrypt_ctx_fail_w_msg(ctx, "malformed bson in original_cmd");
+        }
+
         /* Append 'encryptionInformation' to the original command. */
         bson_copy_to(&original_cmd_bson, &converted);
     } else {
@@ -1456,7 +1760,8 @@ static bool _fle2_finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
         }
 
         bson_iter_init(&iter, &as_bson);
-        bson_init(&converted);
+        /* Ciphertexts are larger than the markings they replace. */
+        _bson_init_sized(&converted, (size_t)ectx->marked_cmd.len + ectx->marked_cmd.len / 4);
         if (!_mongocrypt_transform_binary_in_bson(_replace_marking_with_ciphertext,
                                                   &ctx->kb,
                                                   TRAVERSE_MATCH_MARKING,
@@ -1466,6 +1771,7 @@ static bool _fle2_finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
             bson_destroy(&converted);
             return _mongocrypt_ctx_fail(ctx);
         }
+        _release_buffer(&ectx->marked_cmd);
     }
 
     const char *command_name = ectx->cmd_name;
@@ -1522,11 +1828,8 @@ static bool _fle2_finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
     }
 
     // If input command has $db, ensure output command has $db.
-    bson_iter_t iter;
-    if (bson_iter_init_find(&iter, &original_cmd_bson, "$db")) {
-        if (!bson_iter_init_find(&iter, &converted, "$db")) {
-            BSON_APPEND_UTF8(&converted, "$db", ectx->db_name);
-        }
+    if (ectx->cmd_has_dollar_db && !bson_has_field(&converted, "$db")) {
+        BSON_APPEND_UTF8(&converted, "$db", ectx->db_name);
     }
 
     _mongocrypt_buffer_steal_from_bson(&ectx->encrypted_cmd, &converted);
@@ -1760,6 +2063,13 @@ fail:
     return ret;
 }
 
+/* FLE1_CIPHERTEXT_MAX_GROWTH bounds how many bytes larger an FLE1 ciphertext
+ * is than the marking it replaces. For a value of n bytes, the ciphertext is at
+ * most n + 82 bytes: a blob subtype, key UUID and BSON type (18), an IV (16),
+ * up to a block of padding (16) and an HMAC (32). The marking is at least
+ * n + 18 bytes: a leading byte and the {v: <value>} document around it. */
+#define FLE1_CIPHERTEXT_MAX_GROWTH 64
+
 static bool _finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
     bson_t as_bson, converted;
     bson_iter_t iter;
@@ -1788,7 +2098,8 @@ static bool _finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
         }
 
         bson_iter_init(&iter, &as_bson);
-        bson_init(&converted);
+        _bson_init_sized(&converted,
+                         (size_t)ectx->marked_cmd.len + (size_t)ectx->num_fle1_markings * FLE1_CIPHERTEXT_MAX_GROWTH);
         if (!_mongocrypt_transform_binary_in_bson(_replace_marking_with_ciphertext,
                                                   &ctx->kb,
                                                   TRAVERSE_MATCH_MARKING,
@@ -1798,18 +2109,11 @@ static bool _finalize(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *out) {
             bson_destroy(&converted);
             return _mongocrypt_ctx_fail(ctx);
         }
-
-        bson_t original_cmd_bson;
-        if (!_mongocrypt_buffer_to_bson(&ectx->original_cmd, &original_cmd_bson)) {
-            return _mongocrypt_ctx_fail_w_msg(ctx, "malformed bson in original_cmd");
-        }
+        _release_buffer(&ectx->marked_cmd);
 
         // If input command has $db, ensure output command has $db.
-        bson_iter_t iter;
-        if (bson_iter_init_find(&iter, &original_cmd_bson, "$db")) {
-            if (!bson_iter_init_find(&iter, &converted, "$db")) {
-                BSON_APPEND_UTF8(&converted, "$db", ectx->db_name);
-            }
+        if (ectx->cmd_has_dollar_db && !bson_has_field(&converted, "$db")) {
+            BSON_APPEND_UTF8(&converted, "$db", ectx->db_name);
         }
     } else {
         /* For explicit encryption, we have no marking, but we can fake one */
@@ -1869,6 +2173,7 @@ static void _cleanup(mongocrypt_ctx_t *ctx) {
     bson_free(ectx->ns);
     bson_free(ectx->db_name);
     bson_free(ectx->coll_name);
+    bson_free(ectx->cmd_name);
     _mongocrypt_buffer_cleanup(&ectx->list_collections_filter);
     _mongocrypt_buffer_cleanup(&ectx->schema);
     _mongocrypt_buffer_cleanup(&ectx->encrypted_field_config);
@@ -2543,9 +2848,18 @@ bool mongocrypt_ctx_encrypt_init(mongocrypt_ctx_t *ctx, const char *db, int32_t
 
     _mongocrypt_buffer_copy_from_binary(&ectx->original_cmd, cmd);
 
-    ectx->cmd_name = get_command_name(&ectx->original_cmd, ctx->status);
-    if (!ectx->cmd_name) {
-        return _mongocrypt_ctx_fail(ctx);
+    {
+        const char *cmd_name = get_command_name(&ectx->original_cmd, ctx->status);
+        bson_t cmd_bson;
+
+        if (!cmd_name) {
+            return _mongocrypt_ctx_fail(ctx);
+        }
+        ectx->cmd_name = bson_strdup(cmd_name);
+
+        // get_command_name already validated original_cmd.
+        BSON_ASSERT(_mongocrypt_buffer_to_bson(&ectx->original_cmd, &cmd_bson));
+        ectx->cmd_has_dollar_db = bson_has_field(&cmd_bson, "$db");
     }
 
     if (!_check_cmd_for_auto_encrypt(cmd, &bypass, &ectx->coll_name, ctx->status)) {
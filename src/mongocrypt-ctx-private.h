@@ -17,6 +17,7 @@
 #ifndef MONGOCRYPT_CTX_PRIVATE_H
 #define MONGOCRYPT_CTX_PRIVATE_H
 
+#include "mc-array-private.h"
 #include "mc-efc-private.h"
 #include "mc-optional-private.h"
 #include "mc-rangeopts-private.h"
@@ -80,6 +81,14 @@ typedef struct __mongocrypt_ctx_opts_t {
         mc_RangeOpts_t value;
         bool set;
     } rangeopts;
+
+    /* borrow_input is set by mongocrypt_ctx_setopt_decrypt_borrow_input. */
+    bool borrow_input;
+
+    struct {
+        mc_array_t value; /* char * */
+        bool set;
+    } decrypt_paths;
 } _mongocrypt_ctx_opts_t;
 
 /* All derived contexts may override these methods. */
@@ -141,7 +150,9 @@ typedef struct {
      * mongocryptd_cmd is only applicable for auto encryption. It is the original
      * command with JSONSchema appended.
      *
-     * marked_cmd is the value of the 'result' field in mongocryptd response
+     * marked_cmd is the value of the 'result' field in mongocryptd response.
+     * For auto encryption, original_cmd is released once marked_cmd is set, so
+     * a large command is not held twice while it is encrypted.
      *
      * encrypted_cmd is the final output, the original command encrypted, or for
      * explicit, the {v: <ciphertext>} doc.
@@ -173,8 +184,14 @@ typedef struct {
         int32_t maxwireversion;
     } ismaster;
 
-    // cmd_name is the first BSON field in original_cmd for auto encryption.
-    const char *cmd_name;
+    // cmd_name is a copy of the first BSON field in original_cmd for auto
+    // encryption.
+    char *cmd_name;
+    // cmd_has_dollar_db is true if original_cmd contains "$db".
+    bool cmd_has_dollar_db;
+    // num_fle1_markings is the number of FLE1 markings in marked_cmd. It bounds
+    // how much larger the encrypted command is.
+    uint32_t num_fle1_markings;
 } _mongocrypt_ctx_encrypt_t;
 
 typedef struct {
@@ -194,6 +211,8 @@ typedef struct {
     _mongocrypt_buffer_t key_doc;
     _mongocrypt_buffer_t plaintext_key_material;
     _mongocrypt_buffer_t encrypted_key_material;
+    /* true if this context holds the oauth cache's fetch claim. */
+    bool oauth_claimed;
 
     const char *kmip_unique_identifier;
     bool kmip_activated;
@@ -234,6 +253,8 @@ typedef struct {
     _mongocrypt_ctx_opt_spec_t key_material;
     _mongocrypt_ctx_opt_spec_t algorithm;
     _mongocrypt_ctx_opt_spec_t rangeopts;
+    _mongocrypt_ctx_opt_spec_t borrow_input;
+    _mongocrypt_ctx_opt_spec_t decrypt_paths;
 } _mongocrypt_ctx_opts_spec_t;
 
 /* Common initialization. */
@@ -609,6 +609,12 @@ void mongocrypt_ctx_destroy(mongocrypt_ctx_t *ctx) {
     }
 
     mc_RangeOpts_cleanup(&ctx->opts.rangeopts.value);
+    if (ctx->opts.decrypt_paths.set) {
+        for (size_t i = 0; i < ctx->opts.decrypt_paths.value.len; i++) {
+            bson_free(_mc_array_index(&ctx->opts.decrypt_paths.value, char *, i));
+        }
+        _mc_array_destroy(&ctx->opts.decrypt_paths.value);
+    }
     _mongocrypt_opts_kms_providers_cleanup(&ctx->per_ctx_kms_providers);
     _mongocrypt_kek_cleanup(&ctx->opts.kek);
     mongocrypt_status_destroy(ctx->status);
@@ -812,6 +818,14 @@ bool _mongocrypt_ctx_init(mongocrypt_ctx_t *ctx, _mongocrypt_ctx_opts_spec_t *op
         return _mongocrypt_ctx_fail_w_msg(ctx, "range opts are prohibited on this context");
     }
 
+    if (opts_spec->borrow_input == OPT_PROHIBITED && ctx->opts.borrow_input) {
+        return _mongocrypt_ctx_fail_w_msg(ctx, "borrowing input is prohibited on this context");
+    }
+
+    if (opts_spec->decrypt_paths == OPT_PROHIBITED && ctx->opts.decrypt_paths.set) {
+        return _mongocrypt_ctx_fail_w_msg(ctx, "decrypt paths are prohibited on this context");
+    }
+
     _mongocrypt_key_broker_init(&ctx->kb, ctx->crypt);
     return true;
 }
@@ -1034,6 +1048,76 @@ const char *_mongocrypt_query_type_to_string(mongocrypt_query_type_t val) {
     }
 }
 
+bool mongocrypt_ctx_setopt_decrypt_borrow_input(mongocrypt_ctx_t *ctx) {
+    if (!ctx) {
+        return false;
+    }
+
+    if (ctx->initialized) {
+        return _mongocrypt_ctx_fail_w_msg(ctx, "cannot set options after init");
+    }
+
+    if (ctx->state == MONGOCRYPT_CTX_ERROR) {
+        return false;
+    }
+
+    ctx->opts.borrow_input = true;
+    return true;
+}
+
+bool mongocrypt_ctx_setopt_decrypt_paths(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *paths) {
+    bson_t as_bson;
+    bson_iter_t iter, array_iter;
+
+    if (!ctx) {
+        return false;
+    }
+
+    if (ctx->initialized) {
+        return _mongocrypt_ctx_fail_w_msg(ctx, "cannot set options after init");
+    }
+
+    if (ctx->state == MONGOCRYPT_CTX_ERROR) {
+        return false;
+    }
+
+    if (ctx->opts.decrypt_paths.set) {
+        return _mongocrypt_ctx_fail_w_msg(ctx, "decrypt paths already set");
+    }
+
+    if (!paths || !paths->data) {
+        return _mongocrypt_ctx_fail_w_msg(ctx, "option must be non-NULL");
+    }
+
+    if (!_mongocrypt_binary_to_bson(paths, &as_bson)) {
+        return _mongocrypt_ctx_fail_w_msg(ctx, "invalid decrypt paths bson object");
+    }
+
+    if (!bson_iter_init_find(&iter, &as_bson, "paths") || !BSON_ITER_HOLDS_ARRAY(&iter)
+        || !bson_iter_recurse(&iter, &array_iter)) {
+        return _mongocrypt_ctx_fail_w_msg(ctx, "decrypt paths must have array field 'paths'");
+    }
+
+    _mc_array_init(&ctx->opts.decrypt_paths.value, sizeof(char *));
+    ctx->opts.decrypt_paths.set = true;
+    while (bson_iter_next(&array_iter)) {
+        uint32_t len;
+        const char *path;
+
+        if (!BSON_ITER_HOLDS_UTF8(&array_iter)) {
+            return _mongocrypt_ctx_fail_w_msg(ctx, "decrypt paths expected to be UTF8");
+        }
+        path = bson_iter_utf8(&array_iter, &len);
+        if (len == 0 || path[0] == '.' || path[len - 1u] == '.' || strstr(path, "..") || strlen(path) != len) {
+            return _mongocrypt_ctx_fail_w_msg(ctx, "invalid decrypt path");
+        }
+        char *copy = bson_strdup(path);
+        _mc_array_append_val(&ctx->opts.decrypt_paths.value, copy);
+    }
+
+    return true;
+}
+
 bool mongocrypt_ctx_setopt_algorithm_range(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *opts) {
     bson_t as_bson;
 
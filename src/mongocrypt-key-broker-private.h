@@ -20,6 +20,8 @@
 #include <bson/bson.h>
 
 #include "kms_message/kms_message.h"
+#include "mc-array-private.h"
+#include "mc-dec128.h"
 #include "mongocrypt-binary-private.h"
 #include "mongocrypt-cache-key-private.h"
 #include "mongocrypt-cache-private.h"
@@ -84,6 +86,14 @@ typedef struct _key_returned_t {
 
     bool needs_auth;
 
+    /* KMIP keys are fetched with one Get per endpoint. kmip_endpoint is the
+     * resolved endpoint (not owned). kmip_batch_owner is the key whose kms
+     * context holds the batch, and kmip_batch_index is the position of this
+     * key's secret within it. */
+    const _mongocrypt_endpoint_t *kmip_endpoint;
+    struct _key_returned_t *kmip_batch_owner;
+    size_t kmip_batch_index;
+
     struct _key_returned_t *next;
 } key_returned_t;
 
@@ -91,6 +101,8 @@ typedef struct _auth_request_t {
     mongocrypt_kms_ctx_t kms;
     bool returned;
     bool initialized;
+    /* true if this key broker holds the oauth cache's fetch claim. */
+    bool claimed;
 } auth_request_t;
 
 typedef struct {
@@ -111,6 +123,13 @@ typedef struct {
     key_returned_t *decryptor_iter;
     auth_request_t auth_request_azure;
     auth_request_t auth_request_gcp;
+    /* Range plans for the double fields encrypted with this key broker. An
+     * array of mc_RangePlanDouble_t. Initialized on first use. */
+    mc_array_t range_plans_double;
+#if MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
+    /* An array of mc_RangePlanDecimal128_t. Initialized on first use. */
+    mc_array_t range_plans_dec128;
+#endif
 } _mongocrypt_key_broker_t;
 
 void _mongocrypt_key_broker_init(_mongocrypt_key_broker_t *kb, mongocrypt_t *crypt);
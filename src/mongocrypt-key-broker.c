@@ -507,7 +507,9 @@ bool _mongocrypt_key_broker_add_doc(_mongocrypt_key_broker_t *kb,
                                                   kms_providers,
                                                   key_doc,
                                                   &kb->crypt->log,
-                                                  kb->crypt->crypto)) {
+                                                  kb->crypt->crypto,
+                                                  kb->crypt->cache_signing_key,
+                                                  kb->crypt->opts.use_kms_keep_alive)) {
             mongocrypt_kms_ctx_status(&key_returned->kms, kb->status);
             _key_broker_fail(kb);
             goto done;
@@ -516,7 +518,12 @@ bool _mongocrypt_key_broker_add_doc(_mongocrypt_key_broker_t *kb,
         if (kms_providers->azure.access_token) {
             access_token = bson_strdup(kms_providers->azure.access_token);
         } else {
-            access_token = _mongocrypt_cache_oauth_get(kb->crypt->cache_oauth_azure);
+            bool claimed;
+
+            access_token = _mongocrypt_cache_oauth_get_or_claim(kb->crypt->cache_oauth_azure, &claimed);
+            if (claimed) {
+                kb->auth_request_azure.claimed = true;
+            }
         }
         if (!access_token) {
             key_returned->needs_auth = true;
@@ -526,7 +533,8 @@ bool _mongocrypt_key_broker_add_doc(_mongocrypt_key_broker_t *kb,
                                                          &kb->crypt->log,
                                                          kms_providers,
                                                          /* The key vault endpoint is used to determine the scope. */
-                                                         key_doc->kek.provider.azure.key_vault_endpoint)) {
+                                                         key_doc->kek.provider.azure.key_vault_endpoint,
+                                                         kb->crypt->opts.use_kms_keep_alive)) {
                     mongocrypt_kms_ctx_status(&kb->auth_request_azure.kms, kb->status);
                     _key_broker_fail(kb);
                     goto done;
@@ -538,7 +546,8 @@ bool _mongocrypt_key_broker_add_doc(_mongocrypt_key_broker_t *kb,
                                                           kms_providers,
                                                           access_token,
                                                           key_doc,
-                                                          &kb->crypt->log)) {
+                                                          &kb->crypt->log,
+                                                          kb->crypt->opts.use_kms_keep_alive)) {
                 mongocrypt_kms_ctx_status(&key_returned->kms, kb->status);
                 _key_broker_fail(kb);
                 goto done;
@@ -548,7 +557,12 @@ bool _mongocrypt_key_broker_add_doc(_mongocrypt_key_broker_t *kb,
         if (NULL != kms_providers->gcp.access_token) {
             access_token = bson_strdup(kms_providers->gcp.access_token);
         } else {
-            access_token = _mongocrypt_cache_oauth_get(kb->crypt->cache_oauth_gcp);
+            bool claimed;
+
+            access_token = _mongocrypt_cache_oauth_get_or_claim(kb->crypt->cache_oauth_gcp, &claimed);
+            if (claimed) {
+                kb->auth_request_gcp.claimed = true;
+            }
         }
         if (!access_token) {
             key_returned->needs_auth = true;
@@ -557,8 +571,11 @@ bool _mongocrypt_key_broker_add_doc(_mongocrypt_key_broker_t *kb,
                 if (!_mongocrypt_kms_ctx_init_gcp_auth(&kb->auth_request_gcp.kms,
                                                        &kb->crypt->log,
                                                        &kb->crypt->opts,
+                                                       kb->crypt->crypto,
+                                                       kb->crypt->cache_oauth_gcp,
                                                        kms_providers,
-                                                       key_doc->kek.provider.gcp.endpoint)) {
+                                                       key_doc->kek.provider.gcp.endpoint,
+                                                       kb->crypt->opts.use_kms_keep_alive)) {
                     mongocrypt_kms_ctx_status(&kb->auth_request_gcp.kms, kb->status);
                     _key_broker_fail(kb);
                     goto done;
@@ -570,37 +587,29 @@ bool _mongocrypt_key_broker_add_doc(_mongocrypt_key_broker_t *kb,
                                                       kms_providers,
                                                       access_token,
                                                       key_doc,
-                                                      &kb->crypt->log)) {
+                                                      &kb->crypt->log,
+                                                      kb->crypt->opts.use_kms_keep_alive)) {
                 mongocrypt_kms_ctx_status(&key_returned->kms, kb->status);
                 _key_broker_fail(kb);
                 goto done;
             }
         }
     } else if (kek_provider == MONGOCRYPT_KMS_PROVIDER_KMIP) {
-        char *unique_identifier;
-        _mongocrypt_endpoint_t *endpoint;
-
         if (!key_returned->doc->kek.provider.kmip.key_id) {
             _key_broker_fail_w_msg(kb, "KMIP key malformed, no keyId present");
             goto done;
         }
 
-        unique_identifier = key_returned->doc->kek.provider.kmip.key_id;
-
         if (key_returned->doc->kek.provider.kmip.endpoint) {
-            endpoint = key_returned->doc->kek.provider.kmip.endpoint;
+            key_returned->kmip_endpoint = key_returned->doc->kek.provider.kmip.endpoint;
         } else if (kms_providers->kmip.endpoint) {
-            endpoint = kms_providers->kmip.endpoint;
+            key_returned->kmip_endpoint = kms_providers->kmip.endpoint;
         } else {
             _key_broker_fail_w_msg(kb, "endpoint not set for KMIP request");
             goto done;
         }
-
-        if (!_mongocrypt_kms_ctx_init_kmip_get(&key_returned->kms, endpoint, unique_identifier, &kb->crypt->log)) {
-            mongocrypt_kms_ctx_status(&key_returned->kms, kb->status);
-            _key_broker_fail(kb);
-            goto done;
-        }
+        /* The KMIP Get is created in _mongocrypt_key_broker_docs_done, once all
+         * keys sharing an endpoint are known. */
     } else {
         _key_broker_fail_w_msg(kb, "unrecognized kms provider");
         goto done;
@@ -623,6 +632,64 @@ done:
     return ret;
 }
 
+/* Returns true if key_returned is a KMIP key not yet in a batch and shares
+ * owner's endpoint. */
+static bool _kmip_batchable(const key_returned_t *key_returned, const key_returned_t *owner) {
+    return key_returned->kmip_endpoint && !key_returned->kmip_batch_owner
+        && 0 == strcmp(key_returned->kmip_endpoint->host_and_port, owner->kmip_endpoint->host_and_port);
+}
+
+/* Create one KMIP Get per endpoint for all KMIP keys still needing decryption.
+ * The first key for an endpoint owns the request. */
+static bool _init_kmip_batches(_mongocrypt_key_broker_t *kb) {
+    key_returned_t *owner;
+    key_returned_t *key_returned;
+    const char **unique_identifiers;
+    size_t count;
+
+    BSON_ASSERT_PARAM(kb);
+
+    for (owner = kb->keys_returned; NULL != owner; owner = owner->next) {
+        if (!owner->kmip_endpoint || owner->kmip_batch_owner) {
+            continue;
+        }
+
+        count = 0;
+        for (key_returned = owner; NULL != key_returned; key_returned = key_returned->next) {
+            if (_kmip_batchable(key_returned, owner)) {
+                count++;
+            }
+        }
+
+        unique_identifiers = bson_malloc(count * sizeof(char *));
+        BSON_ASSERT(unique_identifiers);
+
+        count = 0;
+        for (key_returned = owner; NULL != key_returned; key_returned = key_returned->next) {
+            if (!_kmip_batchable(key_returned, owner)) {
+                continue;
+            }
+            unique_identifiers[count] = key_returned->doc->kek.provider.kmip.key_id;
+            key_returned->kmip_batch_owner = owner;
+            key_returned->kmip_batch_index = count;
+            count++;
+        }
+
+        if (!_mongocrypt_kms_ctx_init_kmip_get_batch(&owner->kms,
+                                                     owner->kmip_endpoint,
+                                                     unique_identifiers,
+                                                     count,
+                                                     &kb->crypt->log)) {
+            mongocrypt_kms_ctx_status(&owner->kms, kb->status);
+            bson_free(unique_identifiers);
+            return _key_broker_fail(kb);
+        }
+        bson_free(unique_identifiers);
+    }
+
+    return true;
+}
+
 bool _mongocrypt_key_broker_docs_done(_mongocrypt_key_broker_t *kb) {
     key_returned_t *key_returned;
     bool needs_decryption;
@@ -639,6 +706,10 @@ bool _mongocrypt_key_broker_docs_done(_mongocrypt_key_broker_t *kb) {
         return _key_broker_fail_w_msg(kb, "not all keys requested were satisfied");
     }
 
+    if (!_init_kmip_batches(kb)) {
+        return false;
+    }
+
     /* Transition to the next state.
      *  - If there are any Azure or GCP backed keys, and no oauth token is
      * cached, transition to KB_AUTHENTICATING.
@@ -701,7 +772,9 @@ mongocrypt_kms_ctx_t *_mongocrypt_key_broker_next_kms(_mongocrypt_key_broker_t *
     }
 
     while (kb->decryptor_iter) {
-        if (!kb->decryptor_iter->decrypted) {
+        /* Keys in another key's KMIP batch have no request of their own. */
+        if (!kb->decryptor_iter->decrypted
+            && (!kb->decryptor_iter->kmip_batch_owner || kb->decryptor_iter->kmip_batch_owner == kb->decryptor_iter)) {
             key_returned_t *key_returned;
 
             key_returned = kb->decryptor_iter;
@@ -728,6 +801,7 @@ bool _mongocrypt_key_broker_kms_done(_mongocrypt_key_broker_t *kb, _mongocrypt_o
     if (kb->state == KB_AUTHENTICATING) {
         bson_t oauth_response;
         _mongocrypt_buffer_t oauth_response_buf;
+        bool ok;
 
         if (kb->auth_request_azure.initialized) {
             if (!_mongocrypt_kms_ctx_result(&kb->auth_request_azure.kms, &oauth_response_buf)) {
@@ -737,7 +811,14 @@ bool _mongocrypt_key_broker_kms_done(_mongocrypt_key_broker_t *kb, _mongocrypt_o
 
             /* Cache returned tokens. */
             BSON_ASSERT(_mongocrypt_buffer_to_bson(&oauth_response_buf, &oauth_response));
-            if (!_mongocrypt_cache_oauth_add(kb->crypt->cache_oauth_azure, &oauth_response, kb->status)) {
+            ok = _mongocrypt_cache_oauth_add(kb->crypt->cache_oauth_azure, &oauth_response, kb->status);
+            /* Only the claimant releases the claim, whether or not the token
+             * was added. */
+            if (kb->auth_request_azure.claimed) {
+                _mongocrypt_cache_oauth_release(kb->crypt->cache_oauth_azure);
+                kb->auth_request_azure.claimed = false;
+            }
+            if (!ok) {
                 return false;
             }
         }
@@ -750,7 +831,14 @@ bool _mongocrypt_key_broker_kms_done(_mongocrypt_key_broker_t *kb, _mongocrypt_o
 
             /* Cache returned tokens. */
             BSON_ASSERT(_mongocrypt_buffer_to_bson(&oauth_response_buf, &oauth_response));
-            if (!_mongocrypt_cache_oauth_add(kb->crypt->cache_oauth_gcp, &oauth_response, kb->status)) {
+            ok = _mongocrypt_cache_oauth_add(kb->crypt->cache_oauth_gcp, &oauth_response, kb->status);
+            /* Only the claimant releases the claim, whether or not the token
+             * was added. */
+            if (kb->auth_request_gcp.claimed) {
+                _mongocrypt_cache_oauth_release(kb->crypt->cache_oauth_gcp);
+                kb->auth_request_gcp.claimed = false;
+            }
+            if (!ok) {
                 return false;
             }
         }
@@ -778,7 +866,8 @@ bool _mongocrypt_key_broker_kms_done(_mongocrypt_key_broker_t *kb, _mongocrypt_o
                                                               kms_providers,
                                                               access_token,
                                                               key_returned->doc,
-                                                              &kb->crypt->log)) {
+                                                              &kb->crypt->log,
+                                                              kb->crypt->opts.use_kms_keep_alive)) {
                     mongocrypt_kms_ctx_status(&key_returned->kms, kb->status);
                     bson_free(access_token);
                     return _key_broker_fail(kb);
@@ -801,7 +890,8 @@ bool _mongocrypt_key_broker_kms_done(_mongocrypt_key_broker_t *kb, _mongocrypt_o
                                                           kms_providers,
                                                           access_token,
                                                           key_returned->doc,
-                                                          &kb->crypt->log)) {
+                                                          &kb->crypt->log,
+                                                          kb->crypt->opts.use_kms_keep_alive)) {
                     mongocrypt_kms_ctx_status(&key_returned->kms, kb->status);
                     bson_free(access_token);
                     return _key_broker_fail(kb);
@@ -843,8 +933,18 @@ bool _mongocrypt_key_broker_kms_done(_mongocrypt_key_broker_t *kb, _mongocrypt_o
             }
         } else if (key_returned->doc->kek.kms_provider == MONGOCRYPT_KMS_PROVIDER_KMIP) {
             _mongocrypt_buffer_t kek;
-            if (!_mongocrypt_kms_ctx_result(&key_returned->kms, &kek)) {
-                mongocrypt_kms_ctx_status(&key_returned->kms, kb->status);
+            key_returned_t *owner = key_returned->kmip_batch_owner;
+
+            if (key_returned->decrypted) {
+                continue;
+            }
+
+            if (!owner || !owner->kms.req) {
+                return _key_broker_fail_w_msg(kb, "unexpected, KMS not set on key returned");
+            }
+
+            if (!_mongocrypt_kms_ctx_batch_result(&owner->kms, key_returned->kmip_batch_index, &kek)) {
+                mongocrypt_kms_ctx_status(&owner->kms, kb->status);
                 return _key_broker_fail(kb);
             }
 
@@ -1008,6 +1108,17 @@ void _mongocrypt_key_broker_cleanup(_mongocrypt_key_broker_t *kb) {
     _destroy_key_requests(kb->key_requests);
     _mongocrypt_kms_ctx_cleanup(&kb->auth_request_azure.kms);
     _mongocrypt_kms_ctx_cleanup(&kb->auth_request_gcp.kms);
+    _mc_array_destroy(&kb->range_plans_double);
+#if MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
+    _mc_array_destroy(&kb->range_plans_dec128);
+#endif
+    /* Let another context fetch a token if this one did not finish. */
+    if (kb->auth_request_azure.claimed) {
+        _mongocrypt_cache_oauth_release(kb->crypt->cache_oauth_azure);
+    }
+    if (kb->auth_request_gcp.claimed) {
+        _mongocrypt_cache_oauth_release(kb->crypt->cache_oauth_gcp);
+    }
 }
 
 void _mongocrypt_key_broker_add_test_key(_mongocrypt_key_broker_t *kb, const _mongocrypt_buffer_t *key_id) {
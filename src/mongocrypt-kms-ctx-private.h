@@ -19,7 +19,9 @@
 
 #include "kms_message/kms_message.h"
 #include "mongocrypt-buffer-private.h"
+#include "mongocrypt-cache-oauth-private.h"
 #include "mongocrypt-cache-key-private.h"
+#include "mongocrypt-cache-signing-key-private.h"
 #include "mongocrypt-compat.h"
 #include "mongocrypt-crypto-private.h"
 #include "mongocrypt-endpoint-private.h"
@@ -51,61 +53,88 @@ struct _mongocrypt_kms_ctx_t {
     _mongocrypt_buffer_t result;
     char *endpoint;
     _mongocrypt_log_t *log;
+    // If set, the request omits "Connection: close" so the connection may be
+    // reused, and bytes fed past the end of the response are kept in
+    // unconsumed.
+    bool keep_alive;
+    _mongocrypt_buffer_t unconsumed;
+    char *connection_key;
+    // For a KMIP Get, one SecretData per requested identifier. result is a
+    // non-owning view of the first entry.
+    _mongocrypt_buffer_t *batch_results;
+    size_t batch_len;
 };
 
 bool _mongocrypt_kms_ctx_init_aws_decrypt(mongocrypt_kms_ctx_t *kms,
                                           _mongocrypt_opts_kms_providers_t *kms_providers,
                                           _mongocrypt_key_doc_t *key,
                                           _mongocrypt_log_t *log,
-                                          _mongocrypt_crypto_t *crypto) MONGOCRYPT_WARN_UNUSED_RESULT;
+                                          _mongocrypt_crypto_t *crypto,
+                                          _mongocrypt_cache_signing_key_t *signing_key_cache,
+                                          bool keep_alive) MONGOCRYPT_WARN_UNUSED_RESULT;
 
 bool _mongocrypt_kms_ctx_init_aws_encrypt(mongocrypt_kms_ctx_t *kms,
                                           _mongocrypt_opts_kms_providers_t *kms_providers,
                                           struct __mongocrypt_ctx_opts_t *ctx_opts,
                                           _mongocrypt_buffer_t *decrypted_key_material,
                                           _mongocrypt_log_t *log,
-                                          _mongocrypt_crypto_t *crypto) MONGOCRYPT_WARN_UNUSED_RESULT;
+                                          _mongocrypt_crypto_t *crypto,
+                                          _mongocrypt_cache_signing_key_t *signing_key_cache,
+                                          bool keep_alive) MONGOCRYPT_WARN_UNUSED_RESULT;
 
 bool _mongocrypt_kms_ctx_result(mongocrypt_kms_ctx_t *kms, _mongocrypt_buffer_t *out) MONGOCRYPT_WARN_UNUSED_RESULT;
 
+/* Returns a non-owning view of the index-th SecretData of a KMIP Get. */
+bool _mongocrypt_kms_ctx_batch_result(mongocrypt_kms_ctx_t *kms,
+                                      size_t index,
+                                      _mongocrypt_buffer_t *out) MONGOCRYPT_WARN_UNUSED_RESULT;
+
 void _mongocrypt_kms_ctx_cleanup(mongocrypt_kms_ctx_t *kms);
 
 bool _mongocrypt_kms_ctx_init_azure_auth(mongocrypt_kms_ctx_t *kms,
                                          _mongocrypt_log_t *log,
                                          _mongocrypt_opts_kms_providers_t *kms_providers,
-                                         _mongocrypt_endpoint_t *key_vault_endpoint) MONGOCRYPT_WARN_UNUSED_RESULT;
+                                         _mongocrypt_endpoint_t *key_vault_endpoint,
+                                         bool keep_alive) MONGOCRYPT_WARN_UNUSED_RESULT;
 
 bool _mongocrypt_kms_ctx_init_azure_wrapkey(mongocrypt_kms_ctx_t *kms,
                                             _mongocrypt_log_t *log,
                                             _mongocrypt_opts_kms_providers_t *kms_providers,
                                             struct __mongocrypt_ctx_opts_t *ctx_opts,
                                             const char *access_token,
-                                            _mongocrypt_buffer_t *plaintext_key_material) MONGOCRYPT_WARN_UNUSED_RESULT;
+                                            _mongocrypt_buffer_t *plaintext_key_material,
+                                            bool keep_alive) MONGOCRYPT_WARN_UNUSED_RESULT;
 
 bool _mongocrypt_kms_ctx_init_azure_unwrapkey(mongocrypt_kms_ctx_t *kms,
                                               _mongocrypt_opts_kms_providers_t *kms_providers,
                                               const char *access_token,
                                               _mongocrypt_key_doc_t *key,
-                                              _mongocrypt_log_t *log) MONGOCRYPT_WARN_UNUSED_RESULT;
+                                              _mongocrypt_log_t *log,
+                                              bool keep_alive) MONGOCRYPT_WARN_UNUSED_RESULT;
 
 bool _mongocrypt_kms_ctx_init_gcp_auth(mongocrypt_kms_ctx_t *kms,
                                        _mongocrypt_log_t *log,
                                        _mongocrypt_opts_t *crypt_opts,
+                                       _mongocrypt_crypto_t *crypto,
+                                       _mongocrypt_cache_oauth_t *cache_oauth,
                                        _mongocrypt_opts_kms_providers_t *kms_providers,
-                                       _mongocrypt_endpoint_t *kms_endpoint) MONGOCRYPT_WARN_UNUSED_RESULT;
+                                       _mongocrypt_endpoint_t *kms_endpoint,
+                                       bool keep_alive) MONGOCRYPT_WARN_UNUSED_RESULT;
 
 bool _mongocrypt_kms_ctx_init_gcp_encrypt(mongocrypt_kms_ctx_t *kms,
                                           _mongocrypt_log_t *log,
                                           _mongocrypt_opts_kms_providers_t *kms_providers,
                                           struct __mongocrypt_ctx_opts_t *ctx_opts,
                                           const char *access_token,
-                                          _mongocrypt_buffer_t *plaintext_key_material) MONGOCRYPT_WARN_UNUSED_RESULT;
+                                          _mongocrypt_buffer_t *plaintext_key_material,
+                                          bool keep_alive) MONGOCRYPT_WARN_UNUSED_RESULT;
 
 bool _mongocrypt_kms_ctx_init_gcp_decrypt(mongocrypt_kms_ctx_t *kms,
                                           _mongocrypt_opts_kms_providers_t *kms_providers,
                                           const char *access_token,
                                           _mongocrypt_key_doc_t *key,
-                                          _mongocrypt_log_t *log) MONGOCRYPT_WARN_UNUSED_RESULT;
+                                          _mongocrypt_log_t *log,
+                                          bool keep_alive) MONGOCRYPT_WARN_UNUSED_RESULT;
 
 bool _mongocrypt_kms_ctx_init_kmip_register(mongocrypt_kms_ctx_t *kms,
                                             const _mongocrypt_endpoint_t *endpoint,
@@ -123,4 +152,11 @@ bool _mongocrypt_kms_ctx_init_kmip_get(mongocrypt_kms_ctx_t *kms,
                                        const char *unique_identifier,
                                        _mongocrypt_log_t *log) MONGOCRYPT_WARN_UNUSED_RESULT;
 
+/* Requests count secrets from one KMIP server in a single message. */
+bool _mongocrypt_kms_ctx_init_kmip_get_batch(mongocrypt_kms_ctx_t *kms,
+                                             const _mongocrypt_endpoint_t *endpoint,
+                                             const char *const *unique_identifiers,
+                                             size_t count,
+                                             _mongocrypt_log_t *log) MONGOCRYPT_WARN_UNUSED_RESULT;
+
 #endif /* MONGOCRYPT_KMX_CTX_PRIVATE_H */
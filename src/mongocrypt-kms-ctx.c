@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "mc-sha256-private.h"
 #include "mongocrypt-binary-private.h"
 #include "mongocrypt-buffer-private.h"
 #include "mongocrypt-ctx-private.h"
@@ -105,6 +106,33 @@ _sha256_hmac(void *ctx, const char *key_input, size_t key_len, const char *input
     return ret;
 }
 
+#ifdef MONGOCRYPT_ENABLE_CRYPTO_BUILTIN
+/* kms-message is built without native crypto alongside the built-in crypto, so
+ * it always needs hooks. */
+static bool _builtin_sha256(void *ctx, const char *input, size_t len, unsigned char *hash_out) {
+    BSON_ASSERT_PARAM(input);
+    BSON_ASSERT_PARAM(hash_out);
+
+    mc_sha256((const uint8_t *)input, len, hash_out);
+    return true;
+}
+
+static bool _builtin_sha256_hmac(void *ctx,
+                                 const char *key_input,
+                                 size_t key_len,
+                                 const char *input,
+                                 size_t len,
+                                 unsigned char *hash_out) {
+    BSON_ASSERT_PARAM(key_input);
+    BSON_ASSERT_PARAM(input);
+    BSON_ASSERT_PARAM(hash_out);
+
+    mc_hmac_sha256_job_t job = {(const uint8_t *)key_input, key_len, (const uint8_t *)input, len, hash_out};
+    mc_hmac_sha256_many(mc_sha256_impl_single(), &job, 1);
+    return true;
+}
+#endif
+
 static void
 _set_kms_crypto_hooks(_mongocrypt_crypto_t *crypto, ctx_with_status_t *ctx_with_status, kms_request_opt_t *opts) {
     BSON_ASSERT_PARAM(crypto);
@@ -114,6 +142,56 @@ _set_kms_crypto_hooks(_mongocrypt_crypto_t *crypto, ctx_with_status_t *ctx_with_
     if (crypto->hooks_enabled) {
         kms_request_opt_set_crypto_hooks(opts, _sha256, _sha256_hmac, ctx_with_status);
     }
+#ifdef MONGOCRYPT_ENABLE_CRYPTO_BUILTIN
+    else {
+        kms_request_opt_set_crypto_hooks(opts, _builtin_sha256, _builtin_sha256_hmac, NULL);
+    }
+#endif
+}
+
+static bool _signing_key_cache_get(void *ctx, const unsigned char *scope_hash, unsigned char *key_out) {
+    BSON_ASSERT_PARAM(ctx);
+    BSON_ASSERT_PARAM(scope_hash);
+    BSON_ASSERT_PARAM(key_out);
+
+    return _mongocrypt_cache_signing_key_get((_mongocrypt_cache_signing_key_t *)ctx, scope_hash, key_out);
+}
+
+static void _signing_key_cache_put(void *ctx, const unsigned char *scope_hash, const unsigned char *key) {
+    BSON_ASSERT_PARAM(ctx);
+    BSON_ASSERT_PARAM(scope_hash);
+    BSON_ASSERT_PARAM(key);
+
+    _mongocrypt_cache_signing_key_add((_mongocrypt_cache_signing_key_t *)ctx, scope_hash, key);
+}
+
+static void _set_kms_signing_key_cache(_mongocrypt_cache_signing_key_t *cache, kms_request_opt_t *opts) {
+    BSON_ASSERT_PARAM(opts);
+
+    if (cache) {
+        kms_request_opt_set_signing_key_cache_hooks(opts, _signing_key_cache_get, _signing_key_cache_put, cache);
+    }
+}
+
+static bool _gcp_assertion_cache_get(void *ctx,
+                                     const unsigned char *claims_hash,
+                                     uint64_t *issued_at_out,
+                                     unsigned char *signature_out) {
+    BSON_ASSERT_PARAM(ctx);
+
+    return _mongocrypt_cache_oauth_get_assertion((_mongocrypt_cache_oauth_t *)ctx,
+                                                 claims_hash,
+                                                 issued_at_out,
+                                                 signature_out);
+}
+
+static void _gcp_assertion_cache_put(void *ctx,
+                                     const unsigned char *claims_hash,
+                                     uint64_t issued_at,
+                                     const unsigned char *signature) {
+    BSON_ASSERT_PARAM(ctx);
+
+    _mongocrypt_cache_oauth_add_assertion((_mongocrypt_cache_oauth_t *)ctx, claims_hash, issued_at, signature);
 }
 
 static bool is_kms(_kms_request_type_t kms_type) {
@@ -121,25 +199,33 @@ static bool is_kms(_kms_request_type_t kms_type) {
         || kms_type == MONGOCRYPT_KMS_KMIP_GET;
 }
 
-static void _init_common(mongocrypt_kms_ctx_t *kms, _mongocrypt_log_t *log, _kms_request_type_t kms_type) {
+static void
+_init_common(mongocrypt_kms_ctx_t *kms, _mongocrypt_log_t *log, _kms_request_type_t kms_type, bool keep_alive) {
     BSON_ASSERT_PARAM(kms);
 
     if (is_kms(kms_type)) {
         kms->parser = kms_kmip_response_parser_new(NULL /* reserved */);
     } else {
         kms->parser = kms_response_parser_new();
+        kms_response_parser_set_keep_alive(kms->parser, keep_alive);
     }
     kms->log = log;
     kms->status = mongocrypt_status_new();
     kms->req_type = kms_type;
+    kms->keep_alive = keep_alive;
     _mongocrypt_buffer_init(&kms->result);
+    _mongocrypt_buffer_init(&kms->unconsumed);
+    kms->batch_results = NULL;
+    kms->batch_len = 0;
 }
 
 bool _mongocrypt_kms_ctx_init_aws_decrypt(mongocrypt_kms_ctx_t *kms,
                                           _mongocrypt_opts_kms_providers_t *kms_providers,
                                           _mongocrypt_key_doc_t *key,
                                           _mongocrypt_log_t *log,
-                                          _mongocrypt_crypto_t *crypto) {
+                                          _mongocrypt_crypto_t *crypto,
+                                          _mongocrypt_cache_signing_key_t *signing_key_cache,
+                                          bool keep_alive) {
     BSON_ASSERT_PARAM(kms);
     BSON_ASSERT_PARAM(key);
     BSON_ASSERT_PARAM(kms_providers);
@@ -150,7 +236,7 @@ bool _mongocrypt_kms_ctx_init_aws_decrypt(mongocrypt_kms_ctx_t *kms,
     ctx_with_status_t ctx_with_status;
     bool ret = false;
 
-    _init_common(kms, log, MONGOCRYPT_KMS_AWS_DECRYPT);
+    _init_common(kms, log, MONGOCRYPT_KMS_AWS_DECRYPT, keep_alive);
     status = kms->status;
     ctx_with_status.ctx = crypto;
     ctx_with_status.status = mongocrypt_status_new();
@@ -190,7 +276,8 @@ bool _mongocrypt_kms_ctx_init_aws_decrypt(mongocrypt_kms_ctx_t *kms,
     BSON_ASSERT(opt);
 
     _set_kms_crypto_hooks(crypto, &ctx_with_status, opt);
-    kms_request_opt_set_connection_close(opt, true);
+    _set_kms_signing_key_cache(signing_key_cache, opt);
+    kms_request_opt_set_connection_close(opt, !keep_alive);
 
     kms->req = kms_decrypt_request_new(key->key_material.data, key->key_material.len, opt);
 
@@ -271,7 +358,9 @@ bool _mongocrypt_kms_ctx_init_aws_encrypt(mongocrypt_kms_ctx_t *kms,
                                           _mongocrypt_ctx_opts_t *ctx_opts,
                                           _mongocrypt_buffer_t *plaintext_key_material,
                                           _mongocrypt_log_t *log,
-                                          _mongocrypt_crypto_t *crypto) {
+                                          _mongocrypt_crypto_t *crypto,
+                                          _mongocrypt_cache_signing_key_t *signing_key_cache,
+                                          bool keep_alive) {
     BSON_ASSERT_PARAM(kms);
     BSON_ASSERT_PARAM(ctx_opts);
     BSON_ASSERT_PARAM(kms_providers);
@@ -283,7 +372,7 @@ bool _mongocrypt_kms_ctx_init_aws_encrypt(mongocrypt_kms_ctx_t *kms,
     ctx_with_status_t ctx_with_status;
     bool ret = false;
 
-    _init_common(kms, log, MONGOCRYPT_KMS_AWS_ENCRYPT);
+    _init_common(kms, log, MONGOCRYPT_KMS_AWS_ENCRYPT, keep_alive);
     status = kms->status;
     ctx_with_status.ctx = crypto;
     ctx_with_status.status = mongocrypt_status_new();
@@ -323,7 +412,8 @@ bool _mongocrypt_kms_ctx_init_aws_encrypt(mongocrypt_kms_ctx_t *kms,
     BSON_ASSERT(opt);
 
     _set_kms_crypto_hooks(crypto, &ctx_with_status, opt);
-    kms_request_opt_set_connection_close(opt, true);
+    _set_kms_signing_key_cache(signing_key_cache, opt);
+    kms_request_opt_set_connection_close(opt, !keep_alive);
 
     kms->req = kms_encrypt_request_new(plaintext_key_material->data,
                                        plaintext_key_material->len,
@@ -800,6 +890,7 @@ static bool _ctx_done_kmip_get(mongocrypt_kms_ctx_t *kms_ctx) {
     bool ret = false;
     uint8_t *secretdata;
     size_t secretdata_len;
+    size_t i;
 
     res = kms_response_parser_get_response(kms_ctx->parser);
     if (!res) {
@@ -807,18 +898,23 @@ static bool _ctx_done_kmip_get(mongocrypt_kms_ctx_t *kms_ctx) {
         goto done;
     }
 
-    secretdata = kms_kmip_response_get_secretdata(res, &secretdata_len);
-    if (!secretdata) {
-        CLIENT_ERR("Error getting SecretData from KMIP Get response: %s", kms_response_get_error(res));
-        goto done;
-    }
+    for (i = 0; i < kms_ctx->batch_len; i++) {
+        secretdata = kms_kmip_response_get_secretdata_at(res, i, &secretdata_len);
+        if (!secretdata) {
+            CLIENT_ERR("Error getting SecretData from KMIP Get response: %s", kms_response_get_error(res));
+            goto done;
+        }
 
-    if (!_mongocrypt_buffer_steal_from_data_and_size(&kms_ctx->result, secretdata, secretdata_len)) {
-        CLIENT_ERR("Error storing KMS SecretData result");
-        bson_free(secretdata);
-        goto done;
+        if (!_mongocrypt_buffer_steal_from_data_and_size(&kms_ctx->batch_results[i], secretdata, secretdata_len)) {
+            CLIENT_ERR("Error storing KMS SecretData result");
+            bson_free(secretdata);
+            goto done;
+        }
     }
 
+    _mongocrypt_buffer_init(&kms_ctx->result);
+    kms_ctx->result.data = kms_ctx->batch_results[0].data;
+    kms_ctx->result.len = kms_ctx->batch_results[0].len;
     ret = true;
 
 done:
@@ -876,6 +972,17 @@ bool mongocrypt_kms_ctx_feed(mongocrypt_kms_ctx_t *kms, mongocrypt_binary_t *byt
     }
 
     if (0 == mongocrypt_kms_ctx_bytes_needed(kms)) {
+        if (kms->keep_alive) {
+            /* Keep the start of the next response on the connection before the
+             * parser is reset. */
+            uint32_t trailing_len;
+            const uint8_t *trailing = kms_response_parser_trailing(kms->parser, &trailing_len);
+            if (trailing && !_mongocrypt_buffer_copy_from_data_and_size(&kms->unconsumed, trailing, trailing_len)) {
+                CLIENT_ERR("failed to copy unconsumed KMS response bytes");
+                return false;
+            }
+        }
+
         switch (kms->req_type) {
         default: CLIENT_ERR("Unknown request type"); return false;
         case MONGOCRYPT_KMS_AWS_ENCRYPT: return _ctx_done_aws(kms, "CiphertextBlob");
@@ -920,6 +1027,26 @@ bool _mongocrypt_kms_ctx_result(mongocrypt_kms_ctx_t *kms, _mongocrypt_buffer_t
     return true;
 }
 
+bool _mongocrypt_kms_ctx_batch_result(mongocrypt_kms_ctx_t *kms, size_t index, _mongocrypt_buffer_t *out) {
+    BSON_ASSERT_PARAM(kms);
+    BSON_ASSERT_PARAM(out);
+
+    mongocrypt_status_t *status = kms->status;
+
+    if (!_mongocrypt_kms_ctx_result(kms, out)) {
+        return false;
+    }
+
+    if (index >= kms->batch_len) {
+        CLIENT_ERR("KMS batch result index out of range");
+        return false;
+    }
+
+    out->data = kms->batch_results[index].data;
+    out->len = kms->batch_results[index].len;
+    return true;
+}
+
 bool mongocrypt_kms_ctx_status(mongocrypt_kms_ctx_t *kms, mongocrypt_status_t *status_out) {
     if (!kms) {
         return false;
@@ -947,7 +1074,13 @@ void _mongocrypt_kms_ctx_cleanup(mongocrypt_kms_ctx_t *kms) {
     mongocrypt_status_destroy(kms->status);
     _mongocrypt_buffer_cleanup(&kms->msg);
     _mongocrypt_buffer_cleanup(&kms->result);
+    _mongocrypt_buffer_cleanup(&kms->unconsumed);
+    for (size_t i = 0; i < kms->batch_len; i++) {
+        _mongocrypt_buffer_cleanup(&kms->batch_results[i]);
+    }
+    bson_free(kms->batch_results);
     bson_free(kms->endpoint);
+    bson_free(kms->connection_key);
 }
 
 bool mongocrypt_kms_ctx_message(mongocrypt_kms_ctx_t *kms, mongocrypt_binary_t *msg) {
@@ -981,7 +1114,8 @@ bool mongocrypt_kms_ctx_endpoint(mongocrypt_kms_ctx_t *kms, const char **endpoin
 bool _mongocrypt_kms_ctx_init_azure_auth(mongocrypt_kms_ctx_t *kms,
                                          _mongocrypt_log_t *log,
                                          _mongocrypt_opts_kms_providers_t *kms_providers,
-                                         _mongocrypt_endpoint_t *key_vault_endpoint) {
+                                         _mongocrypt_endpoint_t *key_vault_endpoint,
+                                         bool keep_alive) {
     BSON_ASSERT_PARAM(kms);
     BSON_ASSERT_PARAM(kms_providers);
 
@@ -993,7 +1127,7 @@ bool _mongocrypt_kms_ctx_init_azure_auth(mongocrypt_kms_ctx_t *kms,
     char *request_string;
     bool ret = false;
 
-    _init_common(kms, log, MONGOCRYPT_KMS_AZURE_OAUTH);
+    _init_common(kms, log, MONGOCRYPT_KMS_AZURE_OAUTH, keep_alive);
     status = kms->status;
 
     identity_platform_endpoint = kms_providers->azure.identity_platform_endpoint;
@@ -1018,7 +1152,7 @@ bool _mongocrypt_kms_ctx_init_azure_auth(mongocrypt_kms_ctx_t *kms,
 
     opt = kms_request_opt_new();
     BSON_ASSERT(opt);
-    kms_request_opt_set_connection_close(opt, true);
+    kms_request_opt_set_connection_close(opt, !keep_alive);
     kms_request_opt_set_provider(opt, KMS_REQUEST_PROVIDER_AZURE);
     kms->req = kms_azure_request_oauth_new(hostname,
                                            scope,
@@ -1053,7 +1187,8 @@ bool _mongocrypt_kms_ctx_init_azure_wrapkey(mongocrypt_kms_ctx_t *kms,
                                             _mongocrypt_opts_kms_providers_t *kms_providers,
                                             struct __mongocrypt_ctx_opts_t *ctx_opts,
                                             const char *access_token,
-                                            _mongocrypt_buffer_t *plaintext_key_material) {
+                                            _mongocrypt_buffer_t *plaintext_key_material,
+                                            bool keep_alive) {
     BSON_ASSERT_PARAM(kms);
     BSON_ASSERT_PARAM(ctx_opts);
     BSON_ASSERT_PARAM(plaintext_key_material);
@@ -1066,7 +1201,7 @@ bool _mongocrypt_kms_ctx_init_azure_wrapkey(mongocrypt_kms_ctx_t *kms,
     char *request_string;
     bool ret = false;
 
-    _init_common(kms, log, MONGOCRYPT_KMS_AZURE_WRAPKEY);
+    _init_common(kms, log, MONGOCRYPT_KMS_AZURE_WRAPKEY, keep_alive);
     status = kms->status;
 
     BSON_ASSERT(ctx_opts->kek.provider.azure.key_vault_endpoint);
@@ -1077,7 +1212,7 @@ bool _mongocrypt_kms_ctx_init_azure_wrapkey(mongocrypt_kms_ctx_t *kms,
 
     opt = kms_request_opt_new();
     BSON_ASSERT(opt);
-    kms_request_opt_set_connection_close(opt, true);
+    kms_request_opt_set_connection_close(opt, !keep_alive);
     kms_request_opt_set_provider(opt, KMS_REQUEST_PROVIDER_AZURE);
     kms->req = kms_azure_request_wrapkey_new(host,
                                              access_token,
@@ -1114,7 +1249,8 @@ bool _mongocrypt_kms_ctx_init_azure_unwrapkey(mongocrypt_kms_ctx_t *kms,
                                               _mongocrypt_opts_kms_providers_t *kms_providers,
                                               const char *access_token,
                                               _mongocrypt_key_doc_t *key,
-                                              _mongocrypt_log_t *log) {
+                                              _mongocrypt_log_t *log,
+                                              bool keep_alive) {
     BSON_ASSERT_PARAM(kms);
     BSON_ASSERT_PARAM(key);
 
@@ -1126,7 +1262,7 @@ bool _mongocrypt_kms_ctx_init_azure_unwrapkey(mongocrypt_kms_ctx_t *kms,
     char *request_string;
     bool ret = false;
 
-    _init_common(kms, log, MONGOCRYPT_KMS_AZURE_UNWRAPKEY);
+    _init_common(kms, log, MONGOCRYPT_KMS_AZURE_UNWRAPKEY, keep_alive);
     status = kms->status;
 
     BSON_ASSERT(key->kek.provider.azure.key_vault_endpoint);
@@ -1137,7 +1273,7 @@ bool _mongocrypt_kms_ctx_init_azure_unwrapkey(mongocrypt_kms_ctx_t *kms,
 
     opt = kms_request_opt_new();
     BSON_ASSERT(opt);
-    kms_request_opt_set_connection_close(opt, true);
+    kms_request_opt_set_connection_close(opt, !keep_alive);
     kms_request_opt_set_provider(opt, KMS_REQUEST_PROVIDER_AZURE);
     kms->req = kms_azure_request_unwrapkey_new(host,
                                                access_token,
@@ -1211,14 +1347,50 @@ static bool _sign_rsaes_pkcs1_v1_5_trampoline(void *ctx,
     return ret;
 }
 
+#ifdef MONGOCRYPT_ENABLE_CRYPTO_BUILTIN
+/* Signs with the built-in crypto when no sign hook is set. */
+static bool _builtin_sign_rsaes_pkcs1_v1_5(void *ctx,
+                                           const char *private_key,
+                                           size_t private_key_len,
+                                           const char *input,
+                                           size_t input_len,
+                                           unsigned char *signature_out) {
+    ctx_with_status_t *ctx_with_status;
+    _mongocrypt_buffer_t key_buf, input_buf, out_buf;
+
+    BSON_ASSERT_PARAM(ctx);
+    BSON_ASSERT_PARAM(private_key);
+    BSON_ASSERT_PARAM(input);
+    BSON_ASSERT_PARAM(signature_out);
+
+    ctx_with_status = (ctx_with_status_t *)ctx;
+    BSON_ASSERT(private_key_len <= UINT32_MAX);
+    BSON_ASSERT(input_len <= UINT32_MAX);
+    _mongocrypt_buffer_init(&key_buf);
+    key_buf.data = (uint8_t *)private_key;
+    key_buf.len = (uint32_t)private_key_len;
+    _mongocrypt_buffer_init(&input_buf);
+    input_buf.data = (uint8_t *)input;
+    input_buf.len = (uint32_t)input_len;
+    _mongocrypt_buffer_init(&out_buf);
+    out_buf.data = signature_out;
+    out_buf.len = RSAES_PKCS1_V1_5_SIGNATURE_LEN;
+    return _builtin_crypto_sign_rsaes_pkcs1_v1_5(&key_buf, &input_buf, &out_buf, ctx_with_status->status);
+}
+#endif
+
 bool _mongocrypt_kms_ctx_init_gcp_auth(mongocrypt_kms_ctx_t *kms,
                                        _mongocrypt_log_t *log,
                                        _mongocrypt_opts_t *crypt_opts,
+                                       _mongocrypt_crypto_t *crypto,
+                                       _mongocrypt_cache_oauth_t *cache_oauth,
                                        _mongocrypt_opts_kms_providers_t *kms_providers,
-                                       _mongocrypt_endpoint_t *kms_endpoint) {
+                                       _mongocrypt_endpoint_t *kms_endpoint,
+                                       bool keep_alive) {
     BSON_ASSERT_PARAM(kms);
     BSON_ASSERT_PARAM(kms_providers);
     BSON_ASSERT_PARAM(crypt_opts);
+    BSON_ASSERT_PARAM(crypto);
 
     kms_request_opt_t *opt = NULL;
     mongocrypt_status_t *status;
@@ -1229,11 +1401,14 @@ bool _mongocrypt_kms_ctx_init_gcp_auth(mongocrypt_kms_ctx_t *kms,
     char *request_string;
     bool ret = false;
     ctx_with_status_t ctx_with_status;
+    ctx_with_status_t sha_ctx_with_status;
 
-    _init_common(kms, log, MONGOCRYPT_KMS_GCP_OAUTH);
+    _init_common(kms, log, MONGOCRYPT_KMS_GCP_OAUTH, keep_alive);
     status = kms->status;
     ctx_with_status.ctx = crypt_opts;
     ctx_with_status.status = mongocrypt_status_new();
+    sha_ctx_with_status.ctx = crypto;
+    sha_ctx_with_status.status = mongocrypt_status_new();
 
     auth_endpoint = kms_providers->gcp.endpoint;
     if (auth_endpoint) {
@@ -1256,11 +1431,24 @@ bool _mongocrypt_kms_ctx_init_gcp_auth(mongocrypt_kms_ctx_t *kms,
 
     opt = kms_request_opt_new();
     BSON_ASSERT(opt);
-    kms_request_opt_set_connection_close(opt, true);
+    kms_request_opt_set_connection_close(opt, !keep_alive);
     kms_request_opt_set_provider(opt, KMS_REQUEST_PROVIDER_GCP);
     if (crypt_opts->sign_rsaes_pkcs1_v1_5) {
         kms_request_opt_set_crypto_hook_sign_rsaes_pkcs1_v1_5(opt, _sign_rsaes_pkcs1_v1_5_trampoline, &ctx_with_status);
     }
+#ifdef MONGOCRYPT_ENABLE_CRYPTO_BUILTIN
+    else {
+        kms_request_opt_set_crypto_hook_sign_rsaes_pkcs1_v1_5(opt, _builtin_sign_rsaes_pkcs1_v1_5, &ctx_with_status);
+    }
+#endif
+    /* SHA-256 keys the cache of signed JWT assertions. */
+    _set_kms_crypto_hooks(crypto, &sha_ctx_with_status, opt);
+    if (cache_oauth) {
+        kms_request_opt_set_gcp_assertion_cache_hooks(opt,
+                                                      _gcp_assertion_cache_get,
+                                                      _gcp_assertion_cache_put,
+                                                      cache_oauth);
+    }
     kms->req = kms_gcp_request_oauth_new(hostname,
                                          kms_providers->gcp.email,
                                          audience,
@@ -1291,6 +1479,7 @@ fail:
     bson_free(audience);
     kms_request_opt_destroy(opt);
     mongocrypt_status_destroy(ctx_with_status.status);
+    mongocrypt_status_destroy(sha_ctx_with_status.status);
     return ret;
 }
 
@@ -1299,7 +1488,8 @@ bool _mongocrypt_kms_ctx_init_gcp_encrypt(mongocrypt_kms_ctx_t *kms,
                                           _mongocrypt_opts_kms_providers_t *kms_providers,
                                           struct __mongocrypt_ctx_opts_t *ctx_opts,
                                           const char *access_token,
-                                          _mongocrypt_buffer_t *plaintext_key_material) {
+                                          _mongocrypt_buffer_t *plaintext_key_material,
+                                          bool keep_alive) {
     BSON_ASSERT_PARAM(kms);
     BSON_ASSERT_PARAM(ctx_opts);
     BSON_ASSERT_PARAM(kms_providers);
@@ -1314,7 +1504,7 @@ bool _mongocrypt_kms_ctx_init_gcp_encrypt(mongocrypt_kms_ctx_t *kms,
     char *request_string;
     bool ret = false;
 
-    _init_common(kms, log, MONGOCRYPT_KMS_GCP_ENCRYPT);
+    _init_common(kms, log, MONGOCRYPT_KMS_GCP_ENCRYPT, keep_alive);
     status = kms->status;
 
     if (ctx_opts->kek.provider.gcp.endpoint) {
@@ -1328,7 +1518,7 @@ bool _mongocrypt_kms_ctx_init_gcp_encrypt(mongocrypt_kms_ctx_t *kms,
 
     opt = kms_request_opt_new();
     BSON_ASSERT(opt);
-    kms_request_opt_set_connection_close(opt, true);
+    kms_request_opt_set_connection_close(opt, !keep_alive);
     kms_request_opt_set_provider(opt, KMS_REQUEST_PROVIDER_GCP);
     kms->req = kms_gcp_request_encrypt_new(hostname,
                                            access_token,
@@ -1368,7 +1558,8 @@ bool _mongocrypt_kms_ctx_init_gcp_decrypt(mongocrypt_kms_ctx_t *kms,
                                           _mongocrypt_opts_kms_providers_t *kms_providers,
                                           const char *access_token,
                                           _mongocrypt_key_doc_t *key,
-                                          _mongocrypt_log_t *log) {
+                                          _mongocrypt_log_t *log,
+                                          bool keep_alive) {
     BSON_ASSERT_PARAM(kms);
     BSON_ASSERT_PARAM(kms_providers);
     BSON_ASSERT_PARAM(access_token);
@@ -1382,7 +1573,7 @@ bool _mongocrypt_kms_ctx_init_gcp_decrypt(mongocrypt_kms_ctx_t *kms,
     char *request_string;
     bool ret = false;
 
-    _init_common(kms, log, MONGOCRYPT_KMS_GCP_DECRYPT);
+    _init_common(kms, log, MONGOCRYPT_KMS_GCP_DECRYPT, keep_alive);
     status = kms->status;
 
     if (key->kek.provider.gcp.endpoint) {
@@ -1396,7 +1587,7 @@ bool _mongocrypt_kms_ctx_init_gcp_decrypt(mongocrypt_kms_ctx_t *kms,
 
     opt = kms_request_opt_new();
     BSON_ASSERT(opt);
-    kms_request_opt_set_connection_close(opt, true);
+    kms_request_opt_set_connection_close(opt, !keep_alive);
     kms_request_opt_set_provider(opt, KMS_REQUEST_PROVIDER_GCP);
     kms->req = kms_gcp_request_decrypt_new(hostname,
                                            access_token,
@@ -1445,7 +1636,7 @@ bool _mongocrypt_kms_ctx_init_kmip_register(mongocrypt_kms_ctx_t *kms_ctx,
     const uint8_t *reqdata;
     size_t reqlen;
 
-    _init_common(kms_ctx, log, MONGOCRYPT_KMS_KMIP_REGISTER);
+    _init_common(kms_ctx, log, MONGOCRYPT_KMS_KMIP_REGISTER, false /* keep_alive */);
     status = kms_ctx->status;
 
     kms_ctx->endpoint = bson_strdup(endpoint->host_and_port);
@@ -1481,7 +1672,7 @@ bool _mongocrypt_kms_ctx_init_kmip_activate(mongocrypt_kms_ctx_t *kms_ctx,
     size_t reqlen;
     const uint8_t *reqdata;
 
-    _init_common(kms_ctx, log, MONGOCRYPT_KMS_KMIP_ACTIVATE);
+    _init_common(kms_ctx, log, MONGOCRYPT_KMS_KMIP_ACTIVATE, false /* keep_alive */);
     status = kms_ctx->status;
 
     kms_ctx->endpoint = bson_strdup(endpoint->host_and_port);
@@ -1508,27 +1699,41 @@ bool _mongocrypt_kms_ctx_init_kmip_get(mongocrypt_kms_ctx_t *kms_ctx,
                                        const _mongocrypt_endpoint_t *endpoint,
                                        const char *unique_identifier,
                                        _mongocrypt_log_t *log) {
+    BSON_ASSERT_PARAM(unique_identifier);
+
+    return _mongocrypt_kms_ctx_init_kmip_get_batch(kms_ctx, endpoint, &unique_identifier, 1, log);
+}
+
+bool _mongocrypt_kms_ctx_init_kmip_get_batch(mongocrypt_kms_ctx_t *kms_ctx,
+                                             const _mongocrypt_endpoint_t *endpoint,
+                                             const char *const *unique_identifiers,
+                                             size_t count,
+                                             _mongocrypt_log_t *log) {
     BSON_ASSERT_PARAM(kms_ctx);
     BSON_ASSERT_PARAM(endpoint);
-    BSON_ASSERT_PARAM(unique_identifier);
+    BSON_ASSERT_PARAM(unique_identifiers);
 
     mongocrypt_status_t *status;
     bool ret = false;
     size_t reqlen;
     const uint8_t *reqdata;
 
-    _init_common(kms_ctx, log, MONGOCRYPT_KMS_KMIP_GET);
+    _init_common(kms_ctx, log, MONGOCRYPT_KMS_KMIP_GET, false /* keep_alive */);
     status = kms_ctx->status;
 
     kms_ctx->endpoint = bson_strdup(endpoint->host_and_port);
     _mongocrypt_apply_default_port(&kms_ctx->endpoint, DEFAULT_KMIP_PORT);
-    kms_ctx->req = kms_kmip_request_get_new(NULL /* reserved */, unique_identifier);
+    kms_ctx->req = kms_kmip_request_get_batch_new(NULL /* reserved */, unique_identifiers, count);
 
     if (kms_request_get_error(kms_ctx->req)) {
         CLIENT_ERR("Error creating KMIP get request: %s", kms_request_get_error(kms_ctx->req));
         goto done;
     }
 
+    kms_ctx->batch_results = bson_malloc0(count * sizeof(_mongocrypt_buffer_t));
+    BSON_ASSERT(kms_ctx->batch_results);
+    kms_ctx->batch_len = count;
+
     reqdata = kms_request_to_bytes(kms_ctx->req, &reqlen);
     if (!_mongocrypt_buffer_copy_from_data_and_size(&kms_ctx->msg, reqdata, reqlen)) {
         CLIENT_ERR("Error storing KMS request payload");
@@ -1568,3 +1773,29 @@ const char *mongocrypt_kms_ctx_get_kms_provider(mongocrypt_kms_ctx_t *kms, uint3
     case MONGOCRYPT_KMS_KMIP_GET: return set_and_ret("kmip", len);
     }
 }
+
+const char *mongocrypt_kms_ctx_get_connection_key(mongocrypt_kms_ctx_t *kms, uint32_t *len) {
+    BSON_ASSERT_PARAM(kms);
+
+    if (!kms->connection_key) {
+        BSON_ASSERT(kms->endpoint);
+        kms->connection_key =
+            bson_strdup_printf("%s/%s", mongocrypt_kms_ctx_get_kms_provider(kms, NULL), kms->endpoint);
+    }
+    return set_and_ret(kms->connection_key, len);
+}
+
+bool mongocrypt_kms_ctx_unconsumed(mongocrypt_kms_ctx_t *kms, mongocrypt_binary_t *bytes) {
+    if (!kms) {
+        return false;
+    }
+
+    if (!bytes) {
+        mongocrypt_status_t *status = kms->status;
+        CLIENT_ERR("argument 'bytes' is required");
+        return false;
+    }
+    bytes->data = kms->unconsumed.data;
+    bytes->len = kms->unconsumed.len;
+    return true;
+}
@@ -211,7 +211,7 @@ void _mongocrypt_marking_cleanup(_mongocrypt_marking_t *marking) {
 #define DERIVE_TOKEN_IMPL(Name)                                                                                        \
     static bool _fle2_derive_##Name##_token(_mongocrypt_crypto_t *crypto,                                              \
                                             _mongocrypt_buffer_t *out,                                                 \
-                                            const mc_CollectionsLevel1Token_t *level1Token,                            \
+                                            const mc_CollectionsLevel1TokenValue_t *level1Token,                       \
                                             const _mongocrypt_buffer_t *value,                                         \
                                             bool useCounter,                                                           \
                                             int64_t counter,                                                           \
@@ -221,40 +221,49 @@ void _mongocrypt_marking_cleanup(_mongocrypt_marking_t *marking) {
         BSON_ASSERT_PARAM(level1Token);                                                                                \
         BSON_ASSERT_PARAM(value);                                                                                      \
                                                                                                                        \
+        mc_##Name##TokenValue_t token;                                                                                 \
+        mc_##Name##DerivedFromDataTokenValue_t fromDataToken;                                                          \
+        mc_##Name##DerivedFromDataTokenAndCounterValue_t fromTokenAndCounter;                                          \
+        _mongocrypt_buffer_t view;                                                                                     \
+        bool ok = false;                                                                                               \
+                                                                                                                       \
         _mongocrypt_buffer_init(out);                                                                                  \
                                                                                                                        \
-        mc_##Name##Token_t *token = mc_##Name##Token_new(crypto, level1Token, status);                                 \
-        if (!token) {                                                                                                  \
-            return false;                                                                                              \
+        if (!mc_##Name##TokenValue_init(&token, crypto, level1Token, status)) {                                        \
+            goto done;                                                                                                 \
         }                                                                                                              \
                                                                                                                        \
-        mc_##Name##DerivedFromDataToken_t *fromDataToken =                                                             \
-            mc_##Name##DerivedFromDataToken_new(crypto, token, value, status);                                         \
-        mc_##Name##Token_destroy(token);                                                                               \
-        if (!fromDataToken) {                                                                                          \
-            return false;                                                                                              \
+        if (!mc_##Name##DerivedFromDataTokenValue_init(&fromDataToken, crypto, &token, value, status)) {               \
+            goto done;                                                                                                 \
         }                                                                                                              \
                                                                                                                        \
         if (!useCounter) {                                                                                             \
             /* FindEqualityPayload uses *fromDataToken */                                                              \
-            _mongocrypt_buffer_copy_to(mc_##Name##DerivedFromDataToken_get(fromDataToken), out);                       \
-            mc_##Name##DerivedFromDataToken_destroy(fromDataToken);                                                    \
-            return true;                                                                                               \
+            view = mc_##Name##DerivedFromDataTokenValue_get(&fromDataToken);                                           \
+            _mongocrypt_buffer_copy_to(&view, out);                                                                    \
+            ok = true;                                                                                                 \
+            goto done;                                                                                                 \
         }                                                                                                              \
                                                                                                                        \
         BSON_ASSERT(counter >= 0);                                                                                     \
         /* InsertUpdatePayload continues through *fromDataTokenAndCounter */                                           \
-        mc_##Name##DerivedFromDataTokenAndCounter_t *fromTokenAndCounter =                                             \
-            mc_##Name##DerivedFromDataTokenAndCounter_new(crypto, fromDataToken, (uint64_t)counter, status);           \
-        mc_##Name##DerivedFromDataToken_destroy(fromDataToken);                                                        \
-        if (!fromTokenAndCounter) {                                                                                    \
-            return false;                                                                                              \
+        if (!mc_##Name##DerivedFromDataTokenAndCounterValue_init(&fromTokenAndCounter,                                 \
+                                                                 crypto,                                               \
+                                                                 &fromDataToken,                                       \
+                                                                 (uint64_t)counter,                                    \
+                                                                 status)) {                                            \
+            goto done;                                                                                                 \
         }                                                                                                              \
                                                                                                                        \
-        _mongocrypt_buffer_copy_to(mc_##Name##DerivedFromDataTokenAndCounter_get(fromTokenAndCounter), out);           \
-        mc_##Name##DerivedFromDataTokenAndCounter_destroy(fromTokenAndCounter);                                        \
+        view = mc_##Name##DerivedFromDataTokenAndCounterValue_get(&fromTokenAndCounter);                               \
+        _mongocrypt_buffer_copy_to(&view, out);                                                                        \
+        ok = true;                                                                                                     \
                                                                                                                        \
-        return true;                                                                                                   \
+    done:                                                                                                              \
+        mc_##Name##TokenValue_cleanup(&token);                                                                         \
+        mc_##Name##DerivedFromDataTokenValue_cleanup(&fromDataToken);                                                  \
+        mc_##Name##DerivedFromDataTokenAndCounterValue_cleanup(&fromTokenAndCounter);                                  \
+        return ok;                                                                                                     \
     }
 
 DERIVE_TOKEN_IMPL(EDC)
@@ -265,7 +274,7 @@ DERIVE_TOKEN_IMPL(ECC)
 
 static bool _fle2_derive_serverDerivedFromDataToken(_mongocrypt_crypto_t *crypto,
                                                     _mongocrypt_buffer_t *out,
-                                                    const mc_ServerTokenDerivationLevel1Token_t *level1Token,
+                                                    const mc_ServerTokenDerivationLevel1TokenValue_t *level1Token,
                                                     const _mongocrypt_buffer_t *value,
                                                     mongocrypt_status_t *status) {
     BSON_ASSERT_PARAM(crypto);
@@ -276,13 +285,15 @@ static bool _fle2_derive_serverDerivedFromDataToken(_mongocrypt_crypto_t *crypto
 
     _mongocrypt_buffer_init(out);
 
-    mc_ServerDerivedFromDataToken_t *token = mc_ServerDerivedFromDataToken_new(crypto, level1Token, value, status);
-    if (!token) {
+    mc_ServerDerivedFromDataTokenValue_t token;
+    if (!mc_ServerDerivedFromDataTokenValue_init(&token, crypto, level1Token, value, status)) {
+        mc_ServerDerivedFromDataTokenValue_cleanup(&token);
         return false;
     }
 
-    _mongocrypt_buffer_copy_to(mc_ServerDerivedFromDataToken_get(token), out);
-    mc_ServerDerivedFromDataToken_destroy(token);
+    _mongocrypt_buffer_t view = mc_ServerDerivedFromDataTokenValue_get(&token);
+    _mongocrypt_buffer_copy_to(&view, out);
+    mc_ServerDerivedFromDataTokenValue_cleanup(&token);
     return true;
 }
 
@@ -370,12 +381,13 @@ static bool _fle2_placeholder_aes_aead_encrypt(_mongocrypt_key_broker_t *kb,
 //                            ECCDerivedFromDataTokenAndCounter)
 static bool _fle2_derive_encrypted_token(_mongocrypt_crypto_t *crypto,
                                          _mongocrypt_buffer_t *out,
-                                         const mc_CollectionsLevel1Token_t *collectionsLevel1Token,
+                                         const mc_CollectionsLevel1TokenValue_t *collectionsLevel1Token,
                                          const _mongocrypt_buffer_t *escDerivedToken,
                                          const _mongocrypt_buffer_t *eccDerivedToken,
                                          mongocrypt_status_t *status) {
-    mc_ECOCToken_t *ecocToken = mc_ECOCToken_new(crypto, collectionsLevel1Token, status);
-    if (!ecocToken) {
+    mc_ECOCTokenValue_t ecocToken;
+    if (!mc_ECOCTokenValue_init(&ecocToken, crypto, collectionsLevel1Token, status)) {
+        mc_ECOCTokenValue_cleanup(&ecocToken);
         return false;
     }
 
@@ -391,18 +403,19 @@ static bool _fle2_derive_encrypted_token(_mongocrypt_crypto_t *crypto,
         _mongocrypt_buffer_concat(&tmp, tokens, 2);
     }
 
-    const bool ok = _fle2_placeholder_aes_ctr_encrypt(crypto, mc_ECOCToken_get(ecocToken), p, out, status);
+    const _mongocrypt_buffer_t ecocKey = mc_ECOCTokenValue_get(&ecocToken);
+    const bool ok = _fle2_placeholder_aes_ctr_encrypt(crypto, &ecocKey, p, out, status);
     _mongocrypt_buffer_cleanup(&tmp);
-    mc_ECOCToken_destroy(ecocToken);
+    mc_ECOCTokenValue_cleanup(&ecocToken);
     return ok;
 }
 
 // Field derivations shared by both INSERT and FIND payloads.
 typedef struct {
     _mongocrypt_buffer_t tokenKey;
-    mc_CollectionsLevel1Token_t *collectionsLevel1Token;
-    mc_ServerDataEncryptionLevel1Token_t *serverDataEncryptionLevel1Token;
-    mc_ServerTokenDerivationLevel1Token_t *serverTokenDerivationLevel1Token; // v2
+    mc_CollectionsLevel1TokenValue_t collectionsLevel1Token;
+    mc_ServerDataEncryptionLevel1TokenValue_t serverDataEncryptionLevel1Token;
+    mc_ServerTokenDerivationLevel1TokenValue_t serverTokenDerivationLevel1Token; // v2
     _mongocrypt_buffer_t edcDerivedToken;
     _mongocrypt_buffer_t escDerivedToken;
     _mongocrypt_buffer_t eccDerivedToken;            // v1
@@ -415,9 +428,9 @@ static void _FLE2EncryptedPayloadCommon_cleanup(_FLE2EncryptedPayloadCommon_t *c
     }
 
     _mongocrypt_buffer_cleanup(&common->tokenKey);
-    mc_CollectionsLevel1Token_destroy(common->collectionsLevel1Token);
-    mc_ServerDataEncryptionLevel1Token_destroy(common->serverDataEncryptionLevel1Token);
-    mc_ServerTokenDerivationLevel1Token_destroy(common->serverTokenDerivationLevel1Token);
+    mc_CollectionsLevel1TokenValue_cleanup(&common->collectionsLevel1Token);
+    mc_ServerDataEncryptionLevel1TokenValue_cleanup(&common->serverDataEncryptionLevel1Token);
+    mc_ServerTokenDerivationLevel1TokenValue_cleanup(&common->serverTokenDerivationLevel1Token);
     _mongocrypt_buffer_cleanup(&common->edcDerivedToken);
     _mongocrypt_buffer_cleanup(&common->escDerivedToken);
     _mongocrypt_buffer_cleanup(&common->eccDerivedToken);
@@ -482,21 +495,22 @@ static bool _mongocrypt_fle2_placeholder_common(_mongocrypt_key_broker_t *kb,
         goto fail;
     }
 
-    ret->collectionsLevel1Token = mc_CollectionsLevel1Token_new(crypto, &ret->tokenKey, status);
-    if (!ret->collectionsLevel1Token) {
+    if (!mc_CollectionsLevel1TokenValue_init(&ret->collectionsLevel1Token, crypto, &ret->tokenKey, status)) {
         CLIENT_ERR("unable to derive collectionLevel1Token");
         goto fail;
     }
 
-    ret->serverDataEncryptionLevel1Token = mc_ServerDataEncryptionLevel1Token_new(crypto, &ret->tokenKey, status);
-    if (!ret->serverDataEncryptionLevel1Token) {
+    if (!mc_ServerDataEncryptionLevel1TokenValue_init(&ret->serverDataEncryptionLevel1Token,
+                                                      crypto,
+                                                      &ret->tokenKey,
+                                                      status)) {
         CLIENT_ERR("unable to derive serverDataEncryptionLevel1Token");
         goto fail;
     }
 
     if (!_fle2_derive_EDC_token(crypto,
                                 &ret->edcDerivedToken,
-                                ret->collectionsLevel1Token,
+                                &ret->collectionsLevel1Token,
                                 value,
                                 useCounter,
                                 maxContentionCounter,
@@ -506,7 +520,7 @@ static bool _mongocrypt_fle2_placeholder_common(_mongocrypt_key_broker_t *kb,
 
     if (!_fle2_derive_ESC_token(crypto,
                                 &ret->escDerivedToken,
-                                ret->collectionsLevel1Token,
+                                &ret->collectionsLevel1Token,
                                 value,
                                 useCounter,
                                 maxContentionCounter,
@@ -516,15 +530,17 @@ static bool _mongocrypt_fle2_placeholder_common(_mongocrypt_key_broker_t *kb,
 
     if (kb->crypt->opts.use_fle2_v2) {
         /* FLE2v2 */
-        ret->serverTokenDerivationLevel1Token = mc_ServerTokenDerivationLevel1Token_new(crypto, &ret->tokenKey, status);
-        if (!ret->serverTokenDerivationLevel1Token) {
+        if (!mc_ServerTokenDerivationLevel1TokenValue_init(&ret->serverTokenDerivationLevel1Token,
+                                                           crypto,
+                                                           &ret->tokenKey,
+                                                           status)) {
             CLIENT_ERR("unable to derive serverTokenDerivationLevel1Token");
             goto fail;
         }
 
         if (!_fle2_derive_serverDerivedFromDataToken(crypto,
                                                      &ret->serverDerivedFromDataToken,
-                                                     ret->serverTokenDerivationLevel1Token,
+                                                     &ret->serverTokenDerivationLevel1Token,
                                                      value,
                                                      status)) {
             goto fail;
@@ -533,7 +549,7 @@ static bool _mongocrypt_fle2_placeholder_common(_mongocrypt_key_broker_t *kb,
         /* FLE2v1 */
         if (!_fle2_derive_ECC_token(crypto,
                                     &ret->eccDerivedToken,
-                                    ret->collectionsLevel1Token,
+                                    &ret->collectionsLevel1Token,
                                     value,
                                     useCounter,
                                     maxContentionCounter,
@@ -551,6 +567,164 @@ fail:
     return false;
 }
 
+// _fle2_derive_edge_tokens derives the tokens of every range edge in @edges.
+// It is equivalent to calling _mongocrypt_fle2_placeholder_common on each
+// edge, but derives the tokens shared by all edges once and computes the
+// per-edge HMACs together with _mongocrypt_hmac_sha_256_many. Each of the
+// @count elements of @out receives collectionsLevel1Token, edcDerivedToken,
+// escDerivedToken, and eccDerivedToken (v1) or serverDerivedFromDataToken (v2).
+static bool _fle2_derive_edge_tokens(_mongocrypt_key_broker_t *kb,
+                                     _FLE2EncryptedPayloadCommon_t *out,
+                                     const _mongocrypt_buffer_t *indexKeyId,
+                                     const _mongocrypt_buffer_t *edges,
+                                     size_t count,
+                                     bool useCounter,
+                                     int64_t counter,
+                                     mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(kb);
+    BSON_ASSERT(out || count == 0);
+    BSON_ASSERT_PARAM(indexKeyId);
+    BSON_ASSERT(edges || count == 0);
+    BSON_ASSERT(kb->crypt);
+
+    _mongocrypt_crypto_t *crypto = kb->crypt->crypto;
+    const bool v2 = kb->crypt->opts.use_fle2_v2;
+    _mongocrypt_buffer_t tokenKey = {0};
+    mc_CollectionsLevel1TokenValue_t collectionsLevel1Token = {{0}};
+    mc_EDCTokenValue_t edcToken = {{0}};
+    mc_ESCTokenValue_t escToken = {{0}};
+    mc_ECCTokenValue_t eccToken = {{0}};
+    mc_ServerTokenDerivationLevel1TokenValue_t serverTokenDerivationLevel1Token = {{0}};
+    _mongocrypt_buffer_t keys[3];
+    const _mongocrypt_buffer_t **hmac_keys = NULL;
+    const _mongocrypt_buffer_t **hmac_in = NULL;
+    _mongocrypt_buffer_t *fromData = NULL;
+    _mongocrypt_buffer_t *andCounter = NULL;
+    bool ok = false;
+
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (_FLE2EncryptedPayloadCommon_t){{0}};
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    if (!_get_tokenKey(kb, indexKeyId, &tokenKey, status)) {
+        goto done;
+    }
+
+    if (!mc_CollectionsLevel1TokenValue_init(&collectionsLevel1Token, crypto, &tokenKey, status)) {
+        CLIENT_ERR("unable to derive collectionLevel1Token");
+        goto done;
+    }
+
+    if (!mc_EDCTokenValue_init(&edcToken, crypto, &collectionsLevel1Token, status)
+        || !mc_ESCTokenValue_init(&escToken, crypto, &collectionsLevel1Token, status)) {
+        goto done;
+    }
+    keys[0] = mc_EDCTokenValue_get(&edcToken);
+    keys[1] = mc_ESCTokenValue_get(&escToken);
+
+    if (v2) {
+        /* FLE2v2 */
+        if (!mc_ServerTokenDerivationLevel1TokenValue_init(&serverTokenDerivationLevel1Token,
+                                                           crypto,
+                                                           &tokenKey,
+                                                           status)) {
+            CLIENT_ERR("unable to derive serverTokenDerivationLevel1Token");
+            goto done;
+        }
+        keys[2] = mc_ServerTokenDerivationLevel1TokenValue_get(&serverTokenDerivationLevel1Token);
+    } else {
+        /* FLE2v1 */
+        if (!mc_ECCTokenValue_init(&eccToken, crypto, &collectionsLevel1Token, status)) {
+            goto done;
+        }
+        keys[2] = mc_ECCTokenValue_get(&eccToken);
+    }
+
+    // Three HMACs per edge: EDC, ESC, and ECC (v1) or serverDerivedFromData (v2).
+    BSON_ASSERT(count <= SIZE_MAX / (3u * sizeof(_mongocrypt_buffer_t)));
+    const size_t nhmac = 3u * count;
+    hmac_keys = bson_malloc(nhmac * sizeof(*hmac_keys));
+    hmac_in = bson_malloc(nhmac * sizeof(*hmac_in));
+    fromData = bson_malloc0(nhmac * sizeof(*fromData));
+    andCounter = bson_malloc0(nhmac * sizeof(*andCounter));
+
+    // *DerivedFromDataToken := HMAC(*Token, edge)
+    for (size_t i = 0; i < count; i++) {
+        for (size_t k = 0; k < 3u; k++) {
+            hmac_keys[3u * i + k] = &keys[k];
+            hmac_in[3u * i + k] = &edges[i];
+            _mongocrypt_buffer_init_size(&fromData[3u * i + k], MONGOCRYPT_HMAC_SHA256_LEN);
+        }
+    }
+    if (!_mongocrypt_hmac_sha_256_many(crypto, hmac_keys, hmac_in, fromData, nhmac, status)) {
+        goto done;
+    }
+
+    // The counter applies to the EDC, ESC, and ECC (v1) tokens, but not to
+    // serverDerivedFromDataToken (v2).
+    const size_t perEdge = v2 ? 2u : 3u;
+    if (useCounter) {
+        // *DerivedFromDataTokenAndCounter := HMAC(*DerivedFromDataToken, LE64(counter))
+        BSON_ASSERT(counter >= 0);
+        const uint64_t counter_le = BSON_UINT64_TO_LE((uint64_t)counter);
+        _mongocrypt_buffer_t counter_buf;
+        _mongocrypt_buffer_init(&counter_buf);
+        counter_buf.data = (uint8_t *)&counter_le;
+        counter_buf.len = (uint32_t)sizeof(counter_le);
+
+        for (size_t i = 0; i < count; i++) {
+            for (size_t k = 0; k < perEdge; k++) {
+                hmac_keys[perEdge * i + k] = &fromData[3u * i + k];
+                hmac_in[perEdge * i + k] = &counter_buf;
+                _mongocrypt_buffer_init_size(&andCounter[perEdge * i + k], MONGOCRYPT_HMAC_SHA256_LEN);
+            }
+        }
+        if (!_mongocrypt_hmac_sha_256_many(crypto, hmac_keys, hmac_in, andCounter, perEdge * count, status)) {
+            goto done;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        _mongocrypt_buffer_t *derived = useCounter ? &andCounter[perEdge * i] : &fromData[3u * i];
+        out[i].collectionsLevel1Token = collectionsLevel1Token;
+        _mongocrypt_buffer_steal(&out[i].edcDerivedToken, &derived[0]);
+        _mongocrypt_buffer_steal(&out[i].escDerivedToken, &derived[1]);
+        if (v2) {
+            _mongocrypt_buffer_steal(&out[i].serverDerivedFromDataToken, &fromData[3u * i + 2u]);
+        } else {
+            _mongocrypt_buffer_steal(&out[i].eccDerivedToken, &derived[2]);
+        }
+    }
+    ok = true;
+
+done:
+    if (fromData) {
+        for (size_t j = 0; j < 3u * count; j++) {
+            _mongocrypt_buffer_cleanup(&fromData[j]);
+            _mongocrypt_buffer_cleanup(&andCounter[j]);
+        }
+    }
+    bson_free(fromData);
+    bson_free(andCounter);
+    bson_free(hmac_keys);
+    bson_free(hmac_in);
+    _mongocrypt_buffer_cleanup(&tokenKey);
+    mc_CollectionsLevel1TokenValue_cleanup(&collectionsLevel1Token);
+    mc_EDCTokenValue_cleanup(&edcToken);
+    mc_ESCTokenValue_cleanup(&escToken);
+    mc_ECCTokenValue_cleanup(&eccToken);
+    mc_ServerTokenDerivationLevel1TokenValue_cleanup(&serverTokenDerivationLevel1Token);
+    if (!ok) {
+        for (size_t i = 0; i < count; i++) {
+            _FLE2EncryptedPayloadCommon_cleanup(&out[i]);
+        }
+    }
+    return ok;
+}
+
 // Shared implementation for insert/update and insert/update ForRange (v1)
 static bool _mongocrypt_fle2_placeholder_to_insert_update_common_v1(_mongocrypt_key_broker_t *kb,
                                                                     mc_FLE2InsertUpdatePayload_t *out,
@@ -603,7 +777,7 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_common_v1(_mongocrypt_
     // ECCDerivedFromDataTokenAndCounter)
     if (!_fle2_derive_encrypted_token(crypto,
                                       &out->encryptedTokens,
-                                      common->collectionsLevel1Token,
+                                      &common->collectionsLevel1Token,
                                       &out->escDerivedToken,
                                       &out->eccDerivedToken,
                                       status)) {
@@ -634,8 +808,9 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_common_v1(_mongocrypt_
     }
 
     // e := ServerDataEncryptionLevel1Token
-    _mongocrypt_buffer_copy_to(mc_ServerDataEncryptionLevel1Token_get(common->serverDataEncryptionLevel1Token),
-                               &out->serverEncryptionToken);
+    const _mongocrypt_buffer_t serverEncryptionToken =
+        mc_ServerDataEncryptionLevel1TokenValue_get(&common->serverDataEncryptionLevel1Token);
+    _mongocrypt_buffer_copy_to(&serverEncryptionToken, &out->serverEncryptionToken);
 
     res = true;
 fail:
@@ -739,16 +914,18 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_common(_mongocrypt_key
     }
 
     // d := EDCDerivedToken
-    _mongocrypt_buffer_steal(&out->edcDerivedToken, &common->edcDerivedToken);
+    BSON_ASSERT(
+        mc_EDCDerivedFromDataTokenAndCounterValue_init_from_buffer(&out->edcDerivedToken, &common->edcDerivedToken));
     // s := ESCDerivedToken
-    _mongocrypt_buffer_steal(&out->escDerivedToken, &common->escDerivedToken);
+    BSON_ASSERT(
+        mc_ESCDerivedFromDataTokenAndCounterValue_init_from_buffer(&out->escDerivedToken, &common->escDerivedToken));
     BSON_ASSERT(common->eccDerivedToken.data == NULL);
 
     // p := EncryptCBC(ECOCToken, ESCDerivedFromDataTokenAndCounter)
     if (!_fle2_derive_encrypted_token(crypto,
                                       &out->encryptedTokens,
-                                      common->collectionsLevel1Token,
-                                      &out->escDerivedToken,
+                                      &common->collectionsLevel1Token,
+                                      &common->escDerivedToken,
                                       NULL, // unused in v2
                                       status)) {
         goto fail;
@@ -778,11 +955,11 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_common(_mongocrypt_key
     }
 
     // e := ServerDataEncryptionLevel1Token
-    _mongocrypt_buffer_copy_to(mc_ServerDataEncryptionLevel1Token_get(common->serverDataEncryptionLevel1Token),
-                               &out->serverEncryptionToken);
+    out->serverEncryptionToken = common->serverDataEncryptionLevel1Token;
 
     // l := ServerDerivedFromDataToken
-    _mongocrypt_buffer_steal(&out->serverDerivedFromDataToken, &common->serverDerivedFromDataToken);
+    BSON_ASSERT(mc_ServerDerivedFromDataTokenValue_init_from_buffer(&out->serverDerivedFromDataToken,
+                                                                    &common->serverDerivedFromDataToken));
 
     res = true;
 fail:
@@ -829,12 +1006,10 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_ciphertext(_mongocrypt
         goto fail;
     }
 
-    {
-        bson_t out;
-        bson_init(&out);
-        mc_FLE2InsertUpdatePayloadV2_serialize(&payload, &out);
-        _mongocrypt_buffer_steal_from_bson(&ciphertext->data, &out);
+    if (!mc_FLE2InsertUpdatePayloadV2_serializeWithSubtype(&payload, &ciphertext->data, status)) {
+        goto fail;
     }
+    ciphertext->data_has_subtype = true;
 
     // Do not set ciphertext->original_bson_type and ciphertext->key_id. They are
     // not used for FLE2InsertUpdatePayloadV2.
@@ -848,9 +1023,76 @@ fail:
     return res;
 }
 
+// Every placeholder for a range field repeats the field's min, max, and
+// precision. Plans are cached on the key broker, so each field's plan is built
+// once per context rather than once per value.
+static const mc_RangePlanDouble_t *get_range_plan_double(_mongocrypt_key_broker_t *kb,
+                                                         mc_optional_double_t min,
+                                                         mc_optional_double_t max,
+                                                         mc_optional_uint32_t precision,
+                                                         mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(kb);
+
+    mc_array_t *plans = &kb->range_plans_double;
+    if (!plans->data) {
+        _mc_array_init(plans, sizeof(mc_RangePlanDouble_t));
+    }
+    for (size_t i = 0; i < plans->len; i++) {
+        const mc_RangePlanDouble_t *plan = &_mc_array_index(plans, mc_RangePlanDouble_t, i);
+        if (plan->min.set == min.set && 0 == memcmp(&plan->min.value, &min.value, sizeof(double))
+            && 0 == memcmp(&plan->max.value, &max.value, sizeof(double)) && plan->precision.set == precision.set
+            && plan->precision.value == precision.value) {
+            return plan;
+        }
+    }
+
+    mc_RangePlanDouble_t plan;
+    if (!mc_RangePlanDouble_init(&plan, min, max, precision, status)) {
+        return NULL;
+    }
+    _mc_array_append_val(plans, plan);
+    return &_mc_array_index(plans, mc_RangePlanDouble_t, plans->len - 1u);
+}
+
+#if MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
+static const mc_RangePlanDecimal128_t *get_range_plan_dec128(_mongocrypt_key_broker_t *kb,
+                                                             mc_optional_dec128_t min,
+                                                             mc_optional_dec128_t max,
+                                                             mc_optional_uint32_t precision,
+                                                             mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(kb);
+
+    mc_array_t *plans = &kb->range_plans_dec128;
+    if (!plans->data) {
+        _mc_array_init(plans, sizeof(mc_RangePlanDecimal128_t));
+    }
+    for (size_t i = 0; i < plans->len; i++) {
+        const mc_RangePlanDecimal128_t *plan = &_mc_array_index(plans, mc_RangePlanDecimal128_t, i);
+        // Compare representations. Equal values with different representations
+        // only cost an extra plan.
+        if (plan->min.set == min.set && 0 == memcmp(&plan->min.value, &min.value, sizeof(mc_dec128))
+            && 0 == memcmp(&plan->max.value, &max.value, sizeof(mc_dec128)) && plan->precision.set == precision.set
+            && plan->precision.value == precision.value) {
+            return plan;
+        }
+    }
+
+    mc_RangePlanDecimal128_t plan;
+    if (!mc_RangePlanDecimal128_init(&plan, min, max, precision, status)) {
+        return NULL;
+    }
+    _mc_array_append_val(plans, plan);
+    return &_mc_array_index(plans, mc_RangePlanDecimal128_t, plans->len - 1u);
+}
+#endif // MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
+
 // get_edges creates and returns edges from an FLE2RangeInsertSpec. Returns NULL
 // on error.
-static mc_edges_t *get_edges(mc_FLE2RangeInsertSpec_t *insertSpec, size_t sparsity, mongocrypt_status_t *status) {
+static mc_edges_t *get_edges(_mongocrypt_key_broker_t *kb,
+                             mc_FLE2RangeInsertSpec_t *insertSpec,
+                             size_t sparsity,
+                             mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(kb);
     BSON_ASSERT_PARAM(insertSpec);
 
     bson_type_t value_type = bson_iter_type(&insertSpec->v);
@@ -889,6 +1131,9 @@ static mc_edges_t *get_edges(mc_FLE2RangeInsertSpec_t *insertSpec, size_t sparsi
             args.max = OPT_DOUBLE(bson_iter_double(&insertSpec->max));
             args.precision = insertSpec->precision;
         }
+        if (!(args.plan = get_range_plan_double(kb, args.min, args.max, args.precision, status))) {
+            return NULL;
+        }
 
         return mc_getEdgesDouble(args, status);
     }
@@ -907,6 +1152,9 @@ static mc_edges_t *get_edges(mc_FLE2RangeInsertSpec_t *insertSpec, size_t sparsi
             args.max = OPT_MC_DEC128(max);
             args.precision = insertSpec->precision;
         }
+        if (!(args.plan = get_range_plan_dec128(kb, args.min, args.max, args.precision, status))) {
+            return NULL;
+        }
         return mc_getEdgesDecimal128(args, status);
 #else // ↑↑↑↑↑↑↑↑ With Decimal128 / Without ↓↓↓↓↓↓↓↓↓↓
         CLIENT_ERR("unsupported BSON type (Decimal128) for range: libmongocrypt "
@@ -948,6 +1196,9 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_ciphertextForRange_v1(
     mc_FLE2InsertUpdatePayload_init(&payload);
     bool res = false;
     mc_edges_t *edges = NULL;
+    size_t edges_len = 0;
+    _mongocrypt_buffer_t *edge_bufs = NULL;
+    _FLE2EncryptedPayloadCommon_t *edge_tokens = NULL;
 
     // Parse the value ("v"), min ("min"), and max ("max") from
     // FLE2EncryptionPlaceholder for range insert.
@@ -970,47 +1221,49 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_ciphertextForRange_v1(
     // g:= array<EdgeTokenSet>
     {
         BSON_ASSERT(placeholder->sparsity >= 0 && (uint64_t)placeholder->sparsity <= (uint64_t)SIZE_MAX);
-        edges = get_edges(&insertSpec, (size_t)placeholder->sparsity, status);
+        edges = get_edges(kb, &insertSpec, (size_t)placeholder->sparsity, status);
         if (!edges) {
             goto fail;
         }
 
-        for (size_t i = 0; i < mc_edges_len(edges); ++i) {
+        edges_len = mc_edges_len(edges);
+        edge_bufs = bson_malloc0(edges_len * sizeof(*edge_bufs));
+        edge_tokens = bson_malloc0(edges_len * sizeof(*edge_tokens));
+        for (size_t i = 0; i < edges_len; ++i) {
+            if (!_mongocrypt_buffer_from_string(&edge_bufs[i], mc_edges_get(edges, i))) {
+                CLIENT_ERR("failed to copy edge to buffer");
+                goto fail;
+            }
+        }
+        if (!_fle2_derive_edge_tokens(kb,
+                                      edge_tokens,
+                                      &placeholder->index_key_id,
+                                      edge_bufs,
+                                      edges_len,
+                                      true, /* derive tokens using counter */
+                                      contentionFactor,
+                                      status)) {
+            goto fail;
+        }
+
+        for (size_t i = 0; i < edges_len; ++i) {
             // Create an EdgeTokenSet from each edge.
             bool loop_ok = false;
-            const char *edge = mc_edges_get(edges, i);
-            _mongocrypt_buffer_t edge_buf = {0};
-            _FLE2EncryptedPayloadCommon_t edge_tokens = {{0}};
             _mongocrypt_buffer_t encryptedTokens = {0};
             mc_EdgeTokenSet_t etc = {{0}};
 
-            if (!_mongocrypt_buffer_from_string(&edge_buf, edge)) {
-                CLIENT_ERR("failed to copy edge to buffer");
-                goto fail_loop;
-            }
-
-            if (!_mongocrypt_fle2_placeholder_common(kb,
-                                                     &edge_tokens,
-                                                     &placeholder->index_key_id,
-                                                     &edge_buf,
-                                                     true, /* derive tokens using counter */
-                                                     contentionFactor,
-                                                     status)) {
-                goto fail_loop;
-            }
-
             // d := EDCDerivedToken
-            _mongocrypt_buffer_steal(&etc.edcDerivedToken, &edge_tokens.edcDerivedToken);
+            _mongocrypt_buffer_steal(&etc.edcDerivedToken, &edge_tokens[i].edcDerivedToken);
             // s := ESCDerivedToken
-            _mongocrypt_buffer_steal(&etc.escDerivedToken, &edge_tokens.escDerivedToken);
+            _mongocrypt_buffer_steal(&etc.escDerivedToken, &edge_tokens[i].escDerivedToken);
             // c := ECCDerivedToken
-            _mongocrypt_buffer_steal(&etc.eccDerivedToken, &edge_tokens.eccDerivedToken);
+            _mongocrypt_buffer_steal(&etc.eccDerivedToken, &edge_tokens[i].eccDerivedToken);
 
             // p := EncryptCTR(ECOCToken, ESCDerivedFromDataTokenAndCounter ||
             // ECCDerivedFromDataTokenAndCounter)
             if (!_fle2_derive_encrypted_token(kb->crypt->crypto,
                                               &etc.encryptedTokens,
-                                              edge_tokens.collectionsLevel1Token,
+                                              &edge_tokens[i].collectionsLevel1Token,
                                               &etc.escDerivedToken,
                                               &etc.eccDerivedToken,
                                               status)) {
@@ -1022,8 +1275,7 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_ciphertextForRange_v1(
             loop_ok = true;
         fail_loop:
             _mongocrypt_buffer_cleanup(&encryptedTokens);
-            _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens);
-            _mongocrypt_buffer_cleanup(&edge_buf);
+            _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens[i]);
             if (!loop_ok) {
                 goto fail;
             }
@@ -1042,6 +1294,11 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_ciphertextForRange_v1(
 
     res = true;
 fail:
+    for (size_t i = 0; edge_tokens && i < edges_len; i++) {
+        _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens[i]);
+    }
+    bson_free(edge_tokens);
+    bson_free(edge_bufs);
     mc_edges_destroy(edges);
     mc_FLE2InsertUpdatePayload_cleanup(&payload);
     _FLE2EncryptedPayloadCommon_cleanup(&common);
@@ -1082,6 +1339,9 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_ciphertextForRange(_mo
     mc_FLE2InsertUpdatePayloadV2_init(&payload);
     bool res = false;
     mc_edges_t *edges = NULL;
+    size_t edges_len = 0;
+    _mongocrypt_buffer_t *edge_bufs = NULL;
+    _FLE2EncryptedPayloadCommon_t *edge_tokens = NULL;
 
     // Parse the value ("v"), min ("min"), and max ("max") from
     // FLE2EncryptionPlaceholder for range insert.
@@ -1102,51 +1362,58 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_ciphertextForRange(_mo
     // g:= array<EdgeTokenSetV2>
     {
         BSON_ASSERT(placeholder->sparsity >= 0 && (uint64_t)placeholder->sparsity <= (uint64_t)SIZE_MAX);
-        edges = get_edges(&insertSpec, (size_t)placeholder->sparsity, status);
+        edges = get_edges(kb, &insertSpec, (size_t)placeholder->sparsity, status);
         if (!edges) {
             goto fail;
         }
 
-        for (size_t i = 0; i < mc_edges_len(edges); ++i) {
-            // Create an EdgeTokenSet from each edge.
-            bool loop_ok = false;
-            const char *edge = mc_edges_get(edges, i);
-            _mongocrypt_buffer_t edge_buf = {0};
-            _FLE2EncryptedPayloadCommon_t edge_tokens = {{0}};
-            _mongocrypt_buffer_t encryptedTokens = {0};
-            mc_EdgeTokenSetV2_t etc = {{0}};
-
-            if (!_mongocrypt_buffer_from_string(&edge_buf, edge)) {
+        edges_len = mc_edges_len(edges);
+        edge_bufs = bson_malloc0(edges_len * sizeof(*edge_bufs));
+        edge_tokens = bson_malloc0(edges_len * sizeof(*edge_tokens));
+        for (size_t i = 0; i < edges_len; ++i) {
+            if (!_mongocrypt_buffer_from_string(&edge_bufs[i], mc_edges_get(edges, i))) {
                 CLIENT_ERR("failed to copy edge to buffer");
-                goto fail_loop;
+                goto fail;
             }
+        }
+        if (!_fle2_derive_edge_tokens(kb,
+                                      edge_tokens,
+                                      &placeholder->index_key_id,
+                                      edge_bufs,
+                                      edges_len,
+                                      true, /* derive tokens using counter */
+                                      payload.contentionFactor,
+                                      status)) {
+            goto fail;
+        }
 
-            if (!_mongocrypt_fle2_placeholder_common(kb,
-                                                     &edge_tokens,
-                                                     &placeholder->index_key_id,
-                                                     &edge_buf,
-                                                     true, /* derive tokens using counter */
-                                                     payload.contentionFactor,
-                                                     status)) {
-                goto fail_loop;
-            }
-            BSON_ASSERT(edge_tokens.eccDerivedToken.data == NULL);
+        for (size_t i = 0; i < edges_len; ++i) {
+            // Create an EdgeTokenSet from each edge.
+            bool loop_ok = false;
+            mc_EdgeTokenSetV2_t etc = {{{0}}};
+
+            BSON_ASSERT(edge_tokens[i].eccDerivedToken.data == NULL);
 
             // d := EDCDerivedToken
-            _mongocrypt_buffer_steal(&etc.edcDerivedToken, &edge_tokens.edcDerivedToken);
+            BSON_ASSERT(mc_EDCDerivedFromDataTokenAndCounterValue_init_from_buffer(&etc.edcDerivedToken,
+                                                                                   &edge_tokens[i].edcDerivedToken));
             // s := ESCDerivedToken
-            _mongocrypt_buffer_steal(&etc.escDerivedToken, &edge_tokens.escDerivedToken);
+            BSON_ASSERT(mc_ESCDerivedFromDataTokenAndCounterValue_init_from_buffer(&etc.escDerivedToken,
+                                                                                   &edge_tokens[i].escDerivedToken));
 
             // l := serverDerivedFromDataToken
-            _mongocrypt_buffer_steal(&etc.serverDerivedFromDataToken, &edge_tokens.serverDerivedFromDataToken);
+            BSON_ASSERT(
+                mc_ServerDerivedFromDataTokenValue_init_from_buffer(&etc.serverDerivedFromDataToken,
+                                                                    &edge_tokens[i].serverDerivedFromDataToken));
 
             // p := EncryptCBC(ECOCToken, ESCDerivedFromDataTokenAndCounter)
             if (!_fle2_derive_encrypted_token(kb->crypt->crypto,
                                               &etc.encryptedTokens,
-                                              edge_tokens.collectionsLevel1Token,
-                                              &etc.escDerivedToken,
+                                              &edge_tokens[i].collectionsLevel1Token,
+                                              &edge_tokens[i].escDerivedToken,
                                               NULL, // ecc unsed in FLE2v2
                                               status)) {
+                _mongocrypt_buffer_cleanup(&etc.encryptedTokens);
                 goto fail_loop;
             }
 
@@ -1154,27 +1421,28 @@ static bool _mongocrypt_fle2_placeholder_to_insert_update_ciphertextForRange(_mo
 
             loop_ok = true;
         fail_loop:
-            _mongocrypt_buffer_cleanup(&encryptedTokens);
-            _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens);
-            _mongocrypt_buffer_cleanup(&edge_buf);
+            _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens[i]);
             if (!loop_ok) {
                 goto fail;
             }
         }
     }
 
-    {
-        bson_t out;
-        bson_init(&out);
-        mc_FLE2InsertUpdatePayloadV2_serializeForRange(&payload, &out);
-        _mongocrypt_buffer_steal_from_bson(&ciphertext->data, &out);
+    if (!mc_FLE2InsertUpdatePayloadV2_serializeForRangeWithSubtype(&payload, &ciphertext->data, status)) {
+        goto fail;
     }
+    ciphertext->data_has_subtype = true;
     // Do not set ciphertext->original_bson_type and ciphertext->key_id. They are
     // not used for FLE2InsertUpdatePayloadV2.
     ciphertext->blob_subtype = MC_SUBTYPE_FLE2InsertUpdatePayloadV2;
 
     res = true;
 fail:
+    for (size_t i = 0; edge_tokens && i < edges_len; i++) {
+        _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens[i]);
+    }
+    bson_free(edge_tokens);
+    bson_free(edge_bufs);
     mc_edges_destroy(edges);
     mc_FLE2InsertUpdatePayloadV2_cleanup(&payload);
     _FLE2EncryptedPayloadCommon_cleanup(&common);
@@ -1227,8 +1495,9 @@ static bool _mongocrypt_fle2_placeholder_to_find_ciphertext_v1(_mongocrypt_key_b
     _mongocrypt_buffer_steal(&payload.eccDerivedToken, &common.eccDerivedToken);
 
     // e := ServerDataEncryptionLevel1Token
-    _mongocrypt_buffer_copy_to(mc_ServerDataEncryptionLevel1Token_get(common.serverDataEncryptionLevel1Token),
-                               &payload.serverEncryptionToken);
+    const _mongocrypt_buffer_t serverEncryptionToken =
+        mc_ServerDataEncryptionLevel1TokenValue_get(&common.serverDataEncryptionLevel1Token);
+    _mongocrypt_buffer_copy_to(&serverEncryptionToken, &payload.serverEncryptionToken);
 
     payload.maxContentionCounter = placeholder->maxContentionCounter;
 
@@ -1327,10 +1596,12 @@ static bool isInfinite(bson_iter_t *iter) {
     return mc_isinf(bson_iter_double(iter));
 }
 
-// mc_get_mincover_from_FLE2RangeFindSpec creates and returns a mincover from an
-// FLE2RangeFindSpec. Returns NULL on error.
-mc_mincover_t *
-mc_get_mincover_from_FLE2RangeFindSpec(mc_FLE2RangeFindSpec_t *findSpec, size_t sparsity, mongocrypt_status_t *status) {
+// get_mincover creates and returns a mincover from an FLE2RangeFindSpec. If
+// `kb` is not NULL, range plans are cached on it. Returns NULL on error.
+static mc_mincover_t *get_mincover(_mongocrypt_key_broker_t *kb,
+                                   mc_FLE2RangeFindSpec_t *findSpec,
+                                   size_t sparsity,
+                                   mongocrypt_status_t *status) {
     BSON_ASSERT_PARAM(findSpec);
     BSON_ASSERT(findSpec->edgesInfo.set);
 
@@ -1438,6 +1709,9 @@ mc_get_mincover_from_FLE2RangeFindSpec(mc_FLE2RangeFindSpec_t *findSpec, size_t
             args.max = OPT_DOUBLE(bson_iter_double(&findSpec->edgesInfo.value.indexMax));
             args.precision = findSpec->edgesInfo.value.precision;
         }
+        if (kb && !(args.plan = get_range_plan_double(kb, args.min, args.max, args.precision, status))) {
+            return NULL;
+        }
         return mc_getMincoverDouble(args, status);
     }
     case BSON_TYPE_DECIMAL128: {
@@ -1459,6 +1733,9 @@ mc_get_mincover_from_FLE2RangeFindSpec(mc_FLE2RangeFindSpec_t *findSpec, size_t
             args.max = OPT_MC_DEC128(mc_dec128_from_bson_iter(&findSpec->edgesInfo.value.indexMax));
             args.precision = findSpec->edgesInfo.value.precision;
         }
+        if (kb && !(args.plan = get_range_plan_dec128(kb, args.min, args.max, args.precision, status))) {
+            return NULL;
+        }
         return mc_getMincoverDecimal128(args, status);
 #else // ↑↑↑↑↑↑↑↑ With Decimal128 / Without ↓↓↓↓↓↓↓↓↓↓
         CLIENT_ERR("FLE2 find is not supported for Decimal128: libmongocrypt "
@@ -1488,6 +1765,13 @@ mc_get_mincover_from_FLE2RangeFindSpec(mc_FLE2RangeFindSpec_t *findSpec, size_t
     }
 }
 
+// mc_get_mincover_from_FLE2RangeFindSpec creates and returns a mincover from an
+// FLE2RangeFindSpec. Returns NULL on error.
+mc_mincover_t *
+mc_get_mincover_from_FLE2RangeFindSpec(mc_FLE2RangeFindSpec_t *findSpec, size_t sparsity, mongocrypt_status_t *status) {
+    return get_mincover(NULL, findSpec, sparsity, status);
+}
+
 /**
  * Payload subtype 10: FLE2FindRangePayload
  *
@@ -1508,6 +1792,9 @@ static bool _mongocrypt_fle2_placeholder_to_find_ciphertextForRange_v1(_mongocry
     mc_FLE2FindRangePayload_t payload;
     bool res = false;
     mc_mincover_t *mincover = NULL;
+    size_t edges_len = 0;
+    _mongocrypt_buffer_t *edge_bufs = NULL;
+    _FLE2EncryptedPayloadCommon_t *edge_tokens = NULL;
     _mongocrypt_buffer_t tokenKey = {0};
 
     BSON_ASSERT(kb->crypt->opts.use_fle2_v2 == false);
@@ -1534,63 +1821,57 @@ static bool _mongocrypt_fle2_placeholder_to_find_ciphertextForRange_v1(_mongocry
                 goto fail;
             }
 
-            mc_ServerDataEncryptionLevel1Token_t *serverToken =
-                mc_ServerDataEncryptionLevel1Token_new(crypto, &tokenKey, status);
-            if (!serverToken) {
+            mc_ServerDataEncryptionLevel1TokenValue_t serverToken;
+            if (!mc_ServerDataEncryptionLevel1TokenValue_init(&serverToken, crypto, &tokenKey, status)) {
+                mc_ServerDataEncryptionLevel1TokenValue_cleanup(&serverToken);
                 goto fail;
             }
-            _mongocrypt_buffer_copy_to(mc_ServerDataEncryptionLevel1Token_get(serverToken),
-                                       &payload.payload.value.serverEncryptionToken);
-            mc_ServerDataEncryptionLevel1Token_destroy(serverToken);
+            const _mongocrypt_buffer_t serverTokenBuf = mc_ServerDataEncryptionLevel1TokenValue_get(&serverToken);
+            _mongocrypt_buffer_copy_to(&serverTokenBuf, &payload.payload.value.serverEncryptionToken);
+            mc_ServerDataEncryptionLevel1TokenValue_cleanup(&serverToken);
         }
 
         // g:= array<EdgeFindTokenSet>
         {
             BSON_ASSERT(placeholder->sparsity >= 0 && (uint64_t)placeholder->sparsity <= (uint64_t)SIZE_MAX);
-            mincover = mc_get_mincover_from_FLE2RangeFindSpec(&findSpec, (size_t)placeholder->sparsity, status);
+            mincover = get_mincover(kb, &findSpec, (size_t)placeholder->sparsity, status);
             if (!mincover) {
                 goto fail;
             }
 
-            for (size_t i = 0; i < mc_mincover_len(mincover); i++) {
-                // Create a EdgeFindTokenSet from each edge.
-                bool loop_ok = false;
-                const char *edge = mc_mincover_get(mincover, i);
-                _mongocrypt_buffer_t edge_buf = {0};
-                _FLE2EncryptedPayloadCommon_t edge_tokens = {{0}};
-                mc_EdgeFindTokenSet_t eftc = {{0}};
-
-                if (!_mongocrypt_buffer_from_string(&edge_buf, edge)) {
+            edges_len = mc_mincover_len(mincover);
+            edge_bufs = bson_malloc0(edges_len * sizeof(*edge_bufs));
+            edge_tokens = bson_malloc0(edges_len * sizeof(*edge_tokens));
+            for (size_t i = 0; i < edges_len; i++) {
+                if (!_mongocrypt_buffer_from_string(&edge_bufs[i], mc_mincover_get(mincover, i))) {
                     CLIENT_ERR("failed to copy edge to buffer");
-                    goto fail_loop;
+                    goto fail;
                 }
+            }
+            if (!_fle2_derive_edge_tokens(kb,
+                                          edge_tokens,
+                                          &placeholder->index_key_id,
+                                          edge_bufs,
+                                          edges_len,
+                                          false, /* derive tokens using counter */
+                                          placeholder->maxContentionCounter,
+                                          status)) {
+                goto fail;
+            }
 
-                if (!_mongocrypt_fle2_placeholder_common(kb,
-                                                         &edge_tokens,
-                                                         &placeholder->index_key_id,
-                                                         &edge_buf,
-                                                         false, /* derive tokens using counter */
-                                                         placeholder->maxContentionCounter,
-                                                         status)) {
-                    goto fail_loop;
-                }
+            for (size_t i = 0; i < edges_len; i++) {
+                // Create a EdgeFindTokenSet from each edge.
+                mc_EdgeFindTokenSet_t eftc = {{0}};
 
                 // d := EDCDerivedToken
-                _mongocrypt_buffer_steal(&eftc.edcDerivedToken, &edge_tokens.edcDerivedToken);
+                _mongocrypt_buffer_steal(&eftc.edcDerivedToken, &edge_tokens[i].edcDerivedToken);
                 // s := ESCDerivedToken
-                _mongocrypt_buffer_steal(&eftc.escDerivedToken, &edge_tokens.escDerivedToken);
+                _mongocrypt_buffer_steal(&eftc.escDerivedToken, &edge_tokens[i].escDerivedToken);
                 // c := ECCDerivedToken
-                _mongocrypt_buffer_steal(&eftc.eccDerivedToken, &edge_tokens.eccDerivedToken);
+                _mongocrypt_buffer_steal(&eftc.eccDerivedToken, &edge_tokens[i].eccDerivedToken);
 
                 _mc_array_append_val(&payload.payload.value.edgeFindTokenSetArray, eftc);
-
-                loop_ok = true;
-            fail_loop:
-                _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens);
-                _mongocrypt_buffer_cleanup(&edge_buf);
-                if (!loop_ok) {
-                    goto fail;
-                }
+                _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens[i]);
             }
         }
         payload.payload.set = true;
@@ -1614,6 +1895,11 @@ static bool _mongocrypt_fle2_placeholder_to_find_ciphertextForRange_v1(_mongocry
 
     res = true;
 fail:
+    for (size_t i = 0; edge_tokens && i < edges_len; i++) {
+        _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens[i]);
+    }
+    bson_free(edge_tokens);
+    bson_free(edge_bufs);
     mc_mincover_destroy(mincover);
     mc_FLE2FindRangePayload_cleanup(&payload);
     _mongocrypt_buffer_cleanup(&tokenKey);
@@ -1645,6 +1931,9 @@ static bool _mongocrypt_fle2_placeholder_to_find_ciphertextForRange(_mongocrypt_
     mc_FLE2FindRangePayloadV2_t payload;
     bool res = false;
     mc_mincover_t *mincover = NULL;
+    size_t edges_len = 0;
+    _mongocrypt_buffer_t *edge_bufs = NULL;
+    _FLE2EncryptedPayloadCommon_t *edge_tokens = NULL;
     _mongocrypt_buffer_t tokenKey = {0};
 
     BSON_ASSERT(marking->type == MONGOCRYPT_MARKING_FLE2_ENCRYPTION);
@@ -1667,51 +1956,45 @@ static bool _mongocrypt_fle2_placeholder_to_find_ciphertextForRange(_mongocrypt_
         // g:= array<EdgeFindTokenSet>
         {
             BSON_ASSERT(placeholder->sparsity >= 0 && (uint64_t)placeholder->sparsity <= (uint64_t)SIZE_MAX);
-            mincover = mc_get_mincover_from_FLE2RangeFindSpec(&findSpec, (size_t)placeholder->sparsity, status);
+            mincover = get_mincover(kb, &findSpec, (size_t)placeholder->sparsity, status);
             if (!mincover) {
                 goto fail;
             }
 
-            for (size_t i = 0; i < mc_mincover_len(mincover); i++) {
-                // Create a EdgeFindTokenSet from each edge.
-                bool loop_ok = false;
-                const char *edge = mc_mincover_get(mincover, i);
-                _mongocrypt_buffer_t edge_buf = {0};
-                _FLE2EncryptedPayloadCommon_t edge_tokens = {{0}};
-                mc_EdgeFindTokenSetV2_t eftc = {{0}};
-
-                if (!_mongocrypt_buffer_from_string(&edge_buf, edge)) {
+            edges_len = mc_mincover_len(mincover);
+            edge_bufs = bson_malloc0(edges_len * sizeof(*edge_bufs));
+            edge_tokens = bson_malloc0(edges_len * sizeof(*edge_tokens));
+            for (size_t i = 0; i < edges_len; i++) {
+                if (!_mongocrypt_buffer_from_string(&edge_bufs[i], mc_mincover_get(mincover, i))) {
                     CLIENT_ERR("failed to copy edge to buffer");
-                    goto fail_loop;
+                    goto fail;
                 }
+            }
+            if (!_fle2_derive_edge_tokens(kb,
+                                          edge_tokens,
+                                          &placeholder->index_key_id,
+                                          edge_bufs,
+                                          edges_len,
+                                          false, /* derive tokens using counter */
+                                          placeholder->maxContentionCounter,
+                                          status)) {
+                goto fail;
+            }
 
-                if (!_mongocrypt_fle2_placeholder_common(kb,
-                                                         &edge_tokens,
-                                                         &placeholder->index_key_id,
-                                                         &edge_buf,
-                                                         false, /* derive tokens using counter */
-                                                         placeholder->maxContentionCounter,
-                                                         status)) {
-                    goto fail_loop;
-                }
+            for (size_t i = 0; i < edges_len; i++) {
+                // Create a EdgeFindTokenSet from each edge.
+                mc_EdgeFindTokenSetV2_t eftc = {{0}};
 
                 // d := EDCDerivedToken
-                _mongocrypt_buffer_steal(&eftc.edcDerivedToken, &edge_tokens.edcDerivedToken);
+                _mongocrypt_buffer_steal(&eftc.edcDerivedToken, &edge_tokens[i].edcDerivedToken);
                 // s := ESCDerivedToken
-                _mongocrypt_buffer_steal(&eftc.escDerivedToken, &edge_tokens.escDerivedToken);
+                _mongocrypt_buffer_steal(&eftc.escDerivedToken, &edge_tokens[i].escDerivedToken);
 
                 // l := serverDerivedFromDataToken
-                _mongocrypt_buffer_steal(&eftc.serverDerivedFromDataToken, &edge_tokens.serverDerivedFromDataToken);
+                _mongocrypt_buffer_steal(&eftc.serverDerivedFromDataToken, &edge_tokens[i].serverDerivedFromDataToken);
 
                 _mc_array_append_val(&payload.payload.value.edgeFindTokenSetArray, eftc);
-
-                loop_ok = true;
-            fail_loop:
-                _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens);
-                _mongocrypt_buffer_cleanup(&edge_buf);
-                if (!loop_ok) {
-                    goto fail;
-                }
+                _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens[i]);
             }
         }
         payload.payload.set = true;
@@ -1735,6 +2018,11 @@ static bool _mongocrypt_fle2_placeholder_to_find_ciphertextForRange(_mongocrypt_
 
     res = true;
 fail:
+    for (size_t i = 0; edge_tokens && i < edges_len; i++) {
+        _FLE2EncryptedPayloadCommon_cleanup(&edge_tokens[i]);
+    }
+    bson_free(edge_tokens);
+    bson_free(edge_bufs);
     mc_mincover_destroy(mincover);
     mc_FLE2FindRangePayloadV2_cleanup(&payload);
     _mongocrypt_buffer_cleanup(&tokenKey);
@@ -1801,6 +2089,36 @@ fail:
     return res;
 }
 
+/* Compute the deterministic cache attribute: an HMAC under a per-mongocrypt_t
+ * secret of everything the ciphertext depends on. The key material and
+ * associated data have fixed lengths, so the concatenation is unambiguous. */
+static bool _fle1_deterministic_cache_attr(mongocrypt_t *crypt,
+                                           const _mongocrypt_buffer_t *key_material,
+                                           const _mongocrypt_buffer_t *associated_data,
+                                           const _mongocrypt_buffer_t *plaintext,
+                                           _mongocrypt_buffer_t *out,
+                                           mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(crypt);
+    BSON_ASSERT_PARAM(key_material);
+    BSON_ASSERT_PARAM(associated_data);
+    BSON_ASSERT_PARAM(plaintext);
+    BSON_ASSERT_PARAM(out);
+
+    _mongocrypt_buffer_t srcs[3] = {*key_material, *associated_data, *plaintext};
+    _mongocrypt_buffer_t to_hmac;
+    bool ok;
+
+    _mongocrypt_buffer_init(&to_hmac);
+    if (!_mongocrypt_buffer_concat(&to_hmac, srcs, 3)) {
+        CLIENT_ERR("failed to create deterministic cache attribute");
+        return false;
+    }
+    _mongocrypt_buffer_resize(out, MONGOCRYPT_HMAC_SHA256_LEN);
+    ok = _mongocrypt_hmac_sha_256(crypt->crypto, &crypt->cache_deterministic_secret, &to_hmac, out, status);
+    _mongocrypt_buffer_cleanup(&to_hmac);
+    return ok;
+}
+
 static bool _mongocrypt_fle1_marking_to_ciphertext(_mongocrypt_key_broker_t *kb,
                                                    _mongocrypt_marking_t *marking,
                                                    _mongocrypt_ciphertext_t *ciphertext,
@@ -1811,8 +2129,10 @@ static bool _mongocrypt_fle1_marking_to_ciphertext(_mongocrypt_key_broker_t *kb,
     _mongocrypt_buffer_t associated_data;
     _mongocrypt_buffer_t key_material;
     _mongocrypt_buffer_t key_id;
+    _mongocrypt_buffer_t cache_attr;
     bool ret = false;
     bool key_found;
+    bool use_cache;
     uint32_t bytes_written;
 
     BSON_ASSERT_PARAM(kb);
@@ -1822,6 +2142,7 @@ static bool _mongocrypt_fle1_marking_to_ciphertext(_mongocrypt_key_broker_t *kb,
     BSON_ASSERT((marking->type == MONGOCRYPT_MARKING_FLE1_BY_ID)
                 || (marking->type == MONGOCRYPT_MARKING_FLE1_BY_ALTNAME));
 
+    _mongocrypt_buffer_init(&cache_attr);
     _mongocrypt_buffer_init(&plaintext);
     _mongocrypt_buffer_init(&associated_data);
     _mongocrypt_buffer_init(&iv);
@@ -1858,6 +2179,30 @@ static bool _mongocrypt_fle1_marking_to_ciphertext(_mongocrypt_key_broker_t *kb,
     }
 
     _mongocrypt_buffer_from_iter(&plaintext, &marking->v_iter);
+
+    /* Deterministic ciphertexts depend only on the key, associated data and
+     * plaintext, so a repeated value can reuse an earlier result. */
+    BSON_ASSERT(kb->crypt);
+    use_cache = marking->algorithm == MONGOCRYPT_ENCRYPTION_ALGORITHM_DETERMINISTIC
+             && kb->crypt->cache_deterministic->capacity > 0;
+    if (use_cache) {
+        if (!_fle1_deterministic_cache_attr(kb->crypt,
+                                            &key_material,
+                                            &associated_data,
+                                            &plaintext,
+                                            &cache_attr,
+                                            status)) {
+            goto fail;
+        }
+        if (_mongocrypt_cache_query_get(kb->crypt->cache_deterministic,
+                                        &cache_attr,
+                                        kb->crypt->cache_key.expiration,
+                                        ciphertext)) {
+            ret = true;
+            goto fail;
+        }
+    }
+
     ciphertext->data.len = fle1->get_ciphertext_len(plaintext.len, status);
     if (ciphertext->data.len == 0) {
         goto fail;
@@ -1867,7 +2212,6 @@ static bool _mongocrypt_fle1_marking_to_ciphertext(_mongocrypt_key_broker_t *kb,
 
     ciphertext->data.owned = true;
 
-    BSON_ASSERT(kb->crypt);
     switch (marking->algorithm) {
     case MONGOCRYPT_ENCRYPTION_ALGORITHM_DETERMINISTIC:
         /* Use deterministic encryption. */
@@ -1920,9 +2264,14 @@ static bool _mongocrypt_fle1_marking_to_ciphertext(_mongocrypt_key_broker_t *kb,
 
     BSON_ASSERT(bytes_written == ciphertext->data.len);
 
+    if (use_cache) {
+        _mongocrypt_cache_query_add(kb->crypt->cache_deterministic, &cache_attr, &key_id, ciphertext);
+    }
+
     ret = true;
 
 fail:
+    _mongocrypt_buffer_cleanup(&cache_attr);
     _mongocrypt_buffer_cleanup(&iv);
     _mongocrypt_buffer_cleanup(&key_id);
     _mongocrypt_buffer_cleanup(&plaintext);
@@ -1931,6 +2280,81 @@ fail:
     return ret;
 }
 
+/* Serialize every placeholder field a find payload depends on. The payload is
+ * otherwise a deterministic function of the index key. */
+static bool _fle2_find_cache_attr(_mongocrypt_key_broker_t *kb,
+                                  mc_FLE2EncryptionPlaceholder_t *placeholder,
+                                  _mongocrypt_buffer_t *out) {
+    BSON_ASSERT_PARAM(kb);
+    BSON_ASSERT_PARAM(placeholder);
+    BSON_ASSERT_PARAM(out);
+
+    bson_t attr = BSON_INITIALIZER;
+    bool ok = BSON_APPEND_BOOL(&attr, "v2", kb->crypt->opts.use_fle2_v2)
+           && BSON_APPEND_INT32(&attr, "a", (int32_t)placeholder->algorithm)
+           && _mongocrypt_buffer_append(&placeholder->index_key_id, &attr, "ki", 2)
+           && bson_append_iter(&attr, "v", 1, &placeholder->v_iter)
+           && BSON_APPEND_INT64(&attr, "cm", placeholder->maxContentionCounter)
+           && BSON_APPEND_INT64(&attr, "s", placeholder->sparsity);
+    if (!ok) {
+        bson_destroy(&attr);
+        return false;
+    }
+    _mongocrypt_buffer_steal_from_bson(out, &attr);
+    return true;
+}
+
+/* Find payloads are looked up in, and added to, the query cache on the
+ * mongocrypt_t. Entries expire with, and are evicted by, the key cache. */
+static bool _mongocrypt_fle2_placeholder_to_find_ciphertext_cached(_mongocrypt_key_broker_t *kb,
+                                                                   _mongocrypt_marking_t *marking,
+                                                                   _mongocrypt_ciphertext_t *ciphertext,
+                                                                   mongocrypt_status_t *status) {
+    BSON_ASSERT_PARAM(kb);
+    BSON_ASSERT_PARAM(marking);
+    BSON_ASSERT_PARAM(ciphertext);
+
+    _mongocrypt_cache_query_t *cache = kb->crypt->cache_query;
+    _mongocrypt_buffer_t attr;
+    _mongocrypt_buffer_t index_key_id;
+    bool ok;
+
+    if (0 == cache->capacity) {
+        if (marking->fle2.algorithm == MONGOCRYPT_FLE2_ALGORITHM_RANGE) {
+            return _mongocrypt_fle2_placeholder_to_find_ciphertextForRange(kb, marking, ciphertext, status);
+        }
+        return _mongocrypt_fle2_placeholder_to_find_ciphertext(kb, marking, ciphertext, status);
+    }
+
+    // Build the attribute and copy the key id before computing the payload.
+    // The range payload steals index_key_id.
+    _mongocrypt_buffer_init(&attr);
+    _mongocrypt_buffer_init(&index_key_id);
+    if (!_fle2_find_cache_attr(kb, &marking->fle2, &attr)) {
+        CLIENT_ERR("failed to create query cache attribute");
+        return false;
+    }
+
+    if (_mongocrypt_cache_query_get(cache, &attr, kb->crypt->cache_key.expiration, ciphertext)) {
+        _mongocrypt_buffer_cleanup(&attr);
+        return true;
+    }
+
+    _mongocrypt_buffer_copy_to(&marking->fle2.index_key_id, &index_key_id);
+
+    if (marking->fle2.algorithm == MONGOCRYPT_FLE2_ALGORITHM_RANGE) {
+        ok = _mongocrypt_fle2_placeholder_to_find_ciphertextForRange(kb, marking, ciphertext, status);
+    } else {
+        ok = _mongocrypt_fle2_placeholder_to_find_ciphertext(kb, marking, ciphertext, status);
+    }
+    if (ok) {
+        _mongocrypt_cache_query_add(cache, &attr, &index_key_id, ciphertext);
+    }
+    _mongocrypt_buffer_cleanup(&index_key_id);
+    _mongocrypt_buffer_cleanup(&attr);
+    return ok;
+}
+
 bool _mongocrypt_marking_to_ciphertext(void *ctx,
                                        _mongocrypt_marking_t *marking,
                                        _mongocrypt_ciphertext_t *ciphertext,
@@ -1954,7 +2378,7 @@ bool _mongocrypt_marking_to_ciphertext(void *ctx,
                                                                                         ciphertext,
                                                                                         status);
             case MONGOCRYPT_FLE2_PLACEHOLDER_TYPE_FIND:
-                return _mongocrypt_fle2_placeholder_to_find_ciphertextForRange(kb, marking, ciphertext, status);
+                return _mongocrypt_fle2_placeholder_to_find_ciphertext_cached(kb, marking, ciphertext, status);
             default: CLIENT_ERR("unexpected fle2 type: %d", (int)marking->fle2.type); return false;
             }
         case MONGOCRYPT_FLE2_ALGORITHM_EQUALITY:
@@ -1962,7 +2386,7 @@ bool _mongocrypt_marking_to_ciphertext(void *ctx,
             case MONGOCRYPT_FLE2_PLACEHOLDER_TYPE_INSERT:
                 return _mongocrypt_fle2_placeholder_to_insert_update_ciphertext(kb, marking, ciphertext, status);
             case MONGOCRYPT_FLE2_PLACEHOLDER_TYPE_FIND:
-                return _mongocrypt_fle2_placeholder_to_find_ciphertext(kb, marking, ciphertext, status);
+                return _mongocrypt_fle2_placeholder_to_find_ciphertext_cached(kb, marking, ciphertext, status);
             default: CLIENT_ERR("unexpected fle2 type: %d", (int)marking->fle2.type); return false;
             }
         default: CLIENT_ERR("unexpected algorithm: %d", (int)marking->algorithm); return false;
@@ -22,8 +22,12 @@
 #if defined(BSON_OS_UNIX)
 #include <pthread.h>
 #define mongocrypt_mutex_t pthread_mutex_t
+#define mongocrypt_cond_t pthread_cond_t
+#define mongocrypt_thread_id_t pthread_t
 #else
 #define mongocrypt_mutex_t CRITICAL_SECTION
+#define mongocrypt_cond_t CONDITION_VARIABLE
+#define mongocrypt_thread_id_t DWORD
 #endif
 
 void _mongocrypt_mutex_init(mongocrypt_mutex_t *mutex);
@@ -34,6 +38,21 @@ void _mongocrypt_mutex_lock(mongocrypt_mutex_t *mutex);
 
 void _mongocrypt_mutex_unlock(mongocrypt_mutex_t *mutex);
 
+void _mongocrypt_cond_init(mongocrypt_cond_t *cond);
+
+void _mongocrypt_cond_cleanup(mongocrypt_cond_t *cond);
+
+void _mongocrypt_cond_broadcast(mongocrypt_cond_t *cond);
+
+/* Waits on @cond for at most @timeout_us microseconds. @mutex must be held. It
+ * is released while waiting and held again on return. Returns false on
+ * timeout. Wakeups may be spurious, so callers must recheck their condition. */
+bool _mongocrypt_cond_timedwait(mongocrypt_cond_t *cond, mongocrypt_mutex_t *mutex, int64_t timeout_us);
+
+mongocrypt_thread_id_t _mongocrypt_thread_id_self(void);
+
+bool _mongocrypt_thread_id_equal(mongocrypt_thread_id_t a, mongocrypt_thread_id_t b);
+
 #define MONGOCRYPT_WITH_MUTEX(Mutex)                                                                                   \
     for (int only_once = (_mongocrypt_mutex_lock(&(Mutex)), 1); only_once; _mongocrypt_mutex_unlock(&(Mutex)))         \
         for (; only_once; only_once = 0)
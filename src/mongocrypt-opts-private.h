@@ -88,6 +88,18 @@ typedef struct {
     bool use_need_kms_credentials_state;
     bool bypass_query_analysis;
 
+    // Fraction of an OAuth token's "expires_in" after which a new token is
+    // fetched. 0 disables proactive refresh.
+    double oauth_refresh_fraction;
+
+    // Omit "Connection: close" from HTTP KMS requests so drivers may reuse
+    // connections.
+    bool use_kms_keep_alive;
+
+    // Maximum number of documents of an insert analyzed in one crypt_shared
+    // call. 0 analyzes the whole command at once.
+    uint32_t insert_chunk_size;
+
     // When creating new encrypted payloads,
     // use V2 variants of the FLE2 datatypes.
     bool use_fle2_v2;
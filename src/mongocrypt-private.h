@@ -25,6 +25,8 @@
 #include "mongocrypt-cache-key-private.h"
 #include "mongocrypt-cache-oauth-private.h"
 #include "mongocrypt-cache-private.h"
+#include "mongocrypt-cache-query-private.h"
+#include "mongocrypt-cache-signing-key-private.h"
 #include "mongocrypt-crypto-private.h"
 #include "mongocrypt-dll-private.h"
 #include "mongocrypt-log-private.h"
@@ -123,8 +125,20 @@ struct _mongocrypt_t {
     _mongocrypt_crypto_t *crypto;
     /* A counter, protected by mutex, for generating unique context ids */
     uint32_t ctx_counter;
+    /* Counters, protected by mutex, for mongocrypt_decrypt_stats. */
+    uint64_t decrypt_finalized;
+    uint64_t decrypt_passthrough;
     _mongocrypt_cache_oauth_t *cache_oauth_azure;
     _mongocrypt_cache_oauth_t *cache_oauth_gcp;
+    /* Derived AWS signing keys, shared by all AWS KMS requests. */
+    _mongocrypt_cache_signing_key_t *cache_signing_key;
+    /* FLE2 find payloads, shared by all contexts. */
+    _mongocrypt_cache_query_t *cache_query;
+    /* FLE1 deterministic ciphertexts, shared by all contexts. Disabled by
+     * default. Attributes are HMACs keyed with cache_deterministic_secret so
+     * the cache never retains plaintext. */
+    _mongocrypt_cache_query_t *cache_deterministic;
+    _mongocrypt_buffer_t cache_deterministic_secret;
     /// A CSFLE DLL vtable, initialized by mongocrypt_init
     _mongo_crypt_v1_vtable csfle;
     /// Pointer to the global csfle_lib object. Should not be freed directly.
@@ -17,6 +17,7 @@
 #ifndef MONGOCRYPT_TRAVERSE_UTIL_H
 #define MONGOCRYPT_TRAVERSE_UTIL_H
 
+#include "mc-array-private.h"
 #include "mongocrypt-buffer-private.h"
 #include "mongocrypt-status-private.h"
 
@@ -46,4 +47,59 @@ bool _mongocrypt_transform_binary_in_bson(_mongocrypt_transform_callback_t cb,
                                           bson_t *out,
                                           mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
 
+/*-----------------------------------------------------------------------------
+ *
+ * _mongocrypt_traverse_binary_in_bson_at_paths
+ * _mongocrypt_transform_binary_in_bson_at_paths
+ *
+ *    Like _mongocrypt_traverse_binary_in_bson and
+ *    _mongocrypt_transform_binary_in_bson, but only match values on the dotted
+ *    paths in 'paths', an mc_array_t of const char *. A value matches if it is
+ *    at or inside a path, or is an ancestor of one (e.g. an encrypted document
+ *    at "a" for the path "a.b"). Array indexes are not part of paths: "a.b"
+ *    matches "b" in every document of an array "a". Other values are skipped,
+ *    or copied as-is when transforming. If 'paths' is NULL, all values match.
+ *
+ *-----------------------------------------------------------------------------
+ */
+bool _mongocrypt_traverse_binary_in_bson_at_paths(_mongocrypt_traverse_callback_t cb,
+                                                  void *ctx,
+                                                  traversal_match_t match,
+                                                  const mc_array_t *paths,
+                                                  bson_iter_t *iter,
+                                                  mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
+
+bool _mongocrypt_transform_binary_in_bson_at_paths(_mongocrypt_transform_callback_t cb,
+                                                   void *ctx,
+                                                   traversal_match_t match,
+                                                   const mc_array_t *paths,
+                                                   bson_iter_t *iter,
+                                                   bson_t *out,
+                                                   mongocrypt_status_t *status) MONGOCRYPT_WARN_UNUSED_RESULT;
+
+/*-----------------------------------------------------------------------------
+ *
+ * _mongocrypt_scan_binary_in_bson
+ *
+ *    Skim the raw bytes of the BSON document 'doc' for the binary subtype 06
+ *    values _mongocrypt_traverse_binary_in_bson would match, without the
+ *    overhead of bson_iter_t. Element values are skipped by their lengths, so
+ *    large strings and binaries are not read.
+ *
+ *    Sets 'count' to the number of matches. If 'offsets' is not NULL, it must
+ *    be an mc_array_t of uint32_t, and the offset in 'doc' of each match's
+ *    binary length prefix is appended to it. If 'offsets' is NULL, scanning
+ *    stops at the first match.
+ *
+ * Return:
+ *    False if 'doc' is not well-formed BSON. Callers should fall back to
+ *    _mongocrypt_traverse_binary_in_bson.
+ *
+ *-----------------------------------------------------------------------------
+ */
+bool _mongocrypt_scan_binary_in_bson(const _mongocrypt_buffer_t *doc,
+                                     traversal_match_t match,
+                                     mc_array_t *offsets,
+                                     size_t *count) MONGOCRYPT_WARN_UNUSED_RESULT;
+
 #endif /* MONGOCRYPT_TRAVERSE_UTIL_H */
@@ -16,6 +16,7 @@
 
 #include <bson/bson.h>
 
+#include "mc-array-private.h"
 #include "mc-fle-blob-subtype-private.h"
 #include "mongocrypt-buffer-private.h"
 #include "mongocrypt-log-private.h"
@@ -23,11 +24,18 @@
 #include "mongocrypt-status-private.h"
 #include "mongocrypt-traverse-util-private.h"
 
+#include <mlib/str.h>
+
 typedef struct {
     void *ctx;
     bson_iter_t iter;
     bson_t *copy; /* implies transform */
-    char *path;   /* only enabled during tracing. */
+    /* If paths is set, only elements on the dotted paths in it are matched.
+     * path is then the dotted path of the document being iterated, or NULL for
+     * the top-level document. */
+    const mc_array_t *paths; /* const char * */
+    char *path;
+    bool in_array;
     _mongocrypt_traverse_callback_t traverse_cb;
     _mongocrypt_transform_callback_t transform_cb;
     mongocrypt_status_t *status;
@@ -52,6 +60,78 @@ static bool _check_first_byte(uint8_t byte, traversal_match_t match) {
     return false;
 }
 
+typedef enum {
+    PATH_MATCH_NONE,
+    /* The element is on the way to a requested path. */
+    PATH_MATCH_ANCESTOR,
+    /* The element is at a requested path. Everything inside it matches. */
+    PATH_MATCH_INSIDE,
+} _path_match_t;
+
+static _path_match_t _match_paths(const _recurse_state_t *state) {
+    BSON_ASSERT_PARAM(state);
+
+    if (!state->paths) {
+        return PATH_MATCH_INSIDE;
+    }
+    /* Array indexes are not part of paths, like in a projection. The array
+     * itself was an ancestor, so its elements are too. */
+    if (state->in_array) {
+        return PATH_MATCH_ANCESTOR;
+    }
+
+    const mstr_view key = mstrv_view_data(bson_iter_key(&state->iter), bson_iter_key_len(&state->iter));
+    const mstr_view parent = mstrv_view_cstr(state->path ? state->path : "");
+    _path_match_t ret = PATH_MATCH_NONE;
+    for (size_t i = 0; i < state->paths->len; i++) {
+        mstr_view want = mstrv_view_cstr(_mc_array_index(state->paths, const char *, i));
+        if (state->path) {
+            if (!mstr_starts_with(want, parent) || want.len == parent.len || want.data[parent.len] != '.') {
+                continue;
+            }
+            want = mstrv_remove_prefix(want, parent.len + 1u);
+        }
+        if (!mstr_starts_with(want, key)) {
+            continue;
+        }
+        if (want.len == key.len) {
+            return PATH_MATCH_INSIDE;
+        }
+        if (want.data[key.len] == '.') {
+            ret = PATH_MATCH_ANCESTOR;
+        }
+    }
+    return ret;
+}
+
+/* _descend_paths sets the path filter of @child, the state for the value of
+ * the current element of @state. Returns the new path for the caller to free
+ * after recursing, or NULL. */
+static char *_descend_paths(const _recurse_state_t *state,
+                            _path_match_t path_match,
+                            _recurse_state_t *child,
+                            bool child_is_array) {
+    BSON_ASSERT_PARAM(state);
+    BSON_ASSERT_PARAM(child);
+
+    child->in_array = child_is_array;
+    if (!state->paths) {
+        return NULL;
+    }
+    if (path_match == PATH_MATCH_INSIDE) {
+        child->paths = NULL;
+        child->path = NULL;
+        return NULL;
+    }
+    if (state->in_array) {
+        /* Keep the path of the enclosing array. */
+        return NULL;
+    }
+    const char *key = bson_iter_key(&state->iter);
+    child->path = state->path ? bson_strdup_printf("%s.%s", state->path, key) : bson_strdup(key);
+    return child->path;
+}
+
 static bool _recurse(_recurse_state_t *state) {
     mongocrypt_status_t *status;
 
@@ -59,6 +139,21 @@ static bool _recurse(_recurse_state_t *state) {
 
     status = state->status;
     while (bson_iter_next(&state->iter)) {
+        const _path_match_t path_match = _match_paths(state);
+
+        if (path_match == PATH_MATCH_NONE) {
+            /* Leave elements off the requested paths as-is. */
+            if (state->copy) {
+                const uint32_t key_len = bson_iter_key_len(&state->iter);
+                BSON_ASSERT(key_len <= INT_MAX);
+                bson_append_value(state->copy,
+                                  bson_iter_key(&state->iter),
+                                  (int)key_len,
+                                  bson_iter_value(&state->iter));
+            }
+            continue;
+        }
+
         if (BSON_ITER_HOLDS_BINARY(&state->iter)) {
             _mongocrypt_buffer_t value;
 
@@ -91,6 +186,7 @@ static bool _recurse(_recurse_state_t *state) {
 
         if (BSON_ITER_HOLDS_ARRAY(&state->iter)) {
             _recurse_state_t child_state;
+            char *child_path;
             bool ret;
 
             memcpy(&child_state, state, sizeof(_recurse_state_t));
@@ -98,6 +194,7 @@ static bool _recurse(_recurse_state_t *state) {
                 CLIENT_ERR("error recursing into array");
                 return false;
             }
+            child_path = _descend_paths(state, path_match, &child_state, true);
 
             if (state->copy) {
                 const uint32_t key_len = bson_iter_key_len(&state->iter);
@@ -106,6 +203,7 @@ static bool _recurse(_recurse_state_t *state) {
                 child_state.copy = &state->child;
             }
             ret = _recurse(&child_state);
+            bson_free(child_path);
 
             if (state->copy) {
                 bson_append_array_end(state->copy, &state->child);
@@ -118,6 +216,7 @@ static bool _recurse(_recurse_state_t *state) {
 
         if (BSON_ITER_HOLDS_DOCUMENT(&state->iter)) {
             _recurse_state_t child_state;
+            char *child_path;
             bool ret;
 
             memcpy(&child_state, state, sizeof(_recurse_state_t));
@@ -125,6 +224,7 @@ static bool _recurse(_recurse_state_t *state) {
                 CLIENT_ERR("error recursing into document");
                 return false;
             }
+            child_path = _descend_paths(state, path_match, &child_state, false);
             /* TODO: check for errors everywhere. */
             if (state->copy) {
                 const uint32_t key_len = bson_iter_key_len(&state->iter);
@@ -134,6 +234,7 @@ static bool _recurse(_recurse_state_t *state) {
             }
 
             ret = _recurse(&child_state);
+            bson_free(child_path);
 
             if (state->copy) {
                 if (!bson_append_document_end(state->copy, &state->child)) {
@@ -163,8 +264,27 @@ bool _mongocrypt_transform_binary_in_bson(_mongocrypt_transform_callback_t cb,
                                           bson_iter_t *iter,
                                           bson_t *out,
                                           mongocrypt_status_t *status) {
-    _recurse_state_t starting_state =
-        {ctx, *iter, out /* copy */, NULL /* path */, NULL /* traverse callback */, cb, status, match, {0}};
+    return _mongocrypt_transform_binary_in_bson_at_paths(cb, ctx, match, NULL /* paths */, iter, out, status);
+}
+
+bool _mongocrypt_transform_binary_in_bson_at_paths(_mongocrypt_transform_callback_t cb,
+                                                   void *ctx,
+                                                   traversal_match_t match,
+                                                   const mc_array_t *paths,
+                                                   bson_iter_t *iter,
+                                                   bson_t *out,
+                                                   mongocrypt_status_t *status) {
+    _recurse_state_t starting_state = {ctx,
+                                       *iter,
+                                       out /* copy */,
+                                       paths,
+                                       NULL /* path */,
+                                       false /* in_array */,
+                                       NULL /* traverse callback */,
+                                       cb,
+                                       status,
+                                       match,
+                                       {0}};
 
     return _recurse(&starting_state);
 }
@@ -187,8 +307,208 @@ bool _mongocrypt_traverse_binary_in_bson(_mongocrypt_traverse_callback_t cb,
                                          traversal_match_t match,
                                          bson_iter_t *iter,
                                          mongocrypt_status_t *status) {
-    _recurse_state_t starting_state =
-        {ctx, *iter, NULL /* copy */, NULL /* path */, cb, NULL /* transform callback */, status, match, {0}};
+    return _mongocrypt_traverse_binary_in_bson_at_paths(cb, ctx, match, NULL /* paths */, iter, status);
+}
+
+bool _mongocrypt_traverse_binary_in_bson_at_paths(_mongocrypt_traverse_callback_t cb,
+                                                  void *ctx,
+                                                  traversal_match_t match,
+                                                  const mc_array_t *paths,
+                                                  bson_iter_t *iter,
+                                                  mongocrypt_status_t *status) {
+    _recurse_state_t starting_state = {ctx,
+                                       *iter,
+                                       NULL /* copy */,
+                                       paths,
+                                       NULL /* path */,
+                                       false /* in_array */,
+                                       cb,
+                                       NULL /* transform callback */,
+                                       status,
+                                       match,
+                                       {0}};
 
     return _recurse(&starting_state);
 }
+
+typedef struct {
+    const uint8_t *data;
+    traversal_match_t match;
+    mc_array_t *offsets;
+    size_t count;
+} _scan_state_t;
+
+static int32_t _scan_read_int32(const uint8_t *p) {
+    uint32_t temp;
+    memcpy(&temp, p, sizeof(temp));
+    return (int32_t)BSON_UINT32_FROM_LE(temp);
+}
+
+/* _scan_string_len sets @len to the size of the BSON string starting at @p,
+ * including the length prefix. Returns false if it does not fit in @remaining. */
+static bool _scan_string_len(const uint8_t *p, uint32_t remaining, uint32_t *len) {
+    if (remaining < 5u) {
+        return false;
+    }
+    const int32_t str_len = _scan_read_int32(p);
+    if (str_len < 1 || (uint32_t)str_len > remaining - 4u || p[4u + (uint32_t)str_len - 1u] != 0) {
+        return false;
+    }
+    *len = 4u + (uint32_t)str_len;
+    return true;
+}
+
+/* _scan_cstring_len sets @len to the size of the NUL terminated string starting
+ * at @p, including the NUL. Returns false if it does not fit in @remaining. */
+static bool _scan_cstring_len(const uint8_t *p, uint32_t remaining, uint32_t *len) {
+    /* Most keys are short. Check the first bytes before calling memchr, which
+     * libc vectorizes for long strings. */
+    const uint32_t short_len = remaining < 8u ? remaining : 8u;
+    for (uint32_t i = 0; i < short_len; i++) {
+        if (p[i] == 0) {
+            *len = i + 1u;
+            return true;
+        }
+    }
+    const uint8_t *nul = memchr(p + short_len, 0, remaining - short_len);
+    if (!nul) {
+        return false;
+    }
+    *len = (uint32_t)(nul - p) + 1u;
+    return true;
+}
+
+/* _scan_document scans the document of @len bytes at offset @start. The length
+ * prefix and trailing NUL have already been checked. Returns false if the
+ * document is malformed. */
+static bool _scan_document(_scan_state_t *state, uint32_t start, uint32_t len) {
+    const uint8_t *data = state->data;
+    /* end is the offset of the trailing NUL. */
+    const uint32_t end = start + len - 1u;
+    uint32_t pos = start + 4u;
+
+    while (pos < end) {
+        const uint8_t type = data[pos++];
+        uint32_t key_len;
+        /* Keys are found with memchr, which libc vectorizes. */
+        if (!_scan_cstring_len(data + pos, end - pos, &key_len)) {
+            return false;
+        }
+        pos += key_len;
+
+        const uint8_t *value = data + pos;
+        const uint32_t remaining = end - pos;
+        uint32_t value_len;
+        switch (type) {
+        case BSON_TYPE_UNDEFINED:
+        case BSON_TYPE_NULL:
+        case BSON_TYPE_MINKEY:
+        case BSON_TYPE_MAXKEY: value_len = 0; break;
+        case BSON_TYPE_BOOL: value_len = 1; break;
+        case BSON_TYPE_INT32: value_len = 4; break;
+        case BSON_TYPE_DOUBLE:
+        case BSON_TYPE_DATE_TIME:
+        case BSON_TYPE_TIMESTAMP:
+        case BSON_TYPE_INT64: value_len = 8; break;
+        case BSON_TYPE_OID: value_len = 12; break;
+        case BSON_TYPE_DECIMAL128: value_len = 16; break;
+        case BSON_TYPE_UTF8:
+        case BSON_TYPE_CODE:
+        case BSON_TYPE_SYMBOL:
+            if (!_scan_string_len(value, remaining, &value_len)) {
+                return false;
+            }
+            break;
+        case BSON_TYPE_DBPOINTER:
+            if (!_scan_string_len(value, remaining, &value_len)) {
+                return false;
+            }
+            value_len += 12u;
+            break;
+        case BSON_TYPE_REGEX: {
+            uint32_t options_len;
+            if (!_scan_cstring_len(value, remaining, &value_len)
+                || !_scan_cstring_len(value + value_len, remaining - value_len, &options_len)) {
+                return false;
+            }
+            value_len += options_len;
+            break;
+        }
+        case BSON_TYPE_CODEWSCOPE: {
+            /* Like _recurse, do not look inside the scope document. */
+            if (remaining < 4u) {
+                return false;
+            }
+            const int32_t cws_len = _scan_read_int32(value);
+            if (cws_len < 4) {
+                return false;
+            }
+            value_len = (uint32_t)cws_len;
+            break;
+        }
+        case BSON_TYPE_DOCUMENT:
+        case BSON_TYPE_ARRAY: {
+            if (remaining < 5u) {
+                return false;
+            }
+            const int32_t doc_len = _scan_read_int32(value);
+            if (doc_len < 5 || (uint32_t)doc_len > remaining || value[(uint32_t)doc_len - 1u] != 0) {
+                return false;
+            }
+            value_len = (uint32_t)doc_len;
+            if (!_scan_document(state, pos, value_len)) {
+                return false;
+            }
+            if (!state->offsets && state->count > 0) {
+                return true;
+            }
+            break;
+        }
+        case BSON_TYPE_BINARY: {
+            if (remaining < 5u) {
+                return false;
+            }
+            const int32_t bin_len = _scan_read_int32(value);
+            if (bin_len < 0 || (uint32_t)bin_len > remaining - 5u) {
+                return false;
+            }
+            value_len = 5u + (uint32_t)bin_len;
+            if (value[4] == BSON_SUBTYPE_ENCRYPTED && bin_len > 0 && _check_first_byte(value[5], state->match)) {
+                state->count++;
+                if (!state->offsets) {
+                    return true;
+                }
+                _mc_array_append_val(state->offsets, pos);
+            }
+            break;
+        }
+        default: return false;
+        }
+
+        if (value_len > remaining) {
+            return false;
+        }
+        pos += value_len;
+    }
+
+    return pos == end;
+}
+
+bool _mongocrypt_scan_binary_in_bson(const _mongocrypt_buffer_t *doc,
+                                     traversal_match_t match,
+                                     mc_array_t *offsets,
+                                     size_t *count) {
+    BSON_ASSERT_PARAM(doc);
+    BSON_ASSERT_PARAM(count);
+
+    *count = 0;
+    if (doc->len < 5u || doc->len > INT32_MAX || _scan_read_int32(doc->data) != (int32_t)doc->len
+        || doc->data[doc->len - 1u] != 0) {
+        return false;
+    }
+
+    _scan_state_t state = {doc->data, match, offsets, 0};
+    const bool ok = _scan_document(&state, 0, doc->len);
+    *count = state.count;
+    return ok;
+}
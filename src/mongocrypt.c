@@ -102,6 +102,20 @@ static void _mongocrypt_do_init(void) {
     _native_crypto_init();
 }
 
+/* Query and deterministic cache entries are derived from a DEK. Remove them
+ * when the key cache evicts that DEK. */
+static void _evict_derived_from_key(void *ctx, void *value) {
+    mongocrypt_t *crypt = ctx;
+    _mongocrypt_cache_key_value_t *key_value = value;
+
+    BSON_ASSERT_PARAM(crypt);
+    BSON_ASSERT_PARAM(key_value);
+    BSON_ASSERT(key_value->key_doc);
+
+    _mongocrypt_cache_query_remove_key(crypt->cache_query, &key_value->key_doc->id);
+    _mongocrypt_cache_query_remove_key(crypt->cache_deterministic, &key_value->key_doc->id);
+}
+
 mongocrypt_t *mongocrypt_new(void) {
     mongocrypt_t *crypt;
 
@@ -119,6 +133,11 @@ mongocrypt_t *mongocrypt_new(void) {
     crypt->ctx_counter = 1;
     crypt->cache_oauth_azure = _mongocrypt_cache_oauth_new();
     crypt->cache_oauth_gcp = _mongocrypt_cache_oauth_new();
+    crypt->cache_signing_key = _mongocrypt_cache_signing_key_new();
+    crypt->cache_query = _mongocrypt_cache_query_new();
+    crypt->cache_deterministic = _mongocrypt_cache_query_new();
+    crypt->cache_key.on_evict = _evict_derived_from_key;
+    crypt->cache_key.on_evict_ctx = crypt;
     crypt->csfle = (_mongo_crypt_v1_vtable){.okay = false};
 
     static mlib_once_flag init_flag = MLIB_ONCE_INITIALIZER;
@@ -862,6 +881,9 @@ bool mongocrypt_init(mongocrypt_t *crypt) {
         _mongocrypt_log_set_fn(&crypt->log, crypt->opts.log_fn, crypt->opts.log_ctx);
     }
 
+    crypt->cache_oauth_azure->refresh_fraction = crypt->opts.oauth_refresh_fraction;
+    crypt->cache_oauth_gcp->refresh_fraction = crypt->opts.oauth_refresh_fraction;
+
     if (!crypt->crypto) {
 #ifndef MONGOCRYPT_ENABLE_CRYPTO
         CLIENT_ERR("libmongocrypt built with native crypto disabled. crypto "
@@ -874,6 +896,16 @@ bool mongocrypt_init(mongocrypt_t *crypt) {
 #endif
     }
 
+    if (crypt->cache_deterministic->capacity > 0) {
+        _mongocrypt_buffer_resize(&crypt->cache_deterministic_secret, MONGOCRYPT_MAC_KEY_LEN);
+        if (!_mongocrypt_random(crypt->crypto,
+                                &crypt->cache_deterministic_secret,
+                                MONGOCRYPT_MAC_KEY_LEN,
+                                status)) {
+            return false;
+        }
+    }
+
     if (!_wants_csfle(crypt)) {
         // User does not want csfle. Just succeed.
         return true;
@@ -912,6 +944,10 @@ void mongocrypt_destroy(mongocrypt_t *crypt) {
     bson_free(crypt->crypto);
     _mongocrypt_cache_oauth_destroy(crypt->cache_oauth_azure);
     _mongocrypt_cache_oauth_destroy(crypt->cache_oauth_gcp);
+    _mongocrypt_cache_signing_key_destroy(crypt->cache_signing_key);
+    _mongocrypt_cache_query_destroy(crypt->cache_query);
+    _mongocrypt_cache_query_destroy(crypt->cache_deterministic);
+    _mongocrypt_buffer_cleanup(&crypt->cache_deterministic_secret);
 
     if (crypt->csfle.okay) {
         _csfle_drop_global_ref();
@@ -962,6 +998,14 @@ bool _mongocrypt_validate_and_copy_string(const char *in, int32_t in_len, char *
     return true;
 }
 
+bool mongocrypt_is_crypto_available(void) {
+#ifdef MONGOCRYPT_ENABLE_CRYPTO
+    return true;
+#else
+    return false;
+#endif
+}
+
 bool mongocrypt_setopt_crypto_hooks(mongocrypt_t *crypt,
                                     mongocrypt_crypto_fn aes_256_cbc_encrypt,
                                     mongocrypt_crypto_fn aes_256_cbc_decrypt,
@@ -1373,3 +1417,70 @@ void mongocrypt_setopt_bypass_query_analysis(mongocrypt_t *crypt) {
 
     crypt->opts.bypass_query_analysis = true;
 }
+
+void mongocrypt_setopt_use_kms_keep_alive(mongocrypt_t *crypt) {
+    BSON_ASSERT_PARAM(crypt);
+
+    crypt->opts.use_kms_keep_alive = true;
+}
+
+bool mongocrypt_setopt_oauth_refresh_fraction(mongocrypt_t *crypt, double fraction) {
+    ASSERT_MONGOCRYPT_PARAM_UNINIT(crypt);
+
+    mongocrypt_status_t *status = crypt->status;
+
+    /* Written to also reject NaN. */
+    if (!(fraction >= 0.0 && fraction < 1.0)) {
+        CLIENT_ERR("oauth refresh fraction must be in the range [0, 1)");
+        return false;
+    }
+
+    crypt->opts.oauth_refresh_fraction = fraction;
+    return true;
+}
+
+bool mongocrypt_setopt_query_cache_size(mongocrypt_t *crypt, uint32_t size) {
+    ASSERT_MONGOCRYPT_PARAM_UNINIT(crypt);
+
+    _mongocrypt_cache_query_set_capacity(crypt->cache_query, size);
+    return true;
+}
+
+void mongocrypt_query_cache_stats(mongocrypt_t *crypt, uint64_t *hits, uint64_t *misses) {
+    BSON_ASSERT_PARAM(crypt);
+
+    _mongocrypt_cache_query_stats(crypt->cache_query, hits, misses);
+}
+
+bool mongocrypt_setopt_deterministic_cache_size(mongocrypt_t *crypt, uint32_t size) {
+    ASSERT_MONGOCRYPT_PARAM_UNINIT(crypt);
+
+    _mongocrypt_cache_query_set_capacity(crypt->cache_deterministic, size);
+    return true;
+}
+
+void mongocrypt_deterministic_cache_stats(mongocrypt_t *crypt, uint64_t *hits, uint64_t *misses) {
+    BSON_ASSERT_PARAM(crypt);
+
+    _mongocrypt_cache_query_stats(crypt->cache_deterministic, hits, misses);
+}
+
+void mongocrypt_decrypt_stats(mongocrypt_t *crypt, uint64_t *finalized, uint64_t *passthrough) {
+    BSON_ASSERT_PARAM(crypt);
+
+    MONGOCRYPT_WITH_MUTEX(crypt->mutex) {
+        if (finalized) {
+            *finalized = crypt->decrypt_finalized;
+        }
+        if (passthrough) {
+            *passthrough = crypt->decrypt_passthrough;
+        }
+    }
+}
+
+bool mongocrypt_setopt_insert_chunk_size(mongocrypt_t *crypt, uint32_t num_documents) {
+    ASSERT_MONGOCRYPT_PARAM_UNINIT(crypt);
+
+    crypt->opts.insert_chunk_size = num_documents;
+    return true;
+}
@@ -921,6 +921,54 @@ bool mongocrypt_ctx_explicit_encrypt_expression_init(mongocrypt_ctx_t *ctx, mong
 MONGOCRYPT_EXPORT
 bool mongocrypt_ctx_decrypt_init(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *doc);
 
+/**
+ * @brief View the document passed to decrypt instead of copying it.
+ *
+ * By default, @ref mongocrypt_ctx_decrypt_init and @ref
+ * mongocrypt_ctx_explicit_decrypt_init copy the document. With this option, @p
+ * ctx views the caller's data instead, and the data must remain valid and
+ * unmodified until @p ctx is destroyed with @ref mongocrypt_ctx_destroy.
+ *
+ * If the document contains no encrypted values, @ref mongocrypt_ctx_finalize
+ * returns the caller's data itself, so the document is never copied. Use @ref
+ * mongocrypt_decrypt_stats to see how often that happens.
+ *
+ * This option is prohibited on contexts not initialized for decryption.
+ *
+ * @param[in] ctx The @ref mongocrypt_ctx_t object.
+ * @pre @p ctx has not been initialized.
+ * @returns A boolean indicating success. If false, an error status is set.
+ * Retrieve it with @ref mongocrypt_ctx_status
+ */
+MONGOCRYPT_EXPORT
+bool mongocrypt_ctx_setopt_decrypt_borrow_input(mongocrypt_ctx_t *ctx);
+
+/**
+ * @brief Only decrypt values on the given dotted paths.
+ *
+ * By default, @ref mongocrypt_ctx_decrypt_init decrypts every encrypted value
+ * in the document. With this option, only values at or inside the given
+ * paths are decrypted, and keys are only requested for those values. Other
+ * encrypted values are returned as-is.
+ *
+ * Array indexes are not part of paths: "a.b" matches the field "b" of every
+ * document in an array "a". An encrypted value on the way to a path is also
+ * decrypted: "a.b" matches an encrypted document at "a".
+ *
+ * This option is prohibited on contexts not initialized with @ref
+ * mongocrypt_ctx_decrypt_init.
+ *
+ * @param[in] ctx The @ref mongocrypt_ctx_t object.
+ * @param[in] paths A BSON document of the form { "paths": [ "a.b", "c" ] }.
+ * The viewed data is copied. It is valid to destroy @p paths with @ref
+ * mongocrypt_binary_destroy immediately after.
+ * @pre @p ctx has not been initialized.
+ * @returns A boolean indicating success. If false, an error status is set.
+ * Retrieve it with @ref mongocrypt_ctx_status
+ */
+MONGOCRYPT_EXPORT
+bool mongocrypt_ctx_setopt_decrypt_paths(mongocrypt_ctx_t *ctx, mongocrypt_binary_t *paths);
+
 /**
  * Explicit helper method to decrypt a single BSON object.
  *
@@ -1143,6 +1191,43 @@ bool mongocrypt_kms_ctx_status(mongocrypt_kms_ctx_t *kms, mongocrypt_status_t *s
 MONGOCRYPT_EXPORT
 const char *mongocrypt_kms_ctx_get_kms_provider(mongocrypt_kms_ctx_t *kms, uint32_t *len);
 
+/**
+ * Get a key identifying the connection this KMS request may be sent on.
+ *
+ * Requests with equal keys go to the same endpoint of the same KMS provider.
+ * If @ref mongocrypt_setopt_use_kms_keep_alive is set, a driver may pool
+ * connections by this key and reuse them across requests.
+ *
+ * @param[in] kms The @ref mongocrypt_kms_ctx_t object.
+ * @param[out] len Receives the length of the returned string. It may be NULL.
+ * If it is not NULL, it is set to the length of the returned string without
+ * the NULL terminator.
+ *
+ * @returns A NULL terminated string of the form "<provider>/<host>:<port>".
+ * E.g. "aws/kms.us-east-1.amazonaws.com:443". The storage is not owned by the
+ * caller, and is valid until calling @ref mongocrypt_ctx_kms_done.
+ */
+MONGOCRYPT_EXPORT
+const char *mongocrypt_kms_ctx_get_connection_key(mongocrypt_kms_ctx_t *kms, uint32_t *len);
+
+/**
+ * Get bytes fed past the end of the KMS response.
+ *
+ * Only set if @ref mongocrypt_setopt_use_kms_keep_alive is set and the
+ * response is complete. The bytes are the start of the next response on the
+ * connection, and should be fed to the @ref mongocrypt_kms_ctx_t whose request
+ * was sent next.
+ *
+ * @param[in] kms The @ref mongocrypt_kms_ctx_t object.
+ * @param[out] bytes Receives the unconsumed bytes. It is empty if there are
+ * none. The data viewed by @p bytes is valid until calling
+ * @ref mongocrypt_ctx_kms_done.
+ * @returns A boolean indicating success. If false, an error status is set.
+ * Retrieve it with @ref mongocrypt_kms_ctx_status
+ */
+MONGOCRYPT_EXPORT
+bool mongocrypt_kms_ctx_unconsumed(mongocrypt_kms_ctx_t *kms, mongocrypt_binary_t *bytes);
+
 /**
  * Call when done handling all KMS contexts.
  *
@@ -1299,6 +1384,19 @@ typedef bool (*mongocrypt_hash_fn)(void *ctx,
  */
 typedef bool (*mongocrypt_random_fn)(void *ctx, mongocrypt_binary_t *out, uint32_t count, mongocrypt_status_t *status);
 
+/**
+ * Returns true if libmongocrypt was built with native crypto support.
+ *
+ * If this returns false, crypto hooks must be set with @ref
+ * mongocrypt_setopt_crypto_hooks before calling @ref mongocrypt_init. If
+ * it returns true, bindings may omit the hooks and let libmongocrypt do
+ * crypto without calling back into the host language.
+ *
+ * @returns True if native crypto is available.
+ */
+MONGOCRYPT_EXPORT
+bool mongocrypt_is_crypto_available(void);
+
 MONGOCRYPT_EXPORT
 bool mongocrypt_setopt_crypto_hooks(mongocrypt_t *crypt,
                                     mongocrypt_crypto_fn aes_256_cbc_encrypt,
@@ -1382,6 +1480,146 @@ bool mongocrypt_setopt_crypto_hook_sign_rsaes_pkcs1_v1_5(mongocrypt_t *crypt,
 MONGOCRYPT_EXPORT
 void mongocrypt_setopt_bypass_query_analysis(mongocrypt_t *crypt);
 
+/**
+ * @brief Opt-into persistent connections for KMS requests.
+ *
+ * If opted in, HTTP KMS requests are created without a "Connection: close"
+ * header, so a driver may send several requests over one TLS connection.
+ * Requests that may share a connection have equal keys from
+ * @ref mongocrypt_kms_ctx_get_connection_key.
+ *
+ * If a driver sends several requests on one connection before reading the
+ * responses, bytes read past the end of one response are kept by its
+ * @ref mongocrypt_kms_ctx_t. Retrieve them with
+ * @ref mongocrypt_kms_ctx_unconsumed and feed them to the context whose request
+ * was sent next.
+ *
+ * @param[in] crypt The @ref mongocrypt_t object to update
+ */
+MONGOCRYPT_EXPORT
+void mongocrypt_setopt_use_kms_keep_alive(mongocrypt_t *crypt);
+
+/**
+ * @brief Opt-into proactively refreshing cached Azure and GCP OAuth tokens.
+ *
+ * Once a cached token has been held for @p fraction of its reported
+ * "expires_in" lifetime, the next context needing the token fetches a new one.
+ * Other contexts continue using the cached token until it is replaced, and at
+ * most one refresh is in flight per KMS provider.
+ *
+ * Independently of this option, when no token is cached, a context on one
+ * thread waits briefly for a token being fetched by a context on another
+ * thread instead of fetching its own.
+ *
+ * @param[in] crypt The @ref mongocrypt_t object to update
+ * @param[in] fraction A value in [0, 1). 0 (the default) disables proactive
+ * refresh.
+ * @pre @ref mongocrypt_init has not been called on @p crypt.
+ * @returns A boolean indicating success. If false, an error status is set.
+ * Retrieve it with @ref mongocrypt_status
+ */
+MONGOCRYPT_EXPORT
+bool mongocrypt_setopt_oauth_refresh_fraction(mongocrypt_t *crypt, double fraction);
+
+/**
+ * @brief Set the maximum number of cached Queryable Encryption find payloads.
+ *
+ * Find payloads for equality and range queries are deterministic given the
+ * query value, index key, and query options. Payloads are cached on the
+ * @ref mongocrypt_t so repeated queries skip token derivation. The least
+ * recently used payload is evicted when the cache is full, and payloads are
+ * removed when the cached data key they were derived from expires. Removed
+ * payloads are zeroed.
+ *
+ * @param[in] crypt The @ref mongocrypt_t object to update
+ * @param[in] size The maximum number of entries. Defaults to 0, which disables
+ * the cache.
+ * @pre @ref mongocrypt_init has not been called on @p crypt.
+ * @returns A boolean indicating success. If false, an error status is set.
+ * Retrieve it with @ref mongocrypt_status
+ */
+MONGOCRYPT_EXPORT
+bool mongocrypt_setopt_query_cache_size(mongocrypt_t *crypt, uint32_t size);
+
+/**
+ * @brief Get counters for the Queryable Encryption find payload cache.
+ *
+ * @param[in] crypt The @ref mongocrypt_t object.
+ * @param[out] hits If not NULL, set to the number of lookups that found a
+ * cached payload.
+ * @param[out] misses If not NULL, set to the number of lookups that did not.
+ */
+MONGOCRYPT_EXPORT
+void mongocrypt_query_cache_stats(mongocrypt_t *crypt, uint64_t *hits, uint64_t *misses);
+
+/**
+ * @brief Set the maximum number of cached deterministic ciphertexts.
+ *
+ * Ciphertexts for AEAD_AES_256_CBC_HMAC_SHA_512-Deterministic are a function
+ * of the data key and the value, so repeated values can reuse an earlier
+ * result instead of being encrypted again. Cached entries are looked up by an
+ * HMAC of the data key and value under a random secret, so the cache does not
+ * hold plaintext. The least recently used entry is evicted when the cache is
+ * full, and entries are removed when the cached data key they were derived
+ * from expires.
+ *
+ * @param[in] crypt The @ref mongocrypt_t object to update
+ * @param[in] size The maximum number of entries. Defaults to 0, which disables
+ * the cache.
+ * @pre @ref mongocrypt_init has not been called on @p crypt.
+ * @returns A boolean indicating success. If false, an error status is set.
+ * Retrieve it with @ref mongocrypt_status
+ */
+MONGOCRYPT_EXPORT
+bool mongocrypt_setopt_deterministic_cache_size(mongocrypt_t *crypt, uint32_t size);
+
+/**
+ * @brief Get counters for the deterministic ciphertext cache.
+ *
+ * @param[in] crypt The @ref mongocrypt_t object.
+ * @param[out] hits If not NULL, set to the number of lookups that found a
+ * cached ciphertext.
+ * @param[out] misses If not NULL, set to the number of lookups that did not.
+ */
+MONGOCRYPT_EXPORT
+void mongocrypt_deterministic_cache_stats(mongocrypt_t *crypt, uint64_t *hits, uint64_t *misses);
+
+/**
+ * @brief Get counters for decryption.
+ *
+ * @param[in] crypt The @ref mongocrypt_t object.
+ * @param[out] finalized If not NULL, set to the number of documents returned
+ * by @ref mongocrypt_ctx_finalize from decryption contexts.
+ * @param[out] passthrough If not NULL, set to the number of those documents
+ * that had no encrypted values and were returned unchanged.
+ */
+MONGOCRYPT_EXPORT
+void mongocrypt_decrypt_stats(mongocrypt_t *crypt, uint64_t *finalized, uint64_t *passthrough);
+
+/**
+ * @brief Analyze large inserts with crypt_shared in slices of documents.
+ *
+ * If an "insert" command has more than @p num_documents documents, query
+ * analysis is run separately on each slice of @p num_documents documents, and
+ * the marked slices are joined into one command before encryption. This bounds
+ * the size of each command passed to crypt_shared. Each slice is analyzed with
+ * the command's other fields in their original order, and the marked
+ * documents replace "documents" in place. The encrypted command is the same as
+ * without this option, provided crypt_shared marks each document the same way
+ * regardless of the other documents in the command.
+ *
+ * This option has no effect when markings are obtained from mongocryptd.
+ *
+ * @param[in] crypt The @ref mongocrypt_t object to update
+ * @param[in] num_documents The number of documents per slice. Defaults to 0,
+ * which analyzes the whole command at once.
+ * @pre @ref mongocrypt_init has not been called on @p crypt.
+ * @returns A boolean indicating success. If false, an error status is set.
+ * Retrieve it with @ref mongocrypt_status
+ */
+MONGOCRYPT_EXPORT
+bool mongocrypt_setopt_insert_chunk_size(mongocrypt_t *crypt, uint32_t num_documents);
+
 /**
  * Set the contention factor used for explicit encryption.
  * The contention factor is only used for indexed Queryable Encryption.
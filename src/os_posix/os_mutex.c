@@ -18,6 +18,9 @@
 
 #ifndef _WIN32
 
+#include <errno.h>
+#include <time.h>
+
 void _mongocrypt_mutex_init(mongocrypt_mutex_t *mutex) {
     int ret = pthread_mutex_init(mutex, NULL);
     if (ret) {
@@ -46,4 +49,62 @@ void _mongocrypt_mutex_unlock(mongocrypt_mutex_t *mutex) {
     }
 }
 
+void _mongocrypt_cond_init(mongocrypt_cond_t *cond) {
+    int ret = pthread_cond_init(cond, NULL);
+    if (ret) {
+        abort();
+    }
+}
+
+void _mongocrypt_cond_cleanup(mongocrypt_cond_t *cond) {
+    int ret = pthread_cond_destroy(cond);
+    if (ret) {
+        abort();
+    }
+}
+
+void _mongocrypt_cond_broadcast(mongocrypt_cond_t *cond) {
+    int ret = pthread_cond_broadcast(cond);
+    if (ret) {
+        abort();
+    }
+}
+
+bool _mongocrypt_cond_timedwait(mongocrypt_cond_t *cond, mongocrypt_mutex_t *mutex, int64_t timeout_us) {
+    struct timespec deadline;
+    int ret;
+
+    if (timeout_us < 0) {
+        timeout_us = 0;
+    }
+
+    /* pthread_cond_timedwait takes an absolute CLOCK_REALTIME deadline. */
+    if (0 != clock_gettime(CLOCK_REALTIME, &deadline)) {
+        abort();
+    }
+    deadline.tv_sec += (time_t)(timeout_us / 1000000);
+    deadline.tv_nsec += (long)(timeout_us % 1000000) * 1000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    ret = pthread_cond_timedwait(cond, mutex, &deadline);
+    if (ret == ETIMEDOUT) {
+        return false;
+    }
+    if (ret) {
+        abort();
+    }
+    return true;
+}
+
+mongocrypt_thread_id_t _mongocrypt_thread_id_self(void) {
+    return pthread_self();
+}
+
+bool _mongocrypt_thread_id_equal(mongocrypt_thread_id_t a, mongocrypt_thread_id_t b) {
+    return 0 != pthread_equal(a, b);
+}
+
 #endif /* _WIN32 */
\ No newline at end of file
@@ -34,4 +34,43 @@ void _mongocrypt_mutex_unlock(mongocrypt_mutex_t *mutex) {
     LeaveCriticalSection(mutex);
 }
 
+void _mongocrypt_cond_init(mongocrypt_cond_t *cond) {
+    InitializeConditionVariable(cond);
+}
+
+void _mongocrypt_cond_cleanup(mongocrypt_cond_t *cond) {
+    /* Windows condition variables do not need to be destroyed. */
+    (void)cond;
+}
+
+void _mongocrypt_cond_broadcast(mongocrypt_cond_t *cond) {
+    WakeAllConditionVariable(cond);
+}
+
+bool _mongocrypt_cond_timedwait(mongocrypt_cond_t *cond, mongocrypt_mutex_t *mutex, int64_t timeout_us) {
+    DWORD timeout_ms;
+
+    if (timeout_us < 0) {
+        timeout_us = 0;
+    }
+    /* Round up so a short wait does not become a poll. */
+    timeout_ms = (DWORD)((timeout_us + 999) / 1000);
+
+    if (!SleepConditionVariableCS(cond, mutex, timeout_ms)) {
+        if (GetLastError() == ERROR_TIMEOUT) {
+            return false;
+        }
+        abort();
+    }
+    return true;
+}
+
+mongocrypt_thread_id_t _mongocrypt_thread_id_self(void) {
+    return GetCurrentThreadId();
+}
+
+bool _mongocrypt_thread_id_equal(mongocrypt_thread_id_t a, mongocrypt_thread_id_t b) {
+    return a == b;
+}
+
 #endif /* _WIN32 */
\ No newline at end of file
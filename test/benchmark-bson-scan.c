@@ -0,0 +1,135 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Compares looking for ciphertexts in 1 to 16 MB documents with no ciphertexts
+ * through bson_iter_t (_mongocrypt_traverse_binary_in_bson) and by skimming the
+ * raw bytes (_mongocrypt_scan_binary_in_bson). Two shapes are measured: an
+ * aggregation-like reply of many small documents, and a few large values.
+ *
+ * Usage: benchmark-bson-scan [iterations]
+ */
+
+#include <mongocrypt-private.h>
+#include <mongocrypt-traverse-util-private.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static void _fail(const char *what, mongocrypt_status_t *status) {
+    fprintf(stderr, "%s failed: %s\n", what, mongocrypt_status_message(status, NULL));
+    exit(1);
+}
+
+static void _report(const char *name, int64_t start_us, uint32_t doc_len, size_t iterations) {
+    const double elapsed = (double)(bson_get_monotonic_time() - start_us) / 1e6;
+    const double rate = (double)doc_len * (double)iterations / elapsed / 1e9;
+    printf("  %-12s %10.3f ms/doc %8.2f GB/s\n", name, elapsed * 1e3 / (double)iterations, rate);
+}
+
+static bool _count_cb(void *ctx, _mongocrypt_buffer_t *in, mongocrypt_status_t *status) {
+    (*(size_t *)ctx)++;
+    return true;
+}
+
+/* _make_reply builds {cursor: {firstBatch: [{_id, name, qty, price, tags}, ...]}}
+ * of about @target bytes. */
+static bson_t *_make_reply(uint32_t target) {
+    bson_t *reply = bson_new();
+    bson_t cursor, batch, doc, tags;
+
+    BSON_APPEND_DOCUMENT_BEGIN(reply, "cursor", &cursor);
+    BSON_APPEND_ARRAY_BEGIN(&cursor, "firstBatch", &batch);
+    for (uint32_t i = 0; batch.len < target; i++) {
+        const char *key;
+        char storage[16];
+        bson_uint32_to_string(i, &key, storage, sizeof(storage));
+        BSON_APPEND_DOCUMENT_BEGIN(&batch, key, &doc);
+        BSON_APPEND_INT64(&doc, "_id", (int64_t)i);
+        BSON_APPEND_UTF8(&doc, "name", "a typical product name");
+        BSON_APPEND_INT32(&doc, "qty", (int32_t)(i % 1000u));
+        BSON_APPEND_DOUBLE(&doc, "price", (double)i * 0.25);
+        BSON_APPEND_ARRAY_BEGIN(&doc, "tags", &tags);
+        BSON_APPEND_UTF8(&tags, "0", "red");
+        BSON_APPEND_UTF8(&tags, "1", "large");
+        bson_append_array_end(&doc, &tags);
+        bson_append_document_end(&batch, &doc);
+    }
+    bson_append_array_end(&cursor, &batch);
+    bson_append_document_end(reply, &cursor);
+    return reply;
+}
+
+/* _make_blobs builds a document of 64 KB non-encrypted binaries. */
+static bson_t *_make_blobs(uint32_t target) {
+    bson_t *doc = bson_new();
+    const uint32_t blob_len = 64u * 1024u;
+    uint8_t *blob = bson_malloc0(blob_len);
+
+    for (uint32_t i = 0; doc->len < target; i++) {
+        const char *key;
+        char storage[16];
+        bson_uint32_to_string(i, &key, storage, sizeof(storage));
+        BSON_APPEND_BINARY(doc, key, BSON_SUBTYPE_BINARY, blob, blob_len);
+    }
+    bson_free(blob);
+    return doc;
+}
+
+static void _bench(const char *shape, bson_t *doc, size_t iterations, mongocrypt_status_t *status) {
+    _mongocrypt_buffer_t raw;
+    bson_iter_t iter;
+    size_t count = 0;
+    int64_t start;
+
+    printf("%s, %.1f MB\n", shape, (double)doc->len / (1024.0 * 1024.0));
+    _mongocrypt_buffer_from_bson(&raw, doc);
+
+    start = bson_get_monotonic_time();
+    for (size_t it = 0; it < iterations; it++) {
+        BSON_ASSERT(bson_iter_init(&iter, doc));
+        if (!_mongocrypt_traverse_binary_in_bson(_count_cb, &count, TRAVERSE_MATCH_CIPHERTEXT, &iter, status)) {
+            _fail("_mongocrypt_traverse_binary_in_bson", status);
+        }
+    }
+    _report("bson_iter_t", start, doc->len, iterations);
+
+    start = bson_get_monotonic_time();
+    for (size_t it = 0; it < iterations; it++) {
+        if (!_mongocrypt_scan_binary_in_bson(&raw, TRAVERSE_MATCH_CIPHERTEXT, NULL, &count)) {
+            _fail("_mongocrypt_scan_binary_in_bson", status);
+        }
+    }
+    _report("scan", start, doc->len, iterations);
+    BSON_ASSERT(count == 0);
+}
+
+int main(int argc, char **argv) {
+    const size_t iterations = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 20u;
+    mongocrypt_status_t *status = mongocrypt_status_new();
+
+    for (uint32_t mb = 1; mb <= 16; mb *= 2) {
+        bson_t *reply = _make_reply(mb * 1024u * 1024u);
+        _bench("many small documents", reply, iterations, status);
+        bson_destroy(reply);
+
+        bson_t *blobs = _make_blobs(mb * 1024u * 1024u);
+        _bench("64 KB binaries", blobs, iterations, status);
+        bson_destroy(blobs);
+    }
+
+    mongocrypt_status_destroy(status);
+    return 0;
+}
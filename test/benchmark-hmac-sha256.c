@@ -0,0 +1,124 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Compares HMAC-SHA256 through the native crypto library, one input at a time,
+ * with the batched multi-lane kernels. The inputs mimic range edge token
+ * derivation: 32 byte keys and short edge strings.
+ *
+ * Usage: benchmark-hmac-sha256 [count] [iterations]
+ */
+
+#include <mongocrypt-crypto-private.h>
+#include <mongocrypt-private.h>
+
+#include <mc-sha256-private.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static void _fail(const char *what, mongocrypt_status_t *status) {
+    fprintf(stderr, "%s failed: %s\n", what, mongocrypt_status_message(status, NULL));
+    exit(1);
+}
+
+static void _report(const char *name, int64_t start_us, size_t count, size_t iterations) {
+    const double elapsed = (double)(bson_get_monotonic_time() - start_us) / 1e6;
+    const double rate = (double)count * (double)iterations / elapsed;
+    printf("%-24s %10.3f s %14.0f HMAC/s\n", name, elapsed, rate);
+}
+
+int main(int argc, char **argv) {
+    const size_t count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 1024u;
+    const size_t iterations = argc > 2 ? (size_t)strtoul(argv[2], NULL, 10) : 200u;
+    /* Create a mongocrypt_t to call _native_crypto_init(). */
+    mongocrypt_t *crypt = mongocrypt_new();
+    mongocrypt_status_t *status = mongocrypt_status_new();
+    _mongocrypt_buffer_t *keys = bson_malloc0(count * sizeof(_mongocrypt_buffer_t));
+    _mongocrypt_buffer_t *inputs = bson_malloc0(count * sizeof(_mongocrypt_buffer_t));
+    _mongocrypt_buffer_t *outs = bson_malloc0(count * sizeof(_mongocrypt_buffer_t));
+    const _mongocrypt_buffer_t **key_ptrs = bson_malloc0(count * sizeof(_mongocrypt_buffer_t *));
+    const _mongocrypt_buffer_t **input_ptrs = bson_malloc0(count * sizeof(_mongocrypt_buffer_t *));
+    mc_hmac_sha256_job_t *jobs = bson_malloc0(count * sizeof(mc_hmac_sha256_job_t));
+    const mc_sha256_impl_t impls[] =
+        {MC_SHA256_IMPL_SCALAR, MC_SHA256_IMPL_SSE2, MC_SHA256_IMPL_NEON, MC_SHA256_IMPL_AVX2, MC_SHA256_IMPL_SHANI};
+    int64_t start;
+
+    for (size_t i = 0; i < count; i++) {
+        _mongocrypt_buffer_init_size(&keys[i], MONGOCRYPT_MAC_KEY_LEN);
+        for (uint32_t j = 0; j < keys[i].len; j++) {
+            keys[i].data[j] = (uint8_t)(i + j);
+        }
+        /* Edges are bit strings of up to 64 characters. */
+        _mongocrypt_buffer_init_size(&inputs[i], (uint32_t)(1u + i % 64u));
+        for (uint32_t j = 0; j < inputs[i].len; j++) {
+            inputs[i].data[j] = (uint8_t)('0' + ((i >> (j % 16u)) & 1u));
+        }
+        _mongocrypt_buffer_init_size(&outs[i], MONGOCRYPT_HMAC_SHA256_LEN);
+        key_ptrs[i] = &keys[i];
+        input_ptrs[i] = &inputs[i];
+        jobs[i].key = keys[i].data;
+        jobs[i].key_len = keys[i].len;
+        jobs[i].in = inputs[i].data;
+        jobs[i].in_len = inputs[i].len;
+        jobs[i].out = outs[i].data;
+    }
+
+    printf("%zu HMAC-SHA256 per batch, %zu batches\n", count, iterations);
+
+    start = bson_get_monotonic_time();
+    for (size_t it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < count; i++) {
+            if (!_native_crypto_hmac_sha_256(&keys[i], &inputs[i], &outs[i], status)) {
+                _fail("_native_crypto_hmac_sha_256", status);
+            }
+        }
+    }
+    _report("native (one at a time)", start, count, iterations);
+
+    for (size_t k = 0; k < sizeof(impls) / sizeof(impls[0]); k++) {
+        if (!mc_sha256_impl_supported(impls[k])) {
+            continue;
+        }
+        start = bson_get_monotonic_time();
+        for (size_t it = 0; it < iterations; it++) {
+            mc_hmac_sha256_many(impls[k], jobs, count);
+        }
+        _report(mc_sha256_impl_name(impls[k]), start, count, iterations);
+    }
+
+    start = bson_get_monotonic_time();
+    for (size_t it = 0; it < iterations; it++) {
+        if (!_mongocrypt_hmac_sha_256_many(crypt->crypto, key_ptrs, input_ptrs, outs, count, status)) {
+            _fail("_mongocrypt_hmac_sha_256_many", status);
+        }
+    }
+    _report("_mongocrypt_hmac_sha_256_many", start, count, iterations);
+
+    for (size_t i = 0; i < count; i++) {
+        _mongocrypt_buffer_cleanup(&keys[i]);
+        _mongocrypt_buffer_cleanup(&inputs[i]);
+        _mongocrypt_buffer_cleanup(&outs[i]);
+    }
+    bson_free(jobs);
+    bson_free(input_ptrs);
+    bson_free(key_ptrs);
+    bson_free(outs);
+    bson_free(inputs);
+    bson_free(keys);
+    mongocrypt_status_destroy(status);
+    mongocrypt_destroy(crypt);
+    return 0;
+}
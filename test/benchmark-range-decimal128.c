@@ -0,0 +1,210 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Measures the Decimal128 range algorithms, which spend much of their time in
+ * mlib_int128 multiplication and division: OST encoding, edge generation for
+ * insert, and mincover generation for find. Each is run with and without
+ * min/max/precision. A final pass encodes a dataset of one million monetary
+ * values (two decimal places) with a range plan, as marking does for a field.
+ *
+ * Usage: benchmark-range-decimal128 [iterations]
+ */
+
+#include <mc-dec128.h>
+#include <mc-range-edge-generation-private.h>
+#include <mc-range-encoding-private.h>
+#include <mc-range-mincover-private.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
+
+#define NUM_VALUES 64
+#define NUM_MONEY_VALUES 1000000
+
+static void _fail(const char *what, mongocrypt_status_t *status) {
+    fprintf(stderr, "%s failed: %s\n", what, mongocrypt_status_message(status, NULL));
+    exit(1);
+}
+
+static void _report_count(const char *name, int64_t start_us, size_t count) {
+    const double elapsed = (double)(bson_get_monotonic_time() - start_us) / 1e6;
+    printf("%-32s %10.3f s %14.0f ops/s\n", name, elapsed, (double)count / elapsed);
+}
+
+static void _report(const char *name, int64_t start_us, size_t iterations) {
+    _report_count(name, start_us, NUM_VALUES * iterations);
+}
+
+static void _bench_money(mongocrypt_status_t *status) {
+    mc_dec128 *values = bson_malloc(NUM_MONEY_VALUES * sizeof(mc_dec128));
+    const mc_optional_dec128_t min = OPT_MC_DEC128(MC_DEC128_C(0));
+    const mc_optional_dec128_t max = OPT_MC_DEC128(MC_DEC128_C(1000000));
+    mc_RangePlanDecimal128_t plan;
+    int64_t start;
+
+    if (!mc_RangePlanDecimal128_init(&plan, min, max, OPT_U32(2), status)) {
+        _fail("mc_RangePlanDecimal128_init", status);
+    }
+
+    /* Prices in [0, 1000000) with two decimal places, in scrambled order. */
+    for (uint32_t i = 0; i < NUM_MONEY_VALUES; i++) {
+        char buf[32];
+        const uint32_t cents = (uint32_t)(((uint64_t)i * 2654435761u) % 100000000u);
+        snprintf(buf, sizeof buf, "%" PRIu32 ".%02" PRIu32, cents / 100u, cents % 100u);
+        values[i] = mc_dec128_from_string(buf);
+    }
+
+    printf("%d monetary values\n", NUM_MONEY_VALUES);
+
+    start = bson_get_monotonic_time();
+    for (size_t i = 0; i < NUM_MONEY_VALUES; i++) {
+        mc_OSTType_Decimal128 out;
+        if (!mc_getTypeInfoDecimal128WithPlan(values[i], &plan, &out, status)) {
+            _fail("mc_getTypeInfoDecimal128WithPlan", status);
+        }
+    }
+    _report_count("getTypeInfo (money, plan)", start, NUM_MONEY_VALUES);
+
+    start = bson_get_monotonic_time();
+    for (size_t i = 0; i < NUM_MONEY_VALUES; i++) {
+        mc_edges_t *edges =
+            mc_getEdgesDecimal128((mc_getEdgesDecimal128_args_t){.value = values[i], .sparsity = 2, .plan = &plan},
+                                  status);
+        if (!edges) {
+            _fail("mc_getEdgesDecimal128", status);
+        }
+        mc_edges_destroy(edges);
+    }
+    _report_count("getEdges (money, plan)", start, NUM_MONEY_VALUES);
+
+    bson_free(values);
+}
+
+int main(int argc, char **argv) {
+    const size_t iterations = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 200u;
+    mongocrypt_status_t *status = mongocrypt_status_new();
+    mc_dec128 values[NUM_VALUES];
+    const mc_optional_dec128_t min = OPT_MC_DEC128(mc_dec128_from_string("-1000000"));
+    const mc_optional_dec128_t max = OPT_MC_DEC128(mc_dec128_from_string("1000000"));
+    const mc_optional_uint32_t precision = OPT_U32_C(4);
+    int64_t start;
+
+    /* Spread the values across magnitudes and exponents, all within
+     * [min, max] so the same values work for both variants. */
+    for (size_t i = 0; i < NUM_VALUES; i++) {
+        char buf[64];
+        const int whole = (int)((i * 7919u) % 999983u) - 499991;
+        snprintf(buf, sizeof buf, "%d.%04u", whole, (unsigned)((i * 104729u) % 10000u));
+        values[i] = mc_dec128_from_string(buf);
+    }
+
+    printf("%d values, %zu iterations\n", NUM_VALUES, iterations);
+
+    start = bson_get_monotonic_time();
+    for (size_t it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < NUM_VALUES; i++) {
+            mc_OSTType_Decimal128 out;
+            if (!mc_getTypeInfoDecimal128((mc_getTypeInfoDecimal128_args_t){.value = values[i]}, &out, status)) {
+                _fail("mc_getTypeInfoDecimal128", status);
+            }
+        }
+    }
+    _report("getTypeInfo", start, iterations);
+
+    start = bson_get_monotonic_time();
+    for (size_t it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < NUM_VALUES; i++) {
+            mc_OSTType_Decimal128 out;
+            const mc_getTypeInfoDecimal128_args_t args = {.value = values[i],
+                                                          .min = min,
+                                                          .max = max,
+                                                          .precision = precision};
+            if (!mc_getTypeInfoDecimal128(args, &out, status)) {
+                _fail("mc_getTypeInfoDecimal128", status);
+            }
+        }
+    }
+    _report("getTypeInfo (precision)", start, iterations);
+
+    start = bson_get_monotonic_time();
+    for (size_t it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < NUM_VALUES; i++) {
+            mc_edges_t *edges = mc_getEdgesDecimal128((mc_getEdgesDecimal128_args_t){.value = values[i], .sparsity = 2},
+                                                      status);
+            if (!edges) {
+                _fail("mc_getEdgesDecimal128", status);
+            }
+            mc_edges_destroy(edges);
+        }
+    }
+    _report("getEdges", start, iterations);
+
+    start = bson_get_monotonic_time();
+    for (size_t it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < NUM_VALUES; i++) {
+            mc_edges_t *edges = mc_getEdgesDecimal128((mc_getEdgesDecimal128_args_t){.value = values[i],
+                                                                                     .sparsity = 2,
+                                                                                     .min = min,
+                                                                                     .max = max,
+                                                                                     .precision = precision},
+                                                      status);
+            if (!edges) {
+                _fail("mc_getEdgesDecimal128", status);
+            }
+            mc_edges_destroy(edges);
+        }
+    }
+    _report("getEdges (precision)", start, iterations);
+
+    start = bson_get_monotonic_time();
+    for (size_t it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < NUM_VALUES; i++) {
+            const mc_dec128 a = values[i], b = values[(i + 1) % NUM_VALUES];
+            const mc_dec128 lower = mc_dec128_less(a, b) ? a : b;
+            const mc_dec128 upper = mc_dec128_less(a, b) ? b : a;
+            mc_mincover_t *mc = mc_getMincoverDecimal128((mc_getMincoverDecimal128_args_t){.lowerBound = lower,
+                                                                                           .includeLowerBound = true,
+                                                                                           .upperBound = upper,
+                                                                                           .includeUpperBound = true,
+                                                                                           .sparsity = 2,
+                                                                                           .min = min,
+                                                                                           .max = max,
+                                                                                           .precision = precision},
+                                                         status);
+            if (!mc) {
+                _fail("mc_getMincoverDecimal128", status);
+            }
+            mc_mincover_destroy(mc);
+        }
+    }
+    _report("getMincover (precision)", start, iterations);
+
+    _bench_money(status);
+
+    mongocrypt_status_destroy(status);
+    return 0;
+}
+
+#else // MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
+
+int main(void) {
+    printf("Decimal128 range support is not enabled. Skipping.\n");
+    return 0;
+}
+
+#endif // MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "mc-fle-blob-subtype-private.h"
 #include "mc-fle2-insert-update-payload-private-v2.h"
 #include "test-mongocrypt.h"
 
@@ -73,20 +74,41 @@ static void _test_FLE2InsertUpdatePayloadV2_parse(_mongocrypt_tester_t *tester)
         mc_FLE2InsertUpdatePayloadV2_init(&iup);
         ASSERT_OK_STATUS(mc_FLE2InsertUpdatePayloadV2_parse(&iup, &input, status), status);
 
-        ASSERT_CMPBUF(expect_edcDerivedToken, iup.edcDerivedToken);
-        ASSERT_CMPBUF(expect_escDerivedToken, iup.escDerivedToken);
+        ASSERT_CMPBUF(expect_edcDerivedToken, mc_EDCDerivedFromDataTokenAndCounterValue_get(&iup.edcDerivedToken));
+        ASSERT_CMPBUF(expect_escDerivedToken, mc_ESCDerivedFromDataTokenAndCounterValue_get(&iup.escDerivedToken));
         ASSERT_CMPBUF(expect_encryptedTokens, iup.encryptedTokens);
         ASSERT_CMPBUF(expect_indexKeyId, iup.indexKeyId);
         ASSERT(expect_valueType == iup.valueType);
         ASSERT_CMPBUF(expect_value, iup.value);
-        ASSERT_CMPBUF(expect_serverEncryptionToken, iup.serverEncryptionToken);
-        ASSERT_CMPBUF(expect_serverDerivedFromDataToken, iup.serverDerivedFromDataToken);
+        ASSERT_CMPBUF(expect_serverEncryptionToken,
+                      mc_ServerDataEncryptionLevel1TokenValue_get(&iup.serverEncryptionToken));
+        ASSERT_CMPBUF(expect_serverDerivedFromDataToken,
+                      mc_ServerDerivedFromDataTokenValue_get(&iup.serverDerivedFromDataToken));
         ASSERT_CMPBUF(expect_userKeyId, iup.userKeyId);
         mc_FLE2InsertUpdatePayloadV2_cleanup(&iup);
         _mongocrypt_buffer_cleanup(&input);
         mongocrypt_status_destroy(status);
     }
 
+    /* Test a token with the wrong length. */
+    {
+        mongocrypt_status_t *status = mongocrypt_status_new();
+        const uint8_t short_token[MONGOCRYPT_HMAC_SHA256_LEN - 1] = {0};
+        bson_t doc = BSON_INITIALIZER;
+
+        ASSERT(BSON_APPEND_BINARY(&doc, "d", BSON_SUBTYPE_BINARY, short_token, sizeof(short_token)));
+        _mongocrypt_buffer_init_size(&input, 1u + doc.len);
+        input.data[0] = MC_SUBTYPE_FLE2InsertUpdatePayloadV2;
+        memcpy(input.data + 1, bson_get_data(&doc), doc.len);
+        mc_FLE2InsertUpdatePayloadV2_init(&iup);
+        ASSERT_FAILS_STATUS(mc_FLE2InsertUpdatePayloadV2_parse(&iup, &input, status),
+                            status,
+                            "Field 'd' expected to be 32 bytes, got: 31");
+        bson_destroy(&doc);
+        _mongocrypt_buffer_cleanup(&input);
+        mongocrypt_status_destroy(status);
+    }
+
     _mongocrypt_buffer_cleanup(&expect_edcDerivedToken);
     _mongocrypt_buffer_cleanup(&expect_escDerivedToken);
     _mongocrypt_buffer_cleanup(&expect_encryptedTokens);
@@ -164,9 +186,63 @@ static void _test_mc_FLE2InsertUpdatePayloadV2_decrypt(_mongocrypt_tester_t *tes
     mongocrypt_destroy(crypt);
 }
 
+// Compare the single-allocation serializers to appending to a bson_t.
+static void _test_FLE2InsertUpdatePayloadV2_serializeWithSubtype(_mongocrypt_tester_t *tester) {
+    mongocrypt_status_t *status = mongocrypt_status_new();
+    _mongocrypt_buffer_t input;
+    mc_FLE2InsertUpdatePayloadV2_t iup;
+
+    _mongocrypt_buffer_copy_from_hex(&input, TEST_IUP_HEX_V2);
+    mc_FLE2InsertUpdatePayloadV2_init(&iup);
+    ASSERT_OK_STATUS(mc_FLE2InsertUpdatePayloadV2_parse(&iup, &input, status), status);
+
+    /* Test without edges. The parsed fields are written back in the same order. */
+    {
+        _mongocrypt_buffer_t got;
+        ASSERT_OK_STATUS(mc_FLE2InsertUpdatePayloadV2_serializeWithSubtype(&iup, &got, status), status);
+        ASSERT_CMPUINT8(got.data[0], ==, MC_SUBTYPE_FLE2InsertUpdatePayloadV2);
+        ASSERT_CMPBYTES(input.data + 1, input.len - 1, got.data + 1, got.len - 1);
+
+        bson_t expect = BSON_INITIALIZER;
+        ASSERT(mc_FLE2InsertUpdatePayloadV2_serialize(&iup, &expect));
+        ASSERT_CMPBYTES(bson_get_data(&expect), expect.len, got.data + 1, got.len - 1);
+        bson_destroy(&expect);
+        _mongocrypt_buffer_cleanup(&got);
+    }
+
+    /* Test with edges. Use enough edges to need two-digit array keys. */
+    for (size_t i = 0; i < 12; i++) {
+        mc_EdgeTokenSetV2_t etc = {{{0}}};
+        etc.edcDerivedToken = iup.edcDerivedToken;
+        etc.escDerivedToken = iup.escDerivedToken;
+        etc.serverDerivedFromDataToken = iup.serverDerivedFromDataToken;
+        _mongocrypt_buffer_copy_to(&iup.encryptedTokens, &etc.encryptedTokens);
+        // Vary the sizes so each edge document is measured separately.
+        _mongocrypt_buffer_resize(&etc.encryptedTokens, (uint32_t)(etc.encryptedTokens.len - i));
+        _mc_array_append_val(&iup.edgeTokenSetArray, etc);
+    }
+
+    {
+        _mongocrypt_buffer_t got;
+        ASSERT_OK_STATUS(mc_FLE2InsertUpdatePayloadV2_serializeForRangeWithSubtype(&iup, &got, status), status);
+        ASSERT_CMPUINT8(got.data[0], ==, MC_SUBTYPE_FLE2InsertUpdatePayloadV2);
+
+        bson_t expect = BSON_INITIALIZER;
+        ASSERT(mc_FLE2InsertUpdatePayloadV2_serializeForRange(&iup, &expect));
+        ASSERT_CMPBYTES(bson_get_data(&expect), expect.len, got.data + 1, got.len - 1);
+        bson_destroy(&expect);
+        _mongocrypt_buffer_cleanup(&got);
+    }
+
+    mc_FLE2InsertUpdatePayloadV2_cleanup(&iup);
+    _mongocrypt_buffer_cleanup(&input);
+    mongocrypt_status_destroy(status);
+}
+
 #undef TEST_IUP_HEX_V2
 
 void _mongocrypt_tester_install_fle2_payload_iup_v2(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_FLE2InsertUpdatePayloadV2_parse);
     INSTALL_TEST(_test_mc_FLE2InsertUpdatePayloadV2_decrypt);
+    INSTALL_TEST(_test_FLE2InsertUpdatePayloadV2_serializeWithSubtype);
 }
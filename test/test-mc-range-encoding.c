@@ -441,6 +441,40 @@ static void _test_RangeTest_Encode_Double(_mongocrypt_tester_t *tester) {
     }
 }
 
+// A plan built once encodes every value the same as mc_getTypeInfoDouble.
+static void _test_RangeTest_Encode_Double_Plan(_mongocrypt_tester_t *tester) {
+    const double values[] = {-1000, -999.9999, -1.5, -0.0, 0, 0.0001, 3.14159, 999.999, 1000};
+    const mc_optional_double_t min = OPT_DOUBLE_C(-1000);
+    const mc_optional_double_t max = OPT_DOUBLE_C(1000);
+    mongocrypt_status_t *const status = mongocrypt_status_new();
+
+    for (uint32_t precision = 0; precision < 20; precision++) {
+        mc_RangePlanDouble_t plan;
+        ASSERT_OK_STATUS(mc_RangePlanDouble_init(&plan, min, max, OPT_U32(precision), status), status);
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            mc_OSTType_Double expect, got;
+            ASSERT_OK_STATUS(mc_getTypeInfoDouble((mc_getTypeInfoDouble_args_t){.value = values[i],
+                                                                                .min = min,
+                                                                                .max = max,
+                                                                                .precision = OPT_U32(precision)},
+                                                  &expect,
+                                                  status),
+                             status);
+            ASSERT_OK_STATUS(mc_getTypeInfoDoubleWithPlan(values[i], &plan, &got, status), status);
+            ASSERT_CMPUINT64(got.value, ==, expect.value);
+            ASSERT_CMPUINT64(got.min, ==, expect.min);
+            ASSERT_CMPUINT64(got.max, ==, expect.max);
+        }
+    }
+
+    // Errors in the range options are reported when building the plan.
+    mc_RangePlanDouble_t plan;
+    ASSERT_FAILS_STATUS(mc_RangePlanDouble_init(&plan, max, min, OPT_U32(1), status),
+                        status,
+                        "The minimum value must be less than the maximum value");
+    mongocrypt_status_destroy(status);
+}
+
 #if MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
 typedef struct {
     mc_dec128 value;
@@ -757,13 +791,90 @@ static void _test_RangeTest_Encode_Decimal128(_mongocrypt_tester_t *tester) {
     }
 }
 
+// A plan built once encodes every value the same as mc_getTypeInfoDecimal128.
+static void _test_RangeTest_Encode_Decimal128_Plan(_mongocrypt_tester_t *tester) {
+    const char *const values[] = {"-1000", "-999.9999", "-1.5", "-0", "0", "0.0001", "3.14159", "999.999", "1000"};
+    const mc_optional_dec128_t min = OPT_MC_DEC128(MC_DEC128_C(-1000));
+    const mc_optional_dec128_t max = OPT_MC_DEC128(MC_DEC128_C(1000));
+    mongocrypt_status_t *const status = mongocrypt_status_new();
+
+    for (uint32_t precision = 0; precision < 40; precision += 3) {
+        mc_RangePlanDecimal128_t plan;
+        ASSERT_OK_STATUS(mc_RangePlanDecimal128_init(&plan, min, max, OPT_U32(precision), status), status);
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            const mc_dec128 value = mc_dec128_from_string(values[i]);
+            mc_OSTType_Decimal128 expect, got;
+            ASSERT_OK_STATUS(
+                mc_getTypeInfoDecimal128((mc_getTypeInfoDecimal128_args_t){.value = value,
+                                                                           .min = min,
+                                                                           .max = max,
+                                                                           .precision = OPT_U32(precision)},
+                                         &expect,
+                                         status),
+                status);
+            ASSERT_OK_STATUS(mc_getTypeInfoDecimal128WithPlan(value, &plan, &got, status), status);
+            ASSERT_CMPINT128_EQ(got.value, expect.value);
+            ASSERT_CMPINT128_EQ(got.min, expect.min);
+            ASSERT_CMPINT128_EQ(got.max, expect.max);
+        }
+    }
+    mongocrypt_status_destroy(status);
+}
+
+// Values encoded with integer arithmetic match the DFP encoding, including
+// values with the same numeric value but different exponents.
+static void _test_RangeTest_Encode_Decimal128_Integral(_mongocrypt_tester_t *tester) {
+    const char *const mins[] = {"0", "-1000", "-1000.00", "-1E3", "-999.995", "0.5"};
+    const char *const values[] = {
+        // Equal values with different exponents
+        "12.50", "12.5", "1250E-2", "0.125E2", "1000", "1E3", "7E+2",
+        // Values that truncate to zero, and zeros
+        "-0.001", "-0", "0E-10", "1E-20", "-1E-20",
+        // Values at and beyond the bounds
+        "0.5", "0.50", "0.499", "999.99", "-999.995", "-1000", "-12.345", "1000.01", "-1000.01"};
+    const mc_optional_dec128_t max = OPT_MC_DEC128(MC_DEC128_C(1000));
+    mongocrypt_status_t *const status = mongocrypt_status_new();
+
+    for (size_t m = 0; m < sizeof(mins) / sizeof(mins[0]); m++) {
+        const mc_optional_dec128_t min = OPT_MC_DEC128(mc_dec128_from_string(mins[m]));
+        for (uint32_t precision = 0; precision < 6; precision++) {
+            mc_RangePlanDecimal128_t plan, dfp_plan;
+            ASSERT_OK_STATUS(mc_RangePlanDecimal128_init(&plan, min, max, OPT_U32(precision), status), status);
+            ASSERT(plan.bounds_decoded);
+            // The same plan, but without the precomputed integers, always
+            // takes the DFP path.
+            dfp_plan = plan;
+            dfp_plan.bounds_decoded = false;
+            dfp_plan.min_scaled_exact = false;
+            for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+                const mc_dec128 value = mc_dec128_from_string(values[i]);
+                mc_OSTType_Decimal128 expect, got;
+                const bool ok = mc_getTypeInfoDecimal128WithPlan(value, &dfp_plan, &expect, status);
+                if (!ok) {
+                    ASSERT_FAILS_STATUS(mc_getTypeInfoDecimal128WithPlan(value, &plan, &got, status),
+                                        status,
+                                        "Value must be greater than or equal to the minimum value");
+                    continue;
+                }
+                ASSERT_OK_STATUS(mc_getTypeInfoDecimal128WithPlan(value, &plan, &got, status), status);
+                ASSERT_CMPINT128_EQ(got.value, expect.value);
+                ASSERT_CMPINT128_EQ(got.min, expect.min);
+                ASSERT_CMPINT128_EQ(got.max, expect.max);
+            }
+        }
+    }
+    mongocrypt_status_destroy(status);
+}
 #endif // MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
 
 void _mongocrypt_tester_install_range_encoding(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_RangeTest_Encode_Int32);
     INSTALL_TEST(_test_RangeTest_Encode_Int64);
     INSTALL_TEST(_test_RangeTest_Encode_Double);
+    INSTALL_TEST(_test_RangeTest_Encode_Double_Plan);
 #if MONGOCRYPT_HAVE_DECIMAL128_SUPPORT
     INSTALL_TEST(_test_RangeTest_Encode_Decimal128);
+    INSTALL_TEST(_test_RangeTest_Encode_Decimal128_Plan);
+    INSTALL_TEST(_test_RangeTest_Encode_Decimal128_Integral);
 #endif
 }
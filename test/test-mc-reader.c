@@ -159,10 +159,66 @@ static void _test_mc_reader_bytes(_mongocrypt_tester_t *tester) {
     mongocrypt_status_destroy(status);
 }
 
+static void _test_mc_reader_borrow(_mongocrypt_tester_t *tester) {
+    _mongocrypt_buffer_t input_buf;
+    _mongocrypt_buffer_copy_from_hex(&input_buf,
+                                     "12345678901234567890123456789012"
+                                     "12345678123456781234567812345678"
+                                     "12345678123456781234567812345678"
+                                     "ABCD");
+
+    mongocrypt_status_t *status;
+    status = mongocrypt_status_new();
+
+    mc_reader_t reader;
+    mc_reader_init_from_buffer(&reader, &input_buf, __FUNCTION__);
+
+    // Borrowed buffers point into the input.
+    _mongocrypt_buffer_t uuid;
+    ASSERT_OK_STATUS(mc_reader_borrow_uuid_buffer(&reader, &uuid, status), status);
+    ASSERT(uuid.subtype == BSON_SUBTYPE_UUID);
+    ASSERT(!uuid.owned);
+    ASSERT(uuid.data == input_buf.data);
+    ASSERT_CMPUINT32(uuid.len, ==, 16);
+
+    _mongocrypt_buffer_t prfblock;
+    ASSERT_OK_STATUS(mc_reader_borrow_prfblock_buffer(&reader, &prfblock, status), status);
+    ASSERT(prfblock.subtype == BSON_SUBTYPE_ENCRYPTED);
+    ASSERT(!prfblock.owned);
+    ASSERT(prfblock.data == input_buf.data + 16);
+    ASSERT_CMPUINT32(prfblock.len, ==, 32);
+
+    _mongocrypt_buffer_t value;
+    ASSERT_OK_STATUS(mc_reader_borrow_buffer(&reader, &value, 1, status), status);
+    ASSERT(!value.owned);
+    ASSERT(value.data == input_buf.data + 48);
+    ASSERT_CMPUINT32(value.len, ==, 1);
+    ASSERT_CMPUINT(value.data[0], ==, 0xAB);
+
+    _mongocrypt_buffer_t rest;
+    ASSERT_OK_STATUS(mc_reader_borrow_buffer_to_end(&reader, &rest, status), status);
+    ASSERT(!rest.owned);
+    ASSERT(rest.data == input_buf.data + 49);
+    ASSERT_CMPUINT32(rest.len, ==, 1);
+    ASSERT_CMPUINT(rest.data[0], ==, 0xCD);
+
+    ASSERT_FAILS_STATUS(mc_reader_borrow_buffer(&reader, &value, 1, status),
+                        status,
+                        "expected byte length >= 51 got: 50");
+
+    _mongocrypt_buffer_cleanup(&rest);
+    _mongocrypt_buffer_cleanup(&value);
+    _mongocrypt_buffer_cleanup(&prfblock);
+    _mongocrypt_buffer_cleanup(&uuid);
+    _mongocrypt_buffer_cleanup(&input_buf);
+    mongocrypt_status_destroy(status);
+}
+
 void _mongocrypt_tester_install_mc_reader(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_mc_reader);
     INSTALL_TEST(_test_mc_reader_uuid);
     INSTALL_TEST(_test_mc_reader_prfblock);
     INSTALL_TEST(_test_mc_reader_ints);
     INSTALL_TEST(_test_mc_reader_bytes);
+    INSTALL_TEST(_test_mc_reader_borrow);
 }
@@ -248,8 +248,79 @@ static void _test_mc_tokens_raw_buffer(_mongocrypt_tester_t *tester) {
     mc_ServerDataEncryptionLevel1Token_destroy(token);
 }
 
+static void _test_mc_tokens_value(_mongocrypt_tester_t *tester) {
+    mongocrypt_status_t *status;
+    mongocrypt_t *crypt;
+    _mongocrypt_buffer_t RootKey;
+    _mongocrypt_buffer_t v;
+    _mongocrypt_buffer_t view;
+    const uint64_t u = 1234567890;
+
+    status = mongocrypt_status_new();
+    crypt = _mongocrypt_tester_mongocrypt(TESTER_MONGOCRYPT_DEFAULT);
+    _mongocrypt_buffer_copy_from_hex(&RootKey, "6eda88c8496ec990f5d5518dd2ad6f3d9c33b6055904b120f12de82911fbd933");
+    _mongocrypt_buffer_copy_from_hex(&v, "c07c0df51257948e1a0fc70dd4568e3af99b23b3434c9858237ca7db62db9766");
+
+    /* Heap tokens. */
+    mc_CollectionsLevel1Token_t *level1 = mc_CollectionsLevel1Token_new(crypt->crypto, &RootKey, status);
+    ASSERT_OK_STATUS(level1, status);
+    mc_EDCToken_t *edc = mc_EDCToken_new(crypt->crypto, level1, status);
+    ASSERT_OK_STATUS(edc, status);
+    mc_EDCDerivedFromDataToken_t *edcData = mc_EDCDerivedFromDataToken_new(crypt->crypto, edc, &v, status);
+    ASSERT_OK_STATUS(edcData, status);
+    mc_EDCDerivedFromDataTokenAndCounter_t *edcDataCounter =
+        mc_EDCDerivedFromDataTokenAndCounter_new(crypt->crypto, edcData, u, status);
+    ASSERT_OK_STATUS(edcDataCounter, status);
+
+    /* Value tokens derive the same bytes. */
+    mc_CollectionsLevel1TokenValue_t level1Value;
+    ASSERT_OK_STATUS(mc_CollectionsLevel1TokenValue_init(&level1Value, crypt->crypto, &RootKey, status), status);
+    view = mc_CollectionsLevel1TokenValue_get(&level1Value);
+    ASSERT_CMPBUF(*mc_CollectionsLevel1Token_get(level1), view);
+
+    mc_EDCTokenValue_t edcValue;
+    ASSERT_OK_STATUS(mc_EDCTokenValue_init(&edcValue, crypt->crypto, &level1Value, status), status);
+    view = mc_EDCTokenValue_get(&edcValue);
+    ASSERT_CMPBUF(*mc_EDCToken_get(edc), view);
+
+    mc_EDCDerivedFromDataTokenValue_t edcDataValue;
+    ASSERT_OK_STATUS(mc_EDCDerivedFromDataTokenValue_init(&edcDataValue, crypt->crypto, &edcValue, &v, status),
+                     status);
+    view = mc_EDCDerivedFromDataTokenValue_get(&edcDataValue);
+    ASSERT_CMPBUF(*mc_EDCDerivedFromDataToken_get(edcData), view);
+
+    mc_EDCDerivedFromDataTokenAndCounterValue_t edcDataCounterValue;
+    ASSERT_OK_STATUS(mc_EDCDerivedFromDataTokenAndCounterValue_init(&edcDataCounterValue,
+                                                                    crypt->crypto,
+                                                                    &edcDataValue,
+                                                                    u,
+                                                                    status),
+                     status);
+    view = mc_EDCDerivedFromDataTokenAndCounterValue_get(&edcDataCounterValue);
+    ASSERT_CMPBUF(*mc_EDCDerivedFromDataTokenAndCounter_get(edcDataCounter), view);
+
+    /* Cleanup zeroes the value. */
+    mc_EDCDerivedFromDataTokenAndCounterValue_cleanup(&edcDataCounterValue);
+    for (size_t i = 0; i < MONGOCRYPT_HMAC_SHA256_LEN; i++) {
+        ASSERT(edcDataCounterValue.data[i] == 0);
+    }
+
+    mc_EDCDerivedFromDataTokenValue_cleanup(&edcDataValue);
+    mc_EDCTokenValue_cleanup(&edcValue);
+    mc_CollectionsLevel1TokenValue_cleanup(&level1Value);
+    mc_EDCDerivedFromDataTokenAndCounter_destroy(edcDataCounter);
+    mc_EDCDerivedFromDataToken_destroy(edcData);
+    mc_EDCToken_destroy(edc);
+    mc_CollectionsLevel1Token_destroy(level1);
+    _mongocrypt_buffer_cleanup(&v);
+    _mongocrypt_buffer_cleanup(&RootKey);
+    mongocrypt_destroy(crypt);
+    mongocrypt_status_destroy(status);
+}
+
 void _mongocrypt_tester_install_mc_tokens(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_mc_tokens);
     INSTALL_TEST(_test_mc_tokens_error);
     INSTALL_TEST(_test_mc_tokens_raw_buffer);
+    INSTALL_TEST(_test_mc_tokens_value);
 }
@@ -50,6 +50,208 @@ static void _test_cache_oauth_expiration(_mongocrypt_tester_t *tester) {
     mongocrypt_status_destroy(status);
 }
 
+static void _test_cache_oauth_claim(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_oauth_t *cache;
+    char *token;
+    bool claimed;
+    mongocrypt_status_t *status;
+
+    cache = _mongocrypt_cache_oauth_new();
+    status = mongocrypt_status_new();
+
+    /* The first miss claims the fetch. */
+    token = _mongocrypt_cache_oauth_get_or_claim(cache, &claimed);
+    BSON_ASSERT(!token);
+    BSON_ASSERT(claimed);
+
+    /* A miss on the claimant's thread cannot wait for the claim. It fetches
+     * without holding the claim. */
+    token = _mongocrypt_cache_oauth_get_or_claim(cache, &claimed);
+    BSON_ASSERT(!token);
+    BSON_ASSERT(!claimed);
+
+    /* A token added without the claim does not release the claim. */
+    ASSERT_OR_PRINT(_mongocrypt_cache_oauth_add(cache, TMP_BSON("{'expires_in': 0, 'access_token': 'foo'}"), status),
+                    status);
+    BSON_ASSERT(cache->fetch_in_flight);
+
+    /* Releasing lets the next miss claim. */
+    _mongocrypt_cache_oauth_release(cache);
+    token = _mongocrypt_cache_oauth_get_or_claim(cache, &claimed);
+    BSON_ASSERT(!token);
+    BSON_ASSERT(claimed);
+
+    /* Adding a token leaves the claim to the claimant. Refresh is disabled by
+     * default. */
+    ASSERT_OR_PRINT(_mongocrypt_cache_oauth_add(cache, TMP_BSON("{'expires_in': 1000, 'access_token': 'foo'}"), status),
+                    status);
+    BSON_ASSERT(cache->fetch_in_flight);
+    _mongocrypt_cache_oauth_release(cache);
+    BSON_ASSERT(!cache->fetch_in_flight);
+    token = _mongocrypt_cache_oauth_get_or_claim(cache, &claimed);
+    ASSERT_STREQUAL(token, "foo");
+    BSON_ASSERT(!claimed);
+    bson_free(token);
+
+    _mongocrypt_cache_oauth_destroy(cache);
+    mongocrypt_status_destroy(status);
+}
+
+#if defined(BSON_OS_UNIX)
+typedef struct {
+    _mongocrypt_cache_oauth_t *cache;
+    char *token;
+    bool claimed;
+} _oauth_waiter_t;
+
+static void *_oauth_waiter(void *arg) {
+    _oauth_waiter_t *waiter = arg;
+
+    waiter->token = _mongocrypt_cache_oauth_get_or_claim(waiter->cache, &waiter->claimed);
+    return NULL;
+}
+
+static void _test_cache_oauth_claim_wait(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_oauth_t *cache;
+    _oauth_waiter_t waiter = {0};
+    pthread_t thread;
+    char *token;
+    bool claimed;
+    mongocrypt_status_t *status;
+
+    cache = _mongocrypt_cache_oauth_new();
+    status = mongocrypt_status_new();
+
+    token = _mongocrypt_cache_oauth_get_or_claim(cache, &claimed);
+    BSON_ASSERT(!token);
+    BSON_ASSERT(claimed);
+
+    /* A miss on another thread waits for the claimant's token instead of
+     * fetching its own. */
+    waiter.cache = cache;
+    BSON_ASSERT(0 == pthread_create(&thread, NULL, _oauth_waiter, &waiter));
+    usleep(50 * 1000);
+    ASSERT_OR_PRINT(_mongocrypt_cache_oauth_add(cache, TMP_BSON("{'expires_in': 1000, 'access_token': 'foo'}"), status),
+                    status);
+    _mongocrypt_cache_oauth_release(cache);
+    BSON_ASSERT(0 == pthread_join(thread, NULL));
+
+    ASSERT_STREQUAL(waiter.token, "foo");
+    BSON_ASSERT(!waiter.claimed);
+    bson_free(waiter.token);
+
+    _mongocrypt_cache_oauth_destroy(cache);
+    mongocrypt_status_destroy(status);
+}
+#endif /* BSON_OS_UNIX */
+
+static void _test_cache_oauth_refresh(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_oauth_t *cache;
+    char *token;
+    bool claimed;
+    mongocrypt_status_t *status;
+
+    cache = _mongocrypt_cache_oauth_new();
+    /* Small enough that the token is due for refresh as soon as it is added. */
+    cache->refresh_fraction = 1e-9;
+    status = mongocrypt_status_new();
+
+    ASSERT_OR_PRINT(_mongocrypt_cache_oauth_add(cache, TMP_BSON("{'expires_in': 1000, 'access_token': 'foo'}"), status),
+                    status);
+    BSON_ASSERT(cache->refresh_time_us < cache->expiration_time_us);
+
+    /* One caller claims the refresh. */
+    token = _mongocrypt_cache_oauth_get_or_claim(cache, &claimed);
+    BSON_ASSERT(!token);
+    BSON_ASSERT(claimed);
+
+    /* Others keep using the cached token. */
+    token = _mongocrypt_cache_oauth_get_or_claim(cache, &claimed);
+    ASSERT_STREQUAL(token, "foo");
+    BSON_ASSERT(!claimed);
+    bson_free(token);
+
+    token = _mongocrypt_cache_oauth_get(cache);
+    ASSERT_STREQUAL(token, "foo");
+    bson_free(token);
+
+    /* The refreshed token replaces the old one. */
+    ASSERT_OR_PRINT(_mongocrypt_cache_oauth_add(cache, TMP_BSON("{'expires_in': 2000, 'access_token': 'bar'}"), status),
+                    status);
+    token = _mongocrypt_cache_oauth_get(cache);
+    ASSERT_STREQUAL(token, "bar");
+    bson_free(token);
+
+    _mongocrypt_cache_oauth_destroy(cache);
+    mongocrypt_status_destroy(status);
+}
+
+static void _test_cache_oauth_assertion(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_oauth_t *cache;
+    uint8_t hash_a[32], hash_b[32];
+    uint8_t signature[256], got[256];
+    uint64_t issued_at = 0;
+
+    memset(hash_a, 'a', sizeof(hash_a));
+    memset(hash_b, 'b', sizeof(hash_b));
+    memset(signature, 's', sizeof(signature));
+
+    cache = _mongocrypt_cache_oauth_new();
+    BSON_ASSERT(!_mongocrypt_cache_oauth_get_assertion(cache, hash_a, &issued_at, got));
+
+    _mongocrypt_cache_oauth_add_assertion(cache, hash_a, 123, signature);
+    BSON_ASSERT(_mongocrypt_cache_oauth_get_assertion(cache, hash_a, &issued_at, got));
+    ASSERT_CMPUINT64(issued_at, ==, 123);
+    BSON_ASSERT(0 == memcmp(got, signature, sizeof(signature)));
+    /* An assertion for other claims is not returned. */
+    BSON_ASSERT(!_mongocrypt_cache_oauth_get_assertion(cache, hash_b, &issued_at, got));
+
+    /* A new assertion replaces the old one. */
+    _mongocrypt_cache_oauth_add_assertion(cache, hash_b, 456, signature);
+    BSON_ASSERT(!_mongocrypt_cache_oauth_get_assertion(cache, hash_a, &issued_at, got));
+    BSON_ASSERT(_mongocrypt_cache_oauth_get_assertion(cache, hash_b, &issued_at, got));
+    ASSERT_CMPUINT64(issued_at, ==, 456);
+
+    _mongocrypt_cache_oauth_destroy(cache);
+}
+
+static void _test_setopt_oauth_refresh_fraction(_mongocrypt_tester_t *tester) {
+    mongocrypt_t *crypt;
+
+    crypt = mongocrypt_new();
+    ASSERT_FAILS(mongocrypt_setopt_oauth_refresh_fraction(crypt, 1.0), crypt, "must be in the range [0, 1)");
+    mongocrypt_destroy(crypt);
+
+    crypt = mongocrypt_new();
+    ASSERT_FAILS(mongocrypt_setopt_oauth_refresh_fraction(crypt, -0.5), crypt, "must be in the range [0, 1)");
+    mongocrypt_destroy(crypt);
+
+    crypt = mongocrypt_new();
+    ASSERT_OK(mongocrypt_setopt_oauth_refresh_fraction(crypt, 0.75), crypt);
+    mongocrypt_setopt_use_need_kms_credentials_state(crypt);
+    ASSERT_OK(mongocrypt_setopt_kms_providers(crypt, TEST_BSON("{'gcp': {}}")), crypt);
+    ASSERT_OK(mongocrypt_init(crypt), crypt);
+    BSON_ASSERT(crypt->cache_oauth_azure->refresh_fraction == 0.75);
+    BSON_ASSERT(crypt->cache_oauth_gcp->refresh_fraction == 0.75);
+    mongocrypt_destroy(crypt);
+
+    crypt = mongocrypt_new();
+    mongocrypt_setopt_use_need_kms_credentials_state(crypt);
+    ASSERT_OK(mongocrypt_setopt_kms_providers(crypt, TEST_BSON("{'gcp': {}}")), crypt);
+    ASSERT_OK(mongocrypt_init(crypt), crypt);
+    /* Disabled by default. */
+    BSON_ASSERT(crypt->cache_oauth_gcp->refresh_fraction == 0);
+    ASSERT_FAILS(mongocrypt_setopt_oauth_refresh_fraction(crypt, 0.5), crypt, "cannot be set after initialization");
+    mongocrypt_destroy(crypt);
+}
+
 void _mongocrypt_tester_install_cache_oauth(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_cache_oauth_expiration);
+    INSTALL_TEST(_test_cache_oauth_claim);
+#if defined(BSON_OS_UNIX)
+    INSTALL_TEST(_test_cache_oauth_claim_wait);
+#endif
+    INSTALL_TEST(_test_cache_oauth_refresh);
+    INSTALL_TEST(_test_cache_oauth_assertion);
+    INSTALL_TEST(_test_setopt_oauth_refresh_fraction);
 }
\ No newline at end of file
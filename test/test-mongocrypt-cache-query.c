@@ -0,0 +1,199 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mongocrypt-cache-query-private.h"
+#include "test-mongocrypt.h"
+
+/* Make an attribute and a payload distinguished by @value. The payload's
+ * key_id is filled with @key. */
+static void
+_make_entry_with_key(uint8_t value, uint8_t key, _mongocrypt_buffer_t *attr, _mongocrypt_ciphertext_t *ciphertext) {
+    _mongocrypt_buffer_init(attr);
+    _mongocrypt_buffer_resize(attr, 4);
+    memset(attr->data, value, attr->len);
+
+    _mongocrypt_ciphertext_init(ciphertext);
+    _mongocrypt_buffer_resize(&ciphertext->key_id, UUID_LEN);
+    memset(ciphertext->key_id.data, key, ciphertext->key_id.len);
+    _mongocrypt_buffer_resize(&ciphertext->data, 8);
+    memset(ciphertext->data.data, value, ciphertext->data.len);
+    ciphertext->blob_subtype = MC_SUBTYPE_FLE2FindEqualityPayloadV2;
+}
+
+static void _make_entry(uint8_t value, _mongocrypt_buffer_t *attr, _mongocrypt_ciphertext_t *ciphertext) {
+    _make_entry_with_key(value, 0, attr, ciphertext);
+}
+
+static void _test_cache_query_get_add(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_query_t *cache;
+    _mongocrypt_buffer_t attr;
+    _mongocrypt_ciphertext_t ciphertext, got;
+    uint64_t hits, misses;
+
+    cache = _mongocrypt_cache_query_new();
+    _mongocrypt_cache_query_set_capacity(cache, 4);
+    _make_entry(1, &attr, &ciphertext);
+
+    _mongocrypt_ciphertext_init(&got);
+    ASSERT(!_mongocrypt_cache_query_get(cache, &attr, CACHE_EXPIRATION_MS, &got));
+
+    _mongocrypt_cache_query_add(cache, &attr, &ciphertext.key_id, &ciphertext);
+    ASSERT(_mongocrypt_cache_query_get(cache, &attr, CACHE_EXPIRATION_MS, &got));
+    ASSERT_CMPBUF(got.data, ciphertext.data);
+    ASSERT(got.blob_subtype == MC_SUBTYPE_FLE2FindEqualityPayloadV2);
+
+    /* Adding the same attribute again replaces the entry. */
+    _mongocrypt_cache_query_add(cache, &attr, &ciphertext.key_id, &ciphertext);
+    ASSERT_CMPUINT32(_mongocrypt_cache_query_num_entries(cache), ==, 1);
+
+    _mongocrypt_cache_query_stats(cache, &hits, &misses);
+    ASSERT_CMPUINT64(hits, ==, 1);
+    ASSERT_CMPUINT64(misses, ==, 1);
+
+    _mongocrypt_ciphertext_cleanup(&got);
+    _mongocrypt_ciphertext_cleanup(&ciphertext);
+    _mongocrypt_buffer_cleanup(&attr);
+    _mongocrypt_cache_query_destroy(cache);
+}
+
+static void _test_cache_query_eviction(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_query_t *cache;
+    _mongocrypt_buffer_t attr;
+    _mongocrypt_ciphertext_t ciphertext, got;
+
+    cache = _mongocrypt_cache_query_new();
+    _mongocrypt_cache_query_set_capacity(cache, 2);
+
+    for (uint8_t i = 0; i < 2; i++) {
+        _make_entry(i, &attr, &ciphertext);
+        _mongocrypt_cache_query_add(cache, &attr, &ciphertext.key_id, &ciphertext);
+        _mongocrypt_ciphertext_cleanup(&ciphertext);
+        _mongocrypt_buffer_cleanup(&attr);
+    }
+
+    /* Use entry 0 so entry 1 becomes the least recently used. */
+    _make_entry(0, &attr, &ciphertext);
+    _mongocrypt_ciphertext_init(&got);
+    ASSERT(_mongocrypt_cache_query_get(cache, &attr, CACHE_EXPIRATION_MS, &got));
+    _mongocrypt_ciphertext_cleanup(&got);
+    _mongocrypt_ciphertext_cleanup(&ciphertext);
+    _mongocrypt_buffer_cleanup(&attr);
+
+    _make_entry(2, &attr, &ciphertext);
+    _mongocrypt_cache_query_add(cache, &attr, &ciphertext.key_id, &ciphertext);
+    _mongocrypt_ciphertext_cleanup(&ciphertext);
+    _mongocrypt_buffer_cleanup(&attr);
+    ASSERT_CMPUINT32(_mongocrypt_cache_query_num_entries(cache), ==, 2);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        _make_entry(i, &attr, &ciphertext);
+        _mongocrypt_ciphertext_init(&got);
+        ASSERT(_mongocrypt_cache_query_get(cache, &attr, CACHE_EXPIRATION_MS, &got) == (i != 1));
+        _mongocrypt_ciphertext_cleanup(&got);
+        _mongocrypt_ciphertext_cleanup(&ciphertext);
+        _mongocrypt_buffer_cleanup(&attr);
+    }
+
+    _mongocrypt_cache_query_destroy(cache);
+}
+
+static void _test_cache_query_expiration(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_query_t *cache;
+    _mongocrypt_buffer_t attr;
+    _mongocrypt_ciphertext_t ciphertext, got;
+    int64_t start;
+
+    cache = _mongocrypt_cache_query_new();
+    _mongocrypt_cache_query_set_capacity(cache, 4);
+    _make_entry(1, &attr, &ciphertext);
+    _mongocrypt_cache_query_add(cache, &attr, &ciphertext.key_id, &ciphertext);
+
+    /* Wait until the entry is older than a 1ms expiration. */
+    start = bson_get_monotonic_time();
+    while (bson_get_monotonic_time() - start < 3 * 1000) {
+    }
+
+    _mongocrypt_ciphertext_init(&got);
+    ASSERT(!_mongocrypt_cache_query_get(cache, &attr, 1, &got));
+    ASSERT_CMPUINT32(_mongocrypt_cache_query_num_entries(cache), ==, 0);
+
+    _mongocrypt_ciphertext_cleanup(&got);
+    _mongocrypt_ciphertext_cleanup(&ciphertext);
+    _mongocrypt_buffer_cleanup(&attr);
+    _mongocrypt_cache_query_destroy(cache);
+}
+
+static void _test_cache_query_disabled(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_query_t *cache;
+    _mongocrypt_buffer_t attr;
+    _mongocrypt_ciphertext_t ciphertext, got;
+
+    /* The cache is disabled until a capacity is set. */
+    cache = _mongocrypt_cache_query_new();
+    _make_entry(1, &attr, &ciphertext);
+    _mongocrypt_cache_query_add(cache, &attr, &ciphertext.key_id, &ciphertext);
+
+    _mongocrypt_ciphertext_init(&got);
+    ASSERT(!_mongocrypt_cache_query_get(cache, &attr, CACHE_EXPIRATION_MS, &got));
+    ASSERT_CMPUINT32(_mongocrypt_cache_query_num_entries(cache), ==, 0);
+
+    _mongocrypt_ciphertext_cleanup(&got);
+    _mongocrypt_ciphertext_cleanup(&ciphertext);
+    _mongocrypt_buffer_cleanup(&attr);
+    _mongocrypt_cache_query_destroy(cache);
+}
+
+static void _test_cache_query_remove_key(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_query_t *cache;
+    _mongocrypt_buffer_t attr;
+    _mongocrypt_ciphertext_t ciphertext, got;
+
+    cache = _mongocrypt_cache_query_new();
+    _mongocrypt_cache_query_set_capacity(cache, 4);
+
+    /* Entries 0 and 2 are derived from key 1. Entry 1 from key 2. */
+    for (uint8_t i = 0; i < 3; i++) {
+        _make_entry_with_key(i, i == 1 ? 2 : 1, &attr, &ciphertext);
+        _mongocrypt_cache_query_add(cache, &attr, &ciphertext.key_id, &ciphertext);
+        _mongocrypt_ciphertext_cleanup(&ciphertext);
+        _mongocrypt_buffer_cleanup(&attr);
+    }
+
+    _make_entry_with_key(0, 1, &attr, &ciphertext);
+    _mongocrypt_cache_query_remove_key(cache, &ciphertext.key_id);
+    _mongocrypt_ciphertext_cleanup(&ciphertext);
+    _mongocrypt_buffer_cleanup(&attr);
+    ASSERT_CMPUINT32(_mongocrypt_cache_query_num_entries(cache), ==, 1);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        _make_entry(i, &attr, &ciphertext);
+        _mongocrypt_ciphertext_init(&got);
+        ASSERT(_mongocrypt_cache_query_get(cache, &attr, CACHE_EXPIRATION_MS, &got) == (i == 1));
+        _mongocrypt_ciphertext_cleanup(&got);
+        _mongocrypt_ciphertext_cleanup(&ciphertext);
+        _mongocrypt_buffer_cleanup(&attr);
+    }
+
+    _mongocrypt_cache_query_destroy(cache);
+}
+
+void _mongocrypt_tester_install_cache_query(_mongocrypt_tester_t *tester) {
+    INSTALL_TEST(_test_cache_query_get_add);
+    INSTALL_TEST(_test_cache_query_eviction);
+    INSTALL_TEST(_test_cache_query_expiration);
+    INSTALL_TEST(_test_cache_query_disabled);
+    INSTALL_TEST(_test_cache_query_remove_key);
+}
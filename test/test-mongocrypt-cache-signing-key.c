@@ -0,0 +1,84 @@
+/*
+ * Copyright 2023-present MongoDB, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "mongocrypt-cache-signing-key-private.h"
+#include "test-mongocrypt.h"
+
+static void _fill(uint8_t *buf, uint8_t value) {
+    memset(buf, value, MONGOCRYPT_SIGNING_KEY_LEN);
+}
+
+static void _test_cache_signing_key_get_add(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_signing_key_t *cache;
+    uint8_t scope_hash[MONGOCRYPT_SIGNING_KEY_LEN];
+    uint8_t key[MONGOCRYPT_SIGNING_KEY_LEN];
+    uint8_t got[MONGOCRYPT_SIGNING_KEY_LEN];
+
+    cache = _mongocrypt_cache_signing_key_new();
+    _fill(scope_hash, 1);
+    ASSERT(!_mongocrypt_cache_signing_key_get(cache, scope_hash, got));
+
+    _fill(key, 0xAA);
+    _mongocrypt_cache_signing_key_add(cache, scope_hash, key);
+    ASSERT(_mongocrypt_cache_signing_key_get(cache, scope_hash, got));
+    ASSERT_CMPBYTES(key, sizeof(key), got, sizeof(got));
+
+    /* Adding the same scope again replaces the entry. */
+    _fill(key, 0xBB);
+    _mongocrypt_cache_signing_key_add(cache, scope_hash, key);
+    ASSERT(_mongocrypt_cache_signing_key_get(cache, scope_hash, got));
+    ASSERT_CMPBYTES(key, sizeof(key), got, sizeof(got));
+
+    _mongocrypt_cache_signing_key_destroy(cache);
+}
+
+static void _test_cache_signing_key_eviction(_mongocrypt_tester_t *tester) {
+    _mongocrypt_cache_signing_key_t *cache;
+    uint8_t scope_hash[MONGOCRYPT_SIGNING_KEY_LEN];
+    uint8_t key[MONGOCRYPT_SIGNING_KEY_LEN];
+    uint8_t got[MONGOCRYPT_SIGNING_KEY_LEN];
+
+    cache = _mongocrypt_cache_signing_key_new();
+    for (uint8_t i = 0; i < MONGOCRYPT_SIGNING_KEY_CACHE_SIZE; i++) {
+        _fill(scope_hash, i);
+        _fill(key, i);
+        _mongocrypt_cache_signing_key_add(cache, scope_hash, key);
+    }
+
+    /* Use entry 0 so entry 1 becomes the least recently used. */
+    _fill(scope_hash, 0);
+    ASSERT(_mongocrypt_cache_signing_key_get(cache, scope_hash, got));
+
+    _fill(scope_hash, MONGOCRYPT_SIGNING_KEY_CACHE_SIZE);
+    _fill(key, MONGOCRYPT_SIGNING_KEY_CACHE_SIZE);
+    _mongocrypt_cache_signing_key_add(cache, scope_hash, key);
+
+    _fill(scope_hash, 1);
+    ASSERT(!_mongocrypt_cache_signing_key_get(cache, scope_hash, got));
+    _fill(scope_hash, 0);
+    ASSERT(_mongocrypt_cache_signing_key_get(cache, scope_hash, got));
+    _fill(scope_hash, MONGOCRYPT_SIGNING_KEY_CACHE_SIZE);
+    ASSERT(_mongocrypt_cache_signing_key_get(cache, scope_hash, got));
+    ASSERT_CMPBYTES(key, sizeof(key), got, sizeof(got));
+
+    _mongocrypt_cache_signing_key_destroy(cache);
+}
+
+void _mongocrypt_tester_install_cache_signing_key(_mongocrypt_tester_t *tester) {
+    INSTALL_TEST(_test_cache_signing_key_get_add);
+    INSTALL_TEST(_test_cache_signing_key_eviction);
+}
@@ -554,6 +554,14 @@ static void _test_crypto_hooks_unset(_mongocrypt_tester_t *tester) {
     mongocrypt_destroy(crypt);
 }
 
+static void _test_is_crypto_available(_mongocrypt_tester_t *tester) {
+#ifdef MONGOCRYPT_ENABLE_CRYPTO
+    ASSERT(mongocrypt_is_crypto_available());
+#else
+    ASSERT(!mongocrypt_is_crypto_available());
+#endif
+}
+
 /* test a bug fix, that an error on explicit encryption in the crypto hooks sets
  * the context state */
 static void _test_crypto_hooks_explicit_err(_mongocrypt_tester_t *tester) {
@@ -764,6 +772,7 @@ void _mongocrypt_tester_install_crypto_hooks(_mongocrypt_tester_t *tester) {
     INSTALL_TEST_CRYPTO(_test_crypto_hooks_random, CRYPTO_OPTIONAL);
     INSTALL_TEST_CRYPTO(_test_kms_request, CRYPTO_OPTIONAL);
     INSTALL_TEST_CRYPTO(_test_crypto_hooks_unset, CRYPTO_PROHIBITED);
+    INSTALL_TEST(_test_is_crypto_available);
     INSTALL_TEST_CRYPTO(_test_crypto_hooks_explicit_err, CRYPTO_OPTIONAL);
     INSTALL_TEST_CRYPTO(_test_crypto_hooks_explicit_sha256_err, CRYPTO_OPTIONAL);
     INSTALL_TEST_CRYPTO(_test_crypto_hook_sign_rsaes_pkcs1_v1_5, CRYPTO_OPTIONAL);
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <mc-sha256-private.h>
 #include <mongocrypt-crypto-private.h>
 #include <mongocrypt.h>
 
@@ -353,6 +354,211 @@ void _test_native_crypto_hmac_sha_256(_mongocrypt_tester_t *tester) {
     mongocrypt_destroy(crypt);
 }
 
+typedef struct {
+    const char *testname;
+    bool ctr;
+    const char *iv;
+    const char *plaintext;
+    const char *ciphertext;
+} aes_256_test_t;
+
+static void _test_native_crypto_aes_256(_mongocrypt_tester_t *tester) {
+    /* Test vectors F.2.5, F.2.6, F.5.5, and F.5.6 from NIST SP 800-38A. */
+#define SP800_38A_KEY "603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4"
+#define SP800_38A_PLAINTEXT                                                                                            \
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"                                                 \
+    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710"
+    aes_256_test_t tests[] = {{.testname = "CBC-AES256",
+                               .ctr = false,
+                               .iv = "000102030405060708090a0b0c0d0e0f",
+                               .plaintext = SP800_38A_PLAINTEXT,
+                               .ciphertext = "f58c4c04d6e5f1ba779eabfb5f7bfbd69cfc4e967edb808d679f777bc6702c7d"
+                                             "39f23369a9d9bacfa530e26304231461b2eb05e2c39be9fcda6c19078c6a9d1b"},
+                              {.testname = "CTR-AES256",
+                               .ctr = true,
+                               .iv = "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff",
+                               .plaintext = SP800_38A_PLAINTEXT,
+                               .ciphertext = "601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c5"
+                                             "2b0930daa23de94ce87017ba2d84988ddfc9c58db67aada613c2dd08457941a6"},
+                              {.testname = "CTR-AES256 with a partial block",
+                               .ctr = true,
+                               .iv = "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff",
+                               .plaintext = "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e5130c8",
+                               .ciphertext = "601ec313775789a5b7a7f504bbf3d228f443e3ca4d62b59aca84e990cacaf5c52b09"},
+                              {0}};
+#undef SP800_38A_PLAINTEXT
+    aes_256_test_t *test;
+
+    /* Create a mongocrypt_t to call _native_crypto_init(). */
+    mongocrypt_t *crypt = mongocrypt_new();
+
+    for (test = tests; test->testname != NULL; test++) {
+        _mongocrypt_buffer_t key, iv, plaintext, ciphertext, got;
+        uint32_t bytes_written = 0;
+        mongocrypt_status_t *status = mongocrypt_status_new();
+
+        if (test->ctr && !_aes_ctr_is_supported_by_os) {
+            printf("Common Crypto with no CTR support detected. Skipping %s\n", test->testname);
+            mongocrypt_status_destroy(status);
+            continue;
+        }
+        printf("Begin test '%s'.\n", test->testname);
+
+        _mongocrypt_buffer_copy_from_hex(&key, SP800_38A_KEY);
+        _mongocrypt_buffer_copy_from_hex(&iv, test->iv);
+        _mongocrypt_buffer_copy_from_hex(&plaintext, test->plaintext);
+        _mongocrypt_buffer_copy_from_hex(&ciphertext, test->ciphertext);
+        _mongocrypt_buffer_init_size(&got, plaintext.len);
+
+        aes_256_args_t args = {.key = &key,
+                               .iv = &iv,
+                               .in = &plaintext,
+                               .out = &got,
+                               .bytes_written = &bytes_written,
+                               .status = status};
+        ASSERT_OR_PRINT(test->ctr ? _native_crypto_aes_256_ctr_encrypt(args)
+                                  : _native_crypto_aes_256_cbc_encrypt(args),
+                        status);
+        ASSERT_CMPBYTES(ciphertext.data, ciphertext.len, got.data, bytes_written);
+
+        args.in = &ciphertext;
+        ASSERT_OR_PRINT(test->ctr ? _native_crypto_aes_256_ctr_decrypt(args)
+                                  : _native_crypto_aes_256_cbc_decrypt(args),
+                        status);
+        ASSERT_CMPBYTES(plaintext.data, plaintext.len, got.data, bytes_written);
+
+        _mongocrypt_buffer_cleanup(&got);
+        _mongocrypt_buffer_cleanup(&ciphertext);
+        _mongocrypt_buffer_cleanup(&plaintext);
+        _mongocrypt_buffer_cleanup(&iv);
+        _mongocrypt_buffer_cleanup(&key);
+        mongocrypt_status_destroy(status);
+        printf("End test '%s'.\n", test->testname);
+    }
+#undef SP800_38A_KEY
+
+    mongocrypt_destroy(crypt);
+}
+
+static void _test_mc_hmac_sha256_many(_mongocrypt_tester_t *tester) {
+    hmac_sha_256_test_t tests[] = {
+#include "./data/NIST-CAVP.cstructs"
+        {0}};
+    const mc_sha256_impl_t impls[] = {MC_SHA256_IMPL_SCALAR,
+                                      MC_SHA256_IMPL_SSE2,
+                                      MC_SHA256_IMPL_NEON,
+                                      MC_SHA256_IMPL_AVX2,
+                                      MC_SHA256_IMPL_SHANI,
+                                      MC_SHA256_IMPL_AUTO};
+    const size_t ntests = sizeof(tests) / sizeof(tests[0]) - 1u;
+    _mongocrypt_buffer_t *keys = bson_malloc0(ntests * sizeof(_mongocrypt_buffer_t));
+    _mongocrypt_buffer_t *inputs = bson_malloc0(ntests * sizeof(_mongocrypt_buffer_t));
+    _mongocrypt_buffer_t *expects = bson_malloc0(ntests * sizeof(_mongocrypt_buffer_t));
+    mc_hmac_sha256_job_t *jobs = bson_malloc0(ntests * sizeof(mc_hmac_sha256_job_t));
+    uint8_t *got = bson_malloc0(ntests * MC_SHA256_LEN);
+
+    for (size_t i = 0; i < ntests; i++) {
+        _mongocrypt_buffer_copy_from_hex(&keys[i], tests[i].key);
+        _mongocrypt_buffer_copy_from_hex(&inputs[i], tests[i].input);
+        _mongocrypt_buffer_copy_from_hex(&expects[i], tests[i].expect);
+        jobs[i].key = keys[i].data;
+        jobs[i].key_len = keys[i].len;
+        jobs[i].in = inputs[i].data;
+        jobs[i].in_len = inputs[i].len;
+        jobs[i].out = got + i * MC_SHA256_LEN;
+    }
+
+    for (size_t k = 0; k < sizeof(impls) / sizeof(impls[0]); k++) {
+        if (!mc_sha256_impl_supported(impls[k])) {
+            printf("Skipping unsupported SHA-256 implementation '%s'.\n", mc_sha256_impl_name(impls[k]));
+            continue;
+        }
+        printf("Testing SHA-256 implementation '%s' with %zu lanes.\n",
+               mc_sha256_impl_name(impls[k]),
+               mc_sha256_impl_lanes(impls[k]));
+
+        /* Hash every prefix length of the batch so partial groups of lanes are
+         * covered. */
+        for (size_t count = 0; count <= ntests; count += (count < 20u ? 1u : 7u)) {
+            memset(got, 0, ntests * MC_SHA256_LEN);
+            mc_hmac_sha256_many(impls[k], jobs, count);
+            for (size_t i = 0; i < count; i++) {
+                /* Some NIST CAVP tests expect the output tag to be truncated. */
+                ASSERT_CMPBYTES(expects[i].data, expects[i].len, jobs[i].out, BSON_MIN(expects[i].len, MC_SHA256_LEN));
+            }
+        }
+    }
+
+    for (size_t i = 0; i < ntests; i++) {
+        _mongocrypt_buffer_cleanup(&keys[i]);
+        _mongocrypt_buffer_cleanup(&inputs[i]);
+        _mongocrypt_buffer_cleanup(&expects[i]);
+    }
+    bson_free(got);
+    bson_free(jobs);
+    bson_free(expects);
+    bson_free(inputs);
+    bson_free(keys);
+}
+
+static void _test_mongocrypt_hmac_sha_256_many(_mongocrypt_tester_t *tester) {
+#define HMAC_MANY_COUNT 37
+    mongocrypt_t *crypt;
+    mongocrypt_status_t *status;
+    _mongocrypt_buffer_t keys[HMAC_MANY_COUNT];
+    _mongocrypt_buffer_t inputs[HMAC_MANY_COUNT];
+    const _mongocrypt_buffer_t *key_ptrs[HMAC_MANY_COUNT];
+    const _mongocrypt_buffer_t *input_ptrs[HMAC_MANY_COUNT];
+    _mongocrypt_buffer_t got[HMAC_MANY_COUNT];
+
+    crypt = _mongocrypt_tester_mongocrypt(TESTER_MONGOCRYPT_DEFAULT);
+    status = mongocrypt_status_new();
+
+    for (size_t i = 0; i < HMAC_MANY_COUNT; i++) {
+        _mongocrypt_buffer_init_size(&keys[i], MONGOCRYPT_MAC_KEY_LEN);
+        for (uint32_t j = 0; j < keys[i].len; j++) {
+            keys[i].data[j] = (uint8_t)(i * 31u + j);
+        }
+        /* Vary the input length across block boundaries. */
+        _mongocrypt_buffer_init_size(&inputs[i], (uint32_t)(i * 5u));
+        for (uint32_t j = 0; j < inputs[i].len; j++) {
+            inputs[i].data[j] = (uint8_t)(i + j * 7u);
+        }
+        _mongocrypt_buffer_init_size(&got[i], MONGOCRYPT_HMAC_SHA256_LEN);
+        key_ptrs[i] = &keys[i];
+        input_ptrs[i] = &inputs[i];
+    }
+
+    ASSERT_OR_PRINT(
+        _mongocrypt_hmac_sha_256_many(crypt->crypto, key_ptrs, input_ptrs, got, HMAC_MANY_COUNT, status),
+        status);
+
+    for (size_t i = 0; i < HMAC_MANY_COUNT; i++) {
+        _mongocrypt_buffer_t expect;
+        _mongocrypt_buffer_init_size(&expect, MONGOCRYPT_HMAC_SHA256_LEN);
+        ASSERT_OR_PRINT(_mongocrypt_hmac_sha_256(crypt->crypto, &keys[i], &inputs[i], &expect, status), status);
+        ASSERT_CMPBYTES(expect.data, expect.len, got[i].data, got[i].len);
+        _mongocrypt_buffer_cleanup(&expect);
+    }
+
+    /* Keys must have the same length as for _mongocrypt_hmac_sha_256. */
+    keys[1].len = MONGOCRYPT_MAC_KEY_LEN - 1u;
+    ASSERT_FAILS_STATUS(
+        _mongocrypt_hmac_sha_256_many(crypt->crypto, key_ptrs, input_ptrs, got, HMAC_MANY_COUNT, status),
+        status,
+        "invalid hmac_sha_256 key length");
+    keys[1].len = MONGOCRYPT_MAC_KEY_LEN;
+
+    for (size_t i = 0; i < HMAC_MANY_COUNT; i++) {
+        _mongocrypt_buffer_cleanup(&got[i]);
+        _mongocrypt_buffer_cleanup(&inputs[i]);
+        _mongocrypt_buffer_cleanup(&keys[i]);
+    }
+    mongocrypt_status_destroy(status);
+    mongocrypt_destroy(crypt);
+#undef HMAC_MANY_COUNT
+}
+
 static bool _hook_hmac_sha_256(void *ctx,
                                mongocrypt_binary_t *key,
                                mongocrypt_binary_t *in,
@@ -435,6 +641,9 @@ static void _test_random_int64(_mongocrypt_tester_t *tester) {
 void _mongocrypt_tester_install_crypto(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_roundtrip);
     INSTALL_TEST(_test_native_crypto_hmac_sha_256);
+    INSTALL_TEST(_test_native_crypto_aes_256);
+    INSTALL_TEST(_test_mc_hmac_sha256_many);
+    INSTALL_TEST(_test_mongocrypt_hmac_sha_256_many);
     INSTALL_TEST_CRYPTO(_test_mongocrypt_hmac_sha_256_hook, CRYPTO_OPTIONAL);
     INSTALL_TEST(_test_random_int64);
 }
@@ -121,6 +121,165 @@ static void _test_decrypt_ready(_mongocrypt_tester_t *tester) {
     mongocrypt_binary_destroy(encrypted);
 }
 
+static void _test_decrypt_borrow_input(_mongocrypt_tester_t *tester) {
+    mongocrypt_t *crypt;
+    mongocrypt_ctx_t *ctx;
+    mongocrypt_binary_t *in, *out, *encrypted;
+    uint64_t finalized, passthrough;
+
+    crypt = _mongocrypt_tester_mongocrypt(TESTER_MONGOCRYPT_DEFAULT);
+    out = mongocrypt_binary_new();
+
+    /* A document with no ciphertexts is returned without a copy. */
+    in = TEST_BSON("{'a': 1, 'b': {'c': [1, 2, 3]}}");
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_setopt_decrypt_borrow_input(ctx), ctx);
+    ASSERT_OK(mongocrypt_ctx_decrypt_init(ctx, in), ctx);
+    ASSERT_STATE_EQUAL(mongocrypt_ctx_state(ctx), MONGOCRYPT_CTX_READY);
+    ASSERT_OK(mongocrypt_ctx_finalize(ctx, out), ctx);
+    ASSERT(mongocrypt_binary_data(out) == mongocrypt_binary_data(in));
+    ASSERT_CMPUINT32(mongocrypt_binary_len(out), ==, mongocrypt_binary_len(in));
+    mongocrypt_ctx_destroy(ctx);
+
+    mongocrypt_decrypt_stats(crypt, &finalized, &passthrough);
+    ASSERT_CMPUINT64(finalized, ==, 1);
+    ASSERT_CMPUINT64(passthrough, ==, 1);
+
+    /* Without the option, the document is copied. */
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_decrypt_init(ctx, in), ctx);
+    ASSERT_OK(mongocrypt_ctx_finalize(ctx, out), ctx);
+    ASSERT(mongocrypt_binary_data(out) != mongocrypt_binary_data(in));
+    mongocrypt_ctx_destroy(ctx);
+
+    /* A document with ciphertexts is decrypted into a new document. */
+    encrypted = _mongocrypt_tester_encrypted_doc(tester);
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_setopt_decrypt_borrow_input(ctx), ctx);
+    ASSERT_OK(mongocrypt_ctx_decrypt_init(ctx, encrypted), ctx);
+    _mongocrypt_tester_run_ctx_to(tester, ctx, MONGOCRYPT_CTX_READY);
+    ASSERT_OK(mongocrypt_ctx_finalize(ctx, out), ctx);
+    ASSERT(mongocrypt_binary_data(out) != mongocrypt_binary_data(encrypted));
+    mongocrypt_ctx_destroy(ctx);
+    mongocrypt_binary_destroy(encrypted);
+
+    mongocrypt_decrypt_stats(crypt, &finalized, NULL);
+    ASSERT_CMPUINT64(finalized, ==, 3);
+    mongocrypt_decrypt_stats(crypt, NULL, &passthrough);
+    ASSERT_CMPUINT64(passthrough, ==, 2);
+
+    /* The option is prohibited on other contexts. */
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_setopt_decrypt_borrow_input(ctx), ctx);
+    ASSERT_FAILS(mongocrypt_ctx_encrypt_init(ctx, "test", -1, TEST_BSON("{'find': 'coll'}")),
+                 ctx,
+                 "borrowing input is prohibited");
+    mongocrypt_ctx_destroy(ctx);
+
+    /* The option cannot be set after init. */
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_decrypt_init(ctx, in), ctx);
+    ASSERT_FAILS(mongocrypt_ctx_setopt_decrypt_borrow_input(ctx), ctx, "cannot set options after init");
+    mongocrypt_ctx_destroy(ctx);
+
+    mongocrypt_binary_destroy(out);
+    mongocrypt_destroy(crypt);
+}
+
+static void _test_decrypt_paths(_mongocrypt_tester_t *tester) {
+    mongocrypt_t *crypt;
+    mongocrypt_ctx_t *ctx;
+    mongocrypt_binary_t *encrypted, *in, *out;
+    bson_t encrypted_bson, doc, out_bson;
+    bson_iter_t iter;
+
+    crypt = _mongocrypt_tester_mongocrypt(TESTER_MONGOCRYPT_DEFAULT);
+    out = mongocrypt_binary_new();
+
+    /* Make {a: <ciphertext>, b: {c: <ciphertext>}} */
+    encrypted = _mongocrypt_tester_encrypted_doc(tester);
+    BSON_ASSERT(_mongocrypt_binary_to_bson(encrypted, &encrypted_bson));
+    BSON_ASSERT(bson_iter_init(&iter, &encrypted_bson));
+    BSON_ASSERT(bson_iter_find_descendant(&iter, "filter.ssn", &iter));
+    bson_init(&doc);
+    BSON_ASSERT(BSON_APPEND_VALUE(&doc, "a", bson_iter_value(&iter)));
+    {
+        bson_t child;
+        BSON_ASSERT(BSON_APPEND_DOCUMENT_BEGIN(&doc, "b", &child));
+        BSON_ASSERT(BSON_APPEND_VALUE(&child, "c", bson_iter_value(&iter)));
+        BSON_ASSERT(bson_append_document_end(&doc, &child));
+    }
+    in = mongocrypt_binary_new_from_data((uint8_t *)bson_get_data(&doc), doc.len);
+
+    /* Only b.c is decrypted. */
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_setopt_decrypt_paths(ctx, TEST_BSON("{'paths': ['b.c']}")), ctx);
+    ASSERT_OK(mongocrypt_ctx_decrypt_init(ctx, in), ctx);
+    _mongocrypt_tester_run_ctx_to(tester, ctx, MONGOCRYPT_CTX_READY);
+    ASSERT_OK(mongocrypt_ctx_finalize(ctx, out), ctx);
+    BSON_ASSERT(_mongocrypt_binary_to_bson(out, &out_bson));
+    BSON_ASSERT(bson_iter_init(&iter, &out_bson));
+    BSON_ASSERT(bson_iter_find_descendant(&iter, "b.c", &iter));
+    BSON_ASSERT(BSON_ITER_HOLDS_UTF8(&iter));
+    BSON_ASSERT(0 == strcmp(bson_iter_utf8(&iter, NULL), _mongocrypt_tester_plaintext(tester)));
+    BSON_ASSERT(bson_iter_init_find(&iter, &out_bson, "a"));
+    BSON_ASSERT(BSON_ITER_HOLDS_BINARY(&iter));
+    mongocrypt_ctx_destroy(ctx);
+
+    /* No keys are requested if no ciphertext is on the paths. */
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_setopt_decrypt_paths(ctx, TEST_BSON("{'paths': ['b.d', 'c']}")), ctx);
+    ASSERT_OK(mongocrypt_ctx_decrypt_init(ctx, in), ctx);
+    ASSERT_STATE_EQUAL(mongocrypt_ctx_state(ctx), MONGOCRYPT_CTX_READY);
+    ASSERT_OK(mongocrypt_ctx_finalize(ctx, out), ctx);
+    ASSERT_CMPBYTES(mongocrypt_binary_data(in),
+                    mongocrypt_binary_len(in),
+                    mongocrypt_binary_data(out),
+                    mongocrypt_binary_len(out));
+    mongocrypt_ctx_destroy(ctx);
+
+    /* Invalid paths. */
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_FAILS(mongocrypt_ctx_setopt_decrypt_paths(ctx, TEST_BSON("{'paths': 'a'}")),
+                 ctx,
+                 "decrypt paths must have array field 'paths'");
+    mongocrypt_ctx_destroy(ctx);
+
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_FAILS(mongocrypt_ctx_setopt_decrypt_paths(ctx, TEST_BSON("{'paths': ['a..b']}")),
+                 ctx,
+                 "invalid decrypt path");
+    mongocrypt_ctx_destroy(ctx);
+
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_setopt_decrypt_paths(ctx, TEST_BSON("{'paths': ['a']}")), ctx);
+    ASSERT_FAILS(mongocrypt_ctx_setopt_decrypt_paths(ctx, TEST_BSON("{'paths': ['b']}")),
+                 ctx,
+                 "decrypt paths already set");
+    mongocrypt_ctx_destroy(ctx);
+
+    /* The option is prohibited on other contexts. */
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_setopt_decrypt_paths(ctx, TEST_BSON("{'paths': ['a']}")), ctx);
+    ASSERT_FAILS(mongocrypt_ctx_explicit_decrypt_init(ctx, in),
+                 ctx,
+                 "decrypt paths are prohibited on explicit decryption");
+    mongocrypt_ctx_destroy(ctx);
+
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_setopt_decrypt_paths(ctx, TEST_BSON("{'paths': ['a']}")), ctx);
+    ASSERT_FAILS(mongocrypt_ctx_encrypt_init(ctx, "test", -1, TEST_BSON("{'find': 'coll'}")),
+                 ctx,
+                 "decrypt paths are prohibited");
+    mongocrypt_ctx_destroy(ctx);
+
+    mongocrypt_binary_destroy(in);
+    bson_destroy(&doc);
+    mongocrypt_binary_destroy(encrypted);
+    mongocrypt_binary_destroy(out);
+    mongocrypt_destroy(crypt);
+}
+
 /* Test with empty AWS credentials. */
 void _test_decrypt_empty_aws(_mongocrypt_tester_t *tester) {
     mongocrypt_t *crypt;
@@ -942,6 +1101,8 @@ void _mongocrypt_tester_install_ctx_decrypt(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_decrypt_init);
     INSTALL_TEST(_test_decrypt_need_keys);
     INSTALL_TEST(_test_decrypt_ready);
+    INSTALL_TEST(_test_decrypt_borrow_input);
+    INSTALL_TEST(_test_decrypt_paths);
     INSTALL_TEST(_test_decrypt_empty_aws);
     INSTALL_TEST(_test_decrypt_empty_binary);
     INSTALL_TEST(_test_decrypt_per_ctx_credentials);
@@ -20,6 +20,10 @@
 #include "test-mongocrypt-crypto-std-hooks.h"
 #include "test-mongocrypt.h"
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 static void _test_explicit_encrypt_init(_mongocrypt_tester_t *tester) {
     mongocrypt_binary_t *string_msg;
     mongocrypt_binary_t *no_v_msg;
@@ -523,6 +527,228 @@ static void _test_encrypt_csfle_no_needs_markings(_mongocrypt_tester_t *tester)
     mongocrypt_destroy(crypt);
 }
 
+/* Encrypt an insert of five documents with crypt_shared, analyzing at most
+ * chunk_size documents at a time. */
+static void _encrypt_insert_with_csfle(_mongocrypt_tester_t *tester, uint32_t chunk_size, _mongocrypt_buffer_t *out) {
+    mongocrypt_t *crypt = mongocrypt_new();
+    mongocrypt_binary_t *bin = mongocrypt_binary_new();
+
+    ASSERT_OK(mongocrypt_setopt_kms_provider_aws(crypt, "example", -1, "example", -1), crypt);
+    mongocrypt_setopt_append_crypt_shared_lib_search_path(crypt, "$ORIGIN");
+    ASSERT_OK(mongocrypt_setopt_insert_chunk_size(crypt, chunk_size), crypt);
+    ASSERT_OK(mongocrypt_init(crypt), crypt);
+
+    mongocrypt_ctx_t *ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_encrypt_init(ctx,
+                                          "test",
+                                          -1,
+                                          TEST_BSON("{'insert': 'test', 'documents': ["
+                                                    "{'_id': 0, 'ssn': '000-00-0000'},"
+                                                    "{'_id': 1, 'ssn': '111-11-1111'},"
+                                                    "{'_id': 2, 'ssn': '222-22-2222'},"
+                                                    "{'_id': 3, 'ssn': '333-33-3333'},"
+                                                    "{'_id': 4, 'ssn': '444-44-4444'}]}")),
+              ctx);
+    _mongocrypt_tester_run_ctx_to(tester, ctx, MONGOCRYPT_CTX_READY);
+    ASSERT_OK(mongocrypt_ctx_finalize(ctx, bin), ctx);
+    _mongocrypt_buffer_copy_from_binary(out, bin);
+
+    mongocrypt_binary_destroy(bin);
+    mongocrypt_ctx_destroy(ctx);
+    mongocrypt_destroy(crypt);
+}
+
+static void _test_encrypt_csfle_insert_chunks(_mongocrypt_tester_t *tester) {
+    if (!TEST_MONGOCRYPT_HAVE_REAL_CRYPT_SHARED_LIB) {
+        fputs("No 'real' csfle library is available. The "
+              "_test_encrypt_csfle_insert_chunks test is a no-op.",
+              stderr);
+        return;
+    }
+
+    _mongocrypt_buffer_t whole, chunked;
+
+    /* Slices of two documents produce the same command as one analysis. */
+    _encrypt_insert_with_csfle(tester, 0, &whole);
+    _encrypt_insert_with_csfle(tester, 2, &chunked);
+    ASSERT_CMPBUF(whole, chunked);
+
+    _mongocrypt_buffer_cleanup(&whole);
+    _mongocrypt_buffer_cleanup(&chunked);
+}
+
+/* A stub crypt_shared query analyzer. analyze_query copies the command without
+ * "jsonSchema" and "isRemoteSchema", replacing each "ssn" in "documents" with
+ * the marking from test/example/mongocryptd-reply.json. */
+static struct {
+    bson_value_t marking;
+    int num_analyze_calls;
+} _stub_csfle;
+
+static mongo_crypt_v1_status *_stub_status_create(void) {
+    return (mongo_crypt_v1_status *)&_stub_csfle;
+}
+
+static void _stub_status_destroy(mongo_crypt_v1_status *status) {}
+
+static int _stub_status_get_error(const mongo_crypt_v1_status *status) {
+    return 0;
+}
+
+static const char *_stub_status_get_explanation(const mongo_crypt_v1_status *status) {
+    return "";
+}
+
+static int _stub_status_get_code(const mongo_crypt_v1_status *status) {
+    return 0;
+}
+
+static mongo_crypt_v1_query_analyzer *_stub_query_analyzer_create(mongo_crypt_v1_lib *lib,
+                                                                  mongo_crypt_v1_status *status) {
+    return (mongo_crypt_v1_query_analyzer *)&_stub_csfle;
+}
+
+static void _stub_query_analyzer_destroy(mongo_crypt_v1_query_analyzer *qa) {}
+
+static uint8_t *_stub_analyze_query(mongo_crypt_v1_query_analyzer *qa,
+                                    const uint8_t *documentBSON,
+                                    const char *ns_str,
+                                    uint32_t ns_len,
+                                    uint32_t *bson_len,
+                                    mongo_crypt_v1_status *status) {
+    bson_t cmd, reply = BSON_INITIALIZER, result;
+    bson_iter_t iter;
+    uint32_t len;
+
+    _stub_csfle.num_analyze_calls++;
+    memcpy(&len, documentBSON, sizeof(len));
+    ASSERT(bson_init_static(&cmd, documentBSON, BSON_UINT32_FROM_LE(len)));
+
+    BSON_APPEND_DOCUMENT_BEGIN(&reply, "result", &result);
+    ASSERT(bson_iter_init(&iter, &cmd));
+    while (bson_iter_next(&iter)) {
+        const char *key = bson_iter_key(&iter);
+        bson_iter_t documents;
+        bson_t marked_documents;
+
+        if (0 == strcmp(key, "jsonSchema") || 0 == strcmp(key, "isRemoteSchema")) {
+            continue;
+        }
+        if (0 != strcmp(key, "documents")) {
+            ASSERT(bson_append_iter(&result, NULL, 0, &iter));
+            continue;
+        }
+
+        ASSERT(bson_iter_recurse(&iter, &documents));
+        BSON_APPEND_ARRAY_BEGIN(&result, "documents", &marked_documents);
+        while (bson_iter_next(&documents)) {
+            bson_iter_t field;
+            bson_t marked;
+
+            BSON_APPEND_DOCUMENT_BEGIN(&marked_documents, bson_iter_key(&documents), &marked);
+            ASSERT(bson_iter_recurse(&documents, &field));
+            while (bson_iter_next(&field)) {
+                if (0 == strcmp(bson_iter_key(&field), "ssn")) {
+                    ASSERT(BSON_APPEND_VALUE(&marked, "ssn", &_stub_csfle.marking));
+                } else {
+                    ASSERT(bson_append_iter(&marked, NULL, 0, &field));
+                }
+            }
+            bson_append_document_end(&marked_documents, &marked);
+        }
+        bson_append_array_end(&result, &marked_documents);
+    }
+    bson_append_document_end(&reply, &result);
+    BSON_APPEND_BOOL(&reply, "hasEncryptedPlaceholders", true);
+    BSON_APPEND_BOOL(&reply, "schemaRequiresEncryption", true);
+
+    *bson_len = reply.len;
+    return bson_destroy_with_steal(&reply, true, NULL);
+}
+
+static void _stub_bson_free(uint8_t *bson) {
+    bson_free(bson);
+}
+
+/* Encrypt an insert of five documents with the stub analyzer, analyzing at
+ * most chunk_size documents at a time. Returns the number of analyze calls. */
+static int
+_encrypt_insert_with_stub_csfle(_mongocrypt_tester_t *tester, uint32_t chunk_size, _mongocrypt_buffer_t *out) {
+    mongocrypt_t *crypt = mongocrypt_new();
+    mongocrypt_binary_t *bin = mongocrypt_binary_new();
+    bson_t reply;
+    bson_iter_t iter;
+
+    BSON_ASSERT(_mongocrypt_binary_to_bson(TEST_FILE("./test/example/mongocryptd-reply.json"), &reply));
+    ASSERT(bson_iter_init(&iter, &reply));
+    ASSERT(bson_iter_find_descendant(&iter, "result.filter.ssn", &iter));
+    bson_value_copy(bson_iter_value(&iter), &_stub_csfle.marking);
+    _stub_csfle.num_analyze_calls = 0;
+
+    ASSERT_OK(mongocrypt_setopt_kms_provider_aws(crypt, "example", -1, "example", -1), crypt);
+    ASSERT_OK(mongocrypt_setopt_insert_chunk_size(crypt, chunk_size), crypt);
+    ASSERT_OK(mongocrypt_init(crypt), crypt);
+    ASSERT(!crypt->csfle.okay);
+    crypt->csfle = (_mongo_crypt_v1_vtable){.status_create = _stub_status_create,
+                                            .status_destroy = _stub_status_destroy,
+                                            .status_get_error = _stub_status_get_error,
+                                            .status_get_explanation = _stub_status_get_explanation,
+                                            .status_get_code = _stub_status_get_code,
+                                            .query_analyzer_create = _stub_query_analyzer_create,
+                                            .query_analyzer_destroy = _stub_query_analyzer_destroy,
+                                            .analyze_query = _stub_analyze_query,
+                                            .bson_free = _stub_bson_free,
+                                            .okay = true};
+    crypt->csfle_lib = (mongo_crypt_v1_lib *)&_stub_csfle;
+
+    mongocrypt_ctx_t *ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_encrypt_init(ctx,
+                                          "test",
+                                          -1,
+                                          TEST_BSON("{'insert': 'test', 'documents': ["
+                                                    "{'_id': 0, 'ssn': '000-00-0000'},"
+                                                    "{'_id': 1, 'ssn': '111-11-1111'},"
+                                                    "{'_id': 2, 'ssn': '222-22-2222'},"
+                                                    "{'_id': 3, 'ssn': '333-33-3333'},"
+                                                    "{'_id': 4, 'ssn': '444-44-4444'}],"
+                                                    "'ordered': false, 'let': {'x': 1}}")),
+              ctx);
+    _mongocrypt_tester_run_ctx_to(tester, ctx, MONGOCRYPT_CTX_READY);
+    ASSERT_OK(mongocrypt_ctx_finalize(ctx, bin), ctx);
+    _mongocrypt_buffer_copy_from_binary(out, bin);
+
+    mongocrypt_binary_destroy(bin);
+    mongocrypt_ctx_destroy(ctx);
+    /* The stub holds no reference to a loaded crypt_shared library. */
+    crypt->csfle.okay = false;
+    crypt->csfle_lib = NULL;
+    mongocrypt_destroy(crypt);
+    bson_value_destroy(&_stub_csfle.marking);
+    return _stub_csfle.num_analyze_calls;
+}
+
+static void _test_encrypt_csfle_insert_chunks_stub(_mongocrypt_tester_t *tester) {
+    _mongocrypt_buffer_t whole, chunked;
+    bson_t as_bson;
+    bson_iter_t iter;
+    const char *expect_keys[] = {"insert", "documents", "ordered", "let"};
+
+    ASSERT(_encrypt_insert_with_stub_csfle(tester, 0, &whole) == 1);
+    ASSERT(_encrypt_insert_with_stub_csfle(tester, 2, &chunked) == 3);
+    ASSERT_CMPBUF(whole, chunked);
+
+    /* "documents" keeps its position between "insert" and the fields after it. */
+    ASSERT(_mongocrypt_buffer_to_bson(&chunked, &as_bson));
+    ASSERT(bson_iter_init(&iter, &as_bson));
+    for (size_t i = 0; i < sizeof(expect_keys) / sizeof(expect_keys[0]); i++) {
+        ASSERT(bson_iter_next(&iter));
+        ASSERT_STREQUAL(bson_iter_key(&iter), expect_keys[i]);
+    }
+
+    _mongocrypt_buffer_cleanup(&whole);
+    _mongocrypt_buffer_cleanup(&chunked);
+}
+
 static void _test_encrypt_need_keys(_mongocrypt_tester_t *tester) {
     mongocrypt_t *crypt;
     mongocrypt_ctx_t *ctx;
@@ -1075,6 +1301,214 @@ static void _test_explicit_encryption(_mongocrypt_tester_t *tester) {
     mongocrypt_destroy(crypt);
 }
 
+// A repeated deterministic encryption reuses the cached ciphertext.
+static void _test_explicit_encryption_deterministic_cached(_mongocrypt_tester_t *tester) {
+    mongocrypt_t *crypt;
+    mongocrypt_binary_t *key_id;
+    _mongocrypt_buffer_t first = {0};
+    uint64_t hits, misses;
+    char *deterministic = MONGOCRYPT_ALGORITHM_DETERMINISTIC_STR;
+    const char *values[] = {"{'v': 123}", "{'v': 123}", "{'v': 456}"};
+
+    crypt = mongocrypt_new();
+    ASSERT_OK(mongocrypt_setopt_kms_provider_aws(crypt, "example", -1, "example", -1), crypt);
+    ASSERT_OK(mongocrypt_setopt_deterministic_cache_size(crypt, 16), crypt);
+    ASSERT_OK(mongocrypt_init(crypt), crypt);
+
+    key_id = mongocrypt_binary_new_from_data(MONGOCRYPT_DATA_AND_LEN("aaaaaaaaaaaaaaaa"));
+
+    for (size_t i = 0; i < sizeof values / sizeof values[0]; i++) {
+        mongocrypt_ctx_t *ctx = mongocrypt_ctx_new(crypt);
+        mongocrypt_binary_t *bin = mongocrypt_binary_new();
+
+        ASSERT_OK(mongocrypt_ctx_setopt_algorithm(ctx, deterministic, -1), ctx);
+        ASSERT_OK(mongocrypt_ctx_setopt_key_id(ctx, key_id), ctx);
+        ASSERT_OK(mongocrypt_ctx_explicit_encrypt_init(ctx, TEST_BSON("%s", values[i])), ctx);
+        _mongocrypt_tester_run_ctx_to(tester, ctx, MONGOCRYPT_CTX_READY);
+        ASSERT_OK(mongocrypt_ctx_finalize(ctx, bin), ctx);
+
+        if (i == 0) {
+            _mongocrypt_buffer_copy_from_binary(&first, bin);
+        } else {
+            _mongocrypt_buffer_t got;
+
+            _mongocrypt_buffer_from_binary(&got, bin);
+            ASSERT((i == 1) == (0 == _mongocrypt_buffer_cmp(&first, &got)));
+        }
+
+        mongocrypt_binary_destroy(bin);
+        mongocrypt_ctx_destroy(ctx);
+    }
+
+    mongocrypt_deterministic_cache_stats(crypt, &hits, &misses);
+    ASSERT_CMPUINT64(hits, ==, 1);
+    ASSERT_CMPUINT64(misses, ==, 2);
+
+    _mongocrypt_buffer_cleanup(&first);
+    mongocrypt_binary_destroy(key_id);
+    mongocrypt_destroy(crypt);
+}
+
+#if defined(__GLIBC__)
+/* Heap accounting for _test_encrypt_large_insert_peak_heap. Blocks allocated
+ * before the counting vtable is installed may be freed while it is installed,
+ * so only the growth over the starting usage is meaningful. */
+static int64_t _heap_in_use;
+static int64_t _heap_peak;
+
+static void _heap_track(int64_t delta) {
+    _heap_in_use += delta;
+    if (_heap_in_use > _heap_peak) {
+        _heap_peak = _heap_in_use;
+    }
+}
+
+static void *_counting_malloc(size_t num_bytes) {
+    void *mem = malloc(num_bytes);
+    if (mem) {
+        _heap_track((int64_t)malloc_usable_size(mem));
+    }
+    return mem;
+}
+
+static void *_counting_calloc(size_t n_members, size_t num_bytes) {
+    void *mem = calloc(n_members, num_bytes);
+    if (mem) {
+        _heap_track((int64_t)malloc_usable_size(mem));
+    }
+    return mem;
+}
+
+static void *_counting_realloc(void *mem, size_t num_bytes) {
+    int64_t before = mem ? (int64_t)malloc_usable_size(mem) : 0;
+    void *out = realloc(mem, num_bytes);
+    if (out) {
+        // realloc may copy, so count the old and new blocks as live at once.
+        _heap_track((int64_t)malloc_usable_size(out));
+        _heap_track(-before);
+    }
+    return out;
+}
+
+static void _counting_free(void *mem) {
+    if (mem) {
+        _heap_track(-(int64_t)malloc_usable_size(mem));
+    }
+    free(mem);
+}
+#endif
+
+/* Auto encryption of a large insert does not hold several copies of the
+ * command at once. */
+static void _test_encrypt_large_insert_peak_heap(_mongocrypt_tester_t *tester) {
+#if !defined(__GLIBC__)
+    printf("Test requires malloc_usable_size. Skipping.");
+#else
+    const int num_docs = 2000;
+    bson_mem_vtable_t counting = {.malloc = _counting_malloc,
+                                  .calloc = _counting_calloc,
+                                  .realloc = _counting_realloc,
+                                  .free = _counting_free};
+    mongocrypt_t *crypt;
+    mongocrypt_ctx_t *ctx;
+    mongocrypt_binary_t *cmd_bin, *reply_bin, *mongocryptd_cmd, *out;
+    bson_t cmd = BSON_INITIALIZER, marked = BSON_INITIALIZER, reply = BSON_INITIALIZER;
+    bson_t docs, marked_docs, example_reply;
+    bson_iter_t iter;
+    const uint8_t *marking;
+    uint32_t marking_len;
+    bson_subtype_t subtype;
+    char pad[1024];
+    int64_t peak;
+
+    /* Build {insert: "test", documents: [...]} and the matching mongocryptd
+     * reply, with a marking in place of every "ssn". */
+    BSON_ASSERT(_mongocrypt_binary_to_bson(TEST_FILE("./test/example/mongocryptd-reply.json"), &example_reply));
+    BSON_ASSERT(bson_iter_init(&iter, &example_reply));
+    BSON_ASSERT(bson_iter_find_descendant(&iter, "result.filter.ssn", &iter));
+    bson_iter_binary(&iter, &subtype, &marking_len, &marking);
+
+    memset(pad, 'x', sizeof pad - 1);
+    pad[sizeof pad - 1] = '\0';
+
+    BSON_APPEND_UTF8(&cmd, "insert", "test");
+    BSON_APPEND_UTF8(&marked, "insert", "test");
+    BSON_APPEND_ARRAY_BEGIN(&cmd, "documents", &docs);
+    BSON_APPEND_ARRAY_BEGIN(&marked, "documents", &marked_docs);
+    for (int i = 0; i < num_docs; i++) {
+        char key[16];
+        bson_t doc;
+
+        ASSERT_CMPINT(bson_snprintf(key, sizeof key, "%d", i), >, 0);
+        BSON_APPEND_DOCUMENT_BEGIN(&docs, key, &doc);
+        BSON_APPEND_INT32(&doc, "_id", i);
+        BSON_APPEND_UTF8(&doc, "pad", pad);
+        BSON_APPEND_UTF8(&doc, "ssn", "457-55-5462");
+        bson_append_document_end(&docs, &doc);
+
+        BSON_APPEND_DOCUMENT_BEGIN(&marked_docs, key, &doc);
+        BSON_APPEND_INT32(&doc, "_id", i);
+        BSON_APPEND_UTF8(&doc, "pad", pad);
+        BSON_APPEND_BINARY(&doc, "ssn", subtype, marking, marking_len);
+        bson_append_document_end(&marked_docs, &doc);
+    }
+    bson_append_array_end(&cmd, &docs);
+    bson_append_array_end(&marked, &marked_docs);
+
+    BSON_APPEND_BOOL(&reply, "schemaRequiresEncryption", true);
+    BSON_APPEND_BOOL(&reply, "hasEncryptedPlaceholders", true);
+    BSON_APPEND_DOCUMENT(&reply, "result", &marked);
+    BSON_APPEND_INT32(&reply, "ok", 1);
+
+    cmd_bin = mongocrypt_binary_new_from_data((uint8_t *)bson_get_data(&cmd), cmd.len);
+    reply_bin = mongocrypt_binary_new_from_data((uint8_t *)bson_get_data(&reply), reply.len);
+    mongocryptd_cmd = mongocrypt_binary_new();
+    out = mongocrypt_binary_new();
+
+    crypt = _mongocrypt_tester_mongocrypt(TESTER_MONGOCRYPT_DEFAULT);
+
+    _heap_in_use = 0;
+    _heap_peak = 0;
+    bson_mem_set_vtable(&counting);
+
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_encrypt_init(ctx, "db", -1, cmd_bin), ctx);
+    _mongocrypt_tester_run_ctx_to(tester, ctx, MONGOCRYPT_CTX_NEED_MONGO_MARKINGS);
+    ASSERT_OK(mongocrypt_ctx_mongo_op(ctx, mongocryptd_cmd), ctx);
+    ASSERT_OK(mongocrypt_ctx_mongo_feed(ctx, reply_bin), ctx);
+    ASSERT_OK(mongocrypt_ctx_mongo_done(ctx), ctx);
+    _mongocrypt_tester_run_ctx_to(tester, ctx, MONGOCRYPT_CTX_READY);
+    ASSERT_OK(mongocrypt_ctx_finalize(ctx, out), ctx);
+    peak = _heap_peak;
+
+    /* The peak is expected at the end of finalize, or while the marked command
+     * is fed:
+     * - marked_cmd, about 1.04x the command. Each marking is 46 bytes larger
+     *   than the plaintext value it replaces.
+     * - The output, presized to marked_cmd plus 64 bytes per marking, about
+     *   1.1x the command.
+     * - Or, while feeding, original_cmd and marked_cmd, about 2.04x.
+     * Excluded: the command returned by mongocrypt_ctx_mongo_op, which stays
+     * valid until the context is destroyed, and the caller's cmd_bin and
+     * reply_bin, which are not counted. The bound leaves about 0.1x for keys
+     * and other small allocations. Holding one more copy of the command fails
+     * it. */
+    ASSERT_CMPINT64(peak - (int64_t)mongocryptd_cmd->len, <=, (int64_t)cmd.len * 9 / 4);
+
+    mongocrypt_ctx_destroy(ctx);
+    bson_mem_restore_vtable();
+
+    mongocrypt_binary_destroy(out);
+    mongocrypt_binary_destroy(mongocryptd_cmd);
+    mongocrypt_binary_destroy(reply_bin);
+    mongocrypt_binary_destroy(cmd_bin);
+    bson_destroy(&reply);
+    bson_destroy(&marked);
+    bson_destroy(&cmd);
+    mongocrypt_destroy(crypt);
+#endif
+}
+
 /* Test with empty AWS credentials. */
 void _test_encrypt_empty_aws(_mongocrypt_tester_t *tester) {
     mongocrypt_t *crypt;
@@ -2012,6 +2446,97 @@ static void _test_encrypt_fle2_find_payload(_mongocrypt_tester_t *tester) {
     TEST_ENCRYPT_FLE2_ENCRYPTION_PLACEHOLDER(tester, "fle2-find-equality", &source, NULL)
 }
 
+// A repeated find reuses the cached FLE2FindEqualityPayload when the query cache is enabled.
+static void _test_encrypt_fle2_find_payload_cached(_mongocrypt_tester_t *tester) {
+    mongocrypt_t *crypt;
+    uint64_t hits, misses;
+
+    if (!_aes_ctr_is_supported_by_os) {
+        printf("Common Crypto with no CTR support detected. Skipping.");
+        return;
+    }
+
+    {
+        char localkey_data[MONGOCRYPT_KEY_LEN] = {0};
+        mongocrypt_binary_t *localkey;
+
+        crypt = mongocrypt_new();
+        localkey = mongocrypt_binary_new_from_data((uint8_t *)localkey_data, sizeof localkey_data);
+        ASSERT_OK(mongocrypt_setopt_kms_provider_local(crypt, localkey), crypt);
+        ASSERT_OK(mongocrypt_setopt_encrypted_field_config_map(
+                      crypt,
+                      TEST_FILE("./test/data/fle2-find-equality/encrypted-field-map.json")),
+                  crypt);
+        mongocrypt_binary_destroy(localkey);
+        ASSERT_OK(mongocrypt_setopt_query_cache_size(crypt, 16), crypt);
+        ASSERT_OK(mongocrypt_init(crypt), crypt);
+    }
+
+    for (int i = 0; i < 2; i++) {
+        mongocrypt_ctx_t *ctx = mongocrypt_ctx_new(crypt);
+        mongocrypt_binary_t *out = mongocrypt_binary_new();
+
+        ASSERT_OK(mongocrypt_ctx_encrypt_init(ctx, "db", -1, TEST_FILE("./test/data/fle2-find-equality/cmd.json")),
+                  ctx);
+        ASSERT_STATE_EQUAL(mongocrypt_ctx_state(ctx), MONGOCRYPT_CTX_NEED_MONGO_MARKINGS);
+        ASSERT_OK(mongocrypt_ctx_mongo_feed(ctx, TEST_FILE("./test/data/fle2-find-equality/mongocryptd-reply.json")),
+                  ctx);
+        ASSERT_OK(mongocrypt_ctx_mongo_done(ctx), ctx);
+
+        // Keys are only fetched for the first context. Later contexts use the key cache.
+        if (mongocrypt_ctx_state(ctx) == MONGOCRYPT_CTX_NEED_MONGO_KEYS) {
+            ASSERT_OK(mongocrypt_ctx_mongo_feed(
+                          ctx,
+                          TEST_FILE("./test/data/keys/12345678123498761234123456789012-local-document.json")),
+                      ctx);
+            ASSERT_OK(mongocrypt_ctx_mongo_feed(
+                          ctx,
+                          TEST_FILE("./test/data/keys/ABCDEFAB123498761234123456789012-local-document.json")),
+                      ctx);
+            ASSERT_OK(mongocrypt_ctx_mongo_done(ctx), ctx);
+        }
+
+        ASSERT_STATE_EQUAL(mongocrypt_ctx_state(ctx), MONGOCRYPT_CTX_READY);
+        ASSERT_OK(mongocrypt_ctx_finalize(ctx, out), ctx);
+        ASSERT_MONGOCRYPT_BINARY_EQUAL_BSON(TEST_FILE("./test/data/fle2-find-equality/encrypted-payload.json"), out);
+
+        mongocrypt_query_cache_stats(crypt, &hits, &misses);
+        ASSERT_CMPUINT64(hits, ==, (uint64_t)i);
+        ASSERT_CMPUINT64(misses, ==, 1);
+
+        mongocrypt_binary_destroy(out);
+        mongocrypt_ctx_destroy(ctx);
+    }
+
+    // Expiring the data key removes the payloads derived from it.
+    {
+        _mongocrypt_buffer_t id;
+        _mongocrypt_cache_key_attr_t *attr;
+        _mongocrypt_cache_key_value_t *value = NULL;
+        int64_t start;
+
+        ASSERT_CMPUINT32(_mongocrypt_cache_query_num_entries(crypt->cache_query), ==, 1);
+        _mongocrypt_cache_set_expiration(&crypt->cache_key, 1);
+        start = bson_get_monotonic_time();
+        while (bson_get_monotonic_time() - start < 3 * 1000) {
+        }
+
+        // Any lookup evicts expired keys.
+        _mongocrypt_buffer_init(&id);
+        _mongocrypt_buffer_resize(&id, UUID_LEN);
+        memset(id.data, 0, id.len);
+        attr = _mongocrypt_cache_key_attr_new(&id, NULL);
+        ASSERT(_mongocrypt_cache_get(&crypt->cache_key, attr, (void **)&value));
+        ASSERT(!value);
+        ASSERT_CMPUINT32(_mongocrypt_cache_num_entries(&crypt->cache_key), ==, 0);
+        ASSERT_CMPUINT32(_mongocrypt_cache_query_num_entries(crypt->cache_query), ==, 0);
+        _mongocrypt_cache_key_attr_destroy(attr);
+        _mongocrypt_buffer_cleanup(&id);
+    }
+
+    mongocrypt_destroy(crypt);
+}
+
 /* 16 bytes of random data are used for IV. This IV produces the expected test
  * ciphertext. */
 #define RNG_DATA "\x4d\x06\x95\x64\xf5\xa0\x5e\x9e\x35\x23\xb9\x8f\x57\x5a\xcb\x15"
@@ -4186,6 +4711,8 @@ void _mongocrypt_tester_install_ctx_encrypt(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_encrypt_need_collinfo);
     INSTALL_TEST(_test_encrypt_need_markings);
     INSTALL_TEST(_test_encrypt_csfle_no_needs_markings);
+    INSTALL_TEST(_test_encrypt_csfle_insert_chunks);
+    INSTALL_TEST(_test_encrypt_csfle_insert_chunks_stub);
     INSTALL_TEST(_test_encrypt_need_keys);
     INSTALL_TEST(_test_encrypt_ready);
     INSTALL_TEST(_test_key_missing_region);
@@ -4201,6 +4728,8 @@ void _mongocrypt_tester_install_ctx_encrypt(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_encrypt_dupe_jsonschema);
     INSTALL_TEST(_test_encrypting_with_explicit_encryption);
     INSTALL_TEST(_test_explicit_encryption);
+    INSTALL_TEST(_test_explicit_encryption_deterministic_cached);
+    INSTALL_TEST(_test_encrypt_large_insert_peak_heap);
     INSTALL_TEST(_test_encrypt_empty_aws);
     INSTALL_TEST(_test_encrypt_custom_endpoint);
     INSTALL_TEST(_test_encrypt_with_aws_session_token);
@@ -4217,6 +4746,7 @@ void _mongocrypt_tester_install_ctx_encrypt(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_FLE2EncryptionPlaceholder_parse);
     INSTALL_TEST(_test_encrypt_fle2_insert_payload);
     INSTALL_TEST(_test_encrypt_fle2_find_payload);
+    INSTALL_TEST(_test_encrypt_fle2_find_payload_cached);
     INSTALL_TEST(_test_encrypt_fle2_unindexed_encrypted_payload);
     INSTALL_TEST(_test_encrypt_fle2_explicit);
     INSTALL_TEST(_test_encrypt_applies_default_state_collections);
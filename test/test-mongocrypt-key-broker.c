@@ -702,6 +702,107 @@ static void _test_key_broker_kmip(_mongocrypt_tester_t *tester) {
     mongocrypt_destroy(crypt);
 }
 
+/* SUCCESS_GET_RESPONSE with BatchCount 2 and its BatchItem repeated with
+ * UniqueBatchItemIDs 0 and 1. */
+static const uint8_t SUCCESS_GET_BATCH_RESPONSE[] = {
+    0x42, 0x00, 0x7b, 0x01, 0x00, 0x00, 0x02, 0x80, 0x42, 0x00, 0x7a, 0x01, 0x00, 0x00, 0x00, 0x48, 0x42, 0x00, 0x69,
+    0x01, 0x00, 0x00, 0x00, 0x20, 0x42, 0x00, 0x6a, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x42, 0x00, 0x6b, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x42,
+    0x00, 0x92, 0x09, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x61, 0x59, 0xea, 0xe8, 0x42, 0x00, 0x0d, 0x02,
+    0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x0f, 0x01, 0x00, 0x00, 0x01,
+    0x10, 0x42, 0x00, 0x5c, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00,
+    0x93, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x7f, 0x05, 0x00,
+    0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x7c, 0x01, 0x00, 0x00, 0x00, 0xd8,
+    0x42, 0x00, 0x57, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x94,
+    0x07, 0x00, 0x00, 0x00, 0x20, 0x79, 0x77, 0x78, 0x72, 0x53, 0x6a, 0x35, 0x54, 0x4c, 0x6a, 0x73, 0x77, 0x64, 0x31,
+    0x47, 0x34, 0x6f, 0x47, 0x46, 0x4a, 0x36, 0x68, 0x77, 0x57, 0x67, 0x74, 0x54, 0x73, 0x51, 0x69, 0x70, 0x30, 0x42,
+    0x00, 0x85, 0x01, 0x00, 0x00, 0x00, 0x98, 0x42, 0x00, 0x86, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02,
+    0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00, 0x80, 0x42, 0x00, 0x42, 0x05, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x45, 0x01, 0x00, 0x00, 0x00, 0x68, 0x42, 0x00,
+    0x43, 0x08, 0x00, 0x00, 0x00, 0x60, 0x0c, 0x2e, 0xa7, 0x29, 0x71, 0x80, 0xf8, 0x2a, 0x98, 0x4b, 0x2f, 0xd4, 0x7d,
+    0x63, 0x27, 0xce, 0x22, 0x6f, 0x62, 0xe9, 0x01, 0x7b, 0x91, 0xdc, 0x6e, 0x5d, 0x6d, 0xfd, 0x98, 0x74, 0x7d, 0x97,
+    0xe8, 0x9f, 0x17, 0xbf, 0x09, 0x26, 0xcf, 0xcc, 0x0a, 0xfb, 0x24, 0xe6, 0x9b, 0x7c, 0x00, 0x12, 0x1d, 0xda, 0x12,
+    0xd0, 0x15, 0x8c, 0x43, 0x75, 0xc3, 0x10, 0x84, 0xab, 0xf7, 0xf2, 0xe6, 0x04, 0x4e, 0xdc, 0x2f, 0x92, 0x80, 0x2b,
+    0xa3, 0xf6, 0x76, 0xd4, 0x70, 0xd2, 0xcb, 0xc4, 0xe3, 0x3a, 0x2a, 0x8e, 0x53, 0xdc, 0xed, 0x78, 0x28, 0xdd, 0x8a,
+    0x35, 0xf2, 0x68, 0x43, 0x7f, 0xf1, 0x41, 0x42, 0x00, 0x0f, 0x01, 0x00, 0x00, 0x01, 0x10, 0x42, 0x00, 0x5c, 0x05,
+    0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x93, 0x08, 0x00, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x7f, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x7c, 0x01, 0x00, 0x00, 0x00, 0xd8, 0x42, 0x00, 0x57, 0x05, 0x00,
+    0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x94, 0x07, 0x00, 0x00, 0x00, 0x20,
+    0x79, 0x77, 0x78, 0x72, 0x53, 0x6a, 0x35, 0x54, 0x4c, 0x6a, 0x73, 0x77, 0x64, 0x31, 0x47, 0x34, 0x6f, 0x47, 0x46,
+    0x4a, 0x36, 0x68, 0x77, 0x57, 0x67, 0x74, 0x54, 0x73, 0x51, 0x69, 0x70, 0x30, 0x42, 0x00, 0x85, 0x01, 0x00, 0x00,
+    0x00, 0x98, 0x42, 0x00, 0x86, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x42,
+    0x00, 0x40, 0x01, 0x00, 0x00, 0x00, 0x80, 0x42, 0x00, 0x42, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x45, 0x01, 0x00, 0x00, 0x00, 0x68, 0x42, 0x00, 0x43, 0x08, 0x00, 0x00, 0x00,
+    0x60, 0x0c, 0x2e, 0xa7, 0x29, 0x71, 0x80, 0xf8, 0x2a, 0x98, 0x4b, 0x2f, 0xd4, 0x7d, 0x63, 0x27, 0xce, 0x22, 0x6f,
+    0x62, 0xe9, 0x01, 0x7b, 0x91, 0xdc, 0x6e, 0x5d, 0x6d, 0xfd, 0x98, 0x74, 0x7d, 0x97, 0xe8, 0x9f, 0x17, 0xbf, 0x09,
+    0x26, 0xcf, 0xcc, 0x0a, 0xfb, 0x24, 0xe6, 0x9b, 0x7c, 0x00, 0x12, 0x1d, 0xda, 0x12, 0xd0, 0x15, 0x8c, 0x43, 0x75,
+    0xc3, 0x10, 0x84, 0xab, 0xf7, 0xf2, 0xe6, 0x04, 0x4e, 0xdc, 0x2f, 0x92, 0x80, 0x2b, 0xa3, 0xf6, 0x76, 0xd4, 0x70,
+    0xd2, 0xcb, 0xc4, 0xe3, 0x3a, 0x2a, 0x8e, 0x53, 0xdc, 0xed, 0x78, 0x28, 0xdd, 0x8a, 0x35, 0xf2, 0x68, 0x43, 0x7f,
+    0xf1, 0x41};
+
+/* KMIP keys sharing an endpoint are fetched with one Get. */
+static void _test_key_broker_kmip_batch(_mongocrypt_tester_t *tester) {
+    mongocrypt_t *crypt;
+    _mongocrypt_key_broker_t kb;
+    bson_t keydoc_bson;
+    bson_t copied;
+    bson_iter_t iter;
+    _mongocrypt_buffer_t id1, id2;
+    _mongocrypt_buffer_t keydoc1, keydoc2;
+    mongocrypt_kms_ctx_t *kms;
+    _mongocrypt_opts_kms_providers_t *kms_providers;
+    _mongocrypt_buffer_t secretdata;
+
+    crypt = _mongocrypt_tester_mongocrypt(TESTER_MONGOCRYPT_DEFAULT);
+    kms_providers = &crypt->opts.kms_providers;
+    _mongocrypt_key_broker_init(&kb, crypt);
+    _load_json_as_bson("./test/data/key-document-kmip.json", &keydoc_bson);
+
+    ASSERT_OR_PRINT_MSG(bson_iter_init_find(&iter, &keydoc_bson, "_id"),
+                        "could not find _id in key-document-kmip.json");
+    BSON_ASSERT(_mongocrypt_buffer_from_binary_iter(&id1, &iter));
+    _mongocrypt_buffer_from_bson(&keydoc1, &keydoc_bson);
+
+    /* A second key wrapped by the same KMIP secret. */
+    _gen_uuid(1, &id2);
+    bson_init(&copied);
+    bson_copy_to_excluding_noinit(&keydoc_bson, &copied, "_id", "keyAltNames", NULL);
+    BSON_ASSERT(_mongocrypt_buffer_append(&id2, &copied, "_id", 3));
+    _mongocrypt_buffer_steal_from_bson(&keydoc2, &copied);
+
+    ASSERT_OK(_mongocrypt_key_broker_request_id(&kb, &id1), &kb);
+    ASSERT_OK(_mongocrypt_key_broker_request_id(&kb, &id2), &kb);
+    ASSERT_OK(_mongocrypt_key_broker_requests_done(&kb), &kb);
+    ASSERT_OK(_mongocrypt_key_broker_add_doc(&kb, kms_providers, &keydoc1), &kb);
+    ASSERT_OK(_mongocrypt_key_broker_add_doc(&kb, kms_providers, &keydoc2), &kb);
+    ASSERT_OK(_mongocrypt_key_broker_docs_done(&kb), &kb);
+
+    /* There should be exactly one KMS request for both keys. */
+    kms = _mongocrypt_key_broker_next_kms(&kb);
+    ASSERT_OR_PRINT_MSG(kms, "expected KMS context returned, got none");
+    ASSERT_CMPSIZE_T(kms->batch_len, ==, 2);
+    ASSERT(!_mongocrypt_key_broker_next_kms(&kb));
+
+    ASSERT_OK(kms_ctx_feed_all(kms, SUCCESS_GET_BATCH_RESPONSE, sizeof(SUCCESS_GET_BATCH_RESPONSE)), kms);
+    ASSERT_OK(_mongocrypt_key_broker_kms_done(&kb, kms_providers), &kb);
+
+    BSON_ASSERT(_mongocrypt_key_broker_decrypted_key_by_id(&kb, &id1, &secretdata));
+    ASSERT_CMPBYTES(secretdata.data, secretdata.len, EXPECTED_SECRETDATA, sizeof(EXPECTED_SECRETDATA));
+    _mongocrypt_buffer_cleanup(&secretdata);
+    BSON_ASSERT(_mongocrypt_key_broker_decrypted_key_by_id(&kb, &id2, &secretdata));
+    ASSERT_CMPBYTES(secretdata.data, secretdata.len, EXPECTED_SECRETDATA, sizeof(EXPECTED_SECRETDATA));
+    _mongocrypt_buffer_cleanup(&secretdata);
+
+    _mongocrypt_buffer_cleanup(&keydoc2);
+    _mongocrypt_buffer_cleanup(&keydoc1);
+    _mongocrypt_buffer_cleanup(&id2);
+    _mongocrypt_buffer_cleanup(&id1);
+    bson_destroy(&keydoc_bson);
+    _mongocrypt_key_broker_cleanup(&kb);
+    mongocrypt_destroy(crypt);
+}
+
 /*
 <ResponseMessage tag="0x42007b" type="Structure">
  <ResponseHeader tag="0x42007a" type="Structure">
@@ -1016,6 +1117,7 @@ void _mongocrypt_tester_install_key_broker(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_key_broker_wrong_subtype);
     INSTALL_TEST(_test_key_broker_multi_match);
     INSTALL_TEST(_test_key_broker_kmip);
+    INSTALL_TEST(_test_key_broker_kmip_batch);
     INSTALL_TEST(_test_key_broker_kmip_notfound);
     INSTALL_TEST(_test_key_broker_request_any);
     INSTALL_TEST(_test_key_broker_add_any);
@@ -364,6 +364,82 @@ static void _test_mongocrypt_kms_ctx_kmip_get(_mongocrypt_tester_t *tester) {
     mongocrypt_destroy(crypt);
 }
 
+/* SUCCESS_GET_RESPONSE with BatchCount 2 and its BatchItem repeated with
+ * UniqueBatchItemIDs 0 and 1. */
+static const uint8_t SUCCESS_GET_BATCH_RESPONSE[] = {
+    0x42, 0x00, 0x7b, 0x01, 0x00, 0x00, 0x02, 0x50, 0x42, 0x00, 0x7a, 0x01, 0x00, 0x00, 0x00, 0x48, 0x42, 0x00, 0x69,
+    0x01, 0x00, 0x00, 0x00, 0x20, 0x42, 0x00, 0x6a, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x42, 0x00, 0x6b, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x42,
+    0x00, 0x92, 0x09, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x61, 0x65, 0x97, 0x15, 0x42, 0x00, 0x0d, 0x02,
+    0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x0f, 0x01, 0x00, 0x00, 0x00,
+    0xf8, 0x42, 0x00, 0x5c, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00,
+    0x93, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x7f, 0x05, 0x00,
+    0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x7c, 0x01, 0x00, 0x00, 0x00, 0xc0,
+    0x42, 0x00, 0x57, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x94,
+    0x07, 0x00, 0x00, 0x00, 0x02, 0x33, 0x39, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x85, 0x01, 0x00, 0x00,
+    0x00, 0x98, 0x42, 0x00, 0x86, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x42,
+    0x00, 0x40, 0x01, 0x00, 0x00, 0x00, 0x80, 0x42, 0x00, 0x42, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02,
+    0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x45, 0x01, 0x00, 0x00, 0x00, 0x68, 0x42, 0x00, 0x43, 0x08, 0x00, 0x00, 0x00,
+    0x60, 0xff, 0xa8, 0xcc, 0x79, 0xe8, 0xc3, 0x76, 0x3b, 0x01, 0x21, 0xfc, 0xd0, 0x6b, 0xb3, 0x48, 0x8c, 0x8b, 0xf4,
+    0x2c, 0x07, 0x74, 0x60, 0x46, 0x40, 0x27, 0x9b, 0x16, 0xb2, 0x64, 0x19, 0x40, 0x30, 0xee, 0xb0, 0x83, 0x96, 0x24,
+    0x1d, 0xef, 0xcc, 0x4d, 0x32, 0xd1, 0x6e, 0xa8, 0x31, 0xad, 0x77, 0x71, 0x38, 0xf0, 0x8e, 0x2f, 0x98, 0x56, 0x64,
+    0xc0, 0x04, 0xc2, 0x48, 0x5d, 0x6f, 0x49, 0x91, 0xeb, 0x3d, 0x9e, 0xc3, 0x28, 0x02, 0x53, 0x78, 0x36, 0xa9, 0x06,
+    0x6b, 0x4e, 0x10, 0xae, 0xb5, 0x6a, 0x5c, 0xcf, 0x6a, 0xa4, 0x69, 0x01, 0xe6, 0x25, 0xe3, 0x40, 0x0c, 0x78, 0x11,
+    0xd2, 0xec, 0x42, 0x00, 0x0f, 0x01, 0x00, 0x00, 0x00, 0xf8, 0x42, 0x00, 0x5c, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00,
+    0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x93, 0x08, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x7f, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x42, 0x00, 0x7c, 0x01, 0x00, 0x00, 0x00, 0xc0, 0x42, 0x00, 0x57, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00,
+    0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x94, 0x07, 0x00, 0x00, 0x00, 0x02, 0x33, 0x39, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x42, 0x00, 0x85, 0x01, 0x00, 0x00, 0x00, 0x98, 0x42, 0x00, 0x86, 0x05, 0x00, 0x00, 0x00, 0x04,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x40, 0x01, 0x00, 0x00, 0x00, 0x80, 0x42, 0x00, 0x42,
+    0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x45, 0x01, 0x00, 0x00,
+    0x00, 0x68, 0x42, 0x00, 0x43, 0x08, 0x00, 0x00, 0x00, 0x60, 0xff, 0xa8, 0xcc, 0x79, 0xe8, 0xc3, 0x76, 0x3b, 0x01,
+    0x21, 0xfc, 0xd0, 0x6b, 0xb3, 0x48, 0x8c, 0x8b, 0xf4, 0x2c, 0x07, 0x74, 0x60, 0x46, 0x40, 0x27, 0x9b, 0x16, 0xb2,
+    0x64, 0x19, 0x40, 0x30, 0xee, 0xb0, 0x83, 0x96, 0x24, 0x1d, 0xef, 0xcc, 0x4d, 0x32, 0xd1, 0x6e, 0xa8, 0x31, 0xad,
+    0x77, 0x71, 0x38, 0xf0, 0x8e, 0x2f, 0x98, 0x56, 0x64, 0xc0, 0x04, 0xc2, 0x48, 0x5d, 0x6f, 0x49, 0x91, 0xeb, 0x3d,
+    0x9e, 0xc3, 0x28, 0x02, 0x53, 0x78, 0x36, 0xa9, 0x06, 0x6b, 0x4e, 0x10, 0xae, 0xb5, 0x6a, 0x5c, 0xcf, 0x6a, 0xa4,
+    0x69, 0x01, 0xe6, 0x25, 0xe3, 0x40, 0x0c, 0x78, 0x11, 0xd2, 0xec};
+static void _test_mongocrypt_kms_ctx_kmip_get_batch(_mongocrypt_tester_t *tester) {
+    mongocrypt_t *crypt;
+    mongocrypt_kms_ctx_t kms_ctx = {0};
+    bool ok;
+    _mongocrypt_buffer_t result;
+    mongocrypt_status_t *status;
+    _mongocrypt_endpoint_t *endpoint;
+    const char *unique_identifiers[] = {"39", "40"};
+    size_t i;
+
+    status = mongocrypt_status_new();
+    endpoint = _mongocrypt_endpoint_new("example.com", -1, NULL /* opts */, status);
+    ASSERT_OK_STATUS(endpoint != NULL, status);
+
+    crypt = _mongocrypt_tester_mongocrypt(TESTER_MONGOCRYPT_DEFAULT);
+    ok = _mongocrypt_kms_ctx_init_kmip_get_batch(&kms_ctx, endpoint, unique_identifiers, 2, &crypt->log);
+    ASSERT_OK_STATUS(ok, kms_ctx.status);
+    ASSERT_CMPSIZE_T(kms_ctx.batch_len, ==, 2);
+
+    ASSERT_OK(kms_ctx_feed_all(&kms_ctx, SUCCESS_GET_BATCH_RESPONSE, sizeof(SUCCESS_GET_BATCH_RESPONSE)), &kms_ctx);
+
+    /* Each identifier has its own result. */
+    for (i = 0; i < 2; i++) {
+        ok = _mongocrypt_kms_ctx_batch_result(&kms_ctx, i, &result);
+        ASSERT_OK_STATUS(ok, kms_ctx.status);
+        ASSERT_CMPBYTES(result.data,
+                        result.len,
+                        SUCCESS_GET_RESPONSE_SECRETDATA,
+                        sizeof(SUCCESS_GET_RESPONSE_SECRETDATA));
+    }
+
+    ASSERT_FAILS_STATUS(_mongocrypt_kms_ctx_batch_result(&kms_ctx, 2, &result),
+                        kms_ctx.status,
+                        "index out of range");
+
+    _mongocrypt_endpoint_destroy(endpoint);
+    mongocrypt_status_destroy(status);
+    _mongocrypt_kms_ctx_cleanup(&kms_ctx);
+    mongocrypt_destroy(crypt);
+}
+
 static void _test_mongocrypt_kms_ctx_get_kms_provider(_mongocrypt_tester_t *tester) {
     mongocrypt_t *crypt;
     mongocrypt_kms_ctx_t kms_ctx = {0};
@@ -467,11 +543,82 @@ static void _test_mongocrypt_kms_ctx_feed_empty_bytes(_mongocrypt_tester_t *test
     mongocrypt_status_destroy(status);
 }
 
+static void _test_mongocrypt_kms_ctx_keep_alive(_mongocrypt_tester_t *tester) {
+    mongocrypt_t *crypt;
+    mongocrypt_ctx_t *ctx;
+    mongocrypt_kms_ctx_t *kms_ctx;
+    mongocrypt_binary_t *msg = mongocrypt_binary_new();
+    mongocrypt_binary_t *unconsumed = mongocrypt_binary_new();
+    mongocrypt_binary_t *stream;
+    _mongocrypt_buffer_t stream_buf;
+    uint32_t len;
+    /* The start of a second response sent back-to-back on the connection. */
+    const char *next = "HTTP/1.1 200 OK\r\nContent-Len";
+
+    /* Without keep-alive, requests close the connection. */
+    crypt = _mongocrypt_tester_mongocrypt(TESTER_MONGOCRYPT_DEFAULT);
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_setopt_masterkey_aws(ctx, "us-east-1", -1, "cmk", -1), ctx);
+    ASSERT_OK(mongocrypt_ctx_datakey_init(ctx), ctx);
+    kms_ctx = mongocrypt_ctx_next_kms_ctx(ctx);
+    BSON_ASSERT(kms_ctx);
+    ASSERT_OK(mongocrypt_kms_ctx_message(kms_ctx, msg), kms_ctx);
+    BSON_ASSERT(NULL != strstr((char *)msg->data, "Connection:close"));
+    mongocrypt_ctx_destroy(ctx);
+    mongocrypt_destroy(crypt);
+
+    /* With keep-alive, the connection is left open. */
+    crypt = mongocrypt_new();
+    mongocrypt_setopt_use_kms_keep_alive(crypt);
+    ASSERT_OK(
+        mongocrypt_setopt_kms_providers(crypt, TEST_BSON("{'aws': {'accessKeyId': 'a', 'secretAccessKey': 'b'}}")),
+        crypt);
+    ASSERT_OK(mongocrypt_init(crypt), crypt);
+    ctx = mongocrypt_ctx_new(crypt);
+    ASSERT_OK(mongocrypt_ctx_setopt_masterkey_aws(ctx, "us-east-1", -1, "cmk", -1), ctx);
+    ASSERT_OK(mongocrypt_ctx_datakey_init(ctx), ctx);
+    kms_ctx = mongocrypt_ctx_next_kms_ctx(ctx);
+    BSON_ASSERT(kms_ctx);
+    ASSERT_OK(mongocrypt_kms_ctx_message(kms_ctx, msg), kms_ctx);
+    BSON_ASSERT(NULL == strstr((char *)msg->data, "Connection:close"));
+
+    ASSERT_STREQUAL(mongocrypt_kms_ctx_get_connection_key(kms_ctx, &len), "aws/kms.us-east-1.amazonaws.com:443");
+    ASSERT_CMPUINT32(len, ==, (uint32_t)strlen("aws/kms.us-east-1.amazonaws.com:443"));
+
+    /* Feed the response followed by the start of the next one, as a read from
+     * a pipelined connection may return. */
+    _mongocrypt_buffer_t parts[2];
+    _mongocrypt_buffer_from_binary(&parts[0], TEST_FILE("./test/data/kms-encrypt-reply.txt"));
+    _mongocrypt_buffer_init(&parts[1]);
+    parts[1].data = (uint8_t *)next;
+    parts[1].len = (uint32_t)strlen(next);
+    ASSERT(_mongocrypt_buffer_concat(&stream_buf, parts, 2));
+    ASSERT_CMPUINT32(stream_buf.len, <=, mongocrypt_kms_ctx_bytes_needed(kms_ctx));
+    stream = _mongocrypt_buffer_as_binary(&stream_buf);
+    ASSERT_OK(mongocrypt_kms_ctx_feed(kms_ctx, stream), kms_ctx);
+    ASSERT_CMPUINT32(mongocrypt_kms_ctx_bytes_needed(kms_ctx), ==, 0);
+
+    ASSERT_OK(mongocrypt_kms_ctx_unconsumed(kms_ctx, unconsumed), kms_ctx);
+    ASSERT_CMPBYTES(parts[1].data, parts[1].len, mongocrypt_binary_data(unconsumed), mongocrypt_binary_len(unconsumed));
+
+    ASSERT_OK(mongocrypt_ctx_kms_done(ctx), ctx);
+    ASSERT_STATE_EQUAL(mongocrypt_ctx_state(ctx), MONGOCRYPT_CTX_READY);
+
+    mongocrypt_binary_destroy(stream);
+    _mongocrypt_buffer_cleanup(&stream_buf);
+    mongocrypt_binary_destroy(unconsumed);
+    mongocrypt_binary_destroy(msg);
+    mongocrypt_ctx_destroy(ctx);
+    mongocrypt_destroy(crypt);
+}
+
 void _mongocrypt_tester_install_kms_ctx(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(_test_mongocrypt_kms_ctx_kmip_register);
     INSTALL_TEST(_test_mongocrypt_kms_ctx_kmip_activate);
     INSTALL_TEST(_test_mongocrypt_kms_ctx_kmip_get);
+    INSTALL_TEST(_test_mongocrypt_kms_ctx_kmip_get_batch);
     INSTALL_TEST(_test_mongocrypt_kms_ctx_get_kms_provider);
     INSTALL_TEST(_test_mongocrypt_kms_ctx_default_port);
     INSTALL_TEST(_test_mongocrypt_kms_ctx_feed_empty_bytes);
+    INSTALL_TEST(_test_mongocrypt_kms_ctx_keep_alive);
 }
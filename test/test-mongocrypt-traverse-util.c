@@ -268,6 +268,26 @@ static void test_traverse(int num_markings,
     /* Count matches */
     BSON_ASSERT(matched == num_matches);
 
+    /* Scanning the raw bytes finds the same values */
+    {
+        _mongocrypt_buffer_t raw;
+        mc_array_t offsets;
+        size_t count;
+
+        _mongocrypt_buffer_from_bson(&raw, bson);
+        _mc_array_init(&offsets, sizeof(uint32_t));
+        BSON_ASSERT(_mongocrypt_scan_binary_in_bson(&raw, match, &offsets, &count));
+        BSON_ASSERT(count == (size_t)num_matches);
+        BSON_ASSERT(offsets.len == (size_t)num_matches);
+        for (size_t i = 0; i < offsets.len; i++) {
+            const uint32_t offset = _mc_array_index(&offsets, uint32_t, i);
+            BSON_ASSERT(raw.data[offset + 4] == BSON_SUBTYPE_ENCRYPTED);
+        }
+        BSON_ASSERT(_mongocrypt_scan_binary_in_bson(&raw, match, NULL, &count));
+        BSON_ASSERT(count == (num_matches > 0 ? 1u : 0u));
+        _mc_array_destroy(&offsets);
+    }
+
     bson_destroy(bson);
     mongocrypt_status_destroy(status);
 }
@@ -468,7 +488,159 @@ static void test_mongocrypt_traverse_util(_mongocrypt_tester_t *tester) {
     test_mongocrypt_traverse_util_nesting(&ctx);
 }
 
+static void test_mongocrypt_scan_util(_mongocrypt_tester_t *tester) {
+    _mongocrypt_buffer_t raw;
+    size_t count;
+    bson_t *scope = BCON_NEW("x", BCON_INT32(1));
+    bson_decimal128_t dec = {0};
+    bson_oid_t oid;
+    bson_t bson = BSON_INITIALIZER;
+
+    /* Skip over every BSON type */
+    bson_oid_init_from_string(&oid, "000000000000000000000000");
+    BSON_ASSERT(BSON_APPEND_DOUBLE(&bson, "double", 1.0));
+    BSON_ASSERT(BSON_APPEND_UTF8(&bson, "utf8", "abc"));
+    BSON_ASSERT(BSON_APPEND_DOCUMENT(&bson, "document", scope));
+    BSON_ASSERT(BSON_APPEND_ARRAY(&bson, "array", scope));
+    BSON_ASSERT(BSON_APPEND_BINARY(&bson, "binary", BSON_SUBTYPE_BINARY, (const uint8_t *)"\x06\x01", 2));
+    BSON_ASSERT(BSON_APPEND_UNDEFINED(&bson, "undefined"));
+    BSON_ASSERT(BSON_APPEND_OID(&bson, "oid", &oid));
+    BSON_ASSERT(BSON_APPEND_BOOL(&bson, "bool", true));
+    BSON_ASSERT(BSON_APPEND_DATE_TIME(&bson, "date_time", 1));
+    BSON_ASSERT(BSON_APPEND_NULL(&bson, "null"));
+    BSON_ASSERT(BSON_APPEND_REGEX(&bson, "regex", "a.*", "i"));
+    BSON_ASSERT(BSON_APPEND_DBPOINTER(&bson, "dbpointer", "db.coll", &oid));
+    BSON_ASSERT(BSON_APPEND_CODE(&bson, "code", "function() {}"));
+    BSON_ASSERT(BSON_APPEND_SYMBOL(&bson, "symbol", "sym"));
+    BSON_ASSERT(BSON_APPEND_CODE_WITH_SCOPE(&bson, "code_w_scope", "function() {}", scope));
+    BSON_ASSERT(BSON_APPEND_INT32(&bson, "int32", 1));
+    BSON_ASSERT(BSON_APPEND_TIMESTAMP(&bson, "timestamp", 1, 2));
+    BSON_ASSERT(BSON_APPEND_INT64(&bson, "int64", 1));
+    BSON_ASSERT(BSON_APPEND_DECIMAL128(&bson, "decimal128", &dec));
+    BSON_ASSERT(BSON_APPEND_MINKEY(&bson, "minkey"));
+    BSON_ASSERT(BSON_APPEND_MAXKEY(&bson, "maxkey"));
+
+    _mongocrypt_buffer_from_bson(&raw, &bson);
+    BSON_ASSERT(_mongocrypt_scan_binary_in_bson(&raw, TRAVERSE_MATCH_CIPHERTEXT, NULL, &count));
+    BSON_ASSERT(count == 0);
+
+    _append_ciphertext_with_subtype(&bson, "ciphertext", -1, 6, 1, tester);
+    _mongocrypt_buffer_from_bson(&raw, &bson);
+    BSON_ASSERT(_mongocrypt_scan_binary_in_bson(&raw, TRAVERSE_MATCH_CIPHERTEXT, NULL, &count));
+    BSON_ASSERT(count == 1);
+
+    /* Malformed BSON is reported */
+    {
+        _mongocrypt_buffer_t truncated;
+        _mongocrypt_buffer_copy_to(&raw, &truncated);
+        truncated.len -= 2;
+        truncated.data[0] = (uint8_t)truncated.len;
+        truncated.data[1] = (uint8_t)(truncated.len >> 8);
+        truncated.data[truncated.len - 1] = 0;
+        BSON_ASSERT(!_mongocrypt_scan_binary_in_bson(&truncated, TRAVERSE_MATCH_CIPHERTEXT, NULL, &count));
+        _mongocrypt_buffer_cleanup(&truncated);
+    }
+
+    bson_destroy(&bson);
+    bson_destroy(scope);
+}
+
+static void test_mongocrypt_traverse_util_paths(_mongocrypt_tester_t *tester) {
+    const char *ct = "{'$binary': {'base64': 'AWFiYw==', 'subType': '06'}}";
+    /* Each binary is a ciphertext. */
+    mongocrypt_binary_t *doc = TEST_BSON("{'a': %s,"
+                                         " 'b': {'c': %s, 'd': %s},"
+                                         " 'bc': %s,"
+                                         " 'e': [{'f': %s}, {'f': %s, 'g': %s}, %s],"
+                                         " 'h': {'i': {'j': %s}},"
+                                         " 'x': %s}",
+                                         ct,
+                                         ct,
+                                         ct,
+                                         ct,
+                                         ct,
+                                         ct,
+                                         ct,
+                                         ct,
+                                         ct,
+                                         ct);
+    const char *path_strs[] = {"b.c", "e.f", "h", "x.y"};
+    mongocrypt_status_t *status = mongocrypt_status_new();
+    mc_array_t paths;
+    bson_t as_bson, out;
+    bson_iter_t iter;
+    int matched;
+
+    _mc_array_init(&paths, sizeof(const char *));
+    _mc_array_append_vals(&paths, path_strs, sizeof(path_strs) / sizeof(path_strs[0]));
+    BSON_ASSERT(_mongocrypt_binary_to_bson(doc, &as_bson));
+
+    /* b.c, e.0.f, e.1.f, e.2 (an ancestor of e.f), h.i.j, and x (an ancestor
+     * of x.y) match. a, b.d, bc, and e.1.g do not. */
+    matched = 0;
+    BSON_ASSERT(bson_iter_init(&iter, &as_bson));
+    ASSERT_OK_STATUS(_mongocrypt_traverse_binary_in_bson_at_paths(test_traverse_cb,
+                                                                  &matched,
+                                                                  TRAVERSE_MATCH_CIPHERTEXT,
+                                                                  &paths,
+                                                                  &iter,
+                                                                  status),
+                     status);
+    ASSERT_CMPINT(matched, ==, 6);
+
+    /* Non-matching values are copied as-is. */
+    matched = 0;
+    bson_init(&out);
+    BSON_ASSERT(bson_iter_init(&iter, &as_bson));
+    ASSERT_OK_STATUS(_mongocrypt_transform_binary_in_bson_at_paths(test_transform_cb,
+                                                                   &matched,
+                                                                   TRAVERSE_MATCH_CIPHERTEXT,
+                                                                   &paths,
+                                                                   &iter,
+                                                                   &out,
+                                                                   status),
+                     status);
+    ASSERT_CMPINT(matched, ==, 6);
+    ASSERT_CMPUINT32(bson_count_keys(&out), ==, bson_count_keys(&as_bson));
+
+    matched = 0;
+    BSON_ASSERT(bson_iter_init(&iter, &out));
+    ASSERT_OK_STATUS(_mongocrypt_traverse_binary_in_bson(post_transform_traverse_check,
+                                                         &matched,
+                                                         TRAVERSE_MATCH_CIPHERTEXT,
+                                                         &iter,
+                                                         status),
+                     status);
+    ASSERT_CMPINT(matched, ==, 6);
+
+    matched = 0;
+    BSON_ASSERT(bson_iter_init(&iter, &out));
+    ASSERT_OK_STATUS(
+        _mongocrypt_traverse_binary_in_bson(test_traverse_cb, &matched, TRAVERSE_MATCH_CIPHERTEXT, &iter, status),
+        status);
+    ASSERT_CMPINT(matched, ==, 10);
+
+    /* No paths match nothing. */
+    _mc_array_clear(&paths);
+    matched = 0;
+    BSON_ASSERT(bson_iter_init(&iter, &as_bson));
+    ASSERT_OK_STATUS(_mongocrypt_traverse_binary_in_bson_at_paths(test_traverse_cb,
+                                                                  &matched,
+                                                                  TRAVERSE_MATCH_CIPHERTEXT,
+                                                                  &paths,
+                                                                  &iter,
+                                                                  status),
+                     status);
+    ASSERT_CMPINT(matched, ==, 0);
+
+    bson_destroy(&out);
+    _mc_array_destroy(&paths);
+    mongocrypt_status_destroy(status);
+}
+
 void _mongocrypt_tester_install_traverse_util(_mongocrypt_tester_t *tester) {
     INSTALL_TEST(test_mongocrypt_traverse_util);
     INSTALL_TEST(test_mongocrypt_transform_util);
+    INSTALL_TEST(test_mongocrypt_scan_util);
+    INSTALL_TEST(test_mongocrypt_traverse_util_paths);
 }
@@ -830,6 +830,8 @@ int main(int argc, char **argv) {
     _mongocrypt_tester_install(&tester, "_test_setopt_kms_providers", _test_setopt_kms_providers, CRYPTO_OPTIONAL);
     _mongocrypt_tester_install_kek(&tester);
     _mongocrypt_tester_install_cache_oauth(&tester);
+    _mongocrypt_tester_install_cache_signing_key(&tester);
+    _mongocrypt_tester_install_cache_query(&tester);
     _mongocrypt_tester_install_kms_ctx(&tester);
     _mongocrypt_tester_install_csfle_lib(&tester);
     _mongocrypt_tester_install_dll(&tester);
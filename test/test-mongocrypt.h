@@ -155,6 +155,10 @@ void _mongocrypt_tester_install_kek(_mongocrypt_tester_t *tester);
 
 void _mongocrypt_tester_install_cache_oauth(_mongocrypt_tester_t *tester);
 
+void _mongocrypt_tester_install_cache_signing_key(_mongocrypt_tester_t *tester);
+
+void _mongocrypt_tester_install_cache_query(_mongocrypt_tester_t *tester);
+
 void _mongocrypt_tester_install_kms_ctx(_mongocrypt_tester_t *tester);
 
 void _mongocrypt_tester_install_mc_tokens(_mongocrypt_tester_t *tester);